@@ -5582,7 +5582,7 @@ INLINE void CCU6_SetT12T13ControlBits(uint16 Mask)
  */
 INLINE uint32 CCU6_ReadHallReg(void)
 {
-	return (uint32)u16_Field_Rd16(&CCU6->CMPSTAT.reg, 3, 0x7u);
+	return (uint32)u16_Field_Rd16(&CCU6->CMPSTAT.reg, 3, 0x38u);
 }
 
 /** \brief Reads actual Hall and PWM patterns for Multi-Channel Mode.
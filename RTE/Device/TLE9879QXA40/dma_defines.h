@@ -176,7 +176,7 @@
 
 #define DMA_CH2_INC (0x1u) /*decimal 1*/
 
-#define DMA_CH2_NoOfTrans (0xBu) /*decimal 11*/
+#define DMA_CH2_NoOfTrans (0xDu) /*decimal 13*/
 
 #define DMA_CH2_SIZE (0x1u) /*decimal 1*/
 
@@ -184,7 +184,7 @@
 
 #define DMA_CH2_SRC_EXT (0x1u) /*decimal 1*/
 
-#define DMA_CH2_SRC_PTR_OFFS (0x14u) /*decimal 20*/
+#define DMA_CH2_SRC_PTR_OFFS (0x18u) /*decimal 24*/
 
 #define DMA_CH2_TASK_NoOfTasks (0x0u) /*decimal 0*/
 
@@ -196,11 +196,11 @@
 
 #define DMA_CH3_DST_EXT (0x1u) /*decimal 1*/
 
-#define DMA_CH3_DST_PTR_OFFS (0x16u) /*decimal 22*/
+#define DMA_CH3_DST_PTR_OFFS (0x1Au) /*decimal 26*/
 
 #define DMA_CH3_INC (0x2u) /*decimal 2*/
 
-#define DMA_CH3_NoOfTrans (0xCu) /*decimal 12*/
+#define DMA_CH3_NoOfTrans (0xEu) /*decimal 14*/
 
 #define DMA_CH3_SIZE (0x1u) /*decimal 1*/
 
@@ -38,17 +38,17 @@
 
 #define CPU_MEMMANAGE_EN (0x0u) /*decimal 0*/
 
-#define CPU_NVIC_IPR0 (0xF0000000u) /*decimal 4026531840*/
+#define CPU_NVIC_IPR0 (0x7070F060u) /*decimal 1886449760*/
 
-#define CPU_NVIC_IPR1 (0x10u) /*decimal 16*/
+#define CPU_NVIC_IPR1 (0xF0F0F010u) /*decimal 4042321936*/
 
-#define CPU_NVIC_IPR2 (0x2000u) /*decimal 8192*/
+#define CPU_NVIC_IPR2 (0x206020F0u) /*decimal 543170800*/
 
-#define CPU_NVIC_IPR3 (0x0u) /*decimal 0*/
+#define CPU_NVIC_IPR3 (0x500040F0u) /*decimal 1342193904*/
 
-#define CPU_NVIC_ISER0 (0x2819u) /*decimal 10265*/
+#define CPU_NVIC_ISER0 (0x6819u) /*decimal 26649*/
 
-#define CPU_SHPR3 (0x40000000u) /*decimal 1073741824*/
+#define CPU_SHPR3 (0x30000000u) /*decimal 805306368*/
 
 #define CPU_SYSTICK_EN (0x1u) /*decimal 1*/
 
@@ -62,7 +62,7 @@
 
 #define PMU_VDDP_OV_EN (0x0u) /*decimal 0*/
 
-#define SCUPM_BDRV_IRQ_CTRL (0x0u) /*decimal 0*/
+#define SCUPM_BDRV_IRQ_CTRL (0x1FC00u) /*decimal 130048*/
 
 #define SCUPM_SYS_IRQ_CTRL (0x0u) /*decimal 0*/
 
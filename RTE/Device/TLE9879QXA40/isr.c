@@ -38,6 +38,14 @@
 #include "isr_defines.h"
 #include "scu_defines.h"
 
+/* Handler run time statistics for ISR_PROF_EN == 1, see IsrProf.h */
+#if (defined(ISR_PROF_EN) && (ISR_PROF_EN == 1))
+#include "IsrProf.h"
+#else
+#define ISR_PROF_ENTER()
+#define ISR_PROF_EXIT(Id)
+#endif
+
 #ifndef ADC1_CH7_INT_EN
   #define ADC1_CH7_INT_EN 0
 #endif
@@ -557,6 +565,8 @@ extern void BDRV_VCP_LO_CALLBACK(void);
       (GPT12E_T4_INT_EN == 1))
 void GPT1_IRQHandler(void)
 {
+  ISR_PROF_ENTER();
+
 #if (GPT12E_T2_INT_EN == 1)
   /* GPT1u - T2 Interrupt */
   if ((uint8)SCU->GPT12IEN.bit.T2IE == (uint8)1)
@@ -592,6 +602,8 @@ void GPT1_IRQHandler(void)
     }
   }
 #endif /*(GPT12E_T4_INT_EN == 1)*/
+
+  ISR_PROF_EXIT(ISR_PROF_ID_GPT1);
 }
 #endif
 
@@ -603,6 +615,8 @@ void GPT1_IRQHandler(void)
       (GPT12E_CAP_INT_EN == 1))
 void GPT2_IRQHandler(void)
 {
+  ISR_PROF_ENTER();
+
 #if (GPT12E_T5_INT_EN == 1)
   /* GPT2 - T5 Interrupt */
   if ((uint8)SCU->GPT12IEN.bit.T5IE == (uint8)1)
@@ -638,6 +652,8 @@ void GPT2_IRQHandler(void)
     }
   }
 #endif /*(GPT12E_CAP_INT_EN == 1)*/
+
+  ISR_PROF_EXIT(ISR_PROF_ID_GPT2);
 }
 #endif
 
@@ -658,6 +674,8 @@ void GPT2_IRQHandler(void)
          (ADC34_ADC4_INT_EN == 1)))
 void ADC2_IRQHandler(void)
 {
+  ISR_PROF_ENTER();
+
 #if defined(TLE9879_2QXA40)
 #if (ADC34_ADC3_INT_EN == 1)
   if (SCUPM->SYS_IRQ_CTRL.bit.ADC3_EOC_IE == 1u)
@@ -799,6 +817,8 @@ void ADC2_IRQHandler(void)
     }
   }
 #endif /*(BEMF_W_LO_INT_EN == 1)*/
+
+  ISR_PROF_EXIT(ISR_PROF_ID_ADC2);
 }
 #endif
 
@@ -820,6 +840,8 @@ void ADC2_IRQHandler(void)
         (ADC2_VAREF_OL_INT_EN == 1)))
 void ADC1_IRQHandler(void)
 {
+  ISR_PROF_ENTER();
+
 #if (ADC1_CH0_INT_EN == 1)
   /* ADC1 - Ch0 Interrupt */
   if (ADC1->IE.bit.CH0_IE == 1u)
@@ -972,16 +994,22 @@ void ADC1_IRQHandler(void)
     }
   }
 #endif /*(ADC2_VAREF_OL_INT_EN == 1)*/
+
+  ISR_PROF_EXIT(ISR_PROF_ID_ADC1);
 }
 #endif
 
 /*******************************************************************************
  **                      CCU6 SR0 ISR                                          **
  *******************************************************************************/
+/* Replaced by the table dispatch of IsrDispatch.c for ISR_DISPATCH_EN == 1 */
+#if (!defined(ISR_DISPATCH_EN) || (ISR_DISPATCH_EN == 0))
 /* violation: Composite expression with smaller essential type than other operand [MISRA 2012 Rule 10.7, required] */
 #if ((CPU_NVIC_ISER0 & (1u << 4u)) != 0u)
 void CCU6SR0_IRQHandler(void)
 {
+  ISR_PROF_ENTER();
+
   /* violation: the shift value is at least the precision of the essential type of the left hand side [MISRA 2012 Rule 12.2, required] */
 #if (((CCU6_INP & (CCU6_INP_Msk << CCU6_INP_INPCC60_Pos)) == (CCU6_SR0 << CCU6_INP_INPCC60_Pos)) || defined(UNIT_TESTING_LV2))
 #if (CCU6_CH0_CM_R_INT_EN == 1)
@@ -1158,8 +1186,11 @@ void CCU6SR0_IRQHandler(void)
 #endif /*(((CCU6_INP & (CCU6_INP_Msk << CCU6_INP_INPCHE_Pos)) == (CCU6_SR0 << CCU6_INP_INPCHE_Pos)) || defined(UNIT_TESTING_LV2))*/
 
   SCU->IRCON3CLR.bit.CCU6SR0C = 1;
+
+  ISR_PROF_EXIT(ISR_PROF_ID_CCU6SR0);
 }
 #endif /*((CPU_NVIC_ISER0 & (1u << 4u)) != 0u)*/
+#endif /*(!defined(ISR_DISPATCH_EN) || (ISR_DISPATCH_EN == 0))*/
 
 /*******************************************************************************
  **                      CCU6 SR1 ISR                                          **
@@ -1168,6 +1199,8 @@ void CCU6SR0_IRQHandler(void)
 #if ((CPU_NVIC_ISER0 & (1u << 5u)) != 0u)
 void CCU6SR1_IRQHandler(void)
 {
+  ISR_PROF_ENTER();
+
   /* violation: the shift value is at least the precision of the essential type of the left hand side [MISRA 2012 Rule 12.2, required] */
 #if (((CCU6_INP & (CCU6_INP_Msk << CCU6_INP_INPCC60_Pos)) == (CCU6_SR1 << CCU6_INP_INPCC60_Pos)) || defined(UNIT_TESTING_LV2))
 #if (CCU6_CH0_CM_R_INT_EN == 1)
@@ -1343,6 +1376,8 @@ void CCU6SR1_IRQHandler(void)
 #endif /*(((CCU6_INP & (CCU6_INP_Msk << CCU6_INP_INPCHE_Pos)) == (CCU6_SR1 << CCU6_INP_INPCHE_Pos)) || defined(UNIT_TESTING_LV2))*/
 
   SCU->IRCON3CLR.bit.CCU6SR1C = 1;
+
+  ISR_PROF_EXIT(ISR_PROF_ID_CCU6SR1);
 }
 #endif /*((CPU_NVIC_ISER0 & (1u << 5u)) != 0u)*/
 
@@ -1353,6 +1388,8 @@ void CCU6SR1_IRQHandler(void)
 #if ((CPU_NVIC_ISER0 & (1u << 6u)) != 0u)
 void CCU6SR2_IRQHandler(void)
 {
+  ISR_PROF_ENTER();
+
   /* violation: the shift value is at least the precision of the essential type of the left hand side [MISRA 2012 Rule 12.2, required] */
 #if (((CCU6_INP & (CCU6_INP_Msk << CCU6_INP_INPCC60_Pos)) == (CCU6_SR2 << CCU6_INP_INPCC60_Pos)) || defined(UNIT_TESTING_LV2))
 #if (CCU6_CH0_CM_R_INT_EN == 1)
@@ -1529,6 +1566,8 @@ void CCU6SR2_IRQHandler(void)
 #endif /*(((CCU6_INP & (CCU6_INP_Msk << CCU6_INP_INPCHE_Pos)) == (CCU6_SR2 << CCU6_INP_INPCHE_Pos)) || defined(UNIT_TESTING_LV2))*/
 
   SCU->IRCON4CLR.bit.CCU6SR2C = 1;
+
+  ISR_PROF_EXIT(ISR_PROF_ID_CCU6SR2);
 }
 #endif /*((CPU_NVIC_ISER0 & (1u << 6u)) != 0u)*/
 
@@ -1539,6 +1578,8 @@ void CCU6SR2_IRQHandler(void)
 #if ((CPU_NVIC_ISER0 & (1u << 7u)) != 0u)
 void CCU6SR3_IRQHandler(void)
 {
+  ISR_PROF_ENTER();
+
   /* violation: the shift value is at least the precision of the essential type of the left hand side [MISRA 2012 Rule 12.2, required] */
 #if (((CCU6_INP & (CCU6_INP_Msk << CCU6_INP_INPCC60_Pos)) == (CCU6_SR3 << CCU6_INP_INPCC60_Pos)) || defined(UNIT_TESTING_LV2))
 #if (CCU6_CH0_CM_R_INT_EN == 1)
@@ -1715,6 +1756,8 @@ void CCU6SR3_IRQHandler(void)
 #endif /*(((CCU6_INP & (CCU6_INP_Msk << CCU6_INP_INPCHE_Pos)) == (CCU6_SR3 << CCU6_INP_INPCHE_Pos)) || defined(UNIT_TESTING_LV2))*/
 
   SCU->IRCON4CLR.bit.CCU6SR3C = 1;
+
+  ISR_PROF_EXIT(ISR_PROF_ID_CCU6SR3);
 }
 #endif /*((CPU_NVIC_ISER0 & (1u << 7u)) != 0u)*/
 
@@ -1726,6 +1769,8 @@ void CCU6SR3_IRQHandler(void)
      (SSC1_ERR_INT_EN == 1))
 void SSC1_IRQHandler(void)
 {
+  ISR_PROF_ENTER();
+
 #if (SSC1_RX_INT_EN == 1)
   /* check for receive interrupt */
   if ((uint8)SCU->MODIEN1.bit.RIREN1 == (uint8)1)
@@ -1761,6 +1806,8 @@ void SSC1_IRQHandler(void)
     }
   }
 #endif /*(SSC1_ERR_INT_EN == 1)*/
+
+  ISR_PROF_EXIT(ISR_PROF_ID_SSC1);
 }
 #endif /*(((SSC1_RX_INT_EN == 1)  || (SSC1_TX_INT_EN == 1)) || (SSC1_ERR_INT_EN == 1))*/
 
@@ -1773,6 +1820,8 @@ void SSC1_IRQHandler(void)
 
 void SSC2_IRQHandler(void)
 {
+  ISR_PROF_ENTER();
+
 #if (SSC2_RX_INT_EN == 1)
   /* check for receive interrupt */
   if ((uint8)SCU->MODIEN2.bit.RIREN2 == (uint8)1)
@@ -1808,6 +1857,8 @@ void SSC2_IRQHandler(void)
     }
   }
 #endif /*(SSC2_ERR_INT_EN == 1)*/
+
+  ISR_PROF_EXIT(ISR_PROF_ID_SSC2);
 }
 #endif /*(((SSC2_RX_INT_EN == 1)  || (SSC2_TX_INT_EN == 1)) || (SSC2_ERR_INT_EN == 1))*/
 
@@ -1825,6 +1876,8 @@ void SSC2_IRQHandler(void)
         (LIN_TMOUT_INT_EN == 1))
 void UART1_IRQHandler(void)
 {
+  ISR_PROF_ENTER();
+
 #if (UART1_RX_INT_EN == 1)
   if ((uint8)SCU->MODIEN1.bit.RIEN1 == (uint8)1)
   {
@@ -1927,6 +1980,8 @@ void UART1_IRQHandler(void)
 #endif /* ((LIN_ERR_INT_EN == 1)*/
   }
 #endif /*((LIN_EOF_INT_EN == 1) || (LIN_ERR_INT_EN == 1))*/
+
+  ISR_PROF_EXIT(ISR_PROF_ID_UART1);
 }
 #endif
 
@@ -1941,6 +1996,8 @@ void UART1_IRQHandler(void)
        (SCU_EXINT2_FALLING_INT_EN == 1)) )
 void UART2_IRQHandler(void)
 {
+  ISR_PROF_ENTER();
+
 #if (UART2_RX_INT_EN == 1)
   if ((uint8)SCU->MODIEN2.bit.RIEN2 == (uint8)1)
   {
@@ -2012,6 +2069,8 @@ void UART2_IRQHandler(void)
   }
 #endif /* (SCU_EXINT2_RISING_INT_EN == 1)*/
 #endif /*((SCU_MODIEN2 & (1u << 5u)) != 0u)*/
+
+  ISR_PROF_EXIT(ISR_PROF_ID_UART2);
 }
 #endif
 
@@ -2024,6 +2083,8 @@ void UART2_IRQHandler(void)
       (MON_FALLING_INT_EN == 1)) )
 void EXINT0_IRQHandler(void)
 {
+  ISR_PROF_ENTER();
+
 #if ((SCU_MODIEN3 & (1u << 0u)) != 0u)
 #if (SCU_EXINT0_FALLING_INT_EN == 1)
   if ((SCU->EXICON0.reg & (uint8)(1u << 1u)) != (uint8)0)
@@ -2075,6 +2136,8 @@ void EXINT0_IRQHandler(void)
   }
 #endif /* (MON_RISING_INT_EN == 1)*/
 #endif /*((SCU_MODIEN3 & (1u << 4u)) != 0u)*/
+
+  ISR_PROF_EXIT(ISR_PROF_ID_EXINT0);
 }
 #endif /*(((SCU_EXINT0_RISING_INT_EN == 1) || (SCU_EXINT0_FALLING_INT_EN == 1)) || ((MON_RISING_INT_EN == 1) || (MON_FALLING_INT_EN == 1)) )*/
 
@@ -2085,6 +2148,8 @@ void EXINT0_IRQHandler(void)
      (SCU_EXINT1_FALLING_INT_EN == 1))
 void EXINT1_IRQHandler(void)
 {
+  ISR_PROF_ENTER();
+
 #if ((SCU_MODIEN4 & (1u << 0u)) != 0u)
 #if (SCU_EXINT1_FALLING_INT_EN == 1)
   if ((SCU->EXICON0.reg & (uint8)(1u << 3u)) != (uint8)0)
@@ -2109,12 +2174,16 @@ void EXINT1_IRQHandler(void)
   }
 #endif /* (SCU_EXINT1_RISING_INT_EN == 1)*/
 #endif /*((SCU_EXINT1_RISING_INT_EN == 1) || (SCU_EXINT1_FALLING_INT_EN == 1))*/
+
+  ISR_PROF_EXIT(ISR_PROF_ID_EXINT1);
 }
 #endif
 
 /*******************************************************************************
  **                      BDRV ISR                                              **
  *******************************************************************************/
+/* Replaced by the table dispatch of IsrDispatch.c for ISR_DISPATCH_EN == 1 */
+#if (!defined(ISR_DISPATCH_EN) || (ISR_DISPATCH_EN == 0))
 #if ((((((BDRV_HS1_OC_INT_EN == 1)     || \
          (BDRV_LS1_OC_INT_EN == 1))    || \
         ((BDRV_HS2_OC_INT_EN == 1)     || \
@@ -2134,6 +2203,8 @@ void EXINT1_IRQHandler(void)
          (ADC2_VCP_LO_INT_EN == 1) )
 void BDRV_IRQHandler(void)
 {
+  ISR_PROF_ENTER();
+
 #if (BDRV_HS1_OC_INT_EN == 1)
   if (SCUPM->BDRV_IRQ_CTRL.bit.HS1_OC_IE == 1u)
   {
@@ -2343,8 +2414,10 @@ void BDRV_IRQHandler(void)
 #endif /*(ADC2_VSD_UP_INT_EN == 1)*/
 
 
+  ISR_PROF_EXIT(ISR_PROF_ID_BDRV);
 }
 #endif
+#endif /*(!defined(ISR_DISPATCH_EN) || (ISR_DISPATCH_EN == 0))*/
 
 /*******************************************************************************
  **                      DMA ISR                                               **
@@ -2365,6 +2438,8 @@ void BDRV_IRQHandler(void)
         (DMA_SDADC_INT_EN == 1))))
 void DMA_IRQHandler(void)
 {
+  ISR_PROF_ENTER();
+
 #if (DMA_CH1_INT_EN == 1)
   if ((uint8)SCU->DMAIEN1.bit.CH1IE == (uint8)1)
   {
@@ -2535,6 +2610,7 @@ void DMA_IRQHandler(void)
   }
 #endif /*(DMA_GPT12E_INT_EN == 1)*/
 
+  ISR_PROF_EXIT(ISR_PROF_ID_DMA);
 }
 #endif
 
@@ -2959,10 +3035,14 @@ void UsageFault_Handler(void)
  *******************************************************************************/
 void SysTick_Handler(void)
 {
+  ISR_PROF_ENTER();
+
 #if (CPU_SYSTICK_EN == 1)
   CPU_SYSTICK_CALLBACK();
 #endif /*(CPU_SYSTICK_EN == 1)*/
 
   WDT1_Window_Count();
+
+  ISR_PROF_EXIT(ISR_PROF_ID_SYSTICK);
 }
 #endif /* INT_XML_VERSION < 0x10300 */
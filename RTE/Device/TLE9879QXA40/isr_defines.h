@@ -112,13 +112,13 @@
 
 #define ADC2_VBG_UP_INT_EN (0x0u) /*decimal 0*/
 
-#define ADC2_VCP_LO_CALLBACK place_your_function_call_back_here
+#define ADC2_VCP_LO_CALLBACK FlightRec_HandleLimit
 
-#define ADC2_VCP_LO_INT_EN (0x0u) /*decimal 0*/
+#define ADC2_VCP_LO_INT_EN (0x1u) /*decimal 1*/
 
-#define ADC2_VCP_UP_CALLBACK place_your_function_call_back_here
+#define ADC2_VCP_UP_CALLBACK FlightRec_HandleLimit
 
-#define ADC2_VCP_UP_INT_EN (0x0u) /*decimal 0*/
+#define ADC2_VCP_UP_INT_EN (0x1u) /*decimal 1*/
 
 #define ADC2_VDDC_LO_CALLBACK place_your_function_call_back_here
 
@@ -136,13 +136,13 @@
 
 #define ADC2_VDDP_UP_INT_EN (0x0u) /*decimal 0*/
 
-#define ADC2_VSD_LO_CALLBACK place_your_function_call_back_here
+#define ADC2_VSD_LO_CALLBACK FlightRec_HandleLimit
 
-#define ADC2_VSD_LO_INT_EN (0x0u) /*decimal 0*/
+#define ADC2_VSD_LO_INT_EN (0x1u) /*decimal 1*/
 
-#define ADC2_VSD_UP_CALLBACK place_your_function_call_back_here
+#define ADC2_VSD_UP_CALLBACK FlightRec_HandleLimit
 
-#define ADC2_VSD_UP_INT_EN (0x0u) /*decimal 0*/
+#define ADC2_VSD_UP_INT_EN (0x1u) /*decimal 1*/
 
 #define ADC2_VS_LO_CALLBACK place_your_function_call_back_here
 
@@ -158,7 +158,7 @@
 
 #define BDRV_HS1_OC_CALLBACK BDRV_Diag
 
-#define BDRV_HS1_OC_INT_EN (0x0u) /*decimal 0*/
+#define BDRV_HS1_OC_INT_EN (0x1u) /*decimal 1*/
 
 #define BDRV_HS2_DS_CALLBACK place_your_function_call_back_here
 
@@ -166,7 +166,7 @@
 
 #define BDRV_HS2_OC_CALLBACK BDRV_Diag
 
-#define BDRV_HS2_OC_INT_EN (0x0u) /*decimal 0*/
+#define BDRV_HS2_OC_INT_EN (0x1u) /*decimal 1*/
 
 #define BDRV_HS3_DS_CALLBACK place_your_function_call_back_here
 
@@ -174,7 +174,7 @@
 
 #define BDRV_HS3_OC_CALLBACK BDRV_Diag
 
-#define BDRV_HS3_OC_INT_EN (0x0u) /*decimal 0*/
+#define BDRV_HS3_OC_INT_EN (0x1u) /*decimal 1*/
 
 #define BDRV_LS1_DS_CALLBACK place_your_function_call_back_here
 
@@ -182,7 +182,7 @@
 
 #define BDRV_LS1_OC_CALLBACK BDRV_Diag
 
-#define BDRV_LS1_OC_INT_EN (0x0u) /*decimal 0*/
+#define BDRV_LS1_OC_INT_EN (0x1u) /*decimal 1*/
 
 #define BDRV_LS2_DS_CALLBACK place_your_function_call_back_here
 
@@ -190,7 +190,7 @@
 
 #define BDRV_LS2_OC_CALLBACK BDRV_Diag
 
-#define BDRV_LS2_OC_INT_EN (0x0u) /*decimal 0*/
+#define BDRV_LS2_OC_INT_EN (0x1u) /*decimal 1*/
 
 #define BDRV_LS3_DS_CALLBACK place_your_function_call_back_here
 
@@ -198,9 +198,9 @@
 
 #define BDRV_LS3_OC_CALLBACK BDRV_Diag
 
-#define BDRV_LS3_OC_INT_EN (0x0u) /*decimal 0*/
+#define BDRV_LS3_OC_INT_EN (0x1u) /*decimal 1*/
 
-#define BDRV_VCP_LO2_INT_EN (0x0u) /*decimal 0*/
+#define BDRV_VCP_LO2_INT_EN (0x1u) /*decimal 1*/
 
 #define BDRV_VCP_LO_CALLBACK BDRV_Diag_Supply
 
@@ -264,9 +264,9 @@
 
 #define CCU6_T12_OM_INT_EN (0x0u) /*decimal 0*/
 
-#define CCU6_T12_PM_CALLBACK place_your_function_call_back_here
+#define CCU6_T12_PM_CALLBACK Main_HandlePwmPeriod
 
-#define CCU6_T12_PM_INT_EN (0x0u) /*decimal 0*/
+#define CCU6_T12_PM_INT_EN (0x1u) /*decimal 1*/
 
 #define CCU6_T13_CM_CALLBACK place_your_function_call_back_here
 
@@ -326,9 +326,9 @@
 
 #define DMA_CH8_INT_EN (0x0u) /*decimal 0*/
 
-#define DMA_GPT12E_CALLBACK place_your_function_call_back_here
+#define DMA_GPT12E_CALLBACK Neopx_HandleDmaDone
 
-#define DMA_GPT12E_INT_EN (0x0u) /*decimal 0*/
+#define DMA_GPT12E_INT_EN (0x1u) /*decimal 1*/
 
 #define DMA_SQ1_RDY_CALLBACK place_your_function_call_back_here
 
@@ -338,9 +338,9 @@
 
 #define DMA_SQ2_RDY_INT_EN (0x0u) /*decimal 0*/
 
-#define DMA_SSC_RX_CALLBACK place_your_function_call_back_here
+#define DMA_SSC_RX_CALLBACK DMA_complete_handler
 
-#define DMA_SSC_RX_INT_EN (0x0u) /*decimal 0*/
+#define DMA_SSC_RX_INT_EN (0x1u) /*decimal 1*/
 
 #define DMA_SSC_TX_CALLBACK place_your_function_call_back_here
 
@@ -352,7 +352,7 @@
 
 #define EXINT1_FALLING_CALLBACK place_your_function_call_back_here
 
-#define EXINT1_RISING_CALLBACK encoder_B_pos
+#define EXINT1_RISING_CALLBACK EmoEnc_HandleEdge
 
 #define EXINT2_FALLING_CALLBACK SPI_slave_react
 
@@ -0,0 +1,279 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, bridge driver fault handlers with retry
+ * V0.2.0: 2026-10-17: Stall fault
+ * V0.2.1: 2026-10-17: Bridge off budget FAULT_OFF_CYCLES_MAX from the host run
+ * V0.2.2: 2026-10-18: Flight recorder frozen with the stop after a fault
+ */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include "tle_device.h"
+#include "Fault.h"
+#include "FlightRec.h"
+#include "Emo.h"
+#include "EmoCcu.h"
+#include "Timebase.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+/* Interrupts handled here, SCUPM_BDRV_IRQ_CTRL of the ICW is not written by INT_Init */
+#define FAULT_BDRV_IRQ_CTRL (SCUPM_BDRV_IRQ_CTRL_LS1_OC_IE_Msk | SCUPM_BDRV_IRQ_CTRL_LS2_OC_IE_Msk | \
+                             SCUPM_BDRV_IRQ_CTRL_HS1_OC_IE_Msk | SCUPM_BDRV_IRQ_CTRL_HS2_OC_IE_Msk | \
+                             SCUPM_BDRV_IRQ_CTRL_LS3_OC_IE_Msk | SCUPM_BDRV_IRQ_CTRL_HS3_OC_IE_Msk | \
+                             SCUPM_BDRV_IRQ_CTRL_VCP_LOWTH2_IE_Msk)
+
+/* Interrupt and status flags cleared before a restart */
+#define FAULT_BDRV_ISCLR (SCUPM_BDRV_ISCLR_LS1_OC_ICLR_Msk | SCUPM_BDRV_ISCLR_LS2_OC_ICLR_Msk | \
+                          SCUPM_BDRV_ISCLR_HS1_OC_ICLR_Msk | SCUPM_BDRV_ISCLR_HS2_OC_ICLR_Msk | \
+                          SCUPM_BDRV_ISCLR_LS3_OC_ICLR_Msk | SCUPM_BDRV_ISCLR_HS3_OC_ICLR_Msk | \
+                          SCUPM_BDRV_ISCLR_VCP_LOWTH2_ICLR_Msk | SCUPM_BDRV_ISCLR_VCP_LOWTH2_SCLR_Msk)
+
+#if ((FAULT_BACKOFF_MS << (FAULT_RETRY_MAX - 1u)) > 0xFFFFu)
+#error "Longest backoff exceeds the backoff counter"
+#endif
+
+/*******************************************************************************
+**                      Global Variable Definitions                           **
+*******************************************************************************/
+volatile TFault_Status Fault_Status;
+
+/*******************************************************************************
+**                      Private Function Declarations                         **
+*******************************************************************************/
+static void Fault_lLatch(uint16 Code, uint32 Start);
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+/** \brief Clears all faults and enables the bridge driver fault interrupts.
+ *
+ * \return None
+ *
+ * \ingroup fault_api
+ */
+void Fault_Init(void)
+{
+  Fault_Status.OcCtr = 0u;
+  Fault_Status.SupplyCtr = 0u;
+  Fault_Status.StallCtr = 0u;
+  Fault_Status.OffCyclesMax = 0u;
+  Fault_Clear();
+
+  SCUPM->BDRV_IRQ_CTRL.reg |= (uint32)FAULT_BDRV_IRQ_CTRL;
+  CPU->NVIC_ISER0.reg = CPU_NVIC_ISER0_Int_BDRV_Msk;
+
+} /* End of Fault_Init */
+
+/** \brief Completes the stop after a fault and restarts after the backoff time.
+ *
+ * Restart n (1..FAULT_RETRY_MAX) follows FAULT_BACKOFF_MS * 2^(n-1) after the
+ * fault. A further fault within FAULT_RETRY_RESET_MS of the last restart counts
+ * as a retry, once the retries are exhausted the fault stays latched. A stall
+ * of the started motor is latched here as FAULT_STALL.
+ *
+ * \return None
+ *
+ * \note Called every ms from Main_HandleSysTick.
+ *
+ * \ingroup fault_api
+ */
+void Fault_Handle(void)
+{
+  uint32 PriMask;
+  uint32 Start;
+
+  /* Stall detected by EmoCcu_CheckStandstill, latched like a bridge fault */
+  if ((EmoCcu_GetStall() == true) && (Emo_GetMotorState() >= EMO_MOTOR_STATE_START) &&
+      ((Fault_Status.Active & FAULT_STALL) == 0u))
+  {
+    Start = Timebase_GetCycles();
+    Fault_BridgeOff();
+    Fault_Status.StallCtr++;
+    Fault_lLatch((uint16)FAULT_STALL, Start);
+    FlightRec_Freeze((uint8)FLIGHTREC_CAUSE_STALL);
+  }
+
+  if (Fault_Status.Active == 0u)
+  {
+    if (Fault_Status.Retries > 0u)
+    {
+      Fault_Status.OkCtr++;
+      if (Fault_Status.OkCtr >= FAULT_RETRY_RESET_MS)
+      {
+        Fault_Status.Retries = 0u;
+      }
+    }
+    return;
+  }
+
+  /* Rest of the stop sequence, the bridge is already off */
+  if (Emo_GetMotorState() >= EMO_MOTOR_STATE_START)
+  {
+    (void)Emo_StopMotor();
+    FlightRec_Stop();
+  }
+
+  if (Fault_Status.Retries >= FAULT_RETRY_MAX)
+  {
+    Fault_Status.Locked = 1u;
+    return;
+  }
+  if (Fault_Status.BackoffCtr > 0u)
+  {
+    Fault_Status.BackoffCtr--;
+    return;
+  }
+
+  /* Retry */
+  Fault_Status.Retries++;
+  Fault_Status.OkCtr = 0u;
+  SCUPM->BDRV_ISCLR.reg = (uint32)FAULT_BDRV_ISCLR;
+  SCUPM->BDRV_ISCLR.reg = (uint32)FAULT_BDRV_ISCLR;
+
+  PriMask = __get_PRIMASK();
+  __disable_irq();
+  Fault_Status.Active = 0u;
+  Emo_Status.StartLock = 0u;
+  __set_PRIMASK(PriMask);
+
+  if (Fault_Status.Restart != 0u)
+  {
+    (void)Emo_StartMotor();
+  }
+
+} /* End of Fault_Handle */
+
+/** \brief Clears the latched faults and the retry count.
+ *
+ * The motor is not restarted.
+ *
+ * \return None
+ *
+ * \ingroup fault_api
+ */
+void Fault_Clear(void)
+{
+  uint32 PriMask;
+
+  SCUPM->BDRV_ISCLR.reg = (uint32)FAULT_BDRV_ISCLR;
+  SCUPM->BDRV_ISCLR.reg = (uint32)FAULT_BDRV_ISCLR;
+
+  PriMask = __get_PRIMASK();
+  __disable_irq();
+  Fault_Status.Active = 0u;
+  Fault_Status.History = 0u;
+  Fault_Status.Retries = 0u;
+  Fault_Status.Locked = 0u;
+  Fault_Status.Restart = 0u;
+  Fault_Status.BackoffCtr = 0u;
+  Fault_Status.OkCtr = 0u;
+  Emo_Status.StartLock = 0u;
+  __set_PRIMASK(PriMask);
+
+} /* End of Fault_Clear */
+
+/** \brief Callback of the bridge driver overcurrent interrupts.
+ *
+ * Switches the bridge off first, everything else follows.
+ *
+ * \return None
+ *
+ * \ingroup fault_api
+ */
+void BDRV_Diag(void)
+{
+  uint32 Start;
+
+  Start = Timebase_GetCycles();
+  Fault_BridgeOff();
+
+  Fault_Status.OcCtr++;
+  Fault_lLatch((uint16)((SCUPM->BDRV_IS.reg >> SCUPM_BDRV_IS_LS1_OC_IS_Pos) & FAULT_OC_Msk), Start);
+  FlightRec_Freeze((uint8)FLIGHTREC_CAUSE_BDRV_OC);
+
+} /* End of BDRV_Diag */
+
+/** \brief Callback of the charge pump undervoltage interrupt (BDRV comparator).
+ *
+ * \return None
+ *
+ * \ingroup fault_api
+ */
+void BDRV_Diag_Supply(void)
+{
+  uint32 Start;
+
+  Start = Timebase_GetCycles();
+  Fault_BridgeOff();
+
+  Fault_Status.SupplyCtr++;
+  Fault_lLatch((uint16)FAULT_VCP_LO, Start);
+  FlightRec_Freeze((uint8)FLIGHTREC_CAUSE_BDRV_VCP);
+
+} /* End of BDRV_Diag_Supply */
+
+/*******************************************************************************
+**                      Private Function Definitions                          **
+*******************************************************************************/
+/** \brief Latches a fault after the bridge has been switched off.
+ *
+ * \param Code Fault code (FAULT_x)
+ * \param Start SysTick at handler entry
+ *
+ * \return None
+ */
+static void Fault_lLatch(uint16 Code, uint32 Start)
+{
+  uint32 Cycles;
+
+  Cycles = Timebase_CyclesSince(Start);
+  if (Cycles > Fault_Status.OffCyclesMax)
+  {
+    Fault_Status.OffCyclesMax = (uint16)Cycles;
+  }
+
+  if (Fault_Status.Active == 0u)
+  {
+    /* First fault: restart only what was running, back off longer with every retry */
+    Fault_Status.Restart = (Emo_GetMotorState() >= EMO_MOTOR_STATE_START) ? 1u : 0u;
+    Fault_Status.BackoffCtr = (uint16)(FAULT_BACKOFF_MS << Fault_Status.Retries);
+  }
+  Fault_Status.Active |= Code;
+  Fault_Status.History |= Code;
+  Emo_Status.StartLock = 1u;
+
+} /* End of Fault_lLatch */
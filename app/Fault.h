@@ -0,0 +1,127 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/* See Fault.c */
+
+#ifndef FAULT_H
+#define FAULT_H
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include <tle_device.h>
+
+/*******************************************************************************
+**                      Global Macro Definitions                              **
+*******************************************************************************/
+/* Fault codes, bit order of the overcurrent flags as in SCUPM BDRV_IS */
+#define FAULT_LS1_OC (0x0001u)
+#define FAULT_LS2_OC (0x0002u)
+#define FAULT_HS1_OC (0x0004u)
+#define FAULT_HS2_OC (0x0008u)
+#define FAULT_LS3_OC (0x0010u)
+#define FAULT_HS3_OC (0x0020u)
+#define FAULT_VCP_LO (0x0040u)   /* charge pump undervoltage, BDRV comparator */
+#define FAULT_STALL  (0x0080u)   /* started motor without Hall event, EmoCcu_GetStall */
+#define FAULT_OC_Msk (0x003Fu)
+
+/* Automatic restarts after a fault, then the fault stays latched until Fault_Clear */
+#define FAULT_RETRY_MAX (3u)
+
+/* Time before the first restart [ms], doubled for every further retry */
+#define FAULT_BACKOFF_MS (100u)
+
+/* Fault-free time after a restart that resets the retry count [ms] */
+#define FAULT_RETRY_RESET_MS (5000u)
+
+/* Budget of OffCyclesMax [CPU cycles]. Host run (test_fault, 40 overcurrents
+ * with the motor at 3000 rpm): 22 cycles from handler entry to bridge off,
+ * 90 cycles (2.3 us) from the interrupt request, exception entry and isr.c
+ * dispatch included. Add the longest interrupt lock of the main loop to the
+ * latter, BDRV preempts all handlers. */
+#define FAULT_OFF_CYCLES_MAX (50u)
+
+/*******************************************************************************
+**                      Global Type Definitions                               **
+*******************************************************************************/
+/** \brief Fault status */
+typedef struct
+{
+  uint16 Active;        /**< \brief Latched faults, bridge off while not 0 */
+  uint16 History;       /**< \brief All faults since Fault_Clear */
+  uint16 OcCtr;         /**< \brief Overcurrent events */
+  uint16 SupplyCtr;     /**< \brief Charge pump undervoltage events */
+  uint16 StallCtr;      /**< \brief Stall events */
+  uint8 Retries;        /**< \brief Restarts since the last fault-free FAULT_RETRY_RESET_MS */
+  uint8 Locked;         /**< \brief Retries exhausted, waiting for Fault_Clear */
+  uint8 Restart;        /**< \brief Motor was running at the fault, restart after the backoff */
+  uint16 BackoffCtr;    /**< \brief Remaining backoff time [ms] */
+  uint16 OkCtr;         /**< \brief Fault-free time since the last restart [ms] */
+  uint16 OffCyclesMax;  /**< \brief Longest time from fault handler entry to bridge off [CPU cycles] */
+} TFault_Status;
+
+/*******************************************************************************
+**                      Global Variable Declarations                          **
+*******************************************************************************/
+extern volatile TFault_Status Fault_Status;
+
+/*******************************************************************************
+**                      Global Function Declarations                          **
+*******************************************************************************/
+extern void Fault_Init(void);
+extern void Fault_Handle(void);
+extern void Fault_Clear(void);
+extern void BDRV_Diag(void);
+extern void BDRV_Diag_Supply(void);
+
+__STATIC_INLINE void Fault_BridgeOff(void);
+
+/*******************************************************************************
+**                      Global Inline Function Definitions                    **
+*******************************************************************************/
+/** \brief Switches all bridge driver channels off.
+ *
+ * Two stores, the same values as written by BDRV_Init. The rest of the stop
+ * sequence (PWM, current measurement, BDRV_Init) follows in Fault_Handle.
+ *
+ * \return None
+ *
+ * \ingroup fault_api
+ */
+__STATIC_INLINE void Fault_BridgeOff(void)
+{
+  BDRV->CTRL1.reg = 0u;
+  BDRV->CTRL2.reg = 0u;
+} /* End of Fault_BridgeOff */
+
+
+#endif /* FAULT_H */
@@ -0,0 +1,281 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, pre-trigger recorder of the PWM periods
+ * V0.1.1: 2026-10-18: ADC2 VCP/VSD limit interrupts enabled by FlightRec_Arm, FlightRec_Stop
+ */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include "tle_device.h"
+#include "FlightRec.h"
+#include "Timebase.h"
+#include "Emo.h"
+#include "EmoCcu.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+#if (FLIGHTREC_RAM_BYTES > FLIGHTREC_RAM_MAX)
+#error "FLIGHTREC_DEPTH exceeds the RAM granted to the flight recorder"
+#endif
+
+/* ADC2 supply limit interrupts of the BDRV node, not written by INT_Init */
+#define FLIGHTREC_LIMIT_IRQ_CTRL (SCUPM_BDRV_IRQ_CTRL_VCP_LOWTH1_IE_Msk | SCUPM_BDRV_IRQ_CTRL_VCP_UPTH_IE_Msk | \
+                                  SCUPM_BDRV_IRQ_CTRL_VSD_LOWTH_IE_Msk | SCUPM_BDRV_IRQ_CTRL_VSD_UPTH_IE_Msk)
+
+#define FLIGHTREC_LIMIT_ISCLR (SCUPM_BDRV_ISCLR_VCP_LOWTH1_ICLR_Msk | SCUPM_BDRV_ISCLR_VCP_UPTH_ICLR_Msk | \
+                               SCUPM_BDRV_ISCLR_VSD_LOWTH_ICLR_Msk | SCUPM_BDRV_ISCLR_VSD_UPTH_ICLR_Msk)
+
+#if (FLIGHTREC_POST_TRIGGER >= FLIGHTREC_DEPTH)
+#error "FLIGHTREC_POST_TRIGGER must leave pre-trigger records"
+#endif
+
+/*******************************************************************************
+**                      Private Type Definitions                              **
+*******************************************************************************/
+/* Record layout is part of the SPI dump frame */
+typedef uint8 FlightRec_lRecSizeCheck[(sizeof(TFlightRec_Rec) == (FLIGHTREC_REC_WORDS * 2u)) ? 1 : -1];
+
+/*******************************************************************************
+**                      Global Variable Definitions                           **
+*******************************************************************************/
+volatile TFlightRec_Status FlightRec_Status;
+
+/*******************************************************************************
+**                      Private Variable Definitions                          **
+*******************************************************************************/
+static TFlightRec_Rec FlightRec_lBuf[FLIGHTREC_DEPTH];
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+/** \brief Discards all records and restarts recording.
+ *
+ * Enables the ADC2 supply limit interrupts, which are disabled again by the
+ * first limit trigger.
+ *
+ * \return None
+ *
+ * \ingroup flightrec_api
+ */
+void FlightRec_Arm(void)
+{
+  uint32 PriMask;
+
+  PriMask = __get_PRIMASK();
+  __disable_irq();
+
+  FlightRec_Status.Wr = 0u;
+  FlightRec_Status.Count = 0u;
+  FlightRec_Status.PostCtr = 0u;
+  FlightRec_Status.Cause = (uint8)FLIGHTREC_CAUSE_NONE;
+  FlightRec_Status.TriggerTime = 0u;
+  FlightRec_Status.Frozen = 0u;
+
+  SCUPM->BDRV_ISCLR.reg = (uint32)FLIGHTREC_LIMIT_ISCLR;
+  SCUPM->BDRV_IRQ_CTRL.reg |= (uint32)FLIGHTREC_LIMIT_IRQ_CTRL;
+  CPU->NVIC_ISER0.reg = CPU_NVIC_ISER0_Int_BDRV_Msk;
+
+  __set_PRIMASK(PriMask);
+
+} /* End of FlightRec_Arm */
+
+/** \brief Records the current PWM period.
+ *
+ * \return None
+ *
+ * \note Called every PWM period from Main_HandlePwmPeriod.
+ *
+ * \ingroup flightrec_api
+ */
+void FlightRec_Sample(void)
+{
+  TFlightRec_Rec *pRec;
+  uint16 Wr;
+  sint16 Speed;
+
+  if (FlightRec_Status.Frozen != 0u)
+  {
+    return;
+  }
+
+  Wr = FlightRec_Status.Wr;
+  pRec = &FlightRec_lBuf[Wr];
+  Speed = (sint16)EmoCcu_HallStatus.Speed;
+  pRec->Duty = Emo_Ctrl.DutyCycle;
+  pRec->Current = Emo_Ctrl.Current;
+  pRec->Speed = (EmoCcu_HallStatus.DirIdx == 0u) ? Speed : (sint16)(-Speed);
+  pRec->PtnVsd = (uint16)(((uint16)EmoCcu_HallStatus.HallPtn << FLIGHTREC_PTN_Pos) |
+                          (ADC2_GetChResult(ADC2_VSD) & FLIGHTREC_VSD_Msk));
+
+  Wr++;
+  if (Wr >= FLIGHTREC_DEPTH)
+  {
+    Wr = 0u;
+  }
+  FlightRec_Status.Wr = Wr;
+  if (FlightRec_Status.Count < FLIGHTREC_DEPTH)
+  {
+    FlightRec_Status.Count++;
+  }
+
+  /* Post-trigger records */
+  if (FlightRec_Status.Cause != (uint8)FLIGHTREC_CAUSE_NONE)
+  {
+    if (FlightRec_Status.PostCtr > 0u)
+    {
+      FlightRec_Status.PostCtr--;
+    }
+    if (FlightRec_Status.PostCtr == 0u)
+    {
+      FlightRec_Status.Frozen = 1u;
+    }
+  }
+
+} /* End of FlightRec_Sample */
+
+/** \brief Triggers the recorder.
+ *
+ * Only the first trigger after FlightRec_Arm is kept, the buffer freezes
+ * after FLIGHTREC_POST_TRIGGER further PWM periods.
+ *
+ * \param Cause Trigger cause (FLIGHTREC_CAUSE_x)
+ *
+ * \return None
+ *
+ * \note Safe in any interrupt context.
+ *
+ * \ingroup flightrec_api
+ */
+void FlightRec_Freeze(uint8 Cause)
+{
+  uint32 PriMask;
+
+  PriMask = __get_PRIMASK();
+  __disable_irq();
+
+  if (FlightRec_Status.Cause == (uint8)FLIGHTREC_CAUSE_NONE)
+  {
+    FlightRec_Status.Cause = Cause;
+    FlightRec_Status.TriggerTime = Timebase_GetUs();
+    FlightRec_Status.PostCtr = (uint16)FLIGHTREC_POST_TRIGGER;
+    if (FlightRec_Status.PostCtr == 0u)
+    {
+      FlightRec_Status.Frozen = 1u;
+    }
+  }
+
+  __set_PRIMASK(PriMask);
+
+} /* End of FlightRec_Freeze */
+
+/** \brief Callback of the ADC2 supply limit interrupts (VCP, VSD).
+ *
+ * A limit stays violated for many conversions, the interrupts are disabled
+ * until the next FlightRec_Arm.
+ *
+ * \return None
+ *
+ * \note Called from the BDRV interrupt, nothing preempts the read-modify-write.
+ *
+ * \ingroup flightrec_api
+ */
+void FlightRec_HandleLimit(void)
+{
+  SCUPM->BDRV_IRQ_CTRL.reg &= ~(uint32)FLIGHTREC_LIMIT_IRQ_CTRL;
+  FlightRec_Freeze((uint8)FLIGHTREC_CAUSE_ADC2);
+
+} /* End of FlightRec_HandleLimit */
+
+/** \brief Freezes a triggered recorder once the PWM has been stopped.
+ *
+ * No further PWM periods complete the post-trigger records, a restart must
+ * not append to them.
+ *
+ * \return None
+ *
+ * \ingroup flightrec_api
+ */
+void FlightRec_Stop(void)
+{
+  if (FlightRec_Status.Cause != (uint8)FLIGHTREC_CAUSE_NONE)
+  {
+    FlightRec_Status.Frozen = 1u;
+  }
+
+} /* End of FlightRec_Stop */
+
+/** \brief Reads a record of the frozen buffer.
+ *
+ * A triggered recorder is frozen by the first read, e.g. if the PWM has been
+ * stopped before the post-trigger records were complete.
+ *
+ * \param Idx Record index, 0 = oldest
+ * \param[out] pWords FLIGHTREC_REC_WORDS words of the record
+ *
+ * \return true if the record exists
+ *
+ * \ingroup flightrec_api
+ */
+bool FlightRec_GetRecord(uint16 Idx, uint16 *pWords)
+{
+  const TFlightRec_Rec *pRec;
+  uint32 Pos;
+
+  if (FlightRec_Status.Cause == (uint8)FLIGHTREC_CAUSE_NONE)
+  {
+    return false;
+  }
+  FlightRec_Status.Frozen = 1u;
+
+  if (Idx >= FlightRec_Status.Count)
+  {
+    return false;
+  }
+
+  /* Oldest record at the write index once the buffer has wrapped */
+  Pos = (FlightRec_Status.Count < FLIGHTREC_DEPTH) ? Idx : (FlightRec_Status.Wr + (uint32)Idx);
+  if (Pos >= FLIGHTREC_DEPTH)
+  {
+    Pos -= FLIGHTREC_DEPTH;
+  }
+
+  pRec = &FlightRec_lBuf[Pos];
+  pWords[0] = pRec->Duty;
+  pWords[1] = (uint16)pRec->Current;
+  pWords[2] = (uint16)pRec->Speed;
+  pWords[3] = pRec->PtnVsd;
+  return true;
+} /* End of FlightRec_GetRecord */
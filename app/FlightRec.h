@@ -0,0 +1,114 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/* See FlightRec.c */
+
+#ifndef FLIGHTREC_H
+#define FLIGHTREC_H
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include <tle_device.h>
+
+/*******************************************************************************
+**                      Global Macro Definitions                              **
+*******************************************************************************/
+/* Recorded PWM periods, 128 = 2.56 ms at 50 us */
+#define FLIGHTREC_DEPTH (128u)
+
+/* PWM periods still recorded after the trigger */
+#define FLIGHTREC_POST_TRIGGER (16u)
+
+/* Record size [bytes] and RAM of the record buffer [bytes] */
+#define FLIGHTREC_REC_WORDS (4u)
+#define FLIGHTREC_RAM_BYTES (FLIGHTREC_DEPTH * FLIGHTREC_REC_WORDS * 2u)
+
+/* Share of RW_IRAM1 (6 KB) granted to the record buffer [bytes] */
+#define FLIGHTREC_RAM_MAX (2048u)
+
+/* Hall pattern and supply voltage share the last record word */
+#define FLIGHTREC_PTN_Pos (13u)
+#define FLIGHTREC_VSD_Msk (0x1FFFu)
+
+/* Trigger causes, 0 = armed */
+#define FLIGHTREC_CAUSE_NONE     (0u)
+#define FLIGHTREC_CAUSE_BDRV_OC  (1u)   /* bridge driver overcurrent */
+#define FLIGHTREC_CAUSE_BDRV_VCP (2u)   /* charge pump undervoltage (BDRV comparator) */
+#define FLIGHTREC_CAUSE_ADC2     (3u)   /* ADC2 supply limit (VSD, VCP) */
+#define FLIGHTREC_CAUSE_USER     (4u)   /* FlightRec_Freeze from the application */
+#define FLIGHTREC_CAUSE_STALL    (5u)   /* started motor without Hall event */
+
+/*******************************************************************************
+**                      Global Type Definitions                               **
+*******************************************************************************/
+/** \brief Record of one PWM period */
+typedef struct
+{
+  uint16 Duty;      /**< \brief Duty cycle [PWM timer ticks] */
+  sint16 Current;   /**< \brief DC link current (1.0 = 1024 ADC counts) */
+  sint16 Speed;     /**< \brief Hall speed, sign = direction [rpm] */
+  uint16 PtnVsd;    /**< \brief Hall pattern (bits 15..13), ADC2 VSD result (bits 12..0) */
+} TFlightRec_Rec;
+
+/** \brief Flight recorder status */
+typedef struct
+{
+  uint16 Wr;          /**< \brief Index of the next record */
+  uint16 Count;       /**< \brief Valid records, up to FLIGHTREC_DEPTH */
+  uint16 PostCtr;     /**< \brief Records still to be written after the trigger */
+  uint8 Cause;        /**< \brief First trigger cause since FlightRec_Arm (FLIGHTREC_CAUSE_x) */
+  uint8 Frozen;       /**< \brief Record buffer frozen, readable */
+  uint32 TriggerTime; /**< \brief Time of the trigger [us] */
+} TFlightRec_Status;
+
+/*******************************************************************************
+**                      Global Variable Declarations                          **
+*******************************************************************************/
+extern volatile TFlightRec_Status FlightRec_Status;
+
+/*******************************************************************************
+**                      Global Function Declarations                          **
+*******************************************************************************/
+extern void FlightRec_Arm(void);
+extern void FlightRec_Sample(void);
+extern void FlightRec_Freeze(uint8 Cause);
+extern void FlightRec_HandleLimit(void);
+extern void FlightRec_Stop(void);
+extern bool FlightRec_GetRecord(uint16 Idx, uint16 *pWords);
+
+/*******************************************************************************
+**                      Global Inline Function Definitions                    **
+*******************************************************************************/
+
+
+#endif /* FLIGHTREC_H */
@@ -0,0 +1,94 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, interrupt priority plan
+ * V0.1.1: 2026-10-17: UART1 trace byte rate against the interrupt load
+ */
+
+#ifndef INTPRIO_H
+#define INTPRIO_H
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include <tle_device.h>
+#include "int_defines.h"
+
+/*******************************************************************************
+**                      Global Macro Definitions                              **
+*******************************************************************************/
+/* Preemption levels, 0 is the most urgent. The values are set in the ICW
+ * (CPU_NVIC_IPRx, CPU_SHPR3) and written by INT_Init; PRIGROUP stays at its
+ * reset value, so all 4 priority bits preempt and equal levels do not nest.
+ * Run tools/isr_rta.py with measured execution times after changing them. */
+#define INT_PRIO_BDRV     (0u)   /* bridge off on overcurrent / charge pump undervoltage */
+#define INT_PRIO_CCU6SR0  (1u)   /* commutation (Hall) and current loop (T12 period match) */
+#define INT_PRIO_UART2    (2u)   /* EXINT2: SPI chip select, latches the telemetry sample */
+#define INT_PRIO_SSC2     (2u)   /* SPI, same level as its chip select */
+#define INT_PRIO_SYSTICK  (3u)   /* 1 ms speed loop */
+#define INT_PRIO_EXINT1   (4u)   /* encoder edges */
+#define INT_PRIO_DMA      (5u)   /* SPI frame received, Neopixel frame sent */
+#define INT_PRIO_GPT1     (6u)   /* Neopixel bit timing */
+#define INT_PRIO_UART1    (6u)   /* trace stream, see below */
+#define INT_PRIO_ADC1     (7u)   /* potentiometer */
+#define INT_PRIO_ADC2     (7u)   /* supply limits */
+#define INT_PRIO_UNUSED   (15u)  /* GPT2, CCU6SR1..3, SSC1, EXINT0 */
+
+/* UART1 load: one TX interrupt per trace byte. At 1 MBaud (10 bits per byte)
+ * the line carries at most 100 kbyte/s, an interrupt every 10 us; at about
+ * 80 + 24 cycles per byte that is 26 % of the CPU, which only happens if
+ * the channels of app/Trace.h do not fit the line. The default record (time,
+ * speed I part, duty, Hall speed and pattern: 3 + 13 + 1 = 17 bytes per 1 ms
+ * SysTick) is 17 k interrupts/s, 4.4 % of the CPU. All 7 channels are 23
+ * bytes, 6 %. Level 6 keeps this out of the way of everything but the
+ * potentiometer and supply checks; a longer record or a higher sample rate
+ * (TRACE_DIV) adds load linearly. */
+
+/* Priority field of a node in CPU_NVIC_IPRx / CPU_SHPR3 */
+#define INT_PRIO_GET(Reg, Pos) ((((Reg) >> (Pos)) & 0xFFu) >> 4u)
+
+#if ((INT_PRIO_GET(CPU_NVIC_IPR3, CPU_NVIC_IPR3_PRI_BDRV_Pos) != INT_PRIO_BDRV)       || \
+     (INT_PRIO_GET(CPU_NVIC_IPR1, CPU_NVIC_IPR1_PRI_CCU6SR0_Pos) != INT_PRIO_CCU6SR0) || \
+     (INT_PRIO_GET(CPU_NVIC_IPR2, CPU_NVIC_IPR2_PRI_UART2_Pos) != INT_PRIO_UART2)     || \
+     (INT_PRIO_GET(CPU_NVIC_IPR2, CPU_NVIC_IPR2_PRI_SSC2_Pos) != INT_PRIO_SSC2)       || \
+     (INT_PRIO_GET(CPU_SHPR3, CPU_SHPR3_PRI_15_Pos) != INT_PRIO_SYSTICK)              || \
+     (INT_PRIO_GET(CPU_NVIC_IPR3, CPU_NVIC_IPR3_PRI_EXINT1_Pos) != INT_PRIO_EXINT1)   || \
+     (INT_PRIO_GET(CPU_NVIC_IPR3, CPU_NVIC_IPR3_PRI_DMA_Pos) != INT_PRIO_DMA)         || \
+     (INT_PRIO_GET(CPU_NVIC_IPR0, CPU_NVIC_IPR0_PRI_GPT1_Pos) != INT_PRIO_GPT1)       || \
+     (INT_PRIO_GET(CPU_NVIC_IPR2, CPU_NVIC_IPR2_PRI_UART1_Pos) != INT_PRIO_UART1)     || \
+     (INT_PRIO_GET(CPU_NVIC_IPR0, CPU_NVIC_IPR0_PRI_ADC1_Pos) != INT_PRIO_ADC1)       || \
+     (INT_PRIO_GET(CPU_NVIC_IPR0, CPU_NVIC_IPR0_PRI_ADC2_Pos) != INT_PRIO_ADC2))
+#error "ICW interrupt priorities (int_defines.h) differ from the plan in IntPrio.h"
+#endif
+
+
+#endif /* INTPRIO_H */
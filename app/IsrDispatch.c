@@ -0,0 +1,418 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, table driven CCU6SR0 and BDRV dispatch
+ * V0.2.0: 2026-10-17: Handler run time hooks (ISR_PROF_EN)
+ * V0.2.1: 2026-10-17: Hall latency of both dispatch variants from the host run
+ * V0.2.2: 2026-10-18: Latency benchmark only with ISR_DISPATCH_BENCH_EN
+ * V0.2.3: 2026-10-18: ADC2 supply limit callbacks of the flight recorder
+ */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include "tle_device.h"
+#include "int_defines.h"
+#include "isr_defines.h"
+#include "IsrDispatch.h"
+#include "Timebase.h"
+#include "IsrProf.h"
+#include "Emo.h"
+/* Callbacks configured in isr_defines.h */
+#include "EmoCcu.h"
+#include "Main.h"
+#include "Fault.h"
+#include "FlightRec.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+/* Busy wait per benchmark event, far above the interrupt latency (ISR_DISPATCH_BENCH_EN) */
+#define ISR_DISPATCH_BENCH_TIMEOUT (1000u)
+
+/* Table entry of sources without callback */
+#define ISR_DISPATCH_NONE ((TIsrDispatch_Callback)0)
+
+#if (ISR_DISPATCH_EN == 1)
+#if (CCU6_INP != 0u)
+#error "Table dispatch expects all CCU6 interrupt nodes on SR0"
+#endif
+
+/* Compile time enabled sources, bit positions as in CCU6 IS/IEN/ISR */
+#define ISR_DISPATCH_CCU6_Msk ((CCU6_CH0_CM_R_INT_EN << CCU6_IS_ICC60R_Pos) | (CCU6_CH0_CM_F_INT_EN << CCU6_IS_ICC60F_Pos) | \
+                               (CCU6_CH1_CM_R_INT_EN << CCU6_IS_ICC61R_Pos) | (CCU6_CH1_CM_F_INT_EN << CCU6_IS_ICC61F_Pos) | \
+                               (CCU6_CH2_CM_R_INT_EN << CCU6_IS_ICC62R_Pos) | (CCU6_CH2_CM_F_INT_EN << CCU6_IS_ICC62F_Pos) | \
+                               (CCU6_T12_OM_INT_EN << CCU6_IS_T12OM_Pos) | (CCU6_T12_PM_INT_EN << CCU6_IS_T12PM_Pos) | \
+                               (CCU6_T13_CM_INT_EN << CCU6_IS_T13CM_Pos) | (CCU6_T13_PM_INT_EN << CCU6_IS_T13PM_Pos) | \
+                               (CCU6_TRAP_INT_EN << CCU6_IS_TRPF_Pos) | (CCU6_CHE_INT_EN << CCU6_IS_CHE_Pos) | \
+                               (CCU6_WHE_INT_EN << CCU6_IS_WHE_Pos) | (CCU6_MCM_STR_INT_EN << CCU6_IS_STR_Pos))
+
+/* Compile time enabled sources, bit positions as in SCUPM BDRV_IS/BDRV_IRQ_CTRL/BDRV_ISCLR */
+#define ISR_DISPATCH_BDRV_Msk ((BDRV_LS1_DS_INT_EN << SCUPM_BDRV_IS_LS1_DS_IS_Pos) | (BDRV_LS2_DS_INT_EN << SCUPM_BDRV_IS_LS2_DS_IS_Pos) | \
+                               (BDRV_HS1_DS_INT_EN << SCUPM_BDRV_IS_HS1_DS_IS_Pos) | (BDRV_HS2_DS_INT_EN << SCUPM_BDRV_IS_HS2_DS_IS_Pos) | \
+                               (BDRV_LS3_DS_INT_EN << SCUPM_BDRV_IS_LS3_DS_IS_Pos) | (BDRV_HS3_DS_INT_EN << SCUPM_BDRV_IS_HS3_DS_IS_Pos) | \
+                               (BDRV_LS1_OC_INT_EN << SCUPM_BDRV_IS_LS1_OC_IS_Pos) | (BDRV_LS2_OC_INT_EN << SCUPM_BDRV_IS_LS2_OC_IS_Pos) | \
+                               (BDRV_HS1_OC_INT_EN << SCUPM_BDRV_IS_HS1_OC_IS_Pos) | (BDRV_HS2_OC_INT_EN << SCUPM_BDRV_IS_HS2_OC_IS_Pos) | \
+                               (BDRV_LS3_OC_INT_EN << SCUPM_BDRV_IS_LS3_OC_IS_Pos) | (BDRV_HS3_OC_INT_EN << SCUPM_BDRV_IS_HS3_OC_IS_Pos) | \
+                               (BDRV_VCP_LO2_INT_EN << SCUPM_BDRV_IS_VCP_LOWTH2_IS_Pos) | (ADC2_VCP_LO_INT_EN << SCUPM_BDRV_IS_VCP_LOWTH1_IS_Pos) | \
+                               (ADC2_VCP_UP_INT_EN << SCUPM_BDRV_IS_VCP_UPTH_IS_Pos) | (ADC2_VSD_LO_INT_EN << SCUPM_BDRV_IS_VSD_LOWTH_IS_Pos) | \
+                               (ADC2_VSD_UP_INT_EN << SCUPM_BDRV_IS_VSD_UPTH_IS_Pos))
+
+/* Table entries, none for sources disabled in the ICW (never dispatched, see masks) */
+#if (CCU6_CH0_CM_R_INT_EN == 1)
+#define ISR_DISPATCH_CC60R CCU6_CH0_CM_R_CALLBACK
+#else
+#define ISR_DISPATCH_CC60R ISR_DISPATCH_NONE
+#endif
+#if (CCU6_CH0_CM_F_INT_EN == 1)
+#define ISR_DISPATCH_CC60F CCU6_CH0_CM_F_CALLBACK
+#else
+#define ISR_DISPATCH_CC60F ISR_DISPATCH_NONE
+#endif
+#if (CCU6_CH1_CM_R_INT_EN == 1)
+#define ISR_DISPATCH_CC61R CCU6_CH1_CM_R_CALLBACK
+#else
+#define ISR_DISPATCH_CC61R ISR_DISPATCH_NONE
+#endif
+#if (CCU6_CH1_CM_F_INT_EN == 1)
+#define ISR_DISPATCH_CC61F CCU6_CH1_CM_F_CALLBACK
+#else
+#define ISR_DISPATCH_CC61F ISR_DISPATCH_NONE
+#endif
+#if (CCU6_CH2_CM_R_INT_EN == 1)
+#define ISR_DISPATCH_CC62R CCU6_CH2_CM_R_CALLBACK
+#else
+#define ISR_DISPATCH_CC62R ISR_DISPATCH_NONE
+#endif
+#if (CCU6_CH2_CM_F_INT_EN == 1)
+#define ISR_DISPATCH_CC62F CCU6_CH2_CM_F_CALLBACK
+#else
+#define ISR_DISPATCH_CC62F ISR_DISPATCH_NONE
+#endif
+#if (CCU6_T12_OM_INT_EN == 1)
+#define ISR_DISPATCH_T12OM CCU6_T12_OM_CALLBACK
+#else
+#define ISR_DISPATCH_T12OM ISR_DISPATCH_NONE
+#endif
+#if (CCU6_T12_PM_INT_EN == 1)
+#define ISR_DISPATCH_T12PM CCU6_T12_PM_CALLBACK
+#else
+#define ISR_DISPATCH_T12PM ISR_DISPATCH_NONE
+#endif
+#if (CCU6_T13_CM_INT_EN == 1)
+#define ISR_DISPATCH_T13CM CCU6_T13_CM_CALLBACK
+#else
+#define ISR_DISPATCH_T13CM ISR_DISPATCH_NONE
+#endif
+#if (CCU6_T13_PM_INT_EN == 1)
+#define ISR_DISPATCH_T13PM CCU6_T13_PM_CALLBACK
+#else
+#define ISR_DISPATCH_T13PM ISR_DISPATCH_NONE
+#endif
+#if (CCU6_TRAP_INT_EN == 1)
+#define ISR_DISPATCH_TRPF CCU6_TRAP_CALLBACK
+#else
+#define ISR_DISPATCH_TRPF ISR_DISPATCH_NONE
+#endif
+#if (CCU6_CHE_INT_EN == 1)
+#define ISR_DISPATCH_CHE CCU6_CORRECT_HALL_CALLBACK
+#else
+#define ISR_DISPATCH_CHE ISR_DISPATCH_NONE
+#endif
+#if (CCU6_WHE_INT_EN == 1)
+#define ISR_DISPATCH_WHE CCU6_WRONG_HALL_CALLBACK
+#else
+#define ISR_DISPATCH_WHE ISR_DISPATCH_NONE
+#endif
+#if (CCU6_MCM_STR_INT_EN == 1)
+#define ISR_DISPATCH_STR CCU6_MCM_STR_CALLBACK
+#else
+#define ISR_DISPATCH_STR ISR_DISPATCH_NONE
+#endif
+
+#if (BDRV_LS1_DS_INT_EN == 1)
+#define ISR_DISPATCH_LS1_DS BDRV_LS1_DS_CALLBACK
+#else
+#define ISR_DISPATCH_LS1_DS ISR_DISPATCH_NONE
+#endif
+#if (BDRV_LS2_DS_INT_EN == 1)
+#define ISR_DISPATCH_LS2_DS BDRV_LS2_DS_CALLBACK
+#else
+#define ISR_DISPATCH_LS2_DS ISR_DISPATCH_NONE
+#endif
+#if (BDRV_HS1_DS_INT_EN == 1)
+#define ISR_DISPATCH_HS1_DS BDRV_HS1_DS_CALLBACK
+#else
+#define ISR_DISPATCH_HS1_DS ISR_DISPATCH_NONE
+#endif
+#if (BDRV_HS2_DS_INT_EN == 1)
+#define ISR_DISPATCH_HS2_DS BDRV_HS2_DS_CALLBACK
+#else
+#define ISR_DISPATCH_HS2_DS ISR_DISPATCH_NONE
+#endif
+#if (BDRV_LS3_DS_INT_EN == 1)
+#define ISR_DISPATCH_LS3_DS BDRV_LS3_DS_CALLBACK
+#else
+#define ISR_DISPATCH_LS3_DS ISR_DISPATCH_NONE
+#endif
+#if (BDRV_HS3_DS_INT_EN == 1)
+#define ISR_DISPATCH_HS3_DS BDRV_HS3_DS_CALLBACK
+#else
+#define ISR_DISPATCH_HS3_DS ISR_DISPATCH_NONE
+#endif
+#if (BDRV_LS1_OC_INT_EN == 1)
+#define ISR_DISPATCH_LS1_OC BDRV_LS1_OC_CALLBACK
+#else
+#define ISR_DISPATCH_LS1_OC ISR_DISPATCH_NONE
+#endif
+#if (BDRV_LS2_OC_INT_EN == 1)
+#define ISR_DISPATCH_LS2_OC BDRV_LS2_OC_CALLBACK
+#else
+#define ISR_DISPATCH_LS2_OC ISR_DISPATCH_NONE
+#endif
+#if (BDRV_HS1_OC_INT_EN == 1)
+#define ISR_DISPATCH_HS1_OC BDRV_HS1_OC_CALLBACK
+#else
+#define ISR_DISPATCH_HS1_OC ISR_DISPATCH_NONE
+#endif
+#if (BDRV_HS2_OC_INT_EN == 1)
+#define ISR_DISPATCH_HS2_OC BDRV_HS2_OC_CALLBACK
+#else
+#define ISR_DISPATCH_HS2_OC ISR_DISPATCH_NONE
+#endif
+#if (BDRV_LS3_OC_INT_EN == 1)
+#define ISR_DISPATCH_LS3_OC BDRV_LS3_OC_CALLBACK
+#else
+#define ISR_DISPATCH_LS3_OC ISR_DISPATCH_NONE
+#endif
+#if (BDRV_HS3_OC_INT_EN == 1)
+#define ISR_DISPATCH_HS3_OC BDRV_HS3_OC_CALLBACK
+#else
+#define ISR_DISPATCH_HS3_OC ISR_DISPATCH_NONE
+#endif
+#if (BDRV_VCP_LO2_INT_EN == 1)
+#define ISR_DISPATCH_VCP_LO2 BDRV_VCP_LO_CALLBACK
+#else
+#define ISR_DISPATCH_VCP_LO2 ISR_DISPATCH_NONE
+#endif
+#if (ADC2_VCP_LO_INT_EN == 1)
+#define ISR_DISPATCH_VCP_LO1 ADC2_VCP_LO_CALLBACK
+#else
+#define ISR_DISPATCH_VCP_LO1 ISR_DISPATCH_NONE
+#endif
+#if (ADC2_VCP_UP_INT_EN == 1)
+#define ISR_DISPATCH_VCP_UP ADC2_VCP_UP_CALLBACK
+#else
+#define ISR_DISPATCH_VCP_UP ISR_DISPATCH_NONE
+#endif
+#if (ADC2_VSD_LO_INT_EN == 1)
+#define ISR_DISPATCH_VSD_LO ADC2_VSD_LO_CALLBACK
+#else
+#define ISR_DISPATCH_VSD_LO ISR_DISPATCH_NONE
+#endif
+#if (ADC2_VSD_UP_INT_EN == 1)
+#define ISR_DISPATCH_VSD_UP ADC2_VSD_UP_CALLBACK
+#else
+#define ISR_DISPATCH_VSD_UP ISR_DISPATCH_NONE
+#endif
+#endif /* (ISR_DISPATCH_EN == 1) */
+
+/*******************************************************************************
+**                      Private Type Definitions                              **
+*******************************************************************************/
+typedef void (*TIsrDispatch_Callback)(void);
+
+/*******************************************************************************
+**                      Global Variable Definitions                           **
+*******************************************************************************/
+#if (ISR_DISPATCH_BENCH_EN == 1)
+volatile TIsrDispatch_Status IsrDispatch_Status;
+#endif
+
+/*******************************************************************************
+**                      Private Constant Definitions                          **
+*******************************************************************************/
+#if (ISR_DISPATCH_EN == 1)
+/* Callbacks indexed by the CCU6 IS bit position */
+static const TIsrDispatch_Callback IsrDispatch_Ccu6[16] =
+{
+  ISR_DISPATCH_CC60R, ISR_DISPATCH_CC60F, ISR_DISPATCH_CC61R, ISR_DISPATCH_CC61F,         /* 0..3 */
+  ISR_DISPATCH_CC62R, ISR_DISPATCH_CC62F, ISR_DISPATCH_T12OM, ISR_DISPATCH_T12PM,         /* 4..7 */
+  ISR_DISPATCH_T13CM, ISR_DISPATCH_T13PM, ISR_DISPATCH_TRPF, ISR_DISPATCH_NONE,           /* 8..11, TRPS is no interrupt */
+  ISR_DISPATCH_CHE, ISR_DISPATCH_WHE, ISR_DISPATCH_NONE, ISR_DISPATCH_STR                 /* 12..15, IDLE is no interrupt */
+};
+
+/* Callbacks indexed by the SCUPM BDRV_IS bit position */
+static const TIsrDispatch_Callback IsrDispatch_Bdrv[21] =
+{
+  ISR_DISPATCH_LS1_DS, ISR_DISPATCH_LS2_DS, ISR_DISPATCH_HS1_DS, ISR_DISPATCH_HS2_DS,     /* 0..3 */
+  ISR_DISPATCH_LS3_DS, ISR_DISPATCH_HS3_DS, ISR_DISPATCH_NONE, ISR_DISPATCH_NONE,         /* 4..7 */
+  ISR_DISPATCH_NONE, ISR_DISPATCH_NONE, ISR_DISPATCH_LS1_OC, ISR_DISPATCH_LS2_OC,         /* 8..11 */
+  ISR_DISPATCH_HS1_OC, ISR_DISPATCH_HS2_OC, ISR_DISPATCH_LS3_OC, ISR_DISPATCH_HS3_OC,     /* 12..15 */
+  ISR_DISPATCH_VCP_LO2, ISR_DISPATCH_VCP_LO1, ISR_DISPATCH_VCP_UP, ISR_DISPATCH_VSD_LO,   /* 16..19 */
+  ISR_DISPATCH_VSD_UP                                                                     /* 20 */
+};
+#endif /* (ISR_DISPATCH_EN == 1) */
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+#if (ISR_DISPATCH_EN == 1)
+/** \brief CCU6 service request 0, replaces the handler of isr.c.
+ *
+ * The pending sources are read once and served from the highest bit down
+ * (CHE before T12PM), one CLZ per source instead of a test per possible
+ * source. Callback first, then the flag is cleared, as in isr.c.
+ *
+ * \return None
+ *
+ * \ingroup isr_dispatch_api
+ */
+void CCU6SR0_IRQHandler(void)
+{
+  uint32 Pending;
+  uint32 Bit;
+  ISR_PROF_ENTER();
+
+  Pending = (uint32)CCU6->IS.reg & (uint32)CCU6->IEN.reg & (uint32)ISR_DISPATCH_CCU6_Msk;
+  while (Pending != 0u)
+  {
+    Bit = 31u - (uint32)__CLZ(Pending);
+    Pending &= ~(1u << Bit);
+    IsrDispatch_Ccu6[Bit]();
+    CCU6->ISR.reg = (uint16)(1u << Bit);
+  }
+
+  SCU->IRCON3CLR.bit.CCU6SR0C = 1;
+
+  ISR_PROF_EXIT(ISR_PROF_ID_CCU6SR0);
+} /* End of CCU6SR0_IRQHandler */
+
+
+/** \brief Bridge driver interrupt, replaces the handler of isr.c.
+ *
+ * Served from the highest bit down, the overcurrent flags come before the
+ * drain-source monitoring flags.
+ *
+ * \return None
+ *
+ * \ingroup isr_dispatch_api
+ */
+void BDRV_IRQHandler(void)
+{
+  uint32 Pending;
+  uint32 Bit;
+  ISR_PROF_ENTER();
+
+  Pending = SCUPM->BDRV_IS.reg & SCUPM->BDRV_IRQ_CTRL.reg & (uint32)ISR_DISPATCH_BDRV_Msk;
+  while (Pending != 0u)
+  {
+    Bit = 31u - (uint32)__CLZ(Pending);
+    Pending &= ~(1u << Bit);
+    IsrDispatch_Bdrv[Bit]();
+    SCUPM->BDRV_ISCLR.reg = 1u << Bit;
+  }
+
+  ISR_PROF_EXIT(ISR_PROF_ID_BDRV);
+} /* End of BDRV_IRQHandler */
+#endif /* (ISR_DISPATCH_EN == 1) */
+
+
+#if (ISR_DISPATCH_BENCH_EN == 1)
+/** \brief Measures the Hall event latency of the active dispatch variant.
+ *
+ * The CHE flag is set by software ISR_DISPATCH_BENCH_RUNS times, the latency
+ * runs from the flag write to the entry of the Hall callback and includes
+ * the interrupt entry and the dispatch. Results are in IsrDispatch_Status.
+ * Only runs with the motor stopped, the Hall callback skips benchmark events.
+ *
+ * \return None
+ *
+ * \ingroup isr_dispatch_api
+ */
+void IsrDispatch_BenchHall(void)
+{
+  uint32 Run;
+  uint32 Timeout;
+
+  if (Emo_GetMotorState() == EMO_MOTOR_STATE_STOP)
+  {
+    IsrDispatch_Status.HallMin = 0xFFFFu;
+    IsrDispatch_Status.HallMax = 0u;
+    IsrDispatch_Status.Runs = 0u;
+    for (Run = 0u; Run < ISR_DISPATCH_BENCH_RUNS; Run++)
+    {
+      IsrDispatch_Status.Pending = 1u;
+      IsrDispatch_Status.Start = Timebase_GetCycles();
+      CCU6->ISS.reg = (uint16)CCU6_ISS_SCHE_Msk;
+
+      Timeout = ISR_DISPATCH_BENCH_TIMEOUT;
+      while ((IsrDispatch_Status.Pending != 0u) && (Timeout > 0u))
+      {
+        Timeout--;
+      }
+    }
+    IsrDispatch_Status.Pending = 0u;
+  }
+
+} /* End of IsrDispatch_BenchHall */
+
+
+/** \brief Records the latency of a benchmark event, see IsrDispatch_HallProbe.
+ *
+ * \return None
+ *
+ * \ingroup isr_dispatch_api
+ */
+void IsrDispatch_BenchHit(void)
+{
+  uint32 Cycles;
+
+  Cycles = Timebase_CyclesSince(IsrDispatch_Status.Start);
+  if (Cycles > 0xFFFFu)
+  {
+    Cycles = 0xFFFFu;
+  }
+  IsrDispatch_Status.HallLast = (uint16)Cycles;
+  if (Cycles < IsrDispatch_Status.HallMin)
+  {
+    IsrDispatch_Status.HallMin = (uint16)Cycles;
+  }
+  if (Cycles > IsrDispatch_Status.HallMax)
+  {
+    IsrDispatch_Status.HallMax = (uint16)Cycles;
+  }
+  IsrDispatch_Status.Runs++;
+  IsrDispatch_Status.Pending = 0u;
+
+} /* End of IsrDispatch_BenchHit */
+#endif /* (ISR_DISPATCH_BENCH_EN == 1) */
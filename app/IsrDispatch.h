@@ -0,0 +1,120 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/* See IsrDispatch.c */
+
+#ifndef ISRDISPATCH_H
+#define ISRDISPATCH_H
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include <tle_device.h>
+
+/*******************************************************************************
+**                      Global Macro Definitions                              **
+*******************************************************************************/
+/* 1: CCU6SR0 and BDRV interrupts are dispatched through the callback tables of
+ * IsrDispatch.c instead of the cascades in isr.c. Set in the project C defines,
+ * isr.c checks the same define. */
+#ifndef ISR_DISPATCH_EN
+#define ISR_DISPATCH_EN (0)
+#endif
+
+/* 1: IsrDispatch_BenchHall measures the Hall event latency at start-up and the
+ * Hall callback checks for its software events. Off in production, the Hall
+ * path then has no probe; on in the host tests test_dispatch_cascade/_table.
+ * May be set in the project C defines. */
+#ifndef ISR_DISPATCH_BENCH_EN
+#define ISR_DISPATCH_BENCH_EN (0)
+#endif
+
+/* Software triggered Hall events per latency benchmark. Host run with the
+ * handler instructions counted (test_dispatch_cascade/_table): HallMin =
+ * HallMax = 41 cycles with the isr.c cascade, 50 cycles with the tables. With
+ * only the T12 period match and CHE enabled the cascade is two flag tests,
+ * the tables add the CLZ scan and an indirect call; they pay off with more
+ * enabled sources. Device figures are read from IsrDispatch_Status. */
+#define ISR_DISPATCH_BENCH_RUNS (16u)
+
+#if (ISR_DISPATCH_BENCH_EN == 1)
+/*******************************************************************************
+**                      Global Type Definitions                               **
+*******************************************************************************/
+/** \brief Hall event latency, from the software trigger to the Hall callback */
+typedef struct
+{
+  uint16 HallMin;       /**< \brief Shortest latency [CPU cycles] */
+  uint16 HallMax;       /**< \brief Longest latency [CPU cycles] */
+  uint16 HallLast;      /**< \brief Latency of the last run [CPU cycles] */
+  uint8 Runs;           /**< \brief Completed runs of the last benchmark */
+  uint8 Pending;        /**< \brief A benchmark event is in flight */
+  uint32 Start;         /**< \brief Cycle stamp of the trigger */
+} TIsrDispatch_Status;
+
+/*******************************************************************************
+**                      Global Variable Declarations                          **
+*******************************************************************************/
+extern volatile TIsrDispatch_Status IsrDispatch_Status;
+
+/*******************************************************************************
+**                      Global Function Declarations                          **
+*******************************************************************************/
+extern void IsrDispatch_BenchHall(void);
+extern void IsrDispatch_BenchHit(void);
+
+__STATIC_INLINE bool IsrDispatch_HallProbe(void);
+
+/*******************************************************************************
+**                      Global Inline Function Definitions                    **
+*******************************************************************************/
+/** \brief Checks for a benchmark event at entry of the Hall callback.
+ *
+ * \return true for a software triggered benchmark event, latency recorded, skip the Hall handling
+ *
+ * \ingroup isr_dispatch_api
+ */
+__STATIC_INLINE bool IsrDispatch_HallProbe(void)
+{
+  bool Res;
+
+  Res = false;
+  if (IsrDispatch_Status.Pending != 0u)
+  {
+    IsrDispatch_BenchHit();
+    Res = true;
+  }
+  return Res;
+} /* End of IsrDispatch_HallProbe */
+#endif /* (ISR_DISPATCH_BENCH_EN == 1) */
+
+
+#endif /* ISRDISPATCH_H */
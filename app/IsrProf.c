@@ -0,0 +1,239 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, interrupt handler run time statistics
+ */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include "IsrProf.h"
+
+#if (ISR_PROF_EN == 1)
+/*******************************************************************************
+**                      Global Variable Definitions                           **
+*******************************************************************************/
+volatile TIsrProf_Isr IsrProf_Isr[ISR_PROF_NUM];
+
+/* Cycles of completed handlers, a handler subtracts the increase during its run */
+volatile uint32 IsrProf_Nested;
+
+/* Cycle counter running, false if the device has no DWT cycle counter */
+bool IsrProf_ClockOk;
+
+/*******************************************************************************
+**                      Private Function Declarations                         **
+*******************************************************************************/
+static void IsrProf_lClear(uint32 Id);
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+/** \brief Clears the statistics and starts the cycle counter.
+ *
+ * \return None
+ *
+ * \ingroup isr_prof_api
+ */
+void IsrProf_Init(void)
+{
+  uint32 Id;
+#if (ISR_PROF_CLK_DWT == 1)
+  uint32 Start;
+#endif
+
+  for (Id = 0u; Id < ISR_PROF_NUM; Id++)
+  {
+    IsrProf_lClear(Id);
+  }
+  IsrProf_Nested = 0u;
+
+#if (ISR_PROF_CLK_DWT == 1)
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0u;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  Start = DWT->CYCCNT;
+  __NOP();
+  __NOP();
+  IsrProf_ClockOk = (((DWT->CTRL & DWT_CTRL_NOCYCCNT_Msk) == 0u) && (DWT->CYCCNT != Start)) ? true : false;
+#else
+  IsrProf_ClockOk = true;
+#endif
+} /* End of IsrProf_Init */
+
+/** \brief Timestamps the exit of a handler and adds the run to its statistics.
+ *
+ * The cycles of handlers that preempted this one are subtracted. Runs with
+ * interrupts locked for the few cycles of the update, IsrProf_Nested and
+ * the statistics are shared by all priority levels.
+ *
+ * \param Id Handler (ISR_PROF_ID_x)
+ * \param[in] pCtx Context of IsrProf_Enter
+ * \return None
+ *
+ * \ingroup isr_prof_api
+ */
+void IsrProf_Exit(uint32 Id, const TIsrProf_Ctx *pCtx)
+{
+  volatile TIsrProf_Isr *pIsr;
+  uint32 PriMask;
+  uint32 Total;
+  uint32 Cycles;
+  uint32 Bucket;
+
+  PriMask = __get_PRIMASK();
+  __disable_irq();
+
+  Total = ISR_PROF_SINCE(pCtx->Start);
+  Cycles = Total - (IsrProf_Nested - pCtx->Nested);
+  IsrProf_Nested = pCtx->Nested + Total;
+
+  pIsr = &IsrProf_Isr[Id];
+  if (pIsr->Sum > (0xFFFFFFFFu - Cycles))
+  {
+    /* Keeps the mean */
+    pIsr->Sum >>= 1u;
+    pIsr->Count >>= 1u;
+  }
+  pIsr->Sum += Cycles;
+  pIsr->Count++;
+
+  if (Cycles > 0xFFFFu)
+  {
+    Cycles = 0xFFFFu;
+  }
+  if (Cycles < pIsr->Min)
+  {
+    pIsr->Min = (uint16)Cycles;
+  }
+  if (Cycles > pIsr->Max)
+  {
+    pIsr->Max = (uint16)Cycles;
+  }
+
+  Bucket = 31u - (uint32)__CLZ(Cycles | 1u);
+  Bucket = (Bucket > ISR_PROF_HIST_SHIFT) ? (Bucket - ISR_PROF_HIST_SHIFT) : 0u;
+  if (Bucket >= ISR_PROF_HIST_NUM)
+  {
+    Bucket = ISR_PROF_HIST_NUM - 1u;
+  }
+  if (pIsr->Hist[Bucket] != 0xFFFFu)
+  {
+    pIsr->Hist[Bucket]++;
+  }
+
+  __set_PRIMASK(PriMask);
+} /* End of IsrProf_Exit */
+
+/** \brief Copies the consistent statistics of one handler.
+ *
+ * \param Id Handler (ISR_PROF_ID_x)
+ * \param[out] pIsr Statistics, only written for a valid ID
+ * \return true if Id is valid
+ *
+ * \ingroup isr_prof_api
+ */
+bool IsrProf_Get(uint32 Id, TIsrProf_Isr *pIsr)
+{
+  uint32 PriMask;
+  uint32 i;
+
+  if (Id >= ISR_PROF_NUM)
+  {
+    return false;
+  }
+
+  PriMask = __get_PRIMASK();
+  __disable_irq();
+  pIsr->Count = IsrProf_Isr[Id].Count;
+  pIsr->Sum = IsrProf_Isr[Id].Sum;
+  pIsr->Min = IsrProf_Isr[Id].Min;
+  pIsr->Max = IsrProf_Isr[Id].Max;
+  for (i = 0u; i < ISR_PROF_HIST_NUM; i++)
+  {
+    pIsr->Hist[i] = IsrProf_Isr[Id].Hist[i];
+  }
+  __set_PRIMASK(PriMask);
+
+  return true;
+} /* End of IsrProf_Get */
+
+/** \brief Clears the statistics of one handler.
+ *
+ * \param Id Handler (ISR_PROF_ID_x), ISR_PROF_NUM and above clear all handlers
+ * \return None
+ *
+ * \ingroup isr_prof_api
+ */
+void IsrProf_Reset(uint32 Id)
+{
+  uint32 PriMask;
+  uint32 i;
+
+  PriMask = __get_PRIMASK();
+  __disable_irq();
+  if (Id < ISR_PROF_NUM)
+  {
+    IsrProf_lClear(Id);
+  }
+  else
+  {
+    for (i = 0u; i < ISR_PROF_NUM; i++)
+    {
+      IsrProf_lClear(i);
+    }
+  }
+  __set_PRIMASK(PriMask);
+} /* End of IsrProf_Reset */
+
+/*******************************************************************************
+**                      Private Function Definitions                          **
+*******************************************************************************/
+/** \brief Clears the statistics of one handler, caller locks interrupts.
+ *
+ * \param Id Handler (ISR_PROF_ID_x)
+ * \return None
+ */
+static void IsrProf_lClear(uint32 Id)
+{
+  uint32 i;
+
+  IsrProf_Isr[Id].Count = 0u;
+  IsrProf_Isr[Id].Sum = 0u;
+  IsrProf_Isr[Id].Min = 0xFFFFu;
+  IsrProf_Isr[Id].Max = 0u;
+  for (i = 0u; i < ISR_PROF_HIST_NUM; i++)
+  {
+    IsrProf_Isr[Id].Hist[i] = 0u;
+  }
+} /* End of IsrProf_lClear */
+#endif /* (ISR_PROF_EN == 1) */
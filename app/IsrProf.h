@@ -0,0 +1,166 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/* See IsrProf.c */
+
+#ifndef ISRPROF_H
+#define ISRPROF_H
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include <tle_device.h>
+#include "Timebase.h"
+
+/*******************************************************************************
+**                      Global Macro Definitions                              **
+*******************************************************************************/
+/* 1: entry and exit of the interrupt handlers are timestamped. Set in the
+ * project C defines, isr.c checks the same define. With 0 the hooks expand to
+ * nothing and this module is empty. */
+#ifndef ISR_PROF_EN
+#define ISR_PROF_EN (0)
+#endif
+
+/* Cycle stamp source: 1 = DWT cycle counter, 0 = SysTick (handlers below 1 ms) */
+#ifndef ISR_PROF_CLK_DWT
+#define ISR_PROF_CLK_DWT (1)
+#endif
+
+/* Profiled handlers, IDs 0..15 are the NVIC nodes */
+#define ISR_PROF_ID_GPT1    ((uint32)GPT1_Int)
+#define ISR_PROF_ID_GPT2    ((uint32)GPT2_Int)
+#define ISR_PROF_ID_ADC2    ((uint32)ADC2_Tmr3_Int)
+#define ISR_PROF_ID_ADC1    ((uint32)ADC1_VREF5_Int)
+#define ISR_PROF_ID_CCU6SR0 ((uint32)CCU6_SR0_Int)
+#define ISR_PROF_ID_CCU6SR1 ((uint32)CCU6_SR1_Int)
+#define ISR_PROF_ID_CCU6SR2 ((uint32)CCU6_SR2_Int)
+#define ISR_PROF_ID_CCU6SR3 ((uint32)CCU6_SR3_Int)
+#define ISR_PROF_ID_SSC1    ((uint32)SSC1_Int)
+#define ISR_PROF_ID_SSC2    ((uint32)SSC2_Int)
+#define ISR_PROF_ID_UART1   ((uint32)UART1_LIN_Tmr2_Int)
+#define ISR_PROF_ID_UART2   ((uint32)UART2_Tmr21_EINT2_Int)
+#define ISR_PROF_ID_EXINT0  ((uint32)EXINT0_MON_Int)
+#define ISR_PROF_ID_EXINT1  ((uint32)EXINT1_Int)
+#define ISR_PROF_ID_BDRV    ((uint32)BDRV_CP_Int)
+#define ISR_PROF_ID_DMA     ((uint32)DMA_Int)
+#define ISR_PROF_ID_SYSTICK (16u)
+#define ISR_PROF_NUM        (17u)
+
+/* Histogram: bucket 0 below 2^(ISR_PROF_HIST_SHIFT + 1) cycles, bucket n from
+ * 2^(ISR_PROF_HIST_SHIFT + n) on, the last bucket open-ended */
+#define ISR_PROF_HIST_NUM   (12u)
+#define ISR_PROF_HIST_SHIFT (4u)
+
+#if (ISR_PROF_EN == 1)
+#if (ISR_PROF_CLK_DWT == 1)
+#define ISR_PROF_NOW()         (DWT->CYCCNT)
+#define ISR_PROF_SINCE(Start)  (DWT->CYCCNT - (Start))
+#else
+#define ISR_PROF_NOW()         Timebase_GetCycles()
+#define ISR_PROF_SINCE(Start)  Timebase_CyclesSince(Start)
+#endif
+
+/* Hooks of the handlers: ISR_PROF_ENTER() is a declaration, it follows the
+ * other declarations of the handler; ISR_PROF_EXIT(Id) is the last statement */
+#define ISR_PROF_ENTER()   TIsrProf_Ctx IsrProf_Ctx = IsrProf_Enter()
+#define ISR_PROF_EXIT(Id)  IsrProf_Exit((Id), &IsrProf_Ctx)
+#else
+#define ISR_PROF_ENTER()
+#define ISR_PROF_EXIT(Id)
+#endif /* (ISR_PROF_EN == 1) */
+
+/*******************************************************************************
+**                      Global Type Definitions                               **
+*******************************************************************************/
+/** \brief Timestamps of a running handler */
+typedef struct
+{
+  uint32 Start;         /**< \brief Cycle stamp at entry */
+  uint32 Nested;        /**< \brief IsrProf_Nested at entry */
+} TIsrProf_Ctx;
+
+/** \brief Statistics of one handler, own cycles without preempting handlers */
+typedef struct
+{
+  uint32 Count;         /**< \brief Runs, halved together with Sum before Sum overflows */
+  uint32 Sum;           /**< \brief Cycles of the counted runs, mean = Sum / Count */
+  uint16 Min;           /**< \brief Shortest run [CPU cycles], saturated */
+  uint16 Max;           /**< \brief Longest run [CPU cycles], saturated */
+  uint16 Hist[ISR_PROF_HIST_NUM]; /**< \brief Runs per log2 bucket, saturated */
+} TIsrProf_Isr;
+
+/*******************************************************************************
+**                      Global Variable Declarations                          **
+*******************************************************************************/
+#if (ISR_PROF_EN == 1)
+extern volatile TIsrProf_Isr IsrProf_Isr[ISR_PROF_NUM];
+extern volatile uint32 IsrProf_Nested;
+extern bool IsrProf_ClockOk;
+#endif /* (ISR_PROF_EN == 1) */
+
+/*******************************************************************************
+**                      Global Function Declarations                          **
+*******************************************************************************/
+#if (ISR_PROF_EN == 1)
+extern void IsrProf_Init(void);
+extern void IsrProf_Exit(uint32 Id, const TIsrProf_Ctx *pCtx);
+extern bool IsrProf_Get(uint32 Id, TIsrProf_Isr *pIsr);
+extern void IsrProf_Reset(uint32 Id);
+
+__STATIC_INLINE TIsrProf_Ctx IsrProf_Enter(void);
+#endif /* (ISR_PROF_EN == 1) */
+
+/*******************************************************************************
+**                      Global Inline Function Definitions                    **
+*******************************************************************************/
+#if (ISR_PROF_EN == 1)
+/** \brief Timestamps the entry of a handler.
+ *
+ * The stamp is taken before IsrProf_Nested is read: a handler preempting in
+ * between is counted as own time of this handler, which never underflows.
+ *
+ * \return Context for IsrProf_Exit
+ *
+ * \ingroup isr_prof_api
+ */
+__STATIC_INLINE TIsrProf_Ctx IsrProf_Enter(void)
+{
+  TIsrProf_Ctx Ctx;
+
+  Ctx.Start = ISR_PROF_NOW();
+  Ctx.Nested = IsrProf_Nested;
+  return Ctx;
+} /* End of IsrProf_Enter */
+#endif /* (ISR_PROF_EN == 1) */
+
+
+#endif /* ISRPROF_H */
@@ -50,26 +50,74 @@
 #include <string.h>
 #include "Main.h"
 #include "Emo.h"
+#include "EmoEnc.h"
+#include "EmoPos.h"
+#include "Neopx.h"
+#include "SpiProt.h"
+#include "Timebase.h"
+#include "Trace.h"
+#include "FlightRec.h"
+#include "Fault.h"
+#include "IsrDispatch.h"
+#include "IsrProf.h"
+#include "IntPrio.h"
+#include "Sched.h"
+#include "EmoCcu.h"
 
 /*******************************************************************************
 **                      Private Macro Definitions                             **
 *******************************************************************************/
+/* SPI frame: first word written to SSC2 by the CPU, the others by DMA channel 2 from spi_tx_data,
+ * all words received by DMA channel 3 into spi_rx_data. Both are ping-pong buffers, the end pointers
+ * of the channels are set to the active half when armed. */
+#if ((DMA_CH2_NoOfTrans != (SPIPROT_FRAME_WORDS - 1u)) || (DMA_CH3_NoOfTrans != SPIPROT_FRAME_WORDS))
+#error "DMA channels 2 and 3 do not match the SPI frame length"
+#endif
+
+#if (FLIGHTREC_REC_WORDS != SPIPROT_DUMP_RECORD_WORDS)
+#error "Flight recorder records do not match the SPI dump frame"
+#endif
+
+#if ((ISR_PROF_NUM > 0x100u) || (ISR_PROF_HIST_NUM > 0x100u))
+#error "Handler IDs and histogram buckets do not fit the SPI profile frame"
+#endif
+
+/* Main loop task periods [ms] */
+#define MAIN_LED_MS     (20u)
+#define MAIN_TELEM_MS   (10u)
+#define MAIN_DIAG_MS    (10u)
+#define MAIN_SUPPLY_MS  (5u)
+
+/* Primary control entry of a DMA channel */
+#define MAIN_DMA_ENTRY(Ch) (&((TDMA_Entry *)DMA_BASE_ADDR)[(Ch)])
 
 /*******************************************************************************
 **                      Private Function Declarations                         **
 *******************************************************************************/
 void Poti_Handler(void);
+void SPI_slave_init(void);
+void SPI_slave_arm_rx(void);
+void SPI_slave_arm_tx(void);
 void SPI_slave_react(void);
+bool SPI_slave_execute(const TSpiProt_Cmd *pCmd);
+void SPI_slave_apply(void);
+void SPI_slave_telemetry(uint8 Status);
+void SPI_slave_dump(uint8 Status);
+void SPI_slave_faults(uint8 Status);
+#if (ISR_PROF_EN == 1)
+void SPI_slave_prof(uint8 Status);
+#endif
+uint32 SysTick_elapsed(uint32 start);
 void HardFaultHdlr(void);
 void DMA_complete_handler(void);
-void encoder_B_pos(void);
+void Main_TaskLed(void);
+void Main_TaskTelem(void);
+void Main_TaskDiag(void);
+void Main_TaskSupply(void);
 
-void Neopx_Write(uint8 *color_rgb);
 void HSV2RGB(double h, double s, double v, uint8 rgb[]);
 void Wheel(uint8 WheelPos, uint8 setcolor[]);
 void SetBrightness(uint8 color[], uint8 brightness);
-void T2_Rising_Reload(void);
-void T4_Falling_Reload(void);
 
 /*******************************************************************************
 **                      Global Variable Definitions                           **
@@ -78,29 +126,54 @@ void T4_Falling_Reload(void);
 /*******************************************************************************
 **                      Private Variable Definitions                          **
 *******************************************************************************/
-uint16 spi_tx_data[11] = {0xCAFE, 0xBABE, 0xDEAD, 0xBEEF, 0xAAAA, 
-																					0xB00B, 0x0F0F, 0xC0DE, 0xF00D, 0xFADE,
-																					0x1};
-uint16 spi_rx_data[DMA_CH3_NoOfTrans];
-uint16 count = 0;							
+uint16 spi_tx_data[2][SPIPROT_FRAME_WORDS];
+uint16 spi_rx_data[2][SPIPROT_FRAME_WORDS];
+uint8 spi_tx_idx;											// Halves in use by DMA
+uint8 spi_rx_idx;
+uint32 spi_swap_ticks_max;						// Longest buffer swap (both channels) [SysTick ticks]
+uint8 spi_seq;												// Sequence number of the last accepted frame
+uint16 spi_frame_ctr;
+uint16 spi_err_ctr;
+uint8 spi_report;											// Command answered by the next slave frame instead of telemetry, 0 = none
+TSpiProt_Cmd spi_cmd;									// Motor command queued by the DMA interrupt for the SysTick
+volatile uint8 spi_cmd_pending;
+uint16 spi_dump_idx;									// First record of the dump
+uint8 spi_dump_arm;										// Re-arm the flight recorder after the dump
+uint8 spi_fault_clear;								// Clear the latched faults after the report
+#if (ISR_PROF_EN == 1)
+uint8 spi_prof_id;										// Handler of the profile report
+uint8 spi_prof_first;									// First histogram bucket of the profile report
+uint8 spi_prof_clear;									// Clear the handler statistics after the report
+#endif
+uint8 spi_status_flags;								// Slow telemetry packed by Main_TaskTelem
+uint8 spi_motor_state;
+uint8 spi_mode;
+uint8 spi_fault;
+uint8 spi_cpu_load;
+uint16 spi_sample_t6;									// Raw sample of the last chip select, sent in the next frame
+sint32 spi_sample_pos;
+uint16 spi_sample_speed;
+uint8 spi_sample_dir;
+sint16 spi_sample_current;
+uint16 supply_vs_mv;									// ADC2 supervision by Main_TaskSupply
+uint16 supply_vs_min_mv = 0xFFFFu;
+uint16 supply_vcp_mv;
+uint16 supply_vcp_min_mv = 0xFFFFu;
+sint16 chip_temp_c;
+sint16 chip_temp_max_c = -128;
 uint16 adc1_result = 0;	
-int64 eticks = 0;						
-
-#define NCOLORS 3
-uint8 npx_data[NCOLORS];
-uint8 npx_index;
-uint8 npx_current_byte;
-uint8 npx_bit_count;                                          
-
-// Thank you so much @bigjosh2 for allowing me to have a bit more headroom in my
-// unoptimized interrupts!
-// https://wp.josh.com/2014/05/13/ws2812-neopixels-are-not-so-finicky-once-you-get-to-know-them/																					
-uint16 npx_T3_high_ticks[2] = {2, 7};    //@10MHz GPTclk, ~0.3 and ~0.6 us 	| Corrected a bit for internal timings
-uint16 npx_T3_low_ticks[2] = {49, 49};    //@10MHz GPTclk, 4.9 us						| Max is 5 us																	
 
 /*******************************************************************************
 **                      Private Constant Definitions                          **
 *******************************************************************************/
+/* Main loop tasks, in order of precedence */
+const TSched_Task main_tasks[] =
+{
+	{Main_TaskDiag,   MAIN_DIAG_MS,   0u},
+	{Main_TaskSupply, MAIN_SUPPLY_MS, 1u},
+	{Main_TaskTelem,  MAIN_TELEM_MS,  2u},
+	{Main_TaskLed,    MAIN_LED_MS,    3u}
+};
 
 /*******************************************************************************
 **                      Global Function Definitions                           **
@@ -113,16 +186,19 @@ uint16 npx_T3_low_ticks[2] = {49, 49};    //@10MHz GPTclk, 4.9 us						| Max is
  */
 int main(void)
 {
-	int i;
 	uint8 colors[5][3] = {{0,0,0}, {0,0,120}, {120,0,0}, {0,120,0}, {137,137,120}};
-	uint8 set_color[3];
-	uint8 brightness = 255;
+	
+#if (ISR_PROF_EN == 1)
+	IsrProf_Init();
+#endif
 	
   /*****************************************************************************
   ** initialization of the hardware modules based on the configuration done   **
   ** by using the IFXConfigWizard                                             **
   *****************************************************************************/
   TLE_Init();
+	Timebase_Init();
+	Trace_Init();
 	
 	/* We clear the under/overvoltage interrupt status flags that occur if the board
 	 * is started @ 24V. (Reason is the default values loaded at boot in the threshold
@@ -131,92 +207,413 @@ int main(void)
 	 */
 	SCUPM->BDRV_ISCLR.reg = 0x11110000u;
 	SCUPM->BDRV_ISCLR.reg = 0x0u;					// Extra op so that they are correctly set.
+
+	/* Arm the flight recorder after the stale supply limit flags are cleared */
+	FlightRec_Arm();
 	
   /* Initialize E-Motor application */
 
   Emo_Init();
+	Fault_Init();
+#if (ISR_DISPATCH_BENCH_EN == 1)
+	IsrDispatch_BenchHall();
+#endif
 	
 	/*Activate DMA controller*/
 	DMA_Master_En();
+	SPI_slave_init();
 	
 	/*Clear LED*/
-	GPT12E->T3CON.reg &= 0xFFFFFBBFu;			//Just in case some insurance, because I'm going crazy
-//	PORT->P1_ALTSEL0.reg &= 0xFB;
-//	PORT->P1_ALTSEL1.reg &= 0xFB;
-//	PORT->P1_DATA.reg |= 0x4;
-	Neopx_Write(colors[0]);
+	Neopx_Init();
+	(void)Neopx_Write(colors[0], 1u);
 	Delay_us(1000);
-	GPT12E->T3CON.reg &= 0xFFFFFBBFu;
-//	PORT->P1_DATA.reg &= 0xFB;
-//	PORT->P1_ALTSEL0.reg |= 0x4;
-//	PORT->P1_ALTSEL1.reg |= 0x4;
 	
 	/*Start motor*/
 	Emo_SetRefSpeed(1000);
 	//Emo_StartMotor();
 	
 	
-  while (1)
-  { 
-		/* Service watch
-		-dog */
-		WDT1_Service();
-		
-//		HSV2RGB(h, s, v, set_color);
-		Wheel((((uint8) (eticks >> 3)) % 255), set_color);
-		SetBrightness(set_color, brightness);
-		Neopx_Write(set_color);
-//		if (h >= 1.0){ h = 0; }
-//		else { h += 0.005; }
-		if  (i >= 255) { i = 0; }
-		else { i++; }
-		Delay_us(20000);
-		
-//		Neopx_Write(colors[1]);
-//		Delay_us(1000000);
-//		WDT1_Service();
-
-//		Neopx_Write(colors[2]);
-//		Delay_us(1000000);
-//		WDT1_Service();
-//		
-//		Neopx_Write(colors[3]);
-//		Delay_us(1000000);
-		
-		
-//		for(i = 0; i < 100; i++)
-//		{
-//			Delay_us(500000);
-//			if(i>=49)
-//			{
-//				Emo_SetRefSpeed(-2000);
-//			}
-//			else
-//			{
-//				Emo_SetRefSpeed(2000);
-//			}
-//		}
-    
-  }
+	/* Tasks run from here on, released by SysTick */
+	Main_TaskTelem();
+	Sched_Init(main_tasks, (uint8)(sizeof(main_tasks) / sizeof(main_tasks[0])));
+	Sched_Run();
+	return 0;
 } /* End of main() */
 
 void Main_HandleSysTick(void)
 {
-  /* Callback function executed every ms for speed control */
+  /* Callback function executed every ms for position and speed control */
+  Timebase_Update();
+  Fault_Handle();
+  SPI_slave_apply();
+  EmoEnc_Update();
+  EmoPos_Exe(EmoEnc_GetPos());
   Emo_CtrlSpeed();
+  Trace_Sample();
+  Sched_Tick();
 } /* End of Main_HandleSysTick */
 
+void Main_HandlePwmPeriod(void)
+{
+  /* Callback function executed every PWM period */
+  Emo_HandlePwmPeriod();
+  FlightRec_Sample();
+} /* End of Main_HandlePwmPeriod */
+
 /*******************************************************************************
 **                      Private Function Definitions                          **
 *******************************************************************************/
+void SPI_slave_init(void)
+{
+	/* Transmit requests of DMA channel 2 from SSC2, the ICW setting writes a read-only bit instead */
+	SCU->DMASRCSEL.reg |= (uint8)SCU_DMASRCSEL_SSCTXSRCSEL_Msk;
+	
+	/* Interrupt after the last received word of a frame */
+	SCU->DMAIEN2.reg |= (uint8)SCU_DMAIEN2_SSCRXIE_Msk;
+	CPU->NVIC_ISER0.reg = CPU_NVIC_ISER0_Int_DMA_Msk;
+	
+	SPI_slave_arm_rx();
+	SPI_slave_latch();
+	SPI_slave_telemetry(0u);
+	spi_tx_idx ^= 1u;
+	SPI_slave_arm_tx();
+}
+
+void SPI_slave_arm_rx(void)
+{
+	/* Receive into the active half, end pointer at its last word */
+	MAIN_DMA_ENTRY(DMA_CH3)->Dst_End_Ptr = (uint32)&spi_rx_data[spi_rx_idx][SPIPROT_WORD_CRC];
+	DMA_Reset_Channel(DMA_CH3, DMA_CH3_NoOfTrans);
+}
+
+void SPI_slave_arm_tx(void)
+{
+	/* Transmit the active half, SSC2 sends the header when the master starts clocking, DMA the rest */
+	MAIN_DMA_ENTRY(DMA_CH2)->Src_End_Ptr = (uint32)&spi_tx_data[spi_tx_idx][SPIPROT_WORD_CRC];
+	DMA_Reset_Channel(DMA_CH2, DMA_CH2_NoOfTrans);
+	SSC2->TB.reg = spi_tx_data[spi_tx_idx][SPIPROT_WORD_HEADER];
+}
+
 void SPI_slave_react(void)
 {
-	if (SSC2->TB.reg != 0xC001u)
+	TDMA_Entry *rx_entry;
+	
+	/* Chip select: the frame being sent is complete and may already be fetched by DMA, the sample
+	 * goes into the next frame, built by SPI_slave_telemetry after this one */
+	SPI_slave_latch();
+	
+	/* An incomplete last frame left the receive channel behind the first word */
+	rx_entry = MAIN_DMA_ENTRY(DMA_CH3);
+	if ((rx_entry->Control.bit.Cycle_Ctrl != (uint8)DMA_Cycle_Type_Basic) ||
+			(rx_entry->Control.bit.N_Minus_1 != (uint16)(DMA_CH3_NoOfTrans - 1u)))
+	{
+		spi_err_ctr++;
+		SPI_slave_arm_rx();
+		SPI_slave_arm_tx();
+	}
+}
+
+void SPI_slave_latch(void)
+{
+	/* Raw values only, SPI_slave_telemetry converts them: the chip select interrupt takes no lock and
+	 * no division, and the SysTick that moves the timebase reference cannot preempt it */
+	spi_sample_t6 = Timebase_GetT6();
+	spi_sample_pos = EmoEnc_GetPos();
+	spi_sample_speed = Emo_GetAbsSpeed();
+	spi_sample_dir = EmoCcu_GetDirIdx();
+	spi_sample_current = Emo_Ctrl.Current;
+}
+
+bool SPI_slave_execute(const TSpiProt_Cmd *pCmd)
+{
+	uint32 primask;
+	
+	switch (pCmd->CmdId)
+	{
+		case SPIPROT_CMD_NONE:
+			return true;
+		
+		case SPIPROT_CMD_SPEED:
+		case SPIPROT_CMD_POS:
+		case SPIPROT_CMD_CURRENT:
+		case SPIPROT_CMD_PWM:
+		case SPIPROT_CMD_GAINS:
+		case SPIPROT_CMD_STOP:
+			break;
+		
+		case SPIPROT_CMD_FREC:
+			if (pCmd->Payload[1] == 1u)
+			{
+				FlightRec_Freeze(FLIGHTREC_CAUSE_USER);
+			}
+			spi_dump_idx = pCmd->Payload[0];
+			spi_dump_arm = (pCmd->Payload[1] == 2u) ? 1u : 0u;
+			spi_report = SPIPROT_CMD_FREC;
+			return true;
+		
+		case SPIPROT_CMD_FAULT:
+			spi_fault_clear = (pCmd->Payload[0] == 1u) ? 1u : 0u;
+			spi_report = SPIPROT_CMD_FAULT;
+			return true;
+		
+		case SPIPROT_CMD_HALLCAL:
+			spi_fault_clear = 0u;
+			spi_report = SPIPROT_CMD_FAULT;
+			if ((pCmd->Payload[0] != 1u) && (pCmd->Payload[0] != 2u))
+			{
+				/* Only report the state */
+				return true;
+			}
+			break;
+		
+#if (ISR_PROF_EN == 1)
+		case SPIPROT_CMD_PROF:
+			if ((pCmd->Payload[0] >= ISR_PROF_NUM) || (pCmd->Payload[1] >= ISR_PROF_HIST_NUM))
+			{
+				return false;
+			}
+			spi_prof_id = (uint8)pCmd->Payload[0];
+			spi_prof_first = (uint8)pCmd->Payload[1];
+			spi_prof_clear = (pCmd->Payload[2] == 1u) ? 1u : 0u;
+			spi_report = SPIPROT_CMD_PROF;
+			return true;
+#endif
+		
+		default:
+			return false;
+	}
+	
+	/* Motor commands are applied by the SysTick, which preempts this interrupt: a start or stop
+	 * must not be cut by the speed loop. A newer command replaces one not yet applied. */
+	primask = __get_PRIMASK();
+	__disable_irq();
+	spi_cmd = *pCmd;
+	spi_cmd_pending = 1u;
+	__set_PRIMASK(primask);
+	return true;
+}
+
+void SPI_slave_apply(void)
+{
+	sint16 ref;
+	
+	/* Called by the SysTick, the DMA interrupt cannot change the command while it is read */
+	if (spi_cmd_pending == 0u)
+	{
+		return;
+	}
+	spi_cmd_pending = 0u;
+	
+	ref = (sint16)spi_cmd.Payload[0];
+	switch (spi_cmd.CmdId)
+	{
+		case SPIPROT_CMD_SPEED:
+			EmoPos_Disable();
+			Emo_SetRefSpeed(ref);
+			break;
+		
+		case SPIPROT_CMD_POS:
+			EmoPos_SetTarget((sint32)(((uint32)spi_cmd.Payload[0] << 16u) | spi_cmd.Payload[1]), EmoEnc_GetPos());
+			return;
+		
+		case SPIPROT_CMD_CURRENT:
+			EmoPos_Disable();
+			Emo_SetRefCurrent(ref);
+			break;
+		
+		case SPIPROT_CMD_PWM:
+			EmoPos_Disable();
+			Emo_SetRefDuty((sint16)(((sint32)ref * (sint32)EMO_PWM_PERIOD_TICKS) >> 15u));
+			break;
+		
+		case SPIPROT_CMD_GAINS:
+			Emo_Ctrl.SpeedPi.Kp = (sint16)spi_cmd.Payload[0];
+			Emo_Ctrl.SpeedPi.Ki = (sint16)spi_cmd.Payload[1];
+			EmoPos_Ctrl.Kp = (sint16)spi_cmd.Payload[2];
+			EmoPos_Ctrl.Kd = (sint16)spi_cmd.Payload[3];
+			return;
+		
+		case SPIPROT_CMD_STOP:
+			EmoPos_Disable();
+			(void)Emo_StopMotor();
+			return;
+		
+		case SPIPROT_CMD_HALLCAL:
+			if (spi_cmd.Payload[0] == 1u)
+			{
+				EmoCcu_StartHallCal();
+			}
+			else
+			{
+				EmoCcu_ClearHallCal();
+			}
+			return;
+		
+		default:
+			return;
+	}
+	
+	/* Speed, current and duty cycle references start the stopped motor */
+	if ((ref != 0) && (Emo_GetMotorState() == EMO_MOTOR_STATE_STOP))
+	{
+		(void)Emo_StartMotor();
+	}
+}
+
+void SPI_slave_telemetry(uint8 Status)
+{
+	TSpiProt_Telem telem;
+	uint32 primask;
+	uint16 t6;
+	sint16 speed;
+	uint8 dir;
+	
+	if (spi_report == SPIPROT_CMD_FREC)
+	{
+		SPI_slave_dump(Status);
+		return;
+	}
+	if (spi_report == SPIPROT_CMD_FAULT)
+	{
+		SPI_slave_faults(Status);
+		return;
+	}
+#if (ISR_PROF_EN == 1)
+	if (spi_report == SPIPROT_CMD_PROF)
 	{
-		SSC2->TB.reg = count++;
+		SPI_slave_prof(Status);
+		return;
 	}
+#endif
+	
+	/* Sample of the chip select of the frame just received, the chip select interrupt preempts this one */
+	primask = __get_PRIMASK();
+	__disable_irq();
+	t6 = spi_sample_t6;
+	telem.Pos = spi_sample_pos;
+	speed = (sint16)spi_sample_speed;
+	dir = spi_sample_dir;
+	telem.Current = spi_sample_current;
+	__set_PRIMASK(primask);
+	telem.Time = Timebase_GetUsAt(t6);
+	telem.Speed = (dir == 0u) ? speed : (sint16)(-speed);
+	
+	telem.Seq = spi_seq;
+	telem.Status = Status | spi_status_flags;
+	telem.Duty = Emo_Ctrl.DutyCycle;
+	telem.MotorState = spi_motor_state;
+	telem.Mode = spi_mode;
+	telem.Fault = spi_fault;
+	telem.CpuLoad = spi_cpu_load;
+	telem.PosErr = (sint16)EmoPos_Ctrl.PosErr;
+	telem.FrameCtr = spi_frame_ctr;
+	telem.ErrCtr = (uint8)spi_err_ctr;
+	
+	/* Complete frame into the half not read by DMA */
+	SpiProt_EncodeTelem(spi_tx_data[spi_tx_idx ^ 1u], &telem);
 }
 
+void SPI_slave_dump(uint8 Status)
+{
+	TSpiProt_Dump dump;
+	uint32 i;
+	
+	spi_report = 0u;
+	dump.Seq = spi_seq;
+	dump.Status = Status;
+	dump.Index = spi_dump_idx;
+	for (i = 0u; i < SPIPROT_DUMP_NUM_RECORDS; i++)
+	{
+		if (FlightRec_GetRecord((uint16)(spi_dump_idx + i), dump.Rec[i]) == false)
+		{
+			memset(dump.Rec[i], 0, sizeof(dump.Rec[i]));
+		}
+	}
+	dump.Cause = FlightRec_Status.Cause;
+	dump.Frozen = FlightRec_Status.Frozen;
+	dump.Count = FlightRec_Status.Count;
+	if (dump.Cause != FLIGHTREC_CAUSE_NONE)
+	{
+		dump.Status |= SPIPROT_STATUS_FREC_TRIG;
+	}
+	
+	/* Re-arm once the records are in the frame */
+	if (spi_dump_arm != 0u)
+	{
+		FlightRec_Arm();
+	}
+	
+	SpiProt_EncodeDump(spi_tx_data[spi_tx_idx ^ 1u], &dump);
+}
+
+void SPI_slave_faults(uint8 Status)
+{
+	TSpiProt_Faults faults;
+	
+	spi_report = 0u;
+	faults.Seq = spi_seq;
+	faults.Status = Status;
+	faults.Active = Fault_Status.Active;
+	faults.History = Fault_Status.History;
+	faults.OcCtr = Fault_Status.OcCtr;
+	faults.SupplyCtr = Fault_Status.SupplyCtr;
+	faults.Retries = Fault_Status.Retries;
+	faults.Locked = Fault_Status.Locked;
+	faults.OffCycles = Fault_Status.OffCyclesMax;
+	faults.StallCtr = Fault_Status.StallCtr;
+	faults.HallCal = EmoCcu_GetHallCalState();
+	if (spi_fault_clear != 0u)
+	{
+		Fault_Clear();
+	}
+	
+	SpiProt_EncodeFaults(spi_tx_data[spi_tx_idx ^ 1u], &faults);
+}
+
+#if (ISR_PROF_EN == 1)
+void SPI_slave_prof(uint8 Status)
+{
+	TSpiProt_Prof prof;
+	TIsrProf_Isr isr;
+	uint32 bucket;
+	uint32 mean;
+	uint32 i;
+	
+	spi_report = 0u;
+	memset(&prof, 0, sizeof(prof));
+	prof.Seq = spi_seq;
+	prof.Status = Status;
+	prof.Id = spi_prof_id;
+	prof.First = spi_prof_first;
+	
+	if (IsrProf_Get(spi_prof_id, &isr) == true)
+	{
+		prof.Count = isr.Count;
+		if (isr.Count != 0u)
+		{
+			mean = isr.Sum / isr.Count;
+			prof.Min = isr.Min;
+			prof.Max = isr.Max;
+			prof.Mean = (uint16)((mean > 0xFFFFu) ? 0xFFFFu : mean);
+		}
+		for (i = 0u; i < SPIPROT_PROF_NUM_BUCKETS; i++)
+		{
+			bucket = spi_prof_first + i;
+			if (bucket < ISR_PROF_HIST_NUM)
+			{
+				prof.Hist[i] = isr.Hist[bucket];
+			}
+		}
+	}
+	if (spi_prof_clear != 0u)
+	{
+		IsrProf_Reset(spi_prof_id);
+	}
+	
+	SpiProt_EncodeProf(spi_tx_data[spi_tx_idx ^ 1u], &prof);
+}
+#endif
+
 void HardFaultHdlr(void)
 {
 
@@ -224,21 +621,119 @@ void HardFaultHdlr(void)
 
 void DMA_complete_handler(void)
 {
-	spi_tx_data[9] = 0xC001u;
+	TSpiProt_Cmd cmd;
+	uint8 status;
+	uint8 rx_idx;
+	uint32 start;
+	uint32 ticks;
+	
+	/* Last word of a frame received: receive the next frame into the other half first */
+	start = CPU->SYSTICK_CUR.reg;
+	rx_idx = spi_rx_idx;
+	spi_rx_idx ^= 1u;
+	SPI_slave_arm_rx();
+	ticks = SysTick_elapsed(start);
+	
+	/* Execute the command */
+	spi_frame_ctr++;
+	if ((SpiProt_DecodeCmd(spi_rx_data[rx_idx], &cmd) == true) && (SPI_slave_execute(&cmd) == true))
+	{
+		spi_seq = cmd.Seq;
+		status = SPIPROT_STATUS_CMD_OK;
+	}
+	else
+	{
+		spi_err_ctr++;
+		status = SPIPROT_STATUS_CMD_ERR;
+	}
+	
+	/* Telemetry for the next frame, the master reads it while sending its next command */
+	SPI_slave_telemetry(status);
+	start = CPU->SYSTICK_CUR.reg;
+	spi_tx_idx ^= 1u;
+	SPI_slave_arm_tx();
+	ticks += SysTick_elapsed(start);
+	
+	if (ticks > spi_swap_ticks_max)
+	{
+		spi_swap_ticks_max = ticks;
+	}
 }
+
+void Main_TaskLed(void)
+{
+	uint8 set_color[3];
+	uint8 brightness = 255;
 	
-void encoder_B_pos(void)
+	Wheel((((uint8) (EmoEnc_GetPos() >> 3)) % 255), set_color);
+	SetBrightness(set_color, brightness);
+	(void)Neopx_Write(set_color, 1u);
+}
+
+void Main_TaskTelem(void)
 {
-	if ((PORT->P2_DATA.reg & 0x1u) == 1)				// Check P2.0, if high increment, if low decrement
+	uint8 flags;
+	
+	/* Status changing slower than the SPI frames, packed here instead of in the DMA interrupt */
+	flags = 0u;
+	if (Emo_GetMotorState() == EMO_MOTOR_STATE_RUN)
 	{
-		eticks++;
+		flags |= SPIPROT_STATUS_RUN;
 	}
-	else
+	if (EmoPos_Ctrl.Enable != 0u)
+	{
+		flags |= SPIPROT_STATUS_POS_EN;
+	}
+	if (EmoPos_Ctrl.Hold != 0u)
+	{
+		flags |= SPIPROT_STATUS_POS_SETTLED;
+	}
+	if (FlightRec_Status.Cause != FLIGHTREC_CAUSE_NONE)
 	{
-		eticks--;
+		flags |= SPIPROT_STATUS_FREC_TRIG;
 	}
+	spi_status_flags = flags;
+	spi_motor_state = Emo_GetMotorState();
+	spi_mode = Emo_Status.Mode;
+	spi_fault = (Fault_Status.Active != 0u) ? 1u : 0u;
+	spi_cpu_load = Sched_Status.Load;
 }
 
+void Main_TaskDiag(void)
+{
+	/* Serviced only while the main loop keeps up, in the open window */
+	(void)WDT1_Service();
+}
+
+void Main_TaskSupply(void)
+{
+	/* ADC2 supply and temperature supervision, the limit interrupts trigger the flight recorder */
+	supply_vs_mv = ADC2_VS_Result_mV();
+	supply_vcp_mv = ADC2_VCP_Result_mV();
+	chip_temp_c = ADC2_Temp_Result_C();
+	if (supply_vs_mv < supply_vs_min_mv)
+	{
+		supply_vs_min_mv = supply_vs_mv;
+	}
+	if (supply_vcp_mv < supply_vcp_min_mv)
+	{
+		supply_vcp_min_mv = supply_vcp_mv;
+	}
+	if (chip_temp_c > chip_temp_max_c)
+	{
+		chip_temp_max_c = chip_temp_c;
+	}
+}
+
+uint32 SysTick_elapsed(uint32 start)
+{
+	uint32 now;
+	
+	/* SysTick counts down from the reload value */
+	now = CPU->SYSTICK_CUR.reg;
+	return (start >= now) ? (start - now) : ((start + CPU->SYSTICK_RL.reg + 1u) - now);
+}
+	
 void Poti_Handler(void)
 {
 	uint16 mV;
@@ -260,80 +755,9 @@ void Poti_Handler(void)
 	}
 }
 
-void Neopx_Write(uint8 *color_rgb)
-{
-	uint8 tmp_color[3];
-
-	tmp_color[0] = color_rgb[1];								//Account for RGB to GRB conversion (Neopixel specific)
-	tmp_color[1] = color_rgb[0];
-	tmp_color[2] = color_rgb[2];
-	memcpy(npx_data, tmp_color, 3);							//Load our RGB data to the cloud
-  
-  npx_index = 0;
-	npx_bit_count = 0;
-	
-  npx_current_byte = tmp_color[0];
-  
-  GPT12E->T3.reg = npx_T3_high_ticks[ (tmp_color[0] >> (sizeof(*tmp_color)*8 - 1)) ];	//color[0].bit0_high
-  GPT12E->T4.reg = npx_T3_low_ticks[ (tmp_color[0] >> (sizeof(*tmp_color)*8 - 1)) ];	//color[0].bit0_low
-	GPT12E->T2.reg = npx_T3_high_ticks[ ((tmp_color[0] & 0x40u) >> 6) ];						//Constant bit latch low time interval
-	GPT12E->T3CON.reg |= 0x440u;			//Set output latch and start timer				**** Both done in one operation with 0x440u
-}
-
-//void T2_Rising_Reload(void)
-//{
-//  if (npx_index >= 3)
-//	{
-//		GPT12E->T4.reg = 800;      												//Reset Latch low pulse
-//	}
-//	else
-//	{
-//		GPT12E->T4.reg = npx_T3_low_ticks[ (npx_current_byte >> (sizeof(npx_current_byte)*8 - 1)) ];	//Reload next low time
-//	}
-//  
-//}
-
-void T4_Falling_Reload(void)
-{
-	//GPT12E->T3CON.reg &= 0xFFFFFFBFu;		//Stop the timer
-	if (npx_bit_count >= 7)										//*1* If we reach end if byte, increase array index and reset data and count
-  {
-    npx_index++;
-		if (npx_index >= 3)														//*2* But if count overflows then configure timers for reset pulse
-		{
-			if (npx_index >= 5)																	//*3* Also if we already executed the reset pulse then stop the timer and leave
-			{
-				GPT12E->T3CON.reg &= 0xFFFFFFBFu;		//Stop the timer
-				GPT12E->T3CON.reg &= 0xFFFFFBFFu;		//Clear output latch **** Both could be done in one operation with 0xFFFFFBBFu
-				return;
-			}
-			else
-			{
-				GPT12E->T2.reg = 7;      									//Standard high duration preceding reset pulse (maybe needs to be shorter so as to not be interpreted by the neopixel as data)
-				GPT12E->T4.reg = 100;      								//Reset Latch low pulse
-				return;
-			}
-		}
-		else																					//*2* Else we carry on to the next data element and reset count
-		{    
-			npx_current_byte = npx_data[npx_index];
-			npx_bit_count = 0;
-		}
-  }
-	else																			//*1* Else we just increment and shift
-  {  
-		npx_bit_count++;
-		npx_current_byte <<= 1;
-	}
-		
-  GPT12E->T2.reg = npx_T3_high_ticks[ (npx_current_byte >> 7) ];	//Reload next high time
-	//GPT12E->T4.reg = npx_T3_low_ticks[ (npx_current_byte >> 7) ];	//Reload next low time
-	//GPT12E->T3CON.reg |= 0x40u;			//Restart timer
-}
-
 void HSV2RGB(double h, double s, double v, uint8 rgb[])
 {
-    double r, g, b;
+    double r = 0.0, g = 0.0, b = 0.0;
 
     int i = (int) (h * 6);
     double f = h * 6 - i;
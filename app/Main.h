@@ -43,6 +43,9 @@
 /*******************************************************************************
 **                      Global Function Declarations                          **
 *******************************************************************************/
+extern void Main_HandleSysTick(void);
+extern void Main_HandlePwmPeriod(void);
+extern void SPI_slave_latch(void);
 
 /*******************************************************************************
 **                      Global Inline Function Definitions                    **
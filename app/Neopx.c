@@ -0,0 +1,355 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Bit timing moved from Main.c, SSC1 + DMA backend added
+ * V0.1.1: 2026-10-17: SSC1 bit 1 pattern 1100b for the WS2812 low time after a 1,
+ *                      fixed DMA destination address
+ * V0.1.2: 2026-10-18: at() placement of the DMA entry for ARMCC only
+ * V0.1.3: 2026-10-18: SSC1 pacing with T4 as reload register, T2 left to the encoder
+ */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include "tle_device.h"
+#include <string.h>
+#include "Neopx.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+#if ((NEOPX_SSC_EN == 0u) && (NEOPX_GPT12E_T2_EN == 0u))
+#error "The GPT12E bit timing needs T2, NEOPX_GPT12E_T2_EN = 0 needs NEOPX_SSC_EN = 1"
+#endif
+
+#if (NEOPX_SSC_EN == 1u)
+#ifndef DMA_EN
+#error "DMA_EN of dma_defines.h is needed to check that DMA channel 12 is free"
+#endif
+#if ((DMA_EN & (1u << DMA_CH12)) != 0u)
+#error "DMA channel 12 is used by the Neopixel backend and must not be configured in dma_defines.h"
+#endif
+
+/* SSC1 CON in programming mode: BM (bits 0..3) shares the position of BC, HB is bit 4 */
+#define NEOPX_SSC1_CON_HB_Msk (0x10u)
+
+/* SSC1 master, 16 bit, MSB first, baud rate = fSYS / (2 * (BR + 1)) = 3.33 MHz (300 ns per SSC bit) */
+#define NEOPX_SSC1_CON (SSC1_CON_BC_Msk | NEOPX_SSC1_CON_HB_Msk | SSC1_CON_MS_Msk)
+#define NEOPX_SSC1_BR (5u)
+
+/* SSC words per LED: 24 WS2812 bits of 4 SSC bits each */
+#define NEOPX_WORDS_PER_LED (6u)
+
+/* DMA request period from GPT12E T3 underflow [GPT1 ticks, 10 MHz]: (49 + 1) = 5.0 us,
+ * slightly longer than one SSC word (4.8 us), the difference extends the low time of every 4th bit */
+#define NEOPX_T3_RELOAD (49u)
+
+/* T2 or T4 in reload mode, reloads T3 on any transition of T3OTL (every T3 underflow) */
+#define NEOPX_T2CON_RELOAD ((4u << GPT12E_T2CON_T2M_Pos) | (7u << GPT12E_T2CON_T2I_Pos))
+#define NEOPX_T4CON_RELOAD ((4u << GPT12E_T4CON_T4M_Pos) | (7u << GPT12E_T4CON_T4I_Pos))
+
+/* PL230 increment code for a fixed address (0 is a byte increment) */
+#define NEOPX_DMA_INC_NONE (3u)
+
+/* GPT12E T3 as request source for DMA channel 12 */
+#define NEOPX_DMASRCSEL2_GPT12_T3 (1u)
+
+/* Data line MTSR_1 on P0.2 */
+#define NEOPX_P0_PIN (2u)
+#endif
+
+/*******************************************************************************
+**                      Private Variable Definitions                          **
+*******************************************************************************/
+#if (NEOPX_SSC_EN == 1u)
+/* SSC words of the frame */
+static uint16 Neopx_lBuf[NEOPX_NUM_LEDS * NEOPX_WORDS_PER_LED];
+
+/* Primary control entry of DMA channel 12, not set up by DMA_Init; GCC has no
+ * at(), the host build places the section by name (sim/Sim.ld) */
+#if defined(__CC_ARM)
+static TDMA_Entry Neopx_lDmaEntry __attribute__((at(DMA_BASE_ADDR + DMA_CH12 * sizeof(TDMA_Entry)),used));
+#else
+static TDMA_Entry Neopx_lDmaEntry __attribute__((used));
+#endif
+
+/* Frame transfer in progress */
+static volatile uint8 Neopx_lBusy;
+#else
+#define NCOLORS 3
+static uint8 npx_data[NCOLORS];
+static uint8 npx_index;
+static uint8 npx_current_byte;
+static uint8 npx_bit_count;                                          
+
+// Thank you so much @bigjosh2 for allowing me to have a bit more headroom in my
+// unoptimized interrupts!
+// https://wp.josh.com/2014/05/13/ws2812-neopixels-are-not-so-finicky-once-you-get-to-know-them/																					
+static uint16 npx_T3_high_ticks[2] = {2, 7};    //@10MHz GPTclk, ~0.3 and ~0.6 us 	| Corrected a bit for internal timings
+static uint16 npx_T3_low_ticks[2] = {49, 49};    //@10MHz GPTclk, 4.9 us						| Max is 5 us																	
+#endif
+
+/*******************************************************************************
+**                      Private Constant Definitions                          **
+*******************************************************************************/
+#if (NEOPX_SSC_EN == 1u)
+/* SSC word for 4 WS2812 bits (one nibble, MSB first): 0 = 1000b (300 ns high,
+ * 900 ns low), 1 = 1100b (600 ns high, 600 ns low), 1.2 us per WS2812 bit.
+ * Checked against the WS2812 timing by test/TestNeopx.c */
+static const uint16 Neopx_lNibbleWords[16] =
+{
+  0x8888u, 0x888Cu, 0x88C8u, 0x88CCu, 0x8C88u, 0x8C8Cu, 0x8CC8u, 0x8CCCu,
+  0xC888u, 0xC88Cu, 0xC8C8u, 0xC8CCu, 0xCC88u, 0xCC8Cu, 0xCCC8u, 0xCCCCu
+};
+#endif
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+#if (NEOPX_SSC_EN == 1u)
+/** \brief Initializes SSC1, GPT12E T3 and DMA channel 12 for the LED chain.
+ *
+ * \return None
+ *
+ * \ingroup neopx_api
+ */
+void Neopx_Init(void)
+{
+  /* SSC1 master on MTSR_1 (P0.2) */
+  SSC1->CON.reg = (uint16)NEOPX_SSC1_CON;
+  SSC1->BR.reg = (uint16)NEOPX_SSC1_BR;
+  SSC1->CON.reg = (uint16)(NEOPX_SSC1_CON | SSC1_CON_EN_Msk);
+  PORT->P0_ALTSEL0.reg &= (uint8)~(1u << NEOPX_P0_PIN);
+  PORT->P0_ALTSEL1.reg |= (uint8)(1u << NEOPX_P0_PIN);
+  PORT->P0_DIR.reg |= (uint8)(1u << NEOPX_P0_PIN);
+
+#if (NEOPX_GPT12E_T2_EN == 1u)
+  /* T3 counts down and is reloaded from T2 on every underflow, T4 without function */
+  GPT12E->T4CON.reg = 0u;
+  GPT12E->T3CON.reg = (uint16)((GPT12E->T3CON.reg & GPT12E_T3CON_BPS1_Msk) | GPT12E_T3CON_T3UD_Msk);
+  GPT12E->T2CON.reg = (uint16)NEOPX_T2CON_RELOAD;
+  GPT12E->T2.reg = (uint16)NEOPX_T3_RELOAD;
+#else
+  /* T3 counts down and is reloaded from T4 on every underflow, no T4 interrupt per reload */
+  SCU->GPT12IEN.reg &= (uint8)~SCU_GPT12IEN_T4IE_Msk;
+  GPT12E->T3CON.reg = (uint16)((GPT12E->T3CON.reg & GPT12E_T3CON_BPS1_Msk) | GPT12E_T3CON_T3UD_Msk);
+  GPT12E->T4CON.reg = (uint16)NEOPX_T4CON_RELOAD;
+  GPT12E->T4.reg = (uint16)NEOPX_T3_RELOAD;
+#endif
+
+  /* T3 underflow requests DMA channel 12, interrupt after the last word */
+  SCU->DMASRCSEL2.reg = (uint8)NEOPX_DMASRCSEL2_GPT12_T3;
+  SCU->DMAIEN2.reg |= (uint8)SCU_DMAIEN2_GPT12IE_Msk;
+  CPU->NVIC_ISER0.reg = CPU_NVIC_ISER0_Int_DMA_Msk;
+
+  Neopx_lBusy = 0u;
+
+} /* End of Neopx_Init */
+
+/** \brief Writes colors to the LED chain.
+ *
+ * Colors are encoded to SSC words and streamed by DMA, the CPU is only
+ * involved in the completion interrupt.
+ *
+ * \param[in] pRgb Colors, 3 bytes (red, green, blue) per LED
+ * \param[in] NumLeds Number of LEDs, limited to NEOPX_NUM_LEDS
+ * \return false if the last frame is still being transferred
+ *
+ * \note Frames have to be at least 300 us apart for the LEDs to latch.
+ *
+ * \ingroup neopx_api
+ */
+bool Neopx_Write(const uint8 *pRgb, uint8 NumLeds)
+{
+  uint16 *pWord;
+  uint8 Led;
+  uint8 Byte;
+  uint8 ByteIdx;
+
+  if(Neopx_lBusy != 0u)
+  {
+    return false;
+  }
+
+  if(NumLeds > NEOPX_NUM_LEDS)
+  {
+    NumLeds = (uint8)NEOPX_NUM_LEDS;
+  }
+
+  /* Encode in GRB order, two SSC words per byte */
+  pWord = Neopx_lBuf;
+  for(Led = 0u; Led < NumLeds; Led++)
+  {
+    for(ByteIdx = 0u; ByteIdx < 3u; ByteIdx++)
+    {
+      Byte = pRgb[(ByteIdx == 0u) ? 1u : ((ByteIdx == 1u) ? 0u : 2u)];
+      *pWord++ = Neopx_lNibbleWords[Byte >> 4u];
+      *pWord++ = Neopx_lNibbleWords[Byte & 0xFu];
+    }
+    pRgb += 3;
+  }
+
+  /* One SSC word per T3 underflow (DMA_Setup_Channel end pointers only fit byte transfers) */
+  (void)DMA_Task_Set(&Neopx_lDmaEntry, DMA_Cycle_Type_Basic, 0u, (uint32)Neopx_lBuf, (uint32)&SSC1->TB.reg,
+                     (uint32)NumLeds * NEOPX_WORDS_PER_LED, DMA_16Bit_Transfer, DMA_Src_Inc);
+  /* DMA_Task_Set codes the fixed destination as DMA_No_Inc, a byte increment */
+  Neopx_lDmaEntry.Control.bit.Dst_Inc = NEOPX_DMA_INC_NONE;
+  DMA_Channel_Enable_Set(DMA_MASK_CH12);
+
+  /* Start pacing, first word after one period */
+  Neopx_lBusy = 1u;
+  GPT12E->T3.reg = (uint16)NEOPX_T3_RELOAD;
+  GPT12E->T3CON.reg |= (uint16)GPT12E_T3CON_T3R_Msk;
+
+  return true;
+} /* End of Neopx_Write */
+
+/** \brief Handles DMA channel 12 interrupt after the last word of a frame.
+ *
+ * \return None
+ *
+ * \ingroup neopx_api
+ */
+void Neopx_HandleDmaDone(void)
+{
+  /* Last word is in SSC1, stop DMA requests */
+  GPT12E->T3CON.reg &= (uint16)~GPT12E_T3CON_T3R_Msk;
+  Neopx_lBusy = 0u;
+
+} /* End of Neopx_HandleDmaDone */
+
+/** \brief Handles GPT12E T4 interrupt, without function for the SSC1 backend.
+ *
+ * \return None
+ *
+ * \ingroup neopx_api
+ */
+void T4_Falling_Reload(void)
+{
+} /* End of T4_Falling_Reload */
+
+#else
+/** \brief Initializes the bit timing, T3 stopped with output latch low.
+ *
+ * \return None
+ *
+ * \ingroup neopx_api
+ */
+void Neopx_Init(void)
+{
+	GPT12E->T3CON.reg &= 0xFFFFFBBFu;			//Stop timer and clear output latch
+} /* End of Neopx_Init */
+
+bool Neopx_Write(const uint8 *pRgb, uint8 NumLeds)
+{
+	uint8 tmp_color[3];
+
+	(void)NumLeds;												//Bit timing drives the first LED only
+	tmp_color[0] = pRgb[1];								//Account for RGB to GRB conversion (Neopixel specific)
+	tmp_color[1] = pRgb[0];
+	tmp_color[2] = pRgb[2];
+	memcpy(npx_data, tmp_color, 3);							//Load our RGB data to the cloud
+  
+  npx_index = 0;
+	npx_bit_count = 0;
+	
+  npx_current_byte = tmp_color[0];
+  
+  GPT12E->T3.reg = npx_T3_high_ticks[ (tmp_color[0] >> (sizeof(*tmp_color)*8 - 1)) ];	//color[0].bit0_high
+  GPT12E->T4.reg = npx_T3_low_ticks[ (tmp_color[0] >> (sizeof(*tmp_color)*8 - 1)) ];	//color[0].bit0_low
+	GPT12E->T2.reg = npx_T3_high_ticks[ ((tmp_color[0] & 0x40u) >> 6) ];						//Constant bit latch low time interval
+	GPT12E->T3CON.reg |= 0x440u;			//Set output latch and start timer				**** Both done in one operation with 0x440u
+	return true;
+}
+
+//void T2_Rising_Reload(void)
+//{
+//  if (npx_index >= 3)
+//	{
+//		GPT12E->T4.reg = 800;      												//Reset Latch low pulse
+//	}
+//	else
+//	{
+//		GPT12E->T4.reg = npx_T3_low_ticks[ (npx_current_byte >> (sizeof(npx_current_byte)*8 - 1)) ];	//Reload next low time
+//	}
+//  
+//}
+
+void T4_Falling_Reload(void)
+{
+	//GPT12E->T3CON.reg &= 0xFFFFFFBFu;		//Stop the timer
+	if (npx_bit_count >= 7)										//*1* If we reach end if byte, increase array index and reset data and count
+  {
+    npx_index++;
+		if (npx_index >= 3)														//*2* But if count overflows then configure timers for reset pulse
+		{
+			if (npx_index >= 5)																	//*3* Also if we already executed the reset pulse then stop the timer and leave
+			{
+				GPT12E->T3CON.reg &= 0xFFFFFFBFu;		//Stop the timer
+				GPT12E->T3CON.reg &= 0xFFFFFBFFu;		//Clear output latch **** Both could be done in one operation with 0xFFFFFBBFu
+				return;
+			}
+			else
+			{
+				GPT12E->T2.reg = 7;      									//Standard high duration preceding reset pulse (maybe needs to be shorter so as to not be interpreted by the neopixel as data)
+				GPT12E->T4.reg = 100;      								//Reset Latch low pulse
+				return;
+			}
+		}
+		else																					//*2* Else we carry on to the next data element and reset count
+		{    
+			npx_current_byte = npx_data[npx_index];
+			npx_bit_count = 0;
+		}
+  }
+	else																			//*1* Else we just increment and shift
+  {  
+		npx_bit_count++;
+		npx_current_byte <<= 1;
+	}
+		
+  GPT12E->T2.reg = npx_T3_high_ticks[ (npx_current_byte >> 7) ];	//Reload next high time
+	//GPT12E->T4.reg = npx_T3_low_ticks[ (npx_current_byte >> 7) ];	//Reload next low time
+	//GPT12E->T3CON.reg |= 0x40u;			//Restart timer
+}
+
+/** \brief Handles DMA channel 12 interrupt, not used by the bit timing backend.
+ *
+ * \return None
+ *
+ * \ingroup neopx_api
+ */
+void Neopx_HandleDmaDone(void)
+{
+} /* End of Neopx_HandleDmaDone */
+#endif
@@ -0,0 +1,80 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/* See Neopx.c */
+
+#ifndef NEOPX_H
+#define NEOPX_H
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include <tle_device.h>
+
+/*******************************************************************************
+**                      Global Macro Definitions                              **
+*******************************************************************************/
+/* WS2812 backend: 1 = SSC1 bit patterns streamed by DMA channel 12 paced by
+ * GPT12E T3, data line on MTSR_1 (P0.2); 0 = GPT12E T2/T3/T4 bit timing with
+ * one interrupt per bit, data line on T3OUT (P1.2), single LED only.
+ * May be set in the project C defines */
+#ifndef NEOPX_SSC_EN
+#define NEOPX_SSC_EN (0u)
+#endif
+
+/* GPT12E T2 used by the backend: 1 = reload of T3 for the SSC1 pacing, bit
+ * high time for the GPT12E bit timing; 0 = SSC1 pacing with T4 as reload
+ * register, T2 is free for the encoder (emo/EmoEnc.h), needs NEOPX_SSC_EN = 1.
+ * May be set in the project C defines */
+#ifndef NEOPX_GPT12E_T2_EN
+#define NEOPX_GPT12E_T2_EN (1u)
+#endif
+
+/* Number of LEDs in the chain, may be set in the project C defines */
+#ifndef NEOPX_NUM_LEDS
+#define NEOPX_NUM_LEDS (1u)
+#endif
+
+/*******************************************************************************
+**                      Global Function Declarations                          **
+*******************************************************************************/
+extern void Neopx_Init(void);
+extern bool Neopx_Write(const uint8 *pRgb, uint8 NumLeds);
+extern void Neopx_HandleDmaDone(void);
+extern void T4_Falling_Reload(void);
+
+/*******************************************************************************
+**                      Global Inline Function Definitions                    **
+*******************************************************************************/
+
+
+#endif /* NEOPX_H */
@@ -0,0 +1,228 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, cooperative tick driven scheduler
+ * V0.2.0: 2026-10-17: Timebase_GetUs locks itself
+ */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include "Sched.h"
+#include "Timebase.h"
+
+/*******************************************************************************
+**                      Global Variable Definitions                           **
+*******************************************************************************/
+volatile TSched_Status Sched_Status;
+
+/*******************************************************************************
+**                      Private Function Declarations                         **
+*******************************************************************************/
+static void Sched_lIdle(void);
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+/** \brief Initializes the scheduler.
+ *
+ * \param[in] pTasks Task table, in order of precedence
+ * \param NumTasks Number of tasks, limited to SCHED_TASK_MAX
+ *
+ * \return None
+ *
+ * \ingroup sched_api
+ */
+void Sched_Init(const TSched_Task *pTasks, uint8 NumTasks)
+{
+  uint32 i;
+  uint32 PriMask;
+
+  if (NumTasks > SCHED_TASK_MAX)
+  {
+    NumTasks = SCHED_TASK_MAX;
+  }
+
+  PriMask = __get_PRIMASK();
+  __disable_irq();
+  for (i = 0u; i < NumTasks; i++)
+  {
+    Sched_Status.Task[i].Ctr = pTasks[i].OffsetMs + 1u;
+    Sched_Status.Task[i].Ready = 0u;
+    Sched_Status.Task[i].Running = 0u;
+    Sched_Status.Task[i].Runs = 0u;
+    Sched_Status.Task[i].Overruns = 0u;
+    Sched_Status.Task[i].TimeLastUs = 0u;
+    Sched_Status.Task[i].TimeMaxUs = 0u;
+  }
+  Sched_Status.pTasks = pTasks;
+  Sched_Status.NumTasks = NumTasks;
+  Sched_Status.Load = 0u;
+  Sched_Status.LoadMax = 0u;
+  Sched_Status.IdleUs = 0u;
+  Sched_Status.WindowStartUs = Timebase_GetUs();
+  __set_PRIMASK(PriMask);
+
+} /* End of Sched_Init */
+
+
+/** \brief Releases the tasks that are due.
+ *
+ * \return None
+ *
+ * \note Called every ms from Main_HandleSysTick.
+ *
+ * \ingroup sched_api
+ */
+void Sched_Tick(void)
+{
+  uint32 i;
+
+  for (i = 0u; i < Sched_Status.NumTasks; i++)
+  {
+    Sched_Status.Task[i].Ctr--;
+    if (Sched_Status.Task[i].Ctr == 0u)
+    {
+      Sched_Status.Task[i].Ctr = Sched_Status.pTasks[i].PeriodMs;
+      if ((Sched_Status.Task[i].Ready != 0u) || (Sched_Status.Task[i].Running != 0u))
+      {
+        Sched_Status.Task[i].Overruns++;
+      }
+      Sched_Status.Task[i].Ready = 1u;
+    }
+  }
+
+} /* End of Sched_Tick */
+
+
+/** \brief Runs released tasks and sleeps in between, does not return.
+ *
+ * Tasks run to completion in table order, a task released again before it
+ * started runs once. The CPU waits for an interrupt when nothing is released,
+ * the time spent there gives the CPU load.
+ *
+ * \return None
+ *
+ * \ingroup sched_api
+ */
+void Sched_Run(void)
+{
+  uint32 i;
+  uint32 PriMask;
+  uint32 Ready;
+  uint32 Start;
+  uint32 Time;
+  uint32 Window;
+
+  for (;;)
+  {
+    for (i = 0u; i < Sched_Status.NumTasks; i++)
+    {
+      PriMask = __get_PRIMASK();
+      __disable_irq();
+      Ready = Sched_Status.Task[i].Ready;
+      Sched_Status.Task[i].Ready = 0u;
+      Sched_Status.Task[i].Running = (uint8)Ready;
+      __set_PRIMASK(PriMask);
+
+      if (Ready != 0u)
+      {
+        Start = Timebase_GetUs();
+        Sched_Status.pTasks[i].pFunc();
+        Time = Timebase_GetUs() - Start;
+        Sched_Status.Task[i].Running = 0u;
+
+        if (Time > 0xFFFFu)
+        {
+          Time = 0xFFFFu;
+        }
+        Sched_Status.Task[i].TimeLastUs = (uint16)Time;
+        if (Time > Sched_Status.Task[i].TimeMaxUs)
+        {
+          Sched_Status.Task[i].TimeMaxUs = (uint16)Time;
+        }
+        Sched_Status.Task[i].Runs++;
+      }
+    }
+
+    Sched_lIdle();
+
+    /* CPU load of the window, interrupts count as busy */
+    Window = Timebase_GetUs() - Sched_Status.WindowStartUs;
+    if (Window >= (SCHED_LOAD_WINDOW_MS * 1000u))
+    {
+      Sched_Status.Load = (Sched_Status.IdleUs >= Window) ? 0u :
+                          (uint8)(((Window - Sched_Status.IdleUs) * 100u) / Window);
+      if (Sched_Status.Load > Sched_Status.LoadMax)
+      {
+        Sched_Status.LoadMax = Sched_Status.Load;
+      }
+      Sched_Status.WindowStartUs += Window;
+      Sched_Status.IdleUs = 0u;
+    }
+  }
+
+} /* End of Sched_Run */
+
+/*******************************************************************************
+**                      Private Function Definitions                          **
+*******************************************************************************/
+/** \brief Waits for an interrupt if no task is released.
+ *
+ * WFI wakes up on a pending interrupt also with interrupts disabled, so the
+ * idle time is taken before the interrupt runs and does not include it.
+ *
+ * \return None
+ */
+static void Sched_lIdle(void)
+{
+  uint32 i;
+  uint32 PriMask;
+  uint32 Ready;
+  uint32 Start;
+
+  PriMask = __get_PRIMASK();
+  __disable_irq();
+  Ready = 0u;
+  for (i = 0u; i < Sched_Status.NumTasks; i++)
+  {
+    Ready |= Sched_Status.Task[i].Ready;
+  }
+  if (Ready == 0u)
+  {
+    Start = Timebase_GetUs();
+    __WFI();
+    Sched_Status.IdleUs += Timebase_GetUs() - Start;
+  }
+  __set_PRIMASK(PriMask);
+
+} /* End of Sched_lIdle */
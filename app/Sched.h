@@ -0,0 +1,99 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/* See Sched.c */
+
+#ifndef SCHED_H
+#define SCHED_H
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include <tle_device.h>
+
+/*******************************************************************************
+**                      Global Macro Definitions                              **
+*******************************************************************************/
+/* Maximum number of tasks */
+#define SCHED_TASK_MAX (8u)
+
+/* CPU load averaging window [ms] */
+#define SCHED_LOAD_WINDOW_MS (100u)
+
+/*******************************************************************************
+**                      Global Type Definitions                               **
+*******************************************************************************/
+/** \brief Task configuration */
+typedef struct
+{
+  void (*pFunc)(void);  /**< \brief Task function, runs to completion in the main loop */
+  uint16 PeriodMs;      /**< \brief Release period [ms] */
+  uint16 OffsetMs;      /**< \brief First release [ms], spreads tasks with a common period */
+} TSched_Task;
+
+/** \brief Task status */
+typedef struct
+{
+  uint16 Ctr;           /**< \brief Time to the next release [ms] */
+  uint8 Ready;          /**< \brief Released, not yet started */
+  uint8 Running;        /**< \brief Started, not yet finished */
+  uint16 Runs;          /**< \brief Completed runs */
+  uint16 Overruns;      /**< \brief Releases while the previous one was pending or running */
+  uint16 TimeLastUs;    /**< \brief Run time of the last run [us] */
+  uint16 TimeMaxUs;     /**< \brief Longest run time [us] */
+} TSched_TaskStatus;
+
+/** \brief Scheduler status */
+typedef struct
+{
+  const TSched_Task *pTasks;                /**< \brief Task table */
+  uint8 NumTasks;                           /**< \brief Number of tasks */
+  uint8 Load;                               /**< \brief CPU load of the last window [%] */
+  uint8 LoadMax;                            /**< \brief Highest load of a window [%] */
+  uint32 WindowStartUs;                     /**< \brief Start of the current load window [us] */
+  uint32 IdleUs;                            /**< \brief Idle time in the current load window [us] */
+  TSched_TaskStatus Task[SCHED_TASK_MAX];   /**< \brief Status per task */
+} TSched_Status;
+
+/*******************************************************************************
+**                      Global Variable Declarations                          **
+*******************************************************************************/
+extern volatile TSched_Status Sched_Status;
+
+/*******************************************************************************
+**                      Global Function Declarations                          **
+*******************************************************************************/
+extern void Sched_Init(const TSched_Task *pTasks, uint8 NumTasks);
+extern void Sched_Tick(void);
+extern void Sched_Run(void);
+
+
+#endif /* SCHED_H */
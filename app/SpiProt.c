@@ -0,0 +1,409 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, protocol version 1
+ * V0.2.0: 2026-10-17: Protocol version 2, sample time in slave frames
+ * V0.3.0: 2026-10-17: Protocol version 3, flight recorder dump frames
+ * V0.4.0: 2026-10-17: Protocol version 4, fault frames and fault flag in telemetry
+ * V0.5.0: 2026-10-17: Protocol version 5, CPU load in telemetry
+ * V0.6.0: 2026-10-17: Protocol version 6, interrupt handler profile frames
+ * V0.7.0: 2026-10-17: Protocol version 7, stall events in fault frames
+ * V0.8.0: 2026-10-17: Protocol version 8, Hall sector calibration command and state
+ * V0.9.0: 2026-10-17: Protocol version 9, samples of the previous chip select
+ */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include "SpiProt.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+/* CRC-16/CCITT-FALSE: polynomial 0x1021, initial value 0xFFFF, no reflection, no final XOR */
+#define SPIPROT_CRC_INIT (0xFFFFu)
+
+#if ((SPIPROT_DUMP_RECORDS + (SPIPROT_DUMP_NUM_RECORDS * SPIPROT_DUMP_RECORD_WORDS)) > SPIPROT_WORD_CRC)
+#error "Dump records do not fit into the frame"
+#endif
+
+/*******************************************************************************
+**                      Private Constant Definitions                          **
+*******************************************************************************/
+/* CRC of a nibble in the upper 4 bits of the CRC register */
+static const uint16 SpiProt_lCrcTab[16] =
+{
+  0x0000u, 0x1021u, 0x2042u, 0x3063u, 0x4084u, 0x50A5u, 0x60C6u, 0x70E7u,
+  0x8108u, 0x9129u, 0xA14Au, 0xB16Bu, 0xC18Cu, 0xD1ADu, 0xE1CEu, 0xF1EFu
+};
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+/** \brief Calculates the CRC-16/CCITT-FALSE of 16 bit words.
+ *
+ * Each word is processed high byte first, as shifted out by the SSC.
+ *
+ * \param[in] pWords Words
+ * \param[in] NumWords Number of words
+ * \return CRC
+ *
+ * \ingroup spiprot_api
+ */
+uint16 SpiProt_Crc16(const uint16 *pWords, uint32 NumWords)
+{
+  uint32 Crc;
+  uint32 Word;
+  uint32 Nibble;
+
+  Crc = SPIPROT_CRC_INIT;
+  while(NumWords > 0u)
+  {
+    /* Four nibbles per word, MSB first */
+    Word = *pWords++;
+    for(Nibble = 0u; Nibble < 4u; Nibble++)
+    {
+      Crc = ((Crc << 4u) & 0xFFFFu) ^ SpiProt_lCrcTab[((Crc >> 12u) ^ (Word >> 12u)) & 0xFu];
+      Word <<= 4u;
+    }
+    NumWords--;
+  }
+
+  return (uint16)Crc;
+} /* End of SpiProt_Crc16 */
+
+/** \brief Encodes a master frame (SPI master side).
+ *
+ * \param[out] pFrame Frame of SPIPROT_FRAME_WORDS words
+ * \param[in] pCmd Command
+ * \return None
+ *
+ * \ingroup spiprot_api
+ */
+void SpiProt_EncodeCmd(uint16 *pFrame, const TSpiProt_Cmd *pCmd)
+{
+  uint32 i;
+
+  pFrame[SPIPROT_WORD_HEADER] = SPIPROT_HEADER;
+  pFrame[SPIPROT_WORD_ID] = (uint16)(((uint16)pCmd->Seq << 8u) | pCmd->CmdId);
+  for(i = 0u; i < SPIPROT_PAYLOAD_WORDS; i++)
+  {
+    pFrame[SPIPROT_WORD_PAYLOAD + i] = pCmd->Payload[i];
+  }
+  pFrame[SPIPROT_WORD_CRC] = SpiProt_Crc16(pFrame, SPIPROT_WORD_CRC);
+
+} /* End of SpiProt_EncodeCmd */
+
+/** \brief Decodes a master frame.
+ *
+ * \param[in] pFrame Frame of SPIPROT_FRAME_WORDS words
+ * \param[out] pCmd Command, only written for a valid frame
+ * \return true if header and CRC are valid
+ *
+ * \note The command ID is not checked.
+ *
+ * \ingroup spiprot_api
+ */
+bool SpiProt_DecodeCmd(const uint16 *pFrame, TSpiProt_Cmd *pCmd)
+{
+  uint32 i;
+
+  if((pFrame[SPIPROT_WORD_HEADER] != SPIPROT_HEADER) ||
+     (pFrame[SPIPROT_WORD_CRC] != SpiProt_Crc16(pFrame, SPIPROT_WORD_CRC)))
+  {
+    return false;
+  }
+
+  pCmd->Seq = (uint8)(pFrame[SPIPROT_WORD_ID] >> 8u);
+  pCmd->CmdId = (uint8)pFrame[SPIPROT_WORD_ID];
+  for(i = 0u; i < SPIPROT_PAYLOAD_WORDS; i++)
+  {
+    pCmd->Payload[i] = pFrame[SPIPROT_WORD_PAYLOAD + i];
+  }
+
+  return true;
+} /* End of SpiProt_DecodeCmd */
+
+/** \brief Encodes a slave frame.
+ *
+ * \param[out] pFrame Frame of SPIPROT_FRAME_WORDS words
+ * \param[in] pTelem Telemetry
+ * \return None
+ *
+ * \ingroup spiprot_api
+ */
+void SpiProt_EncodeTelem(uint16 *pFrame, const TSpiProt_Telem *pTelem)
+{
+  pFrame[SPIPROT_WORD_HEADER] = SPIPROT_HEADER;
+  pFrame[SPIPROT_WORD_ID] = (uint16)(((uint16)pTelem->Seq << 8u) | pTelem->Status);
+  pFrame[SPIPROT_TELEM_TIME_HI] = (uint16)(pTelem->Time >> 16u);
+  pFrame[SPIPROT_TELEM_TIME_LO] = (uint16)pTelem->Time;
+  pFrame[SPIPROT_TELEM_POS_HI] = (uint16)((uint32)pTelem->Pos >> 16u);
+  pFrame[SPIPROT_TELEM_POS_LO] = (uint16)pTelem->Pos;
+  pFrame[SPIPROT_TELEM_SPEED] = (uint16)pTelem->Speed;
+  pFrame[SPIPROT_TELEM_CURRENT] = (uint16)pTelem->Current;
+  pFrame[SPIPROT_TELEM_DUTY] = pTelem->Duty;
+  pFrame[SPIPROT_TELEM_STATE] = (uint16)(((uint16)pTelem->MotorState << 8u) | pTelem->Mode |
+                                         ((pTelem->Fault != 0u) ? SPIPROT_STATE_FAULT : 0u));
+  pFrame[SPIPROT_TELEM_POS_ERR] = (uint16)pTelem->PosErr;
+  pFrame[SPIPROT_TELEM_FRAMES] = pTelem->FrameCtr;
+  pFrame[SPIPROT_TELEM_LOAD] = (uint16)(((uint16)pTelem->CpuLoad << 8u) | pTelem->ErrCtr);
+  pFrame[SPIPROT_WORD_CRC] = SpiProt_Crc16(pFrame, SPIPROT_WORD_CRC);
+
+} /* End of SpiProt_EncodeTelem */
+
+/** \brief Decodes a slave frame (SPI master side).
+ *
+ * \param[in] pFrame Frame of SPIPROT_FRAME_WORDS words
+ * \param[out] pTelem Telemetry, only written for a valid frame
+ * \return true if header and CRC are valid
+ *
+ * \ingroup spiprot_api
+ */
+bool SpiProt_DecodeTelem(const uint16 *pFrame, TSpiProt_Telem *pTelem)
+{
+  if((pFrame[SPIPROT_WORD_HEADER] != SPIPROT_HEADER) ||
+     ((pFrame[SPIPROT_WORD_ID] & (SPIPROT_STATUS_DUMP | SPIPROT_STATUS_FAULTS)) != 0u) ||
+     (pFrame[SPIPROT_WORD_CRC] != SpiProt_Crc16(pFrame, SPIPROT_WORD_CRC)))
+  {
+    return false;
+  }
+
+  pTelem->Seq = (uint8)(pFrame[SPIPROT_WORD_ID] >> 8u);
+  pTelem->Status = (uint8)pFrame[SPIPROT_WORD_ID];
+  pTelem->Time = ((uint32)pFrame[SPIPROT_TELEM_TIME_HI] << 16u) | pFrame[SPIPROT_TELEM_TIME_LO];
+  pTelem->Pos = (sint32)(((uint32)pFrame[SPIPROT_TELEM_POS_HI] << 16u) | pFrame[SPIPROT_TELEM_POS_LO]);
+  pTelem->Speed = (sint16)pFrame[SPIPROT_TELEM_SPEED];
+  pTelem->Current = (sint16)pFrame[SPIPROT_TELEM_CURRENT];
+  pTelem->Duty = pFrame[SPIPROT_TELEM_DUTY];
+  pTelem->MotorState = (uint8)(pFrame[SPIPROT_TELEM_STATE] >> 8u);
+  pTelem->Mode = (uint8)((uint8)pFrame[SPIPROT_TELEM_STATE] & (uint8)~SPIPROT_STATE_FAULT);
+  pTelem->Fault = ((pFrame[SPIPROT_TELEM_STATE] & SPIPROT_STATE_FAULT) != 0u) ? 1u : 0u;
+  pTelem->PosErr = (sint16)pFrame[SPIPROT_TELEM_POS_ERR];
+  pTelem->FrameCtr = pFrame[SPIPROT_TELEM_FRAMES];
+  pTelem->ErrCtr = (uint8)pFrame[SPIPROT_TELEM_LOAD];
+  pTelem->CpuLoad = (uint8)(pFrame[SPIPROT_TELEM_LOAD] >> 8u);
+
+  return true;
+} /* End of SpiProt_DecodeTelem */
+
+/** \brief Encodes a slave dump frame.
+ *
+ * \param[out] pFrame Frame of SPIPROT_FRAME_WORDS words
+ * \param[in] pDump Flight recorder records
+ * \return None
+ *
+ * \ingroup spiprot_api
+ */
+void SpiProt_EncodeDump(uint16 *pFrame, const TSpiProt_Dump *pDump)
+{
+  uint32 i;
+  uint32 j;
+
+  pFrame[SPIPROT_WORD_HEADER] = SPIPROT_HEADER;
+  pFrame[SPIPROT_WORD_ID] = (uint16)(((uint16)pDump->Seq << 8u) | pDump->Status | SPIPROT_STATUS_DUMP);
+  pFrame[SPIPROT_DUMP_INFO] = (uint16)(((uint16)pDump->Cause << 8u) | pDump->Frozen);
+  pFrame[SPIPROT_DUMP_INDEX] = pDump->Index;
+  pFrame[SPIPROT_DUMP_COUNT] = pDump->Count;
+  for(i = 0u; i < SPIPROT_DUMP_NUM_RECORDS; i++)
+  {
+    for(j = 0u; j < SPIPROT_DUMP_RECORD_WORDS; j++)
+    {
+      pFrame[SPIPROT_DUMP_RECORDS + (i * SPIPROT_DUMP_RECORD_WORDS) + j] = pDump->Rec[i][j];
+    }
+  }
+  pFrame[SPIPROT_WORD_CRC] = SpiProt_Crc16(pFrame, SPIPROT_WORD_CRC);
+
+} /* End of SpiProt_EncodeDump */
+
+/** \brief Decodes a slave dump frame (SPI master side).
+ *
+ * \param[in] pFrame Frame of SPIPROT_FRAME_WORDS words
+ * \param[out] pDump Flight recorder records, only written for a valid frame
+ * \return true if header, CRC and frame type are valid
+ *
+ * \ingroup spiprot_api
+ */
+bool SpiProt_DecodeDump(const uint16 *pFrame, TSpiProt_Dump *pDump)
+{
+  uint32 i;
+  uint32 j;
+
+  if((pFrame[SPIPROT_WORD_HEADER] != SPIPROT_HEADER) ||
+     ((pFrame[SPIPROT_WORD_ID] & (SPIPROT_STATUS_DUMP | SPIPROT_STATUS_FAULTS)) != SPIPROT_STATUS_DUMP) ||
+     (pFrame[SPIPROT_WORD_CRC] != SpiProt_Crc16(pFrame, SPIPROT_WORD_CRC)))
+  {
+    return false;
+  }
+
+  pDump->Seq = (uint8)(pFrame[SPIPROT_WORD_ID] >> 8u);
+  pDump->Status = (uint8)pFrame[SPIPROT_WORD_ID];
+  pDump->Cause = (uint8)(pFrame[SPIPROT_DUMP_INFO] >> 8u);
+  pDump->Frozen = (uint8)pFrame[SPIPROT_DUMP_INFO];
+  pDump->Index = pFrame[SPIPROT_DUMP_INDEX];
+  pDump->Count = pFrame[SPIPROT_DUMP_COUNT];
+  for(i = 0u; i < SPIPROT_DUMP_NUM_RECORDS; i++)
+  {
+    for(j = 0u; j < SPIPROT_DUMP_RECORD_WORDS; j++)
+    {
+      pDump->Rec[i][j] = pFrame[SPIPROT_DUMP_RECORDS + (i * SPIPROT_DUMP_RECORD_WORDS) + j];
+    }
+  }
+
+  return true;
+} /* End of SpiProt_DecodeDump */
+
+/** \brief Encodes a slave fault frame.
+ *
+ * \param[out] pFrame Frame of SPIPROT_FRAME_WORDS words
+ * \param[in] pFaults Fault report
+ * \return None
+ *
+ * \ingroup spiprot_api
+ */
+void SpiProt_EncodeFaults(uint16 *pFrame, const TSpiProt_Faults *pFaults)
+{
+  uint32 i;
+
+  pFrame[SPIPROT_WORD_HEADER] = SPIPROT_HEADER;
+  pFrame[SPIPROT_WORD_ID] = (uint16)(((uint16)pFaults->Seq << 8u) | pFaults->Status | SPIPROT_STATUS_FAULTS);
+  pFrame[SPIPROT_FAULT_ACTIVE] = pFaults->Active;
+  pFrame[SPIPROT_FAULT_HISTORY] = pFaults->History;
+  pFrame[SPIPROT_FAULT_OC] = pFaults->OcCtr;
+  pFrame[SPIPROT_FAULT_SUPPLY] = pFaults->SupplyCtr;
+  pFrame[SPIPROT_FAULT_RETRY] = (uint16)(((uint16)pFaults->Retries << 8u) | pFaults->Locked);
+  pFrame[SPIPROT_FAULT_OFF_TIME] = pFaults->OffCycles;
+  pFrame[SPIPROT_FAULT_STALL] = pFaults->StallCtr;
+  pFrame[SPIPROT_FAULT_HALLCAL] = pFaults->HallCal;
+  for(i = SPIPROT_FAULT_HALLCAL + 1u; i < SPIPROT_WORD_CRC; i++)
+  {
+    pFrame[i] = 0u;
+  }
+  pFrame[SPIPROT_WORD_CRC] = SpiProt_Crc16(pFrame, SPIPROT_WORD_CRC);
+
+} /* End of SpiProt_EncodeFaults */
+
+/** \brief Decodes a slave fault frame (SPI master side).
+ *
+ * \param[in] pFrame Frame of SPIPROT_FRAME_WORDS words
+ * \param[out] pFaults Fault report, only written for a valid frame
+ * \return true if header, CRC and frame type are valid
+ *
+ * \ingroup spiprot_api
+ */
+bool SpiProt_DecodeFaults(const uint16 *pFrame, TSpiProt_Faults *pFaults)
+{
+  if((pFrame[SPIPROT_WORD_HEADER] != SPIPROT_HEADER) ||
+     ((pFrame[SPIPROT_WORD_ID] & (SPIPROT_STATUS_DUMP | SPIPROT_STATUS_FAULTS)) != SPIPROT_STATUS_FAULTS) ||
+     (pFrame[SPIPROT_WORD_CRC] != SpiProt_Crc16(pFrame, SPIPROT_WORD_CRC)))
+  {
+    return false;
+  }
+
+  pFaults->Seq = (uint8)(pFrame[SPIPROT_WORD_ID] >> 8u);
+  pFaults->Status = (uint8)pFrame[SPIPROT_WORD_ID];
+  pFaults->Active = pFrame[SPIPROT_FAULT_ACTIVE];
+  pFaults->History = pFrame[SPIPROT_FAULT_HISTORY];
+  pFaults->OcCtr = pFrame[SPIPROT_FAULT_OC];
+  pFaults->SupplyCtr = pFrame[SPIPROT_FAULT_SUPPLY];
+  pFaults->Retries = (uint8)(pFrame[SPIPROT_FAULT_RETRY] >> 8u);
+  pFaults->Locked = (uint8)pFrame[SPIPROT_FAULT_RETRY];
+  pFaults->OffCycles = pFrame[SPIPROT_FAULT_OFF_TIME];
+  pFaults->StallCtr = pFrame[SPIPROT_FAULT_STALL];
+  pFaults->HallCal = pFrame[SPIPROT_FAULT_HALLCAL];
+
+  return true;
+} /* End of SpiProt_DecodeFaults */
+
+/** \brief Encodes a slave profile frame.
+ *
+ * \param[out] pFrame Frame of SPIPROT_FRAME_WORDS words
+ * \param[in] pProf Handler statistics
+ * \return None
+ *
+ * \ingroup spiprot_api
+ */
+void SpiProt_EncodeProf(uint16 *pFrame, const TSpiProt_Prof *pProf)
+{
+  uint32 i;
+
+  pFrame[SPIPROT_WORD_HEADER] = SPIPROT_HEADER;
+  pFrame[SPIPROT_WORD_ID] = (uint16)(((uint16)pProf->Seq << 8u) | pProf->Status | SPIPROT_STATUS_PROF);
+  pFrame[SPIPROT_PROF_INFO] = (uint16)(((uint16)pProf->Id << 8u) | pProf->First);
+  pFrame[SPIPROT_PROF_COUNT_HI] = (uint16)(pProf->Count >> 16u);
+  pFrame[SPIPROT_PROF_COUNT_LO] = (uint16)pProf->Count;
+  pFrame[SPIPROT_PROF_MIN] = pProf->Min;
+  pFrame[SPIPROT_PROF_MAX] = pProf->Max;
+  pFrame[SPIPROT_PROF_MEAN] = pProf->Mean;
+  for(i = 0u; i < SPIPROT_PROF_NUM_BUCKETS; i++)
+  {
+    pFrame[SPIPROT_PROF_HIST + i] = pProf->Hist[i];
+  }
+  pFrame[SPIPROT_WORD_CRC] = SpiProt_Crc16(pFrame, SPIPROT_WORD_CRC);
+
+} /* End of SpiProt_EncodeProf */
+
+/** \brief Decodes a slave profile frame (SPI master side).
+ *
+ * \param[in] pFrame Frame of SPIPROT_FRAME_WORDS words
+ * \param[out] pProf Handler statistics, only written for a valid frame
+ * \return true if header, CRC and frame type are valid
+ *
+ * \ingroup spiprot_api
+ */
+bool SpiProt_DecodeProf(const uint16 *pFrame, TSpiProt_Prof *pProf)
+{
+  uint32 i;
+
+  if((pFrame[SPIPROT_WORD_HEADER] != SPIPROT_HEADER) ||
+     ((pFrame[SPIPROT_WORD_ID] & SPIPROT_STATUS_PROF) != SPIPROT_STATUS_PROF) ||
+     (pFrame[SPIPROT_WORD_CRC] != SpiProt_Crc16(pFrame, SPIPROT_WORD_CRC)))
+  {
+    return false;
+  }
+
+  pProf->Seq = (uint8)(pFrame[SPIPROT_WORD_ID] >> 8u);
+  pProf->Status = (uint8)pFrame[SPIPROT_WORD_ID];
+  pProf->Id = (uint8)(pFrame[SPIPROT_PROF_INFO] >> 8u);
+  pProf->First = (uint8)pFrame[SPIPROT_PROF_INFO];
+  pProf->Count = ((uint32)pFrame[SPIPROT_PROF_COUNT_HI] << 16u) | pFrame[SPIPROT_PROF_COUNT_LO];
+  pProf->Min = pFrame[SPIPROT_PROF_MIN];
+  pProf->Max = pFrame[SPIPROT_PROF_MAX];
+  pProf->Mean = pFrame[SPIPROT_PROF_MEAN];
+  for(i = 0u; i < SPIPROT_PROF_NUM_BUCKETS; i++)
+  {
+    pProf->Hist[i] = pFrame[SPIPROT_PROF_HIST + i];
+  }
+
+  return true;
+} /* End of SpiProt_DecodeProf */
@@ -0,0 +1,229 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/* See SpiProt.c */
+
+#ifndef SPIPROT_H
+#define SPIPROT_H
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+/* Only basic types, the module is also built by the SPI master */
+#include "types.h"
+
+/*******************************************************************************
+**                      Global Macro Definitions                              **
+*******************************************************************************/
+/* Frame length [16 bit words], the same in both directions (full duplex) */
+#define SPIPROT_FRAME_WORDS (14u)
+
+/* Word 0 of every frame: sync byte (high) and protocol version (low) */
+#define SPIPROT_SYNC    (0xA5u)
+#define SPIPROT_VERSION (0x09u)
+#define SPIPROT_HEADER  ((uint16)((SPIPROT_SYNC << 8u) | SPIPROT_VERSION))
+
+/* Words of a frame */
+#define SPIPROT_WORD_HEADER  (0u)   /* sync, version */
+#define SPIPROT_WORD_ID      (1u)   /* sequence number (high), command ID or status (low) */
+#define SPIPROT_WORD_PAYLOAD (2u)   /* first payload word */
+#define SPIPROT_WORD_CRC     (SPIPROT_FRAME_WORDS - 1u)
+
+/* Payload length [16 bit words] */
+#define SPIPROT_PAYLOAD_WORDS (SPIPROT_WORD_CRC - SPIPROT_WORD_PAYLOAD)
+
+/* Words of a slave frame, sample words latched at the chip select edge of the previous frame:
+ * the frame is complete before its own chip select, DMA may fetch any word from then on */
+#define SPIPROT_TELEM_TIME_HI (SPIPROT_WORD_PAYLOAD + 0u)   /* sample */
+#define SPIPROT_TELEM_TIME_LO (SPIPROT_WORD_PAYLOAD + 1u)   /* sample */
+#define SPIPROT_TELEM_POS_HI  (SPIPROT_WORD_PAYLOAD + 2u)   /* sample */
+#define SPIPROT_TELEM_POS_LO  (SPIPROT_WORD_PAYLOAD + 3u)   /* sample */
+#define SPIPROT_TELEM_SPEED   (SPIPROT_WORD_PAYLOAD + 4u)   /* sample */
+#define SPIPROT_TELEM_CURRENT (SPIPROT_WORD_PAYLOAD + 5u)   /* sample */
+#define SPIPROT_TELEM_DUTY    (SPIPROT_WORD_PAYLOAD + 6u)
+#define SPIPROT_TELEM_STATE   (SPIPROT_WORD_PAYLOAD + 7u)   /* motor state (high), fault (bit 7), mode (bits 6..0) */
+#define SPIPROT_TELEM_POS_ERR (SPIPROT_WORD_PAYLOAD + 8u)
+#define SPIPROT_TELEM_FRAMES  (SPIPROT_WORD_PAYLOAD + 9u)
+#define SPIPROT_TELEM_LOAD    (SPIPROT_WORD_PAYLOAD + 10u)  /* CPU load [%] (high), rejected frames mod 256 (low) */
+
+/* Words of a slave dump frame (SPIPROT_STATUS_DUMP set), answer to SPIPROT_CMD_FREC */
+#define SPIPROT_DUMP_INFO    (SPIPROT_WORD_PAYLOAD + 0u)   /* trigger cause (high), frozen (low) */
+#define SPIPROT_DUMP_INDEX   (SPIPROT_WORD_PAYLOAD + 1u)   /* index of the first record, 0 = oldest */
+#define SPIPROT_DUMP_COUNT   (SPIPROT_WORD_PAYLOAD + 2u)   /* records in the recorder */
+#define SPIPROT_DUMP_RECORDS (SPIPROT_WORD_PAYLOAD + 3u)   /* records, unused words 0 */
+
+/* Fault flag in the low byte of SPIPROT_TELEM_STATE */
+#define SPIPROT_STATE_FAULT (0x80u)
+
+/* Words of a slave fault frame (SPIPROT_STATUS_FAULTS set), answer to SPIPROT_CMD_FAULT */
+#define SPIPROT_FAULT_ACTIVE   (SPIPROT_WORD_PAYLOAD + 0u)   /* latched fault codes */
+#define SPIPROT_FAULT_HISTORY  (SPIPROT_WORD_PAYLOAD + 1u)   /* fault codes since the last clear */
+#define SPIPROT_FAULT_OC       (SPIPROT_WORD_PAYLOAD + 2u)   /* overcurrent events */
+#define SPIPROT_FAULT_SUPPLY   (SPIPROT_WORD_PAYLOAD + 3u)   /* supply events */
+#define SPIPROT_FAULT_RETRY    (SPIPROT_WORD_PAYLOAD + 4u)   /* retries (high), locked (low) */
+#define SPIPROT_FAULT_OFF_TIME (SPIPROT_WORD_PAYLOAD + 5u)   /* longest handler entry to bridge off [CPU cycles] */
+#define SPIPROT_FAULT_STALL    (SPIPROT_WORD_PAYLOAD + 6u)   /* stall events */
+#define SPIPROT_FAULT_HALLCAL  (SPIPROT_WORD_PAYLOAD + 7u)   /* Hall sector calibration state */
+
+/* Words of a slave profile frame (SPIPROT_STATUS_PROF set), answer to SPIPROT_CMD_PROF */
+#define SPIPROT_PROF_INFO     (SPIPROT_WORD_PAYLOAD + 0u)   /* handler ID (high), first histogram bucket (low) */
+#define SPIPROT_PROF_COUNT_HI (SPIPROT_WORD_PAYLOAD + 1u)   /* runs */
+#define SPIPROT_PROF_COUNT_LO (SPIPROT_WORD_PAYLOAD + 2u)
+#define SPIPROT_PROF_MIN      (SPIPROT_WORD_PAYLOAD + 3u)   /* shortest run [CPU cycles] */
+#define SPIPROT_PROF_MAX      (SPIPROT_WORD_PAYLOAD + 4u)   /* longest run [CPU cycles] */
+#define SPIPROT_PROF_MEAN     (SPIPROT_WORD_PAYLOAD + 5u)   /* mean run [CPU cycles] */
+#define SPIPROT_PROF_HIST     (SPIPROT_WORD_PAYLOAD + 6u)   /* runs per log2 bucket from the first bucket on */
+
+/* Histogram buckets per profile frame */
+#define SPIPROT_PROF_NUM_BUCKETS (SPIPROT_WORD_CRC - SPIPROT_PROF_HIST)
+
+/* Flight recorder records per dump frame, words per record */
+#define SPIPROT_DUMP_NUM_RECORDS (2u)
+#define SPIPROT_DUMP_RECORD_WORDS (4u)
+
+/* Command IDs of master frames, payload words in brackets */
+#define SPIPROT_CMD_NONE    (0x00u)   /* only telemetry */
+#define SPIPROT_CMD_SPEED   (0x01u)   /* [0] reference speed [rpm] */
+#define SPIPROT_CMD_POS     (0x02u)   /* [0, 1] target position [encoder ticks], high word first */
+#define SPIPROT_CMD_CURRENT (0x03u)   /* [0] reference current (full PWM period = 32768) */
+#define SPIPROT_CMD_PWM     (0x04u)   /* [0] reference duty cycle (full PWM period = 32768) */
+#define SPIPROT_CMD_GAINS   (0x05u)   /* [0, 1] speed PI Kp, Ki; [2, 3] position Kp, Kd */
+#define SPIPROT_CMD_STOP    (0x06u)   /* stop motor */
+#define SPIPROT_CMD_FREC    (0x07u)   /* [0] first record index; [1] 1 = freeze first, 2 = re-arm after */
+#define SPIPROT_CMD_FAULT   (0x08u)   /* [0] 1 = clear latched faults after the report */
+#define SPIPROT_CMD_PROF    (0x09u)   /* [0] handler ID; [1] first histogram bucket; [2] 1 = clear after the report */
+#define SPIPROT_CMD_HALLCAL (0x0Au)   /* [0] 1 = learn Hall sectors at the current speed, 2 = ideal sectors; fault frame answer (state before the command) */
+
+/* Status flags of slave frames */
+#define SPIPROT_STATUS_CMD_OK    (0x01u)   /* last master frame accepted */
+#define SPIPROT_STATUS_CMD_ERR   (0x02u)   /* last master frame rejected (header, CRC or command ID) */
+#define SPIPROT_STATUS_RUN       (0x04u)   /* motor running */
+#define SPIPROT_STATUS_POS_EN    (0x08u)   /* position control enabled */
+#define SPIPROT_STATUS_POS_SETTLED (0x10u) /* position held at target (hold band) */
+#define SPIPROT_STATUS_FREC_TRIG (0x20u)   /* flight recorder triggered */
+#define SPIPROT_STATUS_FAULTS    (0x40u)   /* fault frame instead of telemetry */
+#define SPIPROT_STATUS_DUMP      (0x80u)   /* dump frame instead of telemetry */
+#define SPIPROT_STATUS_PROF      (SPIPROT_STATUS_DUMP | SPIPROT_STATUS_FAULTS) /* profile frame instead of telemetry */
+
+/*******************************************************************************
+**                      Global Type Definitions                               **
+*******************************************************************************/
+/** \brief Master frame: command with setpoints. */
+typedef struct
+{
+  uint8 Seq;                                  /**< \brief Sequence number, echoed in the telemetry */
+  uint8 CmdId;                                /**< \brief Command ID (SPIPROT_CMD_x) */
+  uint16 Payload[SPIPROT_PAYLOAD_WORDS];      /**< \brief Command parameters */
+} TSpiProt_Cmd;
+
+/** \brief Slave frame: telemetry. */
+typedef struct
+{
+  uint8 Seq;            /**< \brief Sequence number of the last accepted master frame */
+  uint8 Status;         /**< \brief Status flags (SPIPROT_STATUS_x) */
+  uint32 Time;          /**< \brief Sample time [us] */
+  sint32 Pos;           /**< \brief Position at Time [encoder ticks] */
+  sint16 Speed;         /**< \brief Speed at Time, sign = direction [rpm] */
+  sint16 Current;       /**< \brief DC link current at Time (full PWM period = 32768) */
+  uint16 Duty;          /**< \brief Duty cycle [PWM timer ticks] */
+  uint8 MotorState;     /**< \brief Motor state (EMO_MOTOR_STATE_x) */
+  uint8 Mode;           /**< \brief Commutation mode (EMO_MODE_x) */
+  uint8 Fault;          /**< \brief Bridge fault latched */
+  sint16 PosErr;        /**< \brief Position control error [encoder ticks], saturated */
+  uint16 FrameCtr;      /**< \brief Received master frames */
+  uint8 ErrCtr;         /**< \brief Rejected master frames, mod 256 */
+  uint8 CpuLoad;        /**< \brief CPU load [%] */
+} TSpiProt_Telem;
+
+/** \brief Slave frame: fault report. */
+typedef struct
+{
+  uint8 Seq;            /**< \brief Sequence number of the last accepted master frame */
+  uint8 Status;         /**< \brief Status flags (SPIPROT_STATUS_x), SPIPROT_STATUS_FAULTS added by the encoder */
+  uint16 Active;        /**< \brief Latched fault codes */
+  uint16 History;       /**< \brief Fault codes since the last clear */
+  uint16 OcCtr;         /**< \brief Overcurrent events */
+  uint16 SupplyCtr;     /**< \brief Supply events */
+  uint8 Retries;        /**< \brief Automatic restarts */
+  uint8 Locked;         /**< \brief Retries exhausted */
+  uint16 OffCycles;     /**< \brief Longest fault handler entry to bridge off [CPU cycles] */
+  uint16 StallCtr;      /**< \brief Stall events */
+  uint16 HallCal;       /**< \brief Hall sector calibration state (EMOCCU_HALLCAL_x) */
+} TSpiProt_Faults;
+
+/** \brief Slave frame: interrupt handler run time statistics. */
+typedef struct
+{
+  uint8 Seq;            /**< \brief Sequence number of the last accepted master frame */
+  uint8 Status;         /**< \brief Status flags (SPIPROT_STATUS_x), SPIPROT_STATUS_PROF added by the encoder */
+  uint8 Id;             /**< \brief Handler ID */
+  uint8 First;          /**< \brief Histogram bucket of Hist[0] */
+  uint32 Count;         /**< \brief Runs */
+  uint16 Min;           /**< \brief Shortest run [CPU cycles] */
+  uint16 Max;           /**< \brief Longest run [CPU cycles] */
+  uint16 Mean;          /**< \brief Mean run [CPU cycles] */
+  uint16 Hist[SPIPROT_PROF_NUM_BUCKETS]; /**< \brief Runs per log2 bucket from First on */
+} TSpiProt_Prof;
+
+/** \brief Slave frame: flight recorder records. */
+typedef struct
+{
+  uint8 Seq;            /**< \brief Sequence number of the last accepted master frame */
+  uint8 Status;         /**< \brief Status flags (SPIPROT_STATUS_x), SPIPROT_STATUS_DUMP added by the encoder */
+  uint8 Cause;          /**< \brief Trigger cause, 0 = not triggered */
+  uint8 Frozen;         /**< \brief Recorder frozen */
+  uint16 Index;         /**< \brief Index of Rec[0], 0 = oldest record */
+  uint16 Count;         /**< \brief Records in the recorder */
+  uint16 Rec[SPIPROT_DUMP_NUM_RECORDS][SPIPROT_DUMP_RECORD_WORDS]; /**< \brief Records from Index on */
+} TSpiProt_Dump;
+
+/*******************************************************************************
+**                      Global Function Declarations                          **
+*******************************************************************************/
+extern uint16 SpiProt_Crc16(const uint16 *pWords, uint32 NumWords);
+extern void SpiProt_EncodeCmd(uint16 *pFrame, const TSpiProt_Cmd *pCmd);
+extern bool SpiProt_DecodeCmd(const uint16 *pFrame, TSpiProt_Cmd *pCmd);
+extern void SpiProt_EncodeTelem(uint16 *pFrame, const TSpiProt_Telem *pTelem);
+extern bool SpiProt_DecodeTelem(const uint16 *pFrame, TSpiProt_Telem *pTelem);
+extern void SpiProt_EncodeDump(uint16 *pFrame, const TSpiProt_Dump *pDump);
+extern bool SpiProt_DecodeDump(const uint16 *pFrame, TSpiProt_Dump *pDump);
+extern void SpiProt_EncodeFaults(uint16 *pFrame, const TSpiProt_Faults *pFaults);
+extern bool SpiProt_DecodeFaults(const uint16 *pFrame, TSpiProt_Faults *pFaults);
+extern void SpiProt_EncodeProf(uint16 *pFrame, const TSpiProt_Prof *pProf);
+extern bool SpiProt_DecodeProf(const uint16 *pFrame, TSpiProt_Prof *pProf);
+
+/*******************************************************************************
+**                      Global Inline Function Definitions                    **
+*******************************************************************************/
+
+
+#endif /* SPIPROT_H */
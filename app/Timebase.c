@@ -0,0 +1,101 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, GPT12E T6 extended to 32 bit microseconds
+ * V0.2.0: 2026-10-17: T6 ticks extended to 32 bit for the Hall period
+ * V0.3.0: 2026-10-17: T6 prescaler set here (0.8 us), getters locked
+ * V0.3.1: 2026-10-18: Raw T6 stamp and its later conversion (Timebase_GetUsAt)
+ */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include "Timebase.h"
+
+/*******************************************************************************
+**                      Global Variable Definitions                           **
+*******************************************************************************/
+TTimebase_Status Timebase_Status;
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+/** \brief Starts the timebase at zero.
+ *
+ * T6 runs from here on with the prescalers of TIMEBASE_T6_DIV, Ccu6_Stop
+ * leaves it running.
+ *
+ * \return None
+ *
+ * \ingroup timebase_api
+ */
+void Timebase_Init(void)
+{
+  Timebase_Status.Us = 0u;
+  Timebase_Status.Rem = 0u;
+  Timebase_Status.Ticks = 0u;
+  GPT12E_GPT2_Clk_Prescaler_Sel((uint16)TIMEBASE_BPS2);
+  GPT12E_T6_Mode_Timer_Clk_Prescaler_Sel((uint16)TIMEBASE_T6I);
+  Timebase_Status.T6Ref = (uint16)GPT12E->T6.reg;
+  GPT12E_T6_Start();
+
+} /* End of Timebase_Init */
+
+/** \brief Moves the reference of the timebase to the current T6 count.
+ *
+ * \return None
+ *
+ * \note Called every ms, T6 wraps after 65536 ticks (52 ms at 40 MHz).
+ *
+ * \ingroup timebase_api
+ */
+void Timebase_Update(void)
+{
+  uint32 PriMask;
+  uint32 Cycles;
+  uint16 T6;
+
+  /* Locked: readers in interrupts need all values of the same update */
+  PriMask = __get_PRIMASK();
+  __disable_irq();
+
+  T6 = (uint16)GPT12E->T6.reg;
+  Cycles = ((uint32)(uint16)(T6 - Timebase_Status.T6Ref) * TIMEBASE_T6_DIV) + Timebase_Status.Rem;
+  Timebase_Status.Us += Cycles / TIMEBASE_CYCLES_PER_US;
+  Timebase_Status.Rem = Cycles % TIMEBASE_CYCLES_PER_US;
+  Timebase_Status.Ticks += (uint32)(uint16)(T6 - Timebase_Status.T6Ref);
+  Timebase_Status.T6Ref = T6;
+
+  __set_PRIMASK(PriMask);
+
+} /* End of Timebase_Update */
@@ -0,0 +1,219 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/* See Timebase.c */
+
+#ifndef TIMEBASE_H
+#define TIMEBASE_H
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include <tle_device.h>
+
+/*******************************************************************************
+**                      Global Macro Definitions                              **
+*******************************************************************************/
+/* GPT12E T6 clock: GPT2 block prescaler fSYS / 2^(TIMEBASE_BPS2 + 1) (GPT12E_GPT2_Clk_Prescaler_Sel)
+ * and T6 prescaler 2^TIMEBASE_T6I, set by Timebase_Init instead of the ICW value */
+#define TIMEBASE_BPS2 (1u)
+#define TIMEBASE_T6I  (3u)
+
+/* GPT12E T6 clock divider to fSYS: 32, 0.8 us per tick at 40 MHz */
+#define TIMEBASE_T6_DIV (1u << (TIMEBASE_BPS2 + 1u + TIMEBASE_T6I))
+
+/* CPU cycles per microsecond */
+#define TIMEBASE_CYCLES_PER_US (SCU_FSYS / 1000000u)
+
+/* Reach of Timebase_GetUsAt before the reference: half the T6 range, rounded
+ * up to whole microseconds [us] */
+#define TIMEBASE_AT_OFS_US (((32768u * TIMEBASE_T6_DIV) + TIMEBASE_CYCLES_PER_US - 1u) / TIMEBASE_CYCLES_PER_US)
+
+/*******************************************************************************
+**                      Global Type Definitions                               **
+*******************************************************************************/
+/** \brief Timebase status, updated together by Timebase_Update */
+typedef struct
+{
+  uint32 Us;        /**< \brief Time at T6Ref [us] */
+  uint32 Rem;       /**< \brief Remainder below 1 us at T6Ref [CPU cycles] */
+  uint32 Ticks;     /**< \brief T6 extended to 32 bit at T6Ref [T6 ticks] */
+  uint16 T6Ref;     /**< \brief T6 at the last update */
+} TTimebase_Status;
+
+/*******************************************************************************
+**                      Global Variable Declarations                          **
+*******************************************************************************/
+extern TTimebase_Status Timebase_Status;
+
+/*******************************************************************************
+**                      Global Function Declarations                          **
+*******************************************************************************/
+extern void Timebase_Init(void);
+extern void Timebase_Update(void);
+
+__STATIC_INLINE uint32 Timebase_GetUs(void);
+__STATIC_INLINE uint16 Timebase_GetT6(void);
+__STATIC_INLINE uint32 Timebase_GetUsAt(uint16 T6);
+__STATIC_INLINE uint32 Timebase_GetTicks(void);
+__STATIC_INLINE uint32 Timebase_GetCycles(void);
+__STATIC_INLINE uint32 Timebase_CyclesSince(uint32 Start);
+
+/*******************************************************************************
+**                      Global Inline Function Definitions                    **
+*******************************************************************************/
+/** \brief Gets the free-running time.
+ *
+ * The 16 bit T6 count since the last Timebase_Update is added to the time of
+ * that update. Resolution is one T6 tick (0.8 us at 40 MHz), the value wraps
+ * after 2^32 us.
+ *
+ * \return Time [us]
+ *
+ * \note Reads T6 and the reference under a short lock: callers below the
+ * SysTick priority (DMA) or in the main loop would otherwise combine a T6
+ * count with the reference of another update.
+ *
+ * \ingroup timebase_api
+ */
+__STATIC_INLINE uint32 Timebase_GetUs(void)
+{
+  uint32 PriMask;
+  uint32 Cycles;
+  uint32 Us;
+
+  PriMask = __get_PRIMASK();
+  __disable_irq();
+  Cycles = ((uint32)(uint16)((uint16)GPT12E->T6.reg - Timebase_Status.T6Ref) * TIMEBASE_T6_DIV) + Timebase_Status.Rem;
+  Us = Timebase_Status.Us;
+  __set_PRIMASK(PriMask);
+
+  return Us + (Cycles / TIMEBASE_CYCLES_PER_US);
+} /* End of Timebase_GetUs */
+
+/** \brief Gets the raw T6 count for a later Timebase_GetUsAt.
+ *
+ * A single timer read without lock, for time stamps in interrupts that cannot
+ * afford the lock and the division of Timebase_GetUs.
+ *
+ * \return T6 count
+ *
+ * \ingroup timebase_api
+ */
+__STATIC_INLINE uint16 Timebase_GetT6(void)
+{
+  return (uint16)GPT12E->T6.reg;
+} /* End of Timebase_GetT6 */
+
+/** \brief Converts a T6 count of Timebase_GetT6 to the free-running time.
+ *
+ * The count may lie up to 32767 ticks (26 ms at 40 MHz) before or after the
+ * reference of the last Timebase_Update, i.e. it has to be converted within
+ * 25 ms.
+ *
+ * \param[in] T6 T6 count
+ * \return Time [us], as Timebase_GetUs at that count
+ *
+ * \ingroup timebase_api
+ */
+__STATIC_INLINE uint32 Timebase_GetUsAt(uint16 T6)
+{
+  uint32 PriMask;
+  uint32 Cycles;
+  uint32 Us;
+
+  /* Signed distance to the reference, moved up by TIMEBASE_AT_OFS_US for the unsigned division */
+  PriMask = __get_PRIMASK();
+  __disable_irq();
+  Cycles = (uint32)((sint32)(sint16)(uint16)(T6 - Timebase_Status.T6Ref) * (sint32)TIMEBASE_T6_DIV) +
+           Timebase_Status.Rem + (TIMEBASE_AT_OFS_US * TIMEBASE_CYCLES_PER_US);
+  Us = Timebase_Status.Us;
+  __set_PRIMASK(PriMask);
+
+  return (Us + (Cycles / TIMEBASE_CYCLES_PER_US)) - TIMEBASE_AT_OFS_US;
+} /* End of Timebase_GetUsAt */
+
+/** \brief Gets the free-running T6 count extended to 32 bit.
+ *
+ * Same extension as Timebase_GetUs without the conversion: differences are
+ * valid for periods up to 2^32 ticks (57 min at 40 MHz) instead of the 52 ms
+ * of the 16 bit timer.
+ *
+ * \return Time [T6 ticks, TIMEBASE_T6_DIV / fSYS]
+ *
+ * \note Locked as Timebase_GetUs, e.g. for the Hall event below SysTick
+ * in the DMA interrupt.
+ *
+ * \ingroup timebase_api
+ */
+__STATIC_INLINE uint32 Timebase_GetTicks(void)
+{
+  uint32 PriMask;
+  uint32 Ticks;
+
+  PriMask = __get_PRIMASK();
+  __disable_irq();
+  Ticks = Timebase_Status.Ticks + (uint32)(uint16)((uint16)GPT12E->T6.reg - Timebase_Status.T6Ref);
+  __set_PRIMASK(PriMask);
+
+  return Ticks;
+} /* End of Timebase_GetTicks */
+
+/** \brief Gets a CPU cycle stamp for short interval measurements.
+ *
+ * \return SysTick value, counts down
+ *
+ * \ingroup timebase_api
+ */
+__STATIC_INLINE uint32 Timebase_GetCycles(void)
+{
+  return CPU->SYSTICK_CUR.reg;
+} /* End of Timebase_GetCycles */
+
+/** \brief Gets the CPU cycles since a stamp of Timebase_GetCycles.
+ *
+ * \param Start Stamp of Timebase_GetCycles
+ *
+ * \return Elapsed time [CPU cycles], valid below one SysTick period (1 ms)
+ *
+ * \ingroup timebase_api
+ */
+__STATIC_INLINE uint32 Timebase_CyclesSince(uint32 Start)
+{
+  uint32 Now;
+
+  Now = CPU->SYSTICK_CUR.reg;
+  return (Start >= Now) ? (Start - Now) : ((Start + CPU->SYSTICK_RL.reg + 1u) - Now);
+} /* End of Timebase_CyclesSince */
+
+
+#endif /* TIMEBASE_H */
@@ -0,0 +1,302 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, control loop trace on UART1 (TXD1, P0.1)
+ * V0.2.0: 2026-10-17: Handler run time hooks (ISR_PROF_EN)
+ */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include "tle_device.h"
+#include "isr_defines.h"
+#include "Trace.h"
+#include "Timebase.h"
+#include "Emo.h"
+#include "EmoCcu.h"
+#include "EmoEnc.h"
+#include "IsrProf.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+#if (((((UART1_RX_INT_EN == 1) || (UART1_TX_INT_EN == 1)) || \
+       ((TIMER2_EXF2_INT_EN == 1) || (TIMER2_TF2_INT_EN == 1))) || \
+      (((LIN_EOF_INT_EN == 1) || (LIN_ERR_INT_EN == 1)) || \
+       ((LIN_OC_INT_EN == 1) || (LIN_OT_INT_EN == 1)))) || \
+      (LIN_TMOUT_INT_EN == 1))
+#error "UART1_IRQHandler is defined in isr.c, disable the UART1, TIMER2 and LIN interrupts in the ICW"
+#endif
+
+#if ((TRACE_BUF_SIZE & (TRACE_BUF_SIZE - 1u)) != 0u)
+#error "TRACE_BUF_SIZE must be a power of 2"
+#endif
+
+#define TRACE_BUF_MASK (TRACE_BUF_SIZE - 1u)
+
+/* UART1 mode 1: 8 data bits, variable baud rate, receiver off */
+#define TRACE_UART1_SCON (UART1_SCON_SM1_Msk)
+
+/* TXD1 on P0.1, alternate function 1 */
+#define TRACE_P0_PIN (1u)
+
+/*******************************************************************************
+**                      Private Type Definitions                              **
+*******************************************************************************/
+/** \brief Trace channel */
+typedef struct
+{
+  const volatile void *pVar;  /**< \brief Traced variable */
+  uint8 Size;                 /**< \brief Size [bytes] */
+} TTrace_Ch;
+
+/*******************************************************************************
+**                      Global Variable Definitions                           **
+*******************************************************************************/
+TTrace_Status Trace_Status;
+
+/*******************************************************************************
+**                      Private Variable Definitions                          **
+*******************************************************************************/
+/* Ring buffer, written by Trace_Sample only, read by the UART1 interrupt only */
+static uint8 Trace_lBuf[TRACE_BUF_SIZE];
+static volatile uint16 Trace_lHead;
+static volatile uint16 Trace_lTail;
+
+/* Byte on the line, the next TI interrupt continues with the ring buffer */
+static volatile uint8 Trace_lBusy;
+
+/* Time of the current sample */
+static uint32 Trace_lTime;
+
+/* Calls since the last sample */
+static uint8 Trace_lDivCtr;
+
+/*******************************************************************************
+**                      Private Constant Definitions                          **
+*******************************************************************************/
+static const TTrace_Ch Trace_lCh[TRACE_NUM_CH] =
+{
+  {&Trace_lTime,                  4u},
+  {&Emo_Ctrl.SpeedPi.IOut,        4u},
+  {&Emo_Ctrl.DutyCycle,           2u},
+  {&EmoCcu_HallStatus.Speed,      2u},
+  {&EmoCcu_HallStatus.HallPtn,    1u},
+  {&Emo_Ctrl.Current,             2u},
+  {&EmoEnc_Status.Pos,            4u}
+};
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+/** \brief Initializes UART1 for the trace and enables the default channels.
+ *
+ * \return None
+ *
+ * \note UART1 must not be configured in the ICW (UART1 and LIN disabled).
+ *
+ * \ingroup trace_api
+ */
+void Trace_Init(void)
+{
+  Trace_lHead = 0u;
+  Trace_lTail = 0u;
+  Trace_lBusy = 0u;
+  Trace_lDivCtr = 0u;
+  Trace_Status.Records = 0u;
+  Trace_Status.Drops = 0u;
+  Trace_Status.Seq = 0u;
+  Trace_Status.Mask = (uint8)TRACE_CHANNELS;
+
+  /* Baud rate generator */
+  SCU->BCON1.reg = 0u;
+  SCU->BGL1.reg = (uint8)(((TRACE_BR_VALUE << SCU_BGL1_BR_VALUE_Pos) & SCU_BGL1_BR_VALUE_Msk) | TRACE_FD_SEL);
+  SCU->BGH1.reg = (uint8)(TRACE_BR_VALUE >> 3u);
+  SCU->BCON1.reg = (uint8)SCU_BCON1_R_Msk;
+  UART1->SCON.reg = (uint8)TRACE_UART1_SCON;
+  UART1->SCONCLR.reg = (uint8)(UART1_SCONCLR_TICLR_Msk | UART1_SCONCLR_RICLR_Msk);
+
+  /* TXD1 on P0.1 */
+  PORT->P0_ALTSEL0.reg |= (uint8)(1u << TRACE_P0_PIN);
+  PORT->P0_ALTSEL1.reg &= (uint8)~(1u << TRACE_P0_PIN);
+  PORT->P0_DIR.reg |= (uint8)(1u << TRACE_P0_PIN);
+
+  /* TI interrupt drains the ring buffer */
+  SCU->MODIEN1.reg |= (uint8)SCU_MODIEN1_TIEN1_Msk;
+  NVIC_Node10_En();
+
+} /* End of Trace_Init */
+
+/** \brief Selects the traced channels.
+ *
+ * \param Mask Bit n enables channel n (TRACE_CH_x), 0 = trace off
+ *
+ * \return None
+ *
+ * \note Call from the context of Trace_Sample or with it blocked.
+ *
+ * \ingroup trace_api
+ */
+void Trace_SetChannels(uint8 Mask)
+{
+  Trace_Status.Mask = (uint8)(Mask & ((1u << TRACE_NUM_CH) - 1u));
+
+} /* End of Trace_SetChannels */
+
+/** \brief Writes one record of the enabled channels into the ring buffer.
+ *
+ * Called every ms from Main_HandleSysTick; may be called from
+ * Emo_HandlePwmPeriod instead, with TRACE_DIV limiting the record rate to the
+ * UART bandwidth (about 100 kbyte/s). A record that does not fit into the ring
+ * buffer is dropped as a whole, the sequence number still advances.
+ *
+ * \return None
+ *
+ * \note Single producer: call from one interrupt level only.
+ *
+ * \ingroup trace_api
+ */
+void Trace_Sample(void)
+{
+  uint8 Rec[TRACE_MAX_RECORD_BYTES];
+  const volatile uint8 *pSrc;
+  uint32 Len;
+  uint32 Free;
+  uint32 Head;
+  uint32 Tail;
+  uint32 i;
+  uint32 j;
+  uint8 Mask;
+  uint8 Chk;
+
+  Mask = Trace_Status.Mask;
+  if (Mask == 0u)
+  {
+    return;
+  }
+
+  Trace_lDivCtr++;
+  if (Trace_lDivCtr < (uint8)TRACE_DIV)
+  {
+    return;
+  }
+  Trace_lDivCtr = 0u;
+
+  Trace_lTime = Timebase_GetUs();
+
+  /* Build the record */
+  Rec[0] = (uint8)TRACE_SYNC;
+  Rec[1] = Trace_Status.Seq;
+  Rec[2] = Mask;
+  Len = TRACE_HEADER_BYTES;
+  for (i = 0u; i < TRACE_NUM_CH; i++)
+  {
+    if ((Mask & (1u << i)) != 0u)
+    {
+      /* Little endian on the line as in memory */
+      pSrc = (const volatile uint8 *)Trace_lCh[i].pVar;
+      for (j = 0u; j < Trace_lCh[i].Size; j++)
+      {
+        Rec[Len] = pSrc[j];
+        Len++;
+      }
+    }
+  }
+  Chk = 0u;
+  for (i = 1u; i < Len; i++)
+  {
+    Chk ^= Rec[i];
+  }
+  Rec[Len] = Chk;
+  Len++;
+
+  Trace_Status.Seq++;
+
+  /* Copy into the ring buffer */
+  Head = Trace_lHead;
+  Free = (Trace_lTail - Head - 1u) & TRACE_BUF_MASK;
+  if (Len > Free)
+  {
+    Trace_Status.Drops++;
+    return;
+  }
+  for (i = 0u; i < Len; i++)
+  {
+    Trace_lBuf[Head] = Rec[i];
+    Head = (Head + 1u) & TRACE_BUF_MASK;
+  }
+  __DMB();
+  Trace_lHead = (uint16)Head;
+  Trace_Status.Records++;
+
+  /* Start the transmission if the line is idle. If the UART1 interrupt has
+   * just found the buffer empty, it clears Busy after this check and the
+   * record goes out with the next one. */
+  if (Trace_lBusy == 0u)
+  {
+    Trace_lBusy = 1u;
+    Tail = Trace_lTail;
+    Trace_lTail = (uint16)((Tail + 1u) & TRACE_BUF_MASK);
+    UART1->SBUF.reg = Trace_lBuf[Tail];
+  }
+
+} /* End of Trace_Sample */
+
+/** \brief UART1 interrupt: sends the next byte of the ring buffer.
+ *
+ * \return None
+ *
+ * \ingroup trace_api
+ */
+void UART1_IRQHandler(void)
+{
+  uint16 Tail;
+  ISR_PROF_ENTER();
+
+  if ((uint8)UART1->SCON.bit.TI == (uint8)1)
+  {
+    UART1->SCONCLR.reg = (uint8)UART1_SCONCLR_TICLR_Msk;
+    Tail = Trace_lTail;
+    if (Tail != Trace_lHead)
+    {
+      Trace_lTail = (uint16)((Tail + 1u) & TRACE_BUF_MASK);
+      UART1->SBUF.reg = Trace_lBuf[Tail];
+    }
+    else
+    {
+      Trace_lBusy = 0u;
+    }
+  }
+
+  ISR_PROF_EXIT(ISR_PROF_ID_UART1);
+} /* End of UART1_IRQHandler */
@@ -0,0 +1,108 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/* See Trace.c */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include <tle_device.h>
+
+/*******************************************************************************
+**                      Global Macro Definitions                              **
+*******************************************************************************/
+/* Trace channels, bit n of the channel mask enables channel n. The values of
+ * the enabled channels follow each other in ascending channel order. */
+#define TRACE_CH_TIME       (0u)  /* Timebase_GetUs, uint32 [us] */
+#define TRACE_CH_SPEED_IOUT (1u)  /* Emo_Ctrl.SpeedPi.IOut, sint32 */
+#define TRACE_CH_DUTY       (2u)  /* Emo_Ctrl.DutyCycle, uint16 [PWM timer ticks] */
+#define TRACE_CH_HALL_SPEED (3u)  /* EmoCcu_HallStatus.Speed, uint16 [rpm] */
+#define TRACE_CH_HALL_PTN   (4u)  /* EmoCcu_HallStatus.HallPtn, uint8 */
+#define TRACE_CH_CURRENT    (5u)  /* Emo_Ctrl.Current, sint16 */
+#define TRACE_CH_POS        (6u)  /* EmoEnc_Status.Pos, sint32 [encoder ticks] */
+#define TRACE_NUM_CH        (7u)
+
+/* Channel mask after Trace_Init, 0 = trace off */
+#define TRACE_CHANNELS ((1u << TRACE_CH_TIME) | (1u << TRACE_CH_SPEED_IOUT) | (1u << TRACE_CH_DUTY) | \
+                        (1u << TRACE_CH_HALL_SPEED) | (1u << TRACE_CH_HALL_PTN))
+
+/* Record sync byte */
+#define TRACE_SYNC (0xA5u)
+
+/* Records: sync, sequence number, channel mask, values (little endian), XOR of
+ * all bytes from the sequence number up to the last value byte */
+#define TRACE_HEADER_BYTES (3u)
+#define TRACE_MAX_RECORD_BYTES (TRACE_HEADER_BYTES + 19u + 1u)
+
+/* Ring buffer size [bytes], power of 2 */
+#define TRACE_BUF_SIZE (512u)
+
+/* Only every TRACE_DIV-th call of Trace_Sample takes a sample */
+#define TRACE_DIV (1u)
+
+/* UART1 baud rate = fPCLK / (16 * (BR_VALUE + FD_SEL / 32)) = 1 MBaud at 40 MHz */
+#define TRACE_BR_VALUE (2u)
+#define TRACE_FD_SEL (16u)
+
+/*******************************************************************************
+**                      Global Type Definitions                               **
+*******************************************************************************/
+/** \brief Trace status */
+typedef struct
+{
+  uint32 Records;   /**< \brief Records written to the ring buffer */
+  uint32 Drops;     /**< \brief Records dropped because the ring buffer was full */
+  uint8 Mask;       /**< \brief Channel mask */
+  uint8 Seq;        /**< \brief Sequence number of the next record, also counts dropped records */
+} TTrace_Status;
+
+/*******************************************************************************
+**                      Global Variable Declarations                          **
+*******************************************************************************/
+extern TTrace_Status Trace_Status;
+
+/*******************************************************************************
+**                      Global Function Declarations                          **
+*******************************************************************************/
+extern void Trace_Init(void);
+extern void Trace_SetChannels(uint8 Mask);
+extern void Trace_Sample(void);
+
+/*******************************************************************************
+**                      Global Inline Function Definitions                    **
+*******************************************************************************/
+
+
+#endif /* TRACE_H */
@@ -51,11 +51,56 @@
 #include "tle_device.h"
 #include "Emo.h"
 #include "EmoCcu.h"
+#include "EmoCsa.h"
+#include "EmoEnc.h"
+#include "EmoFoc.h"
+#include "EmoPos.h"
 #include "bchall_defines.h"
 
 /******************************************************************************
 **                      Private Macro Definitions                            **
 *******************************************************************************/
+/* Inner current control for BC, speed PI output is the current reference: 1 = enabled, 0 = disabled.
+ * May be set in the project C defines. */
+#ifndef EMO_CURRENT_CTRL_EN
+#define EMO_CURRENT_CTRL_EN (0u)
+#endif
+
+/* Current control executed every n-th PWM period, 1 = PWM rate */
+#define EMO_CURRENT_CTRL_DIV (1u)
+
+/* Current sample point in the on-time of the PWM period [1/256 of duty cycle] */
+#define EMO_CURRENT_SAMPLE_POS (128u)
+
+/* Earliest current sample point after T12 period match [T12 ticks]: CSA settling after switching */
+#define EMO_CURRENT_SAMPLE_MIN_TICKS (80u)
+
+/* Current sample point during CSA offset calibration, in the off-time of the start duty cycle [T12 ticks] */
+#define EMO_CURRENT_OFFSET_SAMPLE_TICKS ((EMO_PWM_PERIOD_TICKS * 3u) / 4u)
+
+/* Current PI parameters (see Mat_ExePi: P gain = Kp / 512, I gain = Ki / 32768 per control period).
+ * Plant: G = Vdc / (2R * EMO_PWM_PERIOD_TICKS) = 6.55 current units per duty tick, time constant
+ * tau = L / R = 333 us = 6.7 PWM periods (motor of the host tests). The zero cancels the plant pole,
+ * Ki = 64 * Kp * T / tau; the crossover wc = 5200 rad/s (830 Hz) keeps 60 degrees phase margin with the
+ * dead time of the sample pipeline (about 2 PWM periods, 100 us): Kp = 512 * wc * tau / G. */
+#define EMO_CURRENT_KP (135)
+#define EMO_CURRENT_KI (1300)
+
+/* Run time of the CCU6 SR0 handler with Emo_lCtrlCurrent (incl. EmoCsa_GetCurrent and Mat_ExePi) per
+ * PWM period, host simulation with instruction timing (test_current, 2000 rpm with Hall events):
+ * mean 214 cycles, max 215 cycles = 11 % of a PWM period at 40 MHz / 20 kHz, the test fails above 20 %.
+ * To be measured again on the device with ISR_PROF_EN = 1 for any extension of the loop. */
+
+/* Current reference of a full PWM period for BC with inner current control [1.0 = 1024 ADC counts]:
+ * stall current Vdc / 2R, so that the speed PI gains tuned for the duty cycle give the same torque per
+ * speed error at standstill. Motor of the host tests: 12 V / (2 * 0.3 Ohm) = 20 A, 410 ADC counts. */
+#define EMO_CURRENT_FULL_DUTY (13107)
+
+/* Function-like macro to scale a duty cycle [PWM timer ticks] to a BC current reference (1.0 = 1024 ADC counts) */
+#define Emo_lDutyToCurrentRef(DutyCycle) ((sint16)((((sint32)(DutyCycle)) * EMO_CURRENT_FULL_DUTY) / (sint32)EMO_PWM_PERIOD_TICKS))
+
+/* Function-like macro to scale a duty cycle [PWM timer ticks] to a current reference (full period = 1.0) */
+#define Emo_lDutyToCurrent(DutyCycle) ((sint16)((((sint32)(DutyCycle)) << MAT_FIX_SHIFT) / (sint32)EMO_PWM_PERIOD_TICKS))
 
 /*******************************************************************************
 **                      Private Type Definitions                              **
@@ -66,6 +111,11 @@
 *******************************************************************************/
 static void Emo_lInitPar(void);
 static void Emo_lInitVar(void);
+static void Emo_lSetDir(sint16 Ref);
+#if (EMO_CURRENT_CTRL_EN == 1u)
+static void Emo_lStartCurrentCtrl(void);
+static void Emo_lCtrlCurrent(void);
+#endif
 
 /*******************************************************************************
 **                      Global Variable Definitions                           **
@@ -97,14 +147,23 @@ uint32 Emo_Init(void)
   /* Switch on VDDEXT */
   PMU->VDDEXT_CTRL.reg = 0x01u;
   
-  /* Initialize Hall parameters */
+  /* Initialize Hall parameters, ideal Hall sectors until calibrated */
   EmoCcu_InitHallPar();
+  EmoCcu_ClearHallCal();
 
   /* Initialize parameters */
   Emo_lInitPar();
+
+  /* Initialize FOC parameters */
+  EmoFoc_InitPar();
+
+  /* Initialize encoder and position control parameters */
+  EmoEnc_Init();
+  EmoPos_InitPar();
   
   /* Initialize motor state */
   Emo_Status.MotorState = EMO_MOTOR_STATE_STOP;
+  Emo_Status.StartLock = 0u;
 
   /* Return without error */
   return EMO_ERROR_NONE;
@@ -117,21 +176,67 @@ uint32 Emo_Init(void)
  * \param[in] Reference speed
  * \return None
  *
- * \note Sign should only be changed when motor is stopped.
+ * \note A sign change of the running motor reverses commutation immediately,
+ * the speed control then brakes with minimum duty cycle until the motor turns.
+ * Zero keeps the direction.
  *
  * \ingroup emo_api
  */
 void Emo_SetRefSpeed(sint16 RefSpeed)
 {
-  /* Set direction index */
-  EmoCcu_SetDirIdx((RefSpeed < 0) ? 8u : 0u);
+  /* Set direction */
+  Emo_lSetDir(RefSpeed);
 
   /* Set user reference speed to absolute value */
   Emo_Ctrl.UserRefSpeed = ((RefSpeed < 0) ? (-RefSpeed) : RefSpeed);  
 
+  /* Return to speed control */
+  Emo_Ctrl.RefDutyEn = 0u;
+
 } /* End of Emo_SetRefSpeed */
 
 
+/** \brief Sets a duty cycle reference replacing the speed control.
+ *
+ * \param[in] RefDuty Reference duty cycle [PWM timer ticks], sign = direction
+ * \return None
+ *
+ * \note The duty cycle is limited like the speed PI output. Emo_SetRefSpeed
+ * returns to speed control.
+ *
+ * \ingroup emo_api
+ */
+void Emo_SetRefDuty(sint16 RefDuty)
+{
+  /* Set direction */
+  Emo_lSetDir(RefDuty);
+
+  /* Set user reference duty cycle to absolute value */
+  Emo_Ctrl.UserRefDuty = (uint16)((RefDuty < 0) ? (-(sint32)RefDuty) : (sint32)RefDuty);
+  Emo_Ctrl.RefDutyEn = 1u;
+
+} /* End of Emo_SetRefDuty */
+
+
+/** \brief Sets a current reference replacing the speed control.
+ *
+ * \param[in] RefCurrent Reference current (full PWM period = 1.0), sign = direction
+ * \return None
+ *
+ * \note The reference passes the duty cycle path of Emo_CtrlSpeed, it is a
+ * current reference for FOC and for BC with inner current control (full PWM
+ * period = stall current EMO_CURRENT_FULL_DUTY) and a duty cycle otherwise.
+ *
+ * \ingroup emo_api
+ */
+void Emo_SetRefCurrent(sint16 RefCurrent)
+{
+  /* Scale to PWM timer ticks, inverse of Emo_lDutyToCurrent */
+  Emo_SetRefDuty((sint16)(((sint32)RefCurrent * (sint32)EMO_PWM_PERIOD_TICKS) >> MAT_FIX_SHIFT));
+
+} /* End of Emo_SetRefCurrent */
+
+
 /** \brief Starts the motor.
  *
  * \param[in] Reference speed
@@ -149,9 +254,43 @@ uint32 Emo_StartMotor(void)
     return EMO_ERROR_MOTOR_NOT_STOPPED;
   }
 
+  if(Emo_Status.StartLock != 0u)
+  {
+    /* Error detected: start blocked */
+    return EMO_ERROR_START_LOCKED;
+  }
+
+  if((EmoCcu_GetPosSensor() == EMO_POS_SENSOR_BEMF) && (Emo_Status.Mode != EMO_MODE_BC))
+  {
+    /* Error detected: BEMF sensing needs block commutation */
+    return EMO_ERROR_POS_SENSOR;
+  }
+
   /* Start PWM */
   Ccu6_Start();
 
+  if(Emo_Status.Mode == EMO_MODE_FOC)
+  {
+    /* Switch PWM from block commutation to FOC */
+    EmoFoc_Start();
+  }
+  else if(Emo_Status.Mode == EMO_MODE_SINE)
+  {
+    /* Switch PWM from block commutation to sine commutation */
+    EmoCcu_StartSine();
+  }
+  else
+  {
+#if (EMO_CURRENT_CTRL_EN == 1u)
+    /* Block commutation with inner current control */
+    Emo_lStartCurrentCtrl();
+#else
+    /* Block commutation, T12 period match only for the application callback */
+    CCU6_ClearIntStatus(CCU6_MASK_INT_T12PM);
+    CCU6_EnableInt((uint16)(CCU6_MASK_INT_T12PM | CCU6_MASK_INT_CHE));
+#endif
+  }
+
   /* Enable bridge (after starting PWM according to UM) */
 	BDRV_Set_Bridge(Ch_PWM, Ch_PWM, Ch_PWM, Ch_PWM, Ch_PWM, Ch_PWM);
   
@@ -191,6 +330,23 @@ uint32 Emo_StopMotor(void)
   /* Stop PWM */
   Ccu6_Stop();
 
+  if(Emo_Status.Mode == EMO_MODE_FOC)
+  {
+    /* Release current measurement */
+    EmoFoc_Stop();
+  }
+#if (EMO_CURRENT_CTRL_EN == 1u)
+  else if(Emo_Status.Mode == EMO_MODE_BC)
+  {
+    /* Release current measurement */
+    EmoCsa_Stop();
+  }
+#endif
+  else
+  {
+    /* No current measurement */
+  }
+
   /* Initialize bridge */
   BDRV_Init();
 
@@ -210,19 +366,79 @@ uint32 Emo_StopMotor(void)
 void Emo_CtrlSpeed(void)
 {
   uint16 DutyCycle;
+  uint16 CurrentDuty;
+  sint16 IqRef;
+
+  /* Speed 0 and stall detection without Hall events */
+  EmoCcu_CheckStandstill();
+
+  /* Hall sector correction after calibration */
+  EmoCcu_ExeHallCal();
+
+  if((Emo_Status.MotorState == EMO_MOTOR_STATE_START) && (EmoCcu_GetPosSensor() == EMO_POS_SENSOR_BEMF))
+  {
+    /* Open-loop start until BEMF zero crossings take over commutation */
+    EmoCcu_ExeBemfRamp();
+  }
   
   if(Emo_Status.MotorState == EMO_MOTOR_STATE_RUN)
   {
-    /* Perform speed control */
-    DutyCycle = (uint16)Mat_ExePi(&Emo_Ctrl.SpeedPi, Emo_Ctrl.UserRefSpeed - (sint16)Emo_GetAbsSpeed());
+    if(Emo_Ctrl.RefDutyEn != 0u)
+    {
+      /* Use user reference duty cycle within the speed PI output limits */
+      DutyCycle = Emo_Ctrl.UserRefDuty;
+      if(DutyCycle < (uint16)Emo_Ctrl.SpeedPi.PiMin)
+      {
+        DutyCycle = (uint16)Emo_Ctrl.SpeedPi.PiMin;
+      }
+      else if(DutyCycle > (uint16)Emo_Ctrl.SpeedPi.PiMax)
+      {
+        DutyCycle = (uint16)Emo_Ctrl.SpeedPi.PiMax;
+      }
+
+      /* Track I output for a bumpless return to speed control */
+      Emo_Ctrl.SpeedPi.IOut = ((sint32)DutyCycle) << 15u;
+    }
+    else
+    {
+      /* Perform speed control */
+      DutyCycle = (uint16)Mat_ExePi(&Emo_Ctrl.SpeedPi, Emo_Ctrl.UserRefSpeed - (sint16)Emo_GetAbsSpeed());
+    }
     
-    /* Set new common duty cycle immediately */
-		CCU6_LoadShadowRegister_CC60(DutyCycle);
-		CCU6_LoadShadowRegister_CC61(DutyCycle);
-		CCU6_LoadShadowRegister_CC62(DutyCycle);
-
-		/* Enable shadow transfer for T12 */
-		CCU6_EnableST_T12();
+    /* Current reference: the user reference from 0 on, the speed PI output from its minimum on, which is
+     * no torque instead of the minimum duty cycle */
+    CurrentDuty = (Emo_Ctrl.RefDutyEn != 0u) ? Emo_Ctrl.UserRefDuty : (uint16)(DutyCycle - (uint16)Emo_Ctrl.SpeedPi.PiMin);
+    if(CurrentDuty > (uint16)Emo_Ctrl.SpeedPi.PiMax)
+    {
+      CurrentDuty = (uint16)Emo_Ctrl.SpeedPi.PiMax;
+    }
+
+    if(Emo_Status.Mode == EMO_MODE_FOC)
+    {
+      /* q current reference, scaled from PWM ticks to fixed-point */
+      IqRef = Emo_lDutyToCurrent(CurrentDuty);
+      EmoFoc_SetIqRef((EmoCcu_GetDirIdx() == 0u) ? IqRef : (sint16)(-IqRef));
+    }
+    else if(Emo_Status.Mode == EMO_MODE_SINE)
+    {
+      /* Use speed PI output as sine amplitude, full duty cycle = half PWM period */
+      EmoCcu_SetSineAmp(DutyCycle / 2u);
+    }
+    else
+    {
+#if (EMO_CURRENT_CTRL_EN == 1u)
+      /* Current reference for the inner current control */
+      Emo_Ctrl.CurrentRef = Emo_lDutyToCurrentRef(CurrentDuty);
+#else
+      /* Set new common duty cycle immediately */
+      CCU6_LoadShadowRegister_CC60(DutyCycle);
+      CCU6_LoadShadowRegister_CC61(DutyCycle);
+      CCU6_LoadShadowRegister_CC62(DutyCycle);
+
+      /* Enable shadow transfer for T12 */
+      CCU6_EnableST_T12();
+#endif
+    }
 
     /* Save new duty cycle */
     Emo_Ctrl.DutyCycle = DutyCycle;
@@ -237,16 +453,89 @@ void Emo_CtrlSpeed(void)
  */
 uint16 Emo_GetAbsSpeed(void)
 {
+#if (EMOPLL_EN == 1u)
+  return EmoPll_GetSpeed();
+#else
   return EmoCcu_GetSpeed();
+#endif
 } /* End of Emo_GetAbsSpeed() */
 
+/** \brief Sets the commutation mode.
+ *
+ * \param[in] Mode EMO_MODE_BC, EMO_MODE_FOC or EMO_MODE_SINE
+ * \return None
+ *
+ * \note Mode is applied by Emo_StartMotor and should only be changed when motor is stopped.
+ *
+ * \ingroup emo_api
+ */
+void Emo_SetMode(uint8 Mode)
+{
+  Emo_Status.Mode = Mode;
+} /* End of Emo_SetMode */
+
+/** \brief Selects the position sensor for commutation.
+ *
+ * \param[in] PosSensor EMO_POS_SENSOR_HALL or EMO_POS_SENSOR_BEMF
+ * \return Error or EMO_ERROR_NONE
+ *
+ * \note May be called while the motor is running. BEMF sensing is only
+ * available for block commutation.
+ *
+ * \ingroup emo_api
+ */
+uint32 Emo_SetPosSensor(uint8 PosSensor)
+{
+  if((PosSensor == EMO_POS_SENSOR_BEMF) && (Emo_Status.Mode != EMO_MODE_BC))
+  {
+    /* Error detected: return with error */
+    return EMO_ERROR_POS_SENSOR;
+  }
+
+  EmoCcu_SetPosSensor(PosSensor);
+
+  /* Return without error */
+  return EMO_ERROR_NONE;
+} /* End of Emo_SetPosSensor */
+
+/** \brief Handles CCU6 interrupt for T12 period match.
+ *
+ * \return None
+ *
+ * \note T12 period-match interrupt is enabled in all modes while the motor is started.
+ *
+ * \ingroup emo_api
+ */
+void Emo_HandlePwmPeriod(void)
+{
+  if(Emo_Status.Mode == EMO_MODE_FOC)
+  {
+    EmoFoc_Exe();
+  }
+  else if(Emo_Status.Mode == EMO_MODE_SINE)
+  {
+    EmoCcu_ExeSine();
+  }
+  else
+  {
+#if (EMO_CURRENT_CTRL_EN == 1u)
+    Emo_lCtrlCurrent();
+#endif
+  }
+} /* End of Emo_HandlePwmPeriod */
+
 /*******************************************************************************
 **                      Private Function Definitions                          **
 *******************************************************************************/
 static void Emo_lInitPar(void)
 {
+  /* Initialize commutation mode */
+  Emo_Status.Mode = EMO_MODE_BC;
+
   /* Initialize user reference speed */
 	Emo_Ctrl.UserRefSpeed = 0;
+  Emo_Ctrl.UserRefDuty = 0u;
+  Emo_Ctrl.RefDutyEn = 0u;
 	
   /* Initialize PI control parameters for speed */
   Emo_Ctrl.SpeedPi.Kp = (sint16)BCHALL_SPEED_KP;
@@ -258,14 +547,114 @@ static void Emo_lInitPar(void)
   Emo_Ctrl.SpeedPi.PiMin = (sint16)((((sint32)BCHALL_SPEED_PIMIN) * EMO_PWM_PERIOD_TICKS)/100);
   Emo_Ctrl.SpeedPi.PiMax = (sint16)((((sint32)BCHALL_SPEED_PIMAX) * EMO_PWM_PERIOD_TICKS)/100);
 
+  /* Initialize PI control parameters for current */
+  Emo_Ctrl.CurrentPi.Kp = (sint16)EMO_CURRENT_KP;
+  Emo_Ctrl.CurrentPi.Ki = (sint16)EMO_CURRENT_KI;
+
+  /* Initialize PI control limits for current according to duty cycle limits */
+  Emo_Ctrl.CurrentPi.IMin = Emo_Ctrl.SpeedPi.IMin;
+  Emo_Ctrl.CurrentPi.IMax = Emo_Ctrl.SpeedPi.IMax;
+  Emo_Ctrl.CurrentPi.PiMin = Emo_Ctrl.SpeedPi.PiMin;
+  Emo_Ctrl.CurrentPi.PiMax = Emo_Ctrl.SpeedPi.PiMax;
+
 } /* End of Emo_lInitPar */
 
 static void Emo_lInitVar(void)
 {
   Emo_Ctrl.SpeedPi.IOut = 0;
   Emo_Ctrl.DutyCycle = 0u;
+
+  /* Current control continues from start duty cycle */
+  Emo_Ctrl.CurrentPi.IOut = ((((sint32)BCHALL_INIT_DUTY) * EMO_PWM_PERIOD_TICKS)/100) << 15u;
+  Emo_Ctrl.CurrentRef = 0;
+  Emo_Ctrl.Current = 0;
+  Emo_Ctrl.SampleTick = EmoCsa_T3Ticks(EMO_CURRENT_OFFSET_SAMPLE_TICKS);
+  Emo_Ctrl.CurrentCtrlCtr = 0u;
  
 } /* End of Emo_lInitVar */
 
+static void Emo_lSetDir(sint16 Ref)
+{
+  uint8 DirIdx;
+
+  if(Ref == 0)
+  {
+    /* No direction, keep the commutation of the running motor */
+    return;
+  }
+
+  /* Set direction index */
+  DirIdx = (Ref < 0) ? 8u : 0u;
+  if((DirIdx != EmoCcu_GetDirIdx()) && (Emo_Status.MotorState >= EMO_MOTOR_STATE_START))
+  {
+    /* Resynchronize commutation of the running motor to the new direction */
+    EmoCcu_Reverse(DirIdx);
+  }
+  else
+  {
+    EmoCcu_SetDirIdx(DirIdx);
+  }
+
+} /* End of Emo_lSetDir */
+
+#if (EMO_CURRENT_CTRL_EN == 1u)
+static void Emo_lStartCurrentCtrl(void)
+{
+  /* Start current measurement, first samples in the off-time calibrate the CSA offset */
+  EmoCsa_Start(EmoCsa_T3Ticks(EMO_CURRENT_OFFSET_SAMPLE_TICKS));
+
+  /* Enable interrupts for T12 period match and Hall event */
+  CCU6_ClearIntStatus(CCU6_MASK_INT_T12PM);
+  CCU6_EnableInt((uint16)(CCU6_MASK_INT_T12PM | CCU6_MASK_INT_CHE));
+
+} /* End of Emo_lStartCurrentCtrl */
+
+/* Inner current control for BC, executed in the T12 period-match interrupt.
+ * Pipeline as for FOC: the sample point calculated in the last period is
+ * programmed for the running period and the sample of the last period is read. */
+static void Emo_lCtrlCurrent(void)
+{
+  sint16 Current;
+  uint16 DutyCycle;
+  uint32 SampleTicks;
+
+  /* Program sample point of the PWM period just started */
+  EmoCsa_SetSampleTick(Emo_Ctrl.SampleTick);
+
+  /* Read sample of the last PWM period, keep last current if no sample was taken */
+  if(EmoCsa_GetCurrent(&Current) == true)
+  {
+    Emo_Ctrl.Current = Current;
+  }
+
+  if((Emo_Status.MotorState != EMO_MOTOR_STATE_RUN) || (EmoCsa_IsOffsetValid() == false))
+  {
+    /* Keep start duty cycle until Hall speed and CSA offset are valid */
+    return;
+  }
+
+  Emo_Ctrl.CurrentCtrlCtr++;
+  if(Emo_Ctrl.CurrentCtrlCtr < EMO_CURRENT_CTRL_DIV)
+  {
+    return;
+  }
+  Emo_Ctrl.CurrentCtrlCtr = 0u;
+
+  /* Perform current control */
+  DutyCycle = (uint16)Mat_ExePi(&Emo_Ctrl.CurrentPi, (sint16)__SSAT((sint32)Emo_Ctrl.CurrentRef - Emo_Ctrl.Current, 16u));
+
+  /* Set new common duty cycle for next PWM period */
+  CCU6_LoadShadowRegister_CC60(DutyCycle);
+  CCU6_LoadShadowRegister_CC61(DutyCycle);
+  CCU6_LoadShadowRegister_CC62(DutyCycle);
+  CCU6_EnableST_T12();
+
+  /* Sample within the on-time of the next PWM period, none if the on-time is too short */
+  SampleTicks = ((uint32)DutyCycle * EMO_CURRENT_SAMPLE_POS) >> 8u;
+  Emo_Ctrl.SampleTick = (SampleTicks >= EMO_CURRENT_SAMPLE_MIN_TICKS) ? EmoCsa_T3Ticks(SampleTicks) : EMOCSA_NO_SAMPLE;
+
+} /* End of Emo_lCtrlCurrent */
+#endif
+
 
 
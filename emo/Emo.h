@@ -52,11 +52,22 @@
 #define EMO_MOTOR_STATE_SWITCH (3u)
 #define EMO_MOTOR_STATE_RUN    (4u)
 
+/* Commutation modes */
+#define EMO_MODE_BC   (0u)
+#define EMO_MODE_FOC  (1u)
+#define EMO_MODE_SINE (2u)
+
+/* Position sensors */
+#define EMO_POS_SENSOR_HALL (0u)
+#define EMO_POS_SENSOR_BEMF (1u)
+
 /* Error states */
 #define EMO_ERROR_NONE              (0u)
 #define EMO_ERROR_MOTOR_INIT        (1u)
 #define EMO_ERROR_MOTOR_NOT_STOPPED (2u)
 #define EMO_ERROR_MOTOR_NOT_STARTED (3u)
+#define EMO_ERROR_POS_SENSOR        (4u)
+#define EMO_ERROR_START_LOCKED      (5u)
 
 /* PWM period [PWM timer ticks] */
 #define EMO_PWM_PERIOD_TICKS CCU6_T12PR
@@ -73,8 +84,15 @@
 typedef struct
 {
   sint16 UserRefSpeed;  /**< \brief User reference speed [rpm] */
+  uint16 UserRefDuty;   /**< \brief User reference duty cycle, used instead of speed control if RefDutyEn [PWM timer ticks] */
+  uint8 RefDutyEn;      /**< \brief User reference duty cycle enabled */
   TMat_Pi SpeedPi;      /**< \brief Speed PI control */
   uint16 DutyCycle;     /**< \brief Duty cycle [PWM timer ticks] */ 
+  TMat_Pi CurrentPi;    /**< \brief Current PI control for BC, output = duty cycle [PWM timer ticks] */
+  sint16 CurrentRef;    /**< \brief Current reference for BC (1.0 = 1024 ADC counts) */
+  sint16 Current;       /**< \brief DC link current for BC (1.0 = 1024 ADC counts) */
+  uint16 SampleTick;    /**< \brief Current sample point for next PWM period [Timer3 ticks] */
+  uint8 CurrentCtrlCtr; /**< \brief PWM periods since last current control */
 } TEmo_Ctrl;
 
 /** \ingroup emo_type_definitions
@@ -84,6 +102,8 @@ typedef struct
 typedef struct
 {
   uint8 MotorState;          /**< \brief Motor state */
+  uint8 Mode;                /**< \brief Commutation mode */
+  uint8 StartLock;           /**< \brief Motor start blocked, e.g. by a latched bridge fault */
 } TEmo_Status;
 
 /*******************************************************************************
@@ -96,11 +116,16 @@ extern TEmo_Ctrl Emo_Ctrl;
 **                      Global Function Declarations                          **
 *******************************************************************************/
 extern void Emo_SetRefSpeed(sint16 RefSpeed);
+extern void Emo_SetRefDuty(sint16 RefDuty);
+extern void Emo_SetRefCurrent(sint16 RefCurrent);
 extern uint32 Emo_Init(void);
 extern uint32 Emo_StartMotor(void);
 extern uint32 Emo_StopMotor(void);
 extern void Emo_CtrlSpeed(void);
 extern uint16 Emo_GetAbsSpeed(void);
+extern void Emo_SetMode(uint8 Mode);
+extern uint32 Emo_SetPosSensor(uint8 PosSensor);
+extern void Emo_HandlePwmPeriod(void);
 
 __STATIC_INLINE uint8 Emo_GetMotorState(void);
 __STATIC_INLINE void Emo_SetMotorState(uint8 MotorState);
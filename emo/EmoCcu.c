@@ -50,6 +50,9 @@
 *******************************************************************************/
 #include "Emo.h"
 #include "EmoCcu.h"
+#include "IsrDispatch.h"
+#include "Timebase.h"
+#include "bdrv_defines.h"
 
 /*******************************************************************************
 **                      Private Macro Definitions                             **
@@ -63,17 +66,17 @@
     (((uint32)(STE12D)) << 9u) | \
     (((uint32)(STE13U)) << 13u) )
 
+/* T12 modulation of all six outputs, multi-channel mode disabled (T12MODEN = 0x3F, MCMEN = 0) */
+#define CCU6_MASK_MODCTR_T12MODEN_ALL (0x003Fu)
+
 /* Constants for MCMOUTS register */
 #define CCU6_MASK_MCMOUTS_OUT_ALL (0x003Fu)
 
-/* Constants for CCU6 interrupt registers */
-#define CCU6_MASK_INT_T12PM (0x0080u)
-#define CCU6_MASK_INT_CHE   (0x1000u)
+/* T6 timer ticks per T13 timer tick (fSYS/256), the Hall delay is measured with T6 and timed by T13 */
+#define EMOCCU_T6_PER_T13 (256u / TIMEBASE_T6_DIV)
 
-/* Numerator for calculation of speed from commutation period:
- * speed [rpm] = numerator / (commutation period [256/fSYS in Hz])
- * numerator = CCU6 timer frequency [Hertz] * 60 / (6 * pole pairs), round to nearest */
-#define SPEED_FROM_COMM_PERIOD_NUM ((uint32)((((EMO_FSYS_HZ / 256.0) * 60.0) / (6.0 * (float)BCHALL_POLE_PAIRS)) + 0.5))
+/* Conversion of a time [ms] to T6 timer ticks */
+#define EMOCCU_MS_TO_TICKS(Ms) ((((uint32)(Ms)) * (EMO_FSYS_HZ / 1000u)) / TIMEBASE_T6_DIV)
 	
 /* BC speed low pass filter coefficient
  * Range: 1(slow update)..65535(fast update) */
@@ -82,10 +85,55 @@
 /* Hall filter time after Hall edge in timer ticks */
 #define T13_HALL_FILTER_TIME_TICKS CCU6_T13PERIOD
 
+/* BEMF comparators of phases U, V, W enabled and connected to CCPOS0..2 */
+#define EMOCCU_BEMFC_CTRL_STS_CCPOS \
+  (MF_BEMFC_CTRL_STS_PHUCOMP_EN_Msk | MF_BEMFC_CTRL_STS_PHVCOMP_EN_Msk | MF_BEMFC_CTRL_STS_PHWCOMP_EN_Msk | \
+   MF_BEMFC_CTRL_STS_PHUCOMP_ON_Msk | MF_BEMFC_CTRL_STS_PHVCOMP_ON_Msk | MF_BEMFC_CTRL_STS_PHWCOMP_ON_Msk | \
+   MF_BEMFC_CTRL_STS_CCPOS_INSEL_Msk)
+
+/* Time the first open-loop pattern is held to align the rotor before the BEMF start ramp [ms] */
+#define EMOCCU_BEMF_ALIGN_MS      (250u)
+
+/* Open-loop commutation period at start and end of BEMF start ramp [ms] */
+#define EMOCCU_BEMF_RAMP_START_MS (20u)
+#define EMOCCU_BEMF_RAMP_END_MS   (4u)
+
+/* Duty cycle of the alignment and the first ramp step [% of PWM period], raised in
+ * proportion to the commutation frequency to follow the BEMF of the ramp speed */
+#define EMOCCU_BEMF_RAMP_DUTY     (10u)
+
+/* BEMF pattern used for the first open-loop commutation if comparators show no valid pattern */
+#define EMOCCU_BEMF_RAMP_INIT_PTN (1u)
+
+/* Factor for calculation of angle increment per PWM period from speed:
+ * increment [65536 * angle per PWM period] = speed [rpm] * factor
+ * factor = 65536 * 65536 * pole pairs / (60 * PWM frequency [Hz]), round to nearest */
+#define ANGLE_INC_FROM_SPEED_FAC ((uint32)(((65536.0 * 65536.0 * (float)BCHALL_POLE_PAIRS) / (60.0 * (float)BCHALL_PWM_FREQ)) + 0.5))
+
+/* Electrical revolutions for Hall sector calibration */
+#define EMOCCU_HALLCAL_REVS (64u)
+
+/* Allowed difference of the longest and shortest revolution during calibration,
+ * 2^-x of the longest revolution */
+#define EMOCCU_HALLCAL_REV_TOL_SHIFT (5u)
+
+/* Range of a learned sector width: 40..80 degrees */
+#define EMOCCU_HALLCAL_WIDTH_MIN ((uint32)((EMO_ANGLE_60DEG * 2u) / 3u))
+#define EMOCCU_HALLCAL_WIDTH_MAX ((uint32)((EMO_ANGLE_60DEG * 4u) / 3u))
+
+/*******************************************************************************
+**                      Private Function Declarations                         **
+*******************************************************************************/
+static void Ccu6_lSetPtns(uint32 CurrentHallPtn);
+static uint16 EmoCcu_lGetHallAngle(const TEmoCcu_Cfg *pCfg, uint32 Idx);
+static void EmoCcu_lLearnHallCal(uint32 HallPtn, uint32 NextHallPtn, uint32 DiffTime);
+static void EmoCcu_lRestartHallCal(void);
+
 /*******************************************************************************
 **                      Global Variable Definitions                           **
 *******************************************************************************/
 TEmoCcu_HallStatus EmoCcu_HallStatus;
+TEmoCcu_HallCal EmoCcu_HallCal;
 
 /*******************************************************************************
 **                      Private Variable Definitions                          **
@@ -103,10 +151,7 @@ TEmoCcu_HallStatus EmoCcu_HallStatus;
  */
 void Ccu6_Start(void)
 {
-  uint32 HallOutPtn;
   uint16 InitDutyCycle;
-  uint32 CurrentHallPtn;
-  uint32 ExpHallPtn;
   
   /* Set common duty cycle */
   InitDutyCycle = (uint16)((((uint32)BCHALL_INIT_DUTY) * EMO_PWM_PERIOD_TICKS)/100);;
@@ -115,21 +160,8 @@ void Ccu6_Start(void)
   CCU6_LoadShadowRegister_CC61(InitDutyCycle);
   CCU6_LoadShadowRegister_CC62(InitDutyCycle);
 
-  /* Get current Hall pattern */
-  CurrentHallPtn = CCU6_ReadHallReg();
-
-  /* Set current/next T12MODEN and MCMEN in CCU60_MODCTR */
-  CCU6_ConfigureGlobalModulation((uint16)EmoCcu_Cfg.T12Moden[CurrentHallPtn + EmoCcu_HallStatus.DirIdx]);
-
-  /* Get current Hall and output patterns from table */
-  HallOutPtn = EmoCcu_Cfg.HallOutPtns[CurrentHallPtn + EmoCcu_HallStatus.DirIdx];
-
-  /* Set current Hall and output patterns immediately in MCMOUT */
-  CCU6_WriteMultichannelPatterns((uint16)(HallOutPtn | CCU6_MASK_MCMOUTS_SHADOW_OUT | CCU6_MASK_MCMOUTS_SHADOW_HALL));
-
-  /* Prepare next Hall and output patterns in CCU6_MCMOUTS */
-  ExpHallPtn = (HallOutPtn >> 8u) & 0x7u;
-  CCU6_WriteMultichannelPatterns(EmoCcu_Cfg.HallOutPtns[ExpHallPtn + EmoCcu_HallStatus.DirIdx]);
+  /* Set patterns for current Hall pattern */
+  Ccu6_lSetPtns(CCU6_ReadHallReg());
 
   /* Set Multi-Channel Mode Control register for switching on correct Hall pattern */
   CCU6_ConfigureMultichannelModulation((uint16)Ccu6_lSetMCMCTR
@@ -172,8 +204,7 @@ void Ccu6_Stop(void)
   /* Clear output and Hall patterns immediately */
   CCU6_WriteMultichannelPatterns((uint16)(CCU6_MASK_MCMOUTS_SHADOW_OUT | CCU6_MASK_MCMOUTS_SHADOW_HALL));
   
-  /* Stop timer 3 */
-  GPT12E_T6_Stop();
+  /* Timer 6 keeps running as timebase */
 
   /* Stop and reset T12 and T13 */
   CCU6_SetT12T13ControlBits((uint16)(CCU6_MASK_TCTR4_STOP_T12 | CCU6_MASK_TCTR4_RESET_T12 | CCU6_MASK_TCTR4_STOP_T13 | CCU6_MASK_TCTR4_RESET_T13));
@@ -191,24 +222,53 @@ void Ccu6_Stop(void)
  */
 void EmoCcu_HandleHallEvent(void)
 {
+  const TEmoCcu_Cfg *pCfg;
   uint32 ExpHallPtn;
   uint32 CurrentHallPtn;
   uint32 HallPtn;
-  uint16 DiffTime;
+  uint32 PrevHallPtn;
+  uint32 DiffTime;
+  uint32 Time;
+  uint32 DelayTime;
+  uint32 SpeedRaw;
   uint16 Speed;
-  uint16 Time;
-  uint16 DelayTime;
   
+#if (ISR_DISPATCH_BENCH_EN == 1)
+  if (IsrDispatch_HallProbe() == true)
+  {
+    /* Software triggered latency benchmark, no Hall edge */
+    return;
+  }
+#endif
+
 	/* Set current/next T12MODEN and MCMEN in CCU60_MODCTR */
+	pCfg = EmoCcu_HallStatus.pCfg;
 	HallPtn = (uint32)(CCU6_ReadMultichannelPatterns() >> 8u);
 	CurrentHallPtn = HallPtn >> 3u;
-	CCU6_ConfigureGlobalModulation((uint16)EmoCcu_Cfg.T12Moden[CurrentHallPtn + EmoCcu_HallStatus.DirIdx]);
+	PrevHallPtn = EmoCcu_HallStatus.HallPtn;
+	EmoCcu_HallStatus.HallPtn = (uint8)CurrentHallPtn;
+	if(Emo_Status.Mode == EMO_MODE_BC)
+	{
+		CCU6_ConfigureGlobalModulation((uint16)pCfg->T12Moden[CurrentHallPtn + EmoCcu_HallStatus.DirIdx]);
+	}
+
+	/* Restart angle interpolation at the entry angle of the new Hall pattern */
+	EmoCcu_HallStatus.HallAngle = EmoCcu_lGetHallAngle(pCfg, CurrentHallPtn + EmoCcu_HallStatus.DirIdx);
+	EmoCcu_HallStatus.AngleAdv = 0u;
 
 	/* Prepare next Hall patterns and output pattern */
 	ExpHallPtn = HallPtn & 0x7u;
-	CCU6_WriteMultichannelPatterns(EmoCcu_Cfg.HallOutPtns[ExpHallPtn + EmoCcu_HallStatus.DirIdx]);
+	CCU6_WriteMultichannelPatterns(pCfg->HallOutPtns[ExpHallPtn + EmoCcu_HallStatus.DirIdx]);
+
+  /* 32 bit: periods of slow rotation do not wrap */
+  Time = Timebase_GetTicks();
+#if (EMOPLL_EN == 1u)
+  EmoPll_Update(EmoCcu_HallStatus.HallAngle, Time);
+#endif
 
-  Time = GPT12E_T6_Value_Get();
+  /* Time of the sensor edge: the event follows it by the T13 delay loaded at the
+   * last event, a changing delay must not bias the measured period */
+  Time -= (uint32)EmoCcu_HallStatus.DelayTime * EMOCCU_T6_PER_T13;
 
   if(EmoCcu_HallStatus.StartCtr < 255u)
   {
@@ -227,9 +287,23 @@ void EmoCcu_HandleHallEvent(void)
     DiffTime = Time - EmoCcu_HallStatus.EventTime;
 
     /* Calculate speed */
-    Speed = (uint16)(SPEED_FROM_COMM_PERIOD_NUM / DiffTime);
+    SpeedRaw = EmoCcu_SpeedFromPeriod(DiffTime);
+
+    if(EmoCcu_HallStatus.PosSensor == EMO_POS_SENSOR_HALL)
+    {
+      /* Learned width of the completed sector instead of 60 degrees */
+      SpeedRaw = ((SpeedRaw * EmoCcu_HallCal.SpeedGain[PrevHallPtn]) + (EMOCCU_HALLCAL_GAIN_ONE / 2u)) >> 14u;
+      if(EmoCcu_HallCal.State == EMOCCU_HALLCAL_LEARN)
+      {
+        EmoCcu_lLearnHallCal(PrevHallPtn, CurrentHallPtn, DiffTime);
+      }
+    }
+    Speed = (SpeedRaw > 0xFFFFu) ? 0xFFFFu : (uint16)SpeedRaw;
     EmoCcu_HallStatus.Speed = Speed;
 
+    /* Interpolate angle in the new sector with the speed of the last sector */
+    EmoCcu_HallStatus.AngleInc = (uint32)Speed * ANGLE_INC_FROM_SPEED_FAC;
+
     if(EmoCcu_HallStatus.StartCtr == 2u)
     {
       /* Initialize average speed */
@@ -246,15 +320,20 @@ void EmoCcu_HandleHallEvent(void)
     if(Speed >= EmoCcu_HallStatus.DelayMinSpeed)
     {
       /* Minimum speed reached: */
-      /* Set T13 period to Hall delay time, limit to minimum = Hall filter time */
-      DelayTime = (uint16)(((((uint32)DiffTime) * EmoCcu_HallStatus.DelayAngle) + 30u) / 60u);
+      /* Set T13 period to Hall delay time: delay curve lookup and multiply-shift,
+       * the 16 bit period limits the product to 32 bit */
+      DelayTime = DiffTime / EMOCCU_T6_PER_T13;
+      DelayTime = (DelayTime > 0xFFFFu) ? 0xFFFFu : DelayTime;
+      DelayTime = ((DelayTime * EmoCcu_GetDelayFac(EmoCcu_HallStatus.pDelayCurve, Speed)) + 32768u) >> 16u;
+
+      /* Limit to minimum = Hall filter time */
       if(DelayTime < T13_HALL_FILTER_TIME_TICKS)
       { 
         DelayTime = T13_HALL_FILTER_TIME_TICKS;
       }        
-      CCU6_LoadPeriodRegister_T13_Tick(DelayTime);
+      CCU6_LoadPeriodRegister_T13_Tick((uint16)DelayTime);
       CCU6_EnableST_T13();
-      EmoCcu_HallStatus.DelayTime = DelayTime;
+      EmoCcu_HallStatus.DelayTime = (uint16)DelayTime;
     }
   }
   EmoCcu_HallStatus.EventTime = Time;
@@ -271,11 +350,229 @@ void EmoCcu_HandleHallEvent(void)
 void EmoCcu_InitHallPar(void)
 {
   /* Initialize BC Hall parameters */
-  EmoCcu_HallStatus.DelayAngle = (BCHALL_ANGLE_DELAY_EN == 0)? ((uint8)0) : ((uint8)BCHALL_DELAY_ANGLE);
+  EmoCcu_HallStatus.pCfg = &EmoCcu_Cfg;
+  EmoCcu_HallStatus.PosSensor = EMO_POS_SENSOR_HALL;
+  EmoCcu_SetDelayCurve(&EmoCcu_DelayCurve);
   EmoCcu_HallStatus.DelayMinSpeed = BCHALL_DELAY_MINSPEED;
+  EmoCcu_SetStallTime(EMOCCU_STALL_MS);
 
 } /* End of EmoCcu_InitHallPar */
 
+/** \brief Sets the stall detection time.
+ *
+ * \param StallMs Time without Hall event after which a started motor is
+ * stalled [ms], 0 = stall detection off
+ * \return None
+ *
+ * \ingroup emo_ccu_api
+ */
+void EmoCcu_SetStallTime(uint16 StallMs)
+{
+  EmoCcu_HallStatus.StallTicks = EMOCCU_MS_TO_TICKS(StallMs);
+
+} /* End of EmoCcu_SetStallTime */
+
+/** \brief Sets the commutation delay curve.
+ *
+ * The curve is used by reference: a single pointer store, which the Hall event
+ * reads once, so the curve may be changed while the motor runs.
+ *
+ * \param[in] pCurve Delay angle after the Hall event over speed, must stay
+ * valid and unchanged while in use (const, see EmoCcu_Cfg.c)
+ * \return None
+ *
+ * \ingroup emo_ccu_api
+ */
+void EmoCcu_SetDelayCurve(const TEmoCcu_DelayCurve *pCurve)
+{
+  EmoCcu_HallStatus.pDelayCurve = pCurve;
+
+} /* End of EmoCcu_SetDelayCurve */
+
+/** \brief Resets the Hall sector correction to ideal 60 degree sectors.
+ *
+ * \return None
+ *
+ * \ingroup emo_ccu_api
+ */
+void EmoCcu_ClearHallCal(void)
+{
+  uint32 PriMask;
+  uint32 i;
+
+  PriMask = __get_PRIMASK();
+  __disable_irq();
+  for(i = 0u; i < 16u; i++)
+  {
+    EmoCcu_HallCal.AngleOfs[i] = 0;
+  }
+  for(i = 0u; i < 8u; i++)
+  {
+    EmoCcu_HallCal.SpeedGain[i] = EMOCCU_HALLCAL_GAIN_ONE;
+  }
+  EmoCcu_HallCal.State = EMOCCU_HALLCAL_IDLE;
+  __set_PRIMASK(PriMask);
+
+} /* End of EmoCcu_ClearHallCal */
+
+/** \brief Starts learning the Hall sector widths.
+ *
+ * The time spent in each Hall pattern is accumulated over EMOCCU_HALLCAL_REVS
+ * electrical revolutions. At constant speed it is proportional to the width
+ * of the sector, EmoCcu_ExeHallCal then corrects the sector entry angles and
+ * the speed of each sector. The mean of all sector boundaries is kept, an
+ * offset common to all Hall sensors is not visible in the timing.
+ *
+ * \return None
+ *
+ * \note The motor should run with Hall sensors at constant speed, speed
+ * changes of more than 1/32 between revolutions fail the calibration.
+ *
+ * \ingroup emo_ccu_api
+ */
+void EmoCcu_StartHallCal(void)
+{
+  uint32 PriMask;
+
+  PriMask = __get_PRIMASK();
+  __disable_irq();
+  EmoCcu_lRestartHallCal();
+  EmoCcu_HallCal.State = EMOCCU_HALLCAL_LEARN;
+  __set_PRIMASK(PriMask);
+
+} /* End of EmoCcu_StartHallCal */
+
+/** \brief Calculates the Hall sector correction after learning.
+ *
+ * \return None
+ *
+ * \note Called every ms from Emo_CtrlSpeed, the calculation runs once when
+ * the learning in EmoCcu_HandleHallEvent is complete.
+ *
+ * \ingroup emo_ccu_api
+ */
+void EmoCcu_ExeHallCal(void)
+{
+  const TEmoCcu_Cfg *pCfg;
+  uint32 PriMask;
+  uint32 Seq[6];
+  uint32 Width[6];
+  sint32 Ofs[6];
+  uint16 Gain[6];
+  uint32 Total;
+  uint32 DirIdx;
+  uint32 OtherIdx;
+  uint32 Ptn;
+  uint32 Visited;
+  sint32 Pos;
+  sint32 OfsSum;
+  uint32 i;
+
+  if(EmoCcu_HallCal.State != EMOCCU_HALLCAL_CALC)
+  {
+    return;
+  }
+
+  /* Learning has stopped, the ISR does not write the sums any more */
+  EmoCcu_HallCal.State = EMOCCU_HALLCAL_FAIL;
+  if((EmoCcu_HallCal.RevMax - EmoCcu_HallCal.RevMin) > (EmoCcu_HallCal.RevMax >> EMOCCU_HALLCAL_REV_TOL_SHIFT))
+  {
+    /* Speed not constant */
+    return;
+  }
+
+  /* Hall pattern sequence in direction of rotation, must visit all six patterns */
+  Total = EmoCcu_HallCal.Total;
+  Ptn = EmoCcu_HallCal.Next[1];
+  Visited = 0u;
+  for(i = 0u; i < 6u; i++)
+  {
+    if((Ptn == 0u) || (Ptn == 7u) || ((Visited & (1u << Ptn)) != 0u))
+    {
+      return;
+    }
+    Visited |= 1u << Ptn;
+    Seq[i] = Ptn;
+
+    /* Sector width from the share of the total time (65536 = 360 degrees) */
+    Width[i] = (uint32)((((uint64)EmoCcu_HallCal.Sum[Ptn] << 16u) + (Total / 2u)) / Total);
+    if((Width[i] < EMOCCU_HALLCAL_WIDTH_MIN) || (Width[i] > EMOCCU_HALLCAL_WIDTH_MAX))
+    {
+      return;
+    }
+    Gain[i] = (uint16)(((Width[i] * EMOCCU_HALLCAL_GAIN_ONE) + (EMO_ANGLE_60DEG / 2u)) / EMO_ANGLE_60DEG);
+    Ptn = EmoCcu_HallCal.Next[Ptn];
+  }
+
+  /* Sector entry positions relative to the first entry, minus the nominal ones */
+  pCfg = &EmoCcu_Cfg;
+  DirIdx = EmoCcu_HallStatus.DirIdx;
+  OtherIdx = 8u - DirIdx;
+  Pos = 0;
+  OfsSum = 0;
+  for(i = 0u; i < 6u; i++)
+  {
+    Ofs[i] = (sint32)(sint16)(uint16)((uint32)Pos - ((uint32)pCfg->HallAngles[Seq[i] + DirIdx] - (uint32)pCfg->HallAngles[Seq[0] + DirIdx]));
+    OfsSum += Ofs[i];
+    Pos = (DirIdx == 0u) ? (Pos + (sint32)Width[i]) : (Pos - (sint32)Width[i]);
+  }
+
+  /* Keep the mean boundary; the exit of a sector is the entry of the other direction */
+  PriMask = __get_PRIMASK();
+  __disable_irq();
+  for(i = 0u; i < 6u; i++)
+  {
+    EmoCcu_HallCal.AngleOfs[Seq[i] + DirIdx] = (sint16)(Ofs[i] - (OfsSum / 6));
+    EmoCcu_HallCal.AngleOfs[Seq[i] + OtherIdx] = (sint16)(Ofs[(i + 1u) % 6u] - (OfsSum / 6));
+    EmoCcu_HallCal.SpeedGain[Seq[i]] = Gain[i];
+  }
+  EmoCcu_HallCal.State = EMOCCU_HALLCAL_DONE;
+  __set_PRIMASK(PriMask);
+
+} /* End of EmoCcu_ExeHallCal */
+
+/** \brief Detects standstill and stall from the time since the last Hall event.
+ *
+ * Without a Hall event for EMOCCU_ZERO_SPEED_MS the speed is set to 0, it
+ * would otherwise stay at the speed of the last commutation period. A started
+ * motor without a Hall event for the stall time is reported by
+ * EmoCcu_GetStall, except during the open-loop BEMF start ramp.
+ *
+ * \return None
+ *
+ * \note Called every ms from Emo_CtrlSpeed.
+ *
+ * \ingroup emo_ccu_api
+ */
+void EmoCcu_CheckStandstill(void)
+{
+  uint32 PriMask;
+  uint32 IdleTime;
+
+  /* Locked: a Hall event in between would be overwritten */
+  PriMask = __get_PRIMASK();
+  __disable_irq();
+  IdleTime = Timebase_GetTicks() - EmoCcu_HallStatus.EventTime;
+  if(IdleTime >= EMOCCU_MS_TO_TICKS(EMOCCU_ZERO_SPEED_MS))
+  {
+    EmoCcu_HallStatus.Speed = 0u;
+    EmoCcu_HallStatus.SpeedLong = 0u;
+    EmoCcu_HallStatus.AngleInc = 0u;
+#if (EMOPLL_EN == 1u)
+    EmoPll_Stop();
+#endif
+  }
+  __set_PRIMASK(PriMask);
+
+  if((EmoCcu_HallStatus.StallTicks != 0u) && (IdleTime >= EmoCcu_HallStatus.StallTicks) &&
+     (Emo_Status.MotorState >= EMO_MOTOR_STATE_START) &&
+     ((Emo_Status.MotorState != EMO_MOTOR_STATE_START) || (EmoCcu_HallStatus.PosSensor != EMO_POS_SENSOR_BEMF)))
+  {
+    EmoCcu_HallStatus.Stall = 1u;
+  }
+
+} /* End of EmoCcu_CheckStandstill */
+
 /** \brief Initializes BC Hall status variables.
  *
  * \return None
@@ -286,14 +583,374 @@ void EmoCcu_InitHallVar(void)
 {
   /* Initialize BC Hall variables */
   EmoCcu_HallStatus.SpeedLong = 0u;
-  EmoCcu_HallStatus.EventTime = 0u;
+  EmoCcu_HallStatus.EventTime = Timebase_GetTicks();
+  EmoCcu_HallStatus.Stall = 0u;
+#if (EMOPLL_EN == 1u)
+  EmoPll_Init();
+#endif
+  EmoCcu_lRestartHallCal();
   EmoCcu_HallStatus.DelayTime = T13_HALL_FILTER_TIME_TICKS;
   EmoCcu_HallStatus.Speed = 0u;
   EmoCcu_HallStatus.StartCtr = 0u;
+
+  /* Assume rotor in the middle of the current Hall sector until speed is known */
+  EmoCcu_HallStatus.AngleAdv = EMO_ANGLE_60DEG_LONG / 2u;
+  EmoCcu_HallStatus.AngleInc = 0u;
+
+  /* Initialize open-loop start for BEMF, first commutation aligns the rotor */
+  EmoCcu_HallStatus.RampPeriod = 0u;
+  EmoCcu_HallStatus.RampCtr = 0u;
+  EmoCcu_HallStatus.RampStartCtr = 0u;
   
 	/* EmoCcu_HallStatus.DirIdx is kept. */
 
 } /* End of EmoCcu_InitHallVar */
 
+/** \brief Switches running PWM from block commutation to sine commutation.
+ *
+ * \return None
+ *
+ * \note Called after Ccu6_Start and before the bridge is enabled.
+ *
+ * \ingroup emo_ccu_api
+ */
+void EmoCcu_StartSine(void)
+{
+  uint16 HalfPeriod;
+
+  /* Start amplitude: the start duty cycle of BC, until the speed control takes over in RUN */
+  EmoCcu_HallStatus.SineAmp = (uint16)(((((uint32)BCHALL_INIT_DUTY) * EMO_PWM_PERIOD_TICKS) / 100u) / 2u);
+
+  /* Zero voltage until the first PWM period: same duty cycle on all phases */
+  HalfPeriod = (uint16)(EMO_PWM_PERIOD_TICKS / 2u);
+  CCU6_LoadShadowRegister_CC60(HalfPeriod);
+  CCU6_LoadShadowRegister_CC61(HalfPeriod);
+  CCU6_LoadShadowRegister_CC62(HalfPeriod);
+  CCU6_EnableST_T12();
+
+  /* Modulate all outputs with T12, Hall patterns are still used for Hall event detection */
+  CCU6_ConfigureGlobalModulation(CCU6_MASK_MODCTR_T12MODEN_ALL);
+
+  /* Enable interrupts for T12 period match and Hall event */
+  CCU6_ClearIntStatus(CCU6_MASK_INT_T12PM);
+  CCU6_EnableInt((uint16)(CCU6_MASK_INT_T12PM | CCU6_MASK_INT_CHE));
+
+} /* End of EmoCcu_StartSine */
+
+/** \brief Executes sine commutation for one PWM period.
+ *
+ * The phase voltages follow the interpolated rotor angle with 90 degrees
+ * lead (forward) or lag (reverse), the amplitude is set by EmoCcu_SetSineAmp.
+ *
+ * \return None
+ *
+ * \note Called from the CCU6 interrupt for T12 period match.
+ *
+ * \ingroup emo_ccu_api
+ */
+void EmoCcu_ExeSine(void)
+{
+  uint16 Angle;
+  sint32 Amp;
+  sint32 HalfPeriod;
+
+  /* Angle of voltage vector */
+  Angle = EmoCcu_UpdateAngle();
+  if(EmoCcu_HallStatus.DirIdx == 0u)
+  {
+    Angle += MAT_ANGLE_90DEG;
+  }
+  else
+  {
+    Angle -= MAT_ANGLE_90DEG;
+  }
+
+  /* Set duty cycles from sine table */
+  Amp = (sint32)EmoCcu_HallStatus.SineAmp;
+  HalfPeriod = (sint32)(EMO_PWM_PERIOD_TICKS / 2u);
+  CCU6_LoadShadowRegister_CC60((uint16)(HalfPeriod + Mat_FixMul(Amp, Mat_Cos(Angle))));
+  CCU6_LoadShadowRegister_CC61((uint16)(HalfPeriod + Mat_FixMul(Amp, Mat_Cos((uint16)(Angle - EMO_ANGLE_120DEG)))));
+  CCU6_LoadShadowRegister_CC62((uint16)(HalfPeriod + Mat_FixMul(Amp, Mat_Cos((uint16)(Angle + EMO_ANGLE_120DEG)))));
+
+  /* Enable shadow transfer for T12 */
+  CCU6_EnableST_T12();
+
+} /* End of EmoCcu_ExeSine */
+
+/** \brief Selects the position sensor for block commutation.
+ *
+ * With BEMF sensing the phase comparators replace the Hall inputs of the CCU6
+ * Hall logic, so zero crossings are handled by EmoCcu_HandleHallEvent including
+ * the T13 commutation delay.
+ *
+ * \param[in] PosSensor EMO_POS_SENSOR_HALL or EMO_POS_SENSOR_BEMF
+ * \return None
+ *
+ * \note May be called while the motor is running, commutation is resynchronized
+ * to the new sensor.
+ *
+ * \ingroup emo_ccu_api
+ */
+void EmoCcu_SetPosSensor(uint8 PosSensor)
+{
+  uint16 IntMask;
+
+  /* Lock CCU6 interrupts while patterns are changed */
+  IntMask = (uint16)CCU6->IEN.reg;
+  CCU6_EnableInt(0u);
+
+  if(PosSensor == EMO_POS_SENSOR_BEMF)
+  {
+    /* Connect BEMF comparators U, V, W to CCPOS0..2 */
+    MF->BEMFC_CTRL_STS.reg = EMOCCU_BEMFC_CTRL_STS_CCPOS;
+    CCU6_CCPOS0_Input_Sel((uint16)CCU6_CCPOS0_BEMF);
+    CCU6_CCPOS1_Input_Sel((uint16)CCU6_CCPOS1_BEMF);
+    CCU6_CCPOS2_Input_Sel((uint16)CCU6_CCPOS2_BEMF);
+
+    /* Commutate with delay after each zero crossing */
+    EmoCcu_HallStatus.pCfg = &EmoCcu_BemfCfg;
+    EmoCcu_HallStatus.PosSensor = EMO_POS_SENSOR_BEMF;
+    EmoCcu_SetDelayCurve(&EmoCcu_BemfDelayCurve);
+    EmoCcu_HallStatus.DelayMinSpeed = 0u;
+  }
+  else
+  {
+    /* Restore Hall inputs */
+    CCU6->PISEL0.reg = CCU6_PISEL0;
+    MF->BEMFC_CTRL_STS.reg = MF_BEMFC_CTRL_STS;
+    EmoCcu_InitHallPar();
+  }
+
+  if(Emo_Status.MotorState >= EMO_MOTOR_STATE_START)
+  {
+    /* Resynchronize commutation to pattern of new sensor */
+    Ccu6_lSetPtns(CCU6_ReadHallReg());
+  }
+
+  CCU6_ClearIntStatus(CCU6_MASK_INT_CHE);
+  CCU6_EnableInt(IntMask);
+
+} /* End of EmoCcu_SetPosSensor */
+
+/** \brief Executes open-loop start for BEMF sensing.
+ *
+ * Commutates to the expected pattern if no zero crossing was detected within the
+ * ramp period. The first commutation is held for the alignment time, so the ramp
+ * starts from a known rotor angle; the ramp period then decreases and the duty
+ * cycle rises with every open-loop commutation. Two zero crossings without
+ * open-loop commutation in between switch to run state.
+ *
+ * \return None
+ *
+ * \note Called every ms while the motor is in start state.
+ *
+ * \ingroup emo_ccu_api
+ */
+void EmoCcu_ExeBemfRamp(void)
+{
+  uint16 IntMask;
+  uint16 DutyCycle;
+  uint32 ExpHallPtn;
+  uint32 Period;
+
+  if(EmoCcu_HallStatus.StartCtr != EmoCcu_HallStatus.RampStartCtr)
+  {
+    /* Zero crossing detected: give commutation time to the next zero crossing */
+    EmoCcu_HallStatus.RampStartCtr = EmoCcu_HallStatus.StartCtr;
+    EmoCcu_HallStatus.RampCtr = 0u;
+  }
+  else
+  {
+    EmoCcu_HallStatus.RampCtr++;
+    if(EmoCcu_HallStatus.RampCtr >= EmoCcu_HallStatus.RampPeriod)
+    {
+      /* Lock CCU6 interrupts while patterns are changed */
+      IntMask = (uint16)CCU6->IEN.reg;
+      CCU6_EnableInt(0u);
+
+      /* Commutate to the pattern expected after the last one, the Hall
+       * patterns in CCU6_MCMOUT may have moved on during alignment */
+      ExpHallPtn = ((uint32)EmoCcu_HallStatus.pCfg->HallOutPtns[EmoCcu_HallStatus.HallPtn + EmoCcu_HallStatus.DirIdx] >> 8u) & 0x7u;
+      if((ExpHallPtn == 0u) || (ExpHallPtn == 7u))
+      {
+        ExpHallPtn = EMOCCU_BEMF_RAMP_INIT_PTN;
+      }
+      Ccu6_lSetPtns(ExpHallPtn);
+
+      /* Restart counting of zero crossings */
+      EmoCcu_HallStatus.StartCtr = 0u;
+      EmoCcu_HallStatus.RampStartCtr = 0u;
+      EmoCcu_HallStatus.RampCtr = 0u;
+
+      if(EmoCcu_HallStatus.RampPeriod == 0u)
+      {
+        /* Hold the first pattern until the rotor is aligned, the comparator
+         * edges of the swinging rotor must not commutate */
+        EmoCcu_HallStatus.RampPeriod = EMOCCU_BEMF_ALIGN_MS;
+        CCU6_ConfigureMultichannelModulation((uint16)Ccu6_lSetMCMCTR(0, 0, 0, 0, 0));
+        IntMask &= (uint16)~CCU6_MASK_INT_CHE;
+      }
+      else if(EmoCcu_HallStatus.RampPeriod > EMOCCU_BEMF_RAMP_START_MS)
+      {
+        /* Aligned: start the ramp, zero crossings switch the patterns again */
+        EmoCcu_HallStatus.RampPeriod = EMOCCU_BEMF_RAMP_START_MS;
+        CCU6_ConfigureMultichannelModulation((uint16)Ccu6_lSetMCMCTR(1, 0, 0, 0, 0));
+        IntMask |= (uint16)CCU6_MASK_INT_CHE;
+      }
+      else if(EmoCcu_HallStatus.RampPeriod > EMOCCU_BEMF_RAMP_END_MS)
+      {
+        EmoCcu_HallStatus.RampPeriod--;
+      }
+      else
+      {
+        /* End of ramp reached */
+      }
+
+      /* Open-loop duty cycle proportional to the commutation frequency */
+      Period = (EmoCcu_HallStatus.RampPeriod < EMOCCU_BEMF_RAMP_START_MS) ? EmoCcu_HallStatus.RampPeriod :
+               EMOCCU_BEMF_RAMP_START_MS;
+      DutyCycle = (uint16)((((EMOCCU_BEMF_RAMP_DUTY * EMO_PWM_PERIOD_TICKS) / 100u) * EMOCCU_BEMF_RAMP_START_MS) / Period);
+      CCU6_LoadShadowRegister_CC60(DutyCycle);
+      CCU6_LoadShadowRegister_CC61(DutyCycle);
+      CCU6_LoadShadowRegister_CC62(DutyCycle);
+      CCU6_EnableST_T12();
+
+      CCU6_ClearIntStatus(CCU6_MASK_INT_CHE);
+      CCU6_EnableInt(IntMask);
+    }
+  }
+
+} /* End of EmoCcu_ExeBemfRamp */
+
+/** \brief Changes the direction of a running motor.
+ *
+ * \param[in] DirIdx Direction index, 0=Forward, 8=Reverse
+ * \return None
+ *
+ * \note Commutation is resynchronized to the patterns of the new direction.
+ * Angle interpolation restarts at the Hall angle of the current pattern.
+ *
+ * \ingroup emo_ccu_api
+ */
+void EmoCcu_Reverse(uint8 DirIdx)
+{
+  uint16 IntMask;
+
+  /* Lock CCU6 interrupts while patterns are changed */
+  IntMask = (uint16)CCU6->IEN.reg;
+  CCU6_EnableInt(0u);
+
+  EmoCcu_HallStatus.DirIdx = DirIdx;
+  EmoCcu_HallStatus.AngleAdv = EMO_ANGLE_60DEG_LONG / 2u;
+  EmoCcu_HallStatus.AngleInc = 0u;
+  EmoCcu_lRestartHallCal();
+  Ccu6_lSetPtns(CCU6_ReadHallReg());
+
+  CCU6_ClearIntStatus(CCU6_MASK_INT_CHE);
+  CCU6_EnableInt(IntMask);
+
+} /* End of EmoCcu_Reverse */
+
+/*******************************************************************************
+**                      Private Function Definitions                          **
+*******************************************************************************/
+/* Sets current and next Hall and output patterns immediately for the given
+ * Hall pattern, according to the configuration of the active position sensor */
+static void Ccu6_lSetPtns(uint32 CurrentHallPtn)
+{
+  const TEmoCcu_Cfg *pCfg;
+  uint32 HallOutPtn;
+  uint32 ExpHallPtn;
+
+  pCfg = EmoCcu_HallStatus.pCfg;
+  EmoCcu_HallStatus.HallPtn = (uint8)CurrentHallPtn;
+  EmoCcu_HallStatus.HallAngle = EmoCcu_lGetHallAngle(pCfg, CurrentHallPtn + EmoCcu_HallStatus.DirIdx);
+
+  if(Emo_Status.Mode == EMO_MODE_BC)
+  {
+    /* Set current/next T12MODEN and MCMEN in CCU60_MODCTR */
+    CCU6_ConfigureGlobalModulation((uint16)pCfg->T12Moden[CurrentHallPtn + EmoCcu_HallStatus.DirIdx]);
+  }
+
+  /* Get current Hall and output patterns from table */
+  HallOutPtn = pCfg->HallOutPtns[CurrentHallPtn + EmoCcu_HallStatus.DirIdx];
+
+  /* Set current Hall and output patterns immediately in MCMOUT */
+  CCU6_WriteMultichannelPatterns((uint16)(HallOutPtn | CCU6_MASK_MCMOUTS_SHADOW_OUT | CCU6_MASK_MCMOUTS_SHADOW_HALL));
+
+  /* Prepare next Hall and output patterns in CCU6_MCMOUTS */
+  ExpHallPtn = (HallOutPtn >> 8u) & 0x7u;
+  CCU6_WriteMultichannelPatterns(pCfg->HallOutPtns[ExpHallPtn + EmoCcu_HallStatus.DirIdx]);
+
+} /* End of Ccu6_lSetPtns */
+
+/* Gets the entry angle of a Hall pattern, Hall sensor angles are corrected by
+ * the learned sector boundaries */
+static uint16 EmoCcu_lGetHallAngle(const TEmoCcu_Cfg *pCfg, uint32 Idx)
+{
+  uint16 Angle;
+
+  Angle = pCfg->HallAngles[Idx];
+  if(EmoCcu_HallStatus.PosSensor == EMO_POS_SENSOR_HALL)
+  {
+    Angle += (uint16)EmoCcu_HallCal.AngleOfs[Idx];
+  }
+  return Angle;
+
+} /* End of EmoCcu_lGetHallAngle */
+
+/* Accumulates the time of a completed Hall sector and the time of each
+ * electrical revolution (any six sectors) for the speed check */
+static void EmoCcu_lLearnHallCal(uint32 HallPtn, uint32 NextHallPtn, uint32 DiffTime)
+{
+  uint32 RevTime;
+
+  EmoCcu_HallCal.Sum[HallPtn] += DiffTime;
+  EmoCcu_HallCal.Next[HallPtn] = (uint8)NextHallPtn;
+  EmoCcu_HallCal.Total += DiffTime;
+  EmoCcu_HallCal.EdgeCtr++;
+  if((EmoCcu_HallCal.EdgeCtr % 6u) == 0u)
+  {
+    RevTime = EmoCcu_HallCal.Total - EmoCcu_HallCal.RevStart;
+    EmoCcu_HallCal.RevStart = EmoCcu_HallCal.Total;
+    if(RevTime < EmoCcu_HallCal.RevMin)
+    {
+      EmoCcu_HallCal.RevMin = RevTime;
+    }
+    if(RevTime > EmoCcu_HallCal.RevMax)
+    {
+      EmoCcu_HallCal.RevMax = RevTime;
+    }
+    if(EmoCcu_HallCal.EdgeCtr >= (EMOCCU_HALLCAL_REVS * 6u))
+    {
+      /* Calculated by EmoCcu_ExeHallCal */
+      EmoCcu_HallCal.State = EMOCCU_HALLCAL_CALC;
+    }
+  }
+
+} /* End of EmoCcu_lLearnHallCal */
+
+/* Clears the sector times, learning restarts at the next complete sector */
+static void EmoCcu_lRestartHallCal(void)
+{
+  uint32 i;
+
+  for(i = 0u; i < 8u; i++)
+  {
+    EmoCcu_HallCal.Sum[i] = 0u;
+    EmoCcu_HallCal.Next[i] = 0u;
+  }
+  EmoCcu_HallCal.Total = 0u;
+  EmoCcu_HallCal.RevStart = 0u;
+  EmoCcu_HallCal.RevMin = 0xFFFFFFFFu;
+  EmoCcu_HallCal.RevMax = 0u;
+  EmoCcu_HallCal.EdgeCtr = 0u;
+  if(EmoCcu_HallCal.State == EMOCCU_HALLCAL_CALC)
+  {
+    EmoCcu_HallCal.State = EMOCCU_HALLCAL_LEARN;
+  }
+
+} /* End of EmoCcu_lRestartHallCal */
+
 
 
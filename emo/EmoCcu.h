@@ -40,6 +40,8 @@
 *******************************************************************************/
 #include "tle_device.h"
 #include "Emo.h"
+#include "EmoPll.h"
+#include "Timebase.h"
 
 /*******************************************************************************
 **                      Global Macro Definitions                              **
@@ -53,46 +55,195 @@
   (((uint32)(T13CLK)) << 8u) | \
   (((uint32)(T13PRE)) << 11u) )
 
+/* Constants for CCU6 interrupt registers */
+#define CCU6_MASK_INT_T12PM (0x0080u)
+#define CCU6_MASK_INT_CHE   (0x1000u)
+
+/* Electrical angle of one Hall sector (angle 0..65535 = 0..360 degrees) */
+#define EMO_ANGLE_60DEG (10923u)
+#define EMO_ANGLE_120DEG (21845u)
+
+/* Electrical angle of one Hall sector including fractional part */
+#define EMO_ANGLE_60DEG_LONG (((uint32)EMO_ANGLE_60DEG) << 16u)
+
+/* Time without Hall event after which the speed is 0 [ms], 50 rpm per pole pair */
+#define EMOCCU_ZERO_SPEED_MS (200u)
+
+/* Default time without Hall event after which a started motor is stalled [ms], 0 = off */
+#define EMOCCU_STALL_MS (500u)
+
+/* Commutation delay table: speed step 2^x rpm, steps (last step for all higher speeds) */
+#define EMOCCU_DELAY_SPEED_SHIFT (7u)
+#define EMOCCU_DELAY_TAB_NUM (64u)
+
+/* Speed in the middle of delay table step I [rpm] */
+#define EMOCCU_DELAY_STEP_SPEED(I) \
+  ((((uint32)(I)) << EMOCCU_DELAY_SPEED_SHIFT) + (1u << (EMOCCU_DELAY_SPEED_SHIFT - 1u)))
+
+/* Delay angle [1/256 degrees] at speed S between points (SA, AA) and (SB, AB) */
+#define EMOCCU_DELAY_INTERP(S, SA, AA, SB, AB) \
+  (((((uint32)(AA) << 8u) * ((SB) - (S))) + (((uint32)(AB) << 8u) * ((S) - (SA)))) / \
+   (((SB) > (SA)) ? ((SB) - (SA)) : 1u))
+
+/* Delay angle [1/256 degrees] at speed S of a four point curve, linear between
+ * the points, constant outside */
+#define EMOCCU_DELAY_ANGLE(S, S0, A0, S1, A1, S2, A2, S3, A3) \
+  (((S) <= (S0)) ? ((uint32)(A0) << 8u) : \
+   (((S) < (S1)) ? EMOCCU_DELAY_INTERP(S, S0, A0, S1, A1) : \
+    (((S) < (S2)) ? EMOCCU_DELAY_INTERP(S, S1, A1, S2, A2) : \
+     (((S) < (S3)) ? EMOCCU_DELAY_INTERP(S, S2, A2, S3, A3) : ((uint32)(A3) << 8u)))))
+
+/* Delay angle [1/256 degrees] to delay time / commutation period, 65535 = 60 degrees */
+#define EMOCCU_DELAY_FAC(ANGLE) \
+  ((uint16)(((ANGLE) >= (60u << 8u)) ? 0xFFFFu : ((((ANGLE) * 65536u) + (30u << 8u)) / (60u << 8u))))
+
+/* Delay table entries I..I+7 of a four point curve */
+#define EMOCCU_DELAY_STEP(I, S0, A0, S1, A1, S2, A2, S3, A3) \
+  EMOCCU_DELAY_FAC(EMOCCU_DELAY_ANGLE(EMOCCU_DELAY_STEP_SPEED(I), S0, A0, S1, A1, S2, A2, S3, A3))
+#define EMOCCU_DELAY_STEP8(I, S0, A0, S1, A1, S2, A2, S3, A3) \
+  EMOCCU_DELAY_STEP((I), S0, A0, S1, A1, S2, A2, S3, A3), \
+  EMOCCU_DELAY_STEP((I) + 1u, S0, A0, S1, A1, S2, A2, S3, A3), \
+  EMOCCU_DELAY_STEP((I) + 2u, S0, A0, S1, A1, S2, A2, S3, A3), \
+  EMOCCU_DELAY_STEP((I) + 3u, S0, A0, S1, A1, S2, A2, S3, A3), \
+  EMOCCU_DELAY_STEP((I) + 4u, S0, A0, S1, A1, S2, A2, S3, A3), \
+  EMOCCU_DELAY_STEP((I) + 5u, S0, A0, S1, A1, S2, A2, S3, A3), \
+  EMOCCU_DELAY_STEP((I) + 6u, S0, A0, S1, A1, S2, A2, S3, A3), \
+  EMOCCU_DELAY_STEP((I) + 7u, S0, A0, S1, A1, S2, A2, S3, A3)
+
+/* Initializer of a TEmoCcu_DelayCurve from the speed [rpm] and delay angle
+ * [degrees] of four points, speeds ascending, angles 0..60. The table is
+ * sampled in the middle of each speed step at compile time. */
+#define EMOCCU_DELAY_CURVE(S0, A0, S1, A1, S2, A2, S3, A3) \
+  { { EMOCCU_DELAY_STEP8(0u, S0, A0, S1, A1, S2, A2, S3, A3), \
+      EMOCCU_DELAY_STEP8(8u, S0, A0, S1, A1, S2, A2, S3, A3), \
+      EMOCCU_DELAY_STEP8(16u, S0, A0, S1, A1, S2, A2, S3, A3), \
+      EMOCCU_DELAY_STEP8(24u, S0, A0, S1, A1, S2, A2, S3, A3), \
+      EMOCCU_DELAY_STEP8(32u, S0, A0, S1, A1, S2, A2, S3, A3), \
+      EMOCCU_DELAY_STEP8(40u, S0, A0, S1, A1, S2, A2, S3, A3), \
+      EMOCCU_DELAY_STEP8(48u, S0, A0, S1, A1, S2, A2, S3, A3), \
+      EMOCCU_DELAY_STEP8(56u, S0, A0, S1, A1, S2, A2, S3, A3) } }
+
+/* Numerator for calculation of speed from commutation period:
+ * speed [rpm] = numerator / (commutation period [T6 timer ticks])
+ * numerator = T6 timer frequency [Hertz] * 60 / (6 * pole pairs), round to nearest */
+#define EMOCCU_SPEED_FROM_PERIOD_NUM ((uint32)((((EMO_FSYS_HZ / (float)TIMEBASE_T6_DIV) * 60.0) / (6.0 * (float)BCHALL_POLE_PAIRS)) + 0.5))
+
+/* Shortest commutation period with a speed below 65536 rpm [T6 ticks], shorter
+ * periods (including 0) saturate the speed instead of truncating the quotient */
+#define EMOCCU_SPEED_PERIOD_MIN ((uint16)((EMOCCU_SPEED_FROM_PERIOD_NUM + 65534u) / 65535u))
+
+/* Hall sector calibration states */
+#define EMOCCU_HALLCAL_IDLE  (0u)   /* ideal or previously learned sectors */
+#define EMOCCU_HALLCAL_LEARN (1u)   /* accumulating sector times */
+#define EMOCCU_HALLCAL_CALC  (2u)   /* sector times complete, table is calculated */
+#define EMOCCU_HALLCAL_DONE  (3u)   /* learned sectors applied */
+#define EMOCCU_HALLCAL_FAIL  (4u)   /* speed not constant or sector out of range, table unchanged */
+
+/* Sector speed gain of an ideal 60 degree sector */
+#define EMOCCU_HALLCAL_GAIN_ONE (16384u)
+
 /*******************************************************************************
 **                      Global Type Definitions                               **
 *******************************************************************************/
+/** \brief CCU6 configuration for block commutation, active freewheeling
+ */
+typedef struct
+{
+  uint16 HallOutPtns[16];    /**< \brief Hall and output patterns */
+  uint8 T12Moden[16];        /**< \brief T12 modulation enable patterns */
+  uint16 HallAngles[16];     /**< \brief Electrical angles at entry of Hall patterns */
+} TEmoCcu_Cfg;
+
+/** \brief Commutation delay after the Hall event as a function of speed,
+ * one entry per speed step. Built by EMOCCU_DELAY_CURVE, const in flash.
+ */
+typedef struct
+{
+  uint16 Fac[EMOCCU_DELAY_TAB_NUM]; /**< \brief Delay time / commutation period per speed step, 65535 = 60 degrees */
+} TEmoCcu_DelayCurve;
+
 typedef struct
 {
+  const TEmoCcu_Cfg *pCfg; /**< \brief Pattern configuration of active position sensor */
   uint32 SpeedLong;     /**< \brief Speed, including fractional part */
   uint16 Speed;         /**< \brief Speed [rpm] */
-  uint16 EventTime;     /**< \brief Last event time [T3 timer ticks] */
+  uint32 EventTime;     /**< \brief Last event time, Timebase_GetTicks [T6 timer ticks] */
+  uint32 StallTicks;    /**< \brief Time without Hall event for stall detection [T6 timer ticks], 0 = off */
+  uint8 Stall;          /**< \brief Started motor without Hall event for StallTicks */
   uint16 DelayTime;     /**< \brief Delay time for Hall [T13 timer ticks] */
   uint16 DelayMinSpeed; /**< \brief Minimum (absolute) speed for Hall delay */
-  uint8 DelayAngle;     /**< \brief Delay angle for Hall [degrees] */
+  const TEmoCcu_DelayCurve *pDelayCurve; /**< \brief Commutation delay curve */
   uint8 StartCtr;       /**< \brief Start counter */
   uint8 DirIdx;         /**< \brief Direction index, 0=Forward, 8=Reverse */
+  uint8 HallPtn;        /**< \brief Current Hall pattern (1..6) */
+  uint16 HallAngle;     /**< \brief Electrical angle at last Hall event */
+  uint16 Angle;         /**< \brief Interpolated electrical angle (0..65535 = 0..360 degrees) */
+  uint32 AngleAdv;      /**< \brief Angle advanced since last Hall event, including fractional part */
+  uint32 AngleInc;      /**< \brief Angle increment per PWM period, including fractional part */
+  uint16 SineAmp;       /**< \brief Phase voltage amplitude for sine commutation [T12 timer ticks] */
+  uint8 PosSensor;      /**< \brief Position sensor, EMO_POS_SENSOR_HALL or EMO_POS_SENSOR_BEMF */
+  uint8 RampPeriod;     /**< \brief Open-loop commutation period for BEMF start [ms] */
+  uint8 RampCtr;        /**< \brief Time since last commutation for BEMF start [ms] */
+  uint8 RampStartCtr;   /**< \brief Start counter at last BEMF start ramp step */
 } TEmoCcu_HallStatus;
 
-/** \brief CCU6 configuration for block commutation, active freewheeling
+/** \brief Learned Hall sector correction and learning state
  */
 typedef struct
 {
-  uint16 HallOutPtns[16];    /**< \brief Hall and output patterns */
-  uint8 T12Moden[16];        /**< \brief T12 modulation enable patterns */
-} TEmoCcu_Cfg;
+  sint16 AngleOfs[16];  /**< \brief Correction of HallAngles per Hall pattern and direction */
+  uint16 SpeedGain[8];  /**< \brief Sector width / 60 degrees per Hall pattern, 1.0 = EMOCCU_HALLCAL_GAIN_ONE */
+  uint32 Sum[8];        /**< \brief Learning: time in Hall pattern [T6 timer ticks] */
+  uint8 Next[8];        /**< \brief Learning: Hall pattern following the Hall pattern */
+  uint32 Total;         /**< \brief Learning: time of all sectors [T6 timer ticks] */
+  uint32 RevStart;      /**< \brief Learning: Total at the start of the current revolution */
+  uint32 RevMin;        /**< \brief Learning: shortest electrical revolution [T6 timer ticks] */
+  uint32 RevMax;        /**< \brief Learning: longest electrical revolution [T6 timer ticks] */
+  uint16 EdgeCtr;       /**< \brief Learning: Hall events */
+  uint8 State;          /**< \brief Calibration state (EMOCCU_HALLCAL_x) */
+} TEmoCcu_HallCal;
 
 /*******************************************************************************
 **                      Global Variable Declarations                          **
 *******************************************************************************/
 extern const TEmoCcu_Cfg EmoCcu_Cfg;
+extern const TEmoCcu_Cfg EmoCcu_BemfCfg;
+extern const TEmoCcu_DelayCurve EmoCcu_DelayCurve;
+extern const TEmoCcu_DelayCurve EmoCcu_BemfDelayCurve;
 extern TEmoCcu_HallStatus EmoCcu_HallStatus;
+extern TEmoCcu_HallCal EmoCcu_HallCal;
 
 /*******************************************************************************
 **                      Global Function Declarations                          **
 *******************************************************************************/
 extern void Ccu6_Start(void);
 extern void Ccu6_Stop(void);
+extern void EmoCcu_HandleHallEvent(void);
 extern void EmoCcu_InitHallVar(void);
 extern void EmoCcu_InitHallPar(void);
+extern void EmoCcu_CheckStandstill(void);
+extern void EmoCcu_SetStallTime(uint16 StallMs);
+extern void EmoCcu_SetDelayCurve(const TEmoCcu_DelayCurve *pCurve);
+extern void EmoCcu_ClearHallCal(void);
+extern void EmoCcu_StartHallCal(void);
+extern void EmoCcu_ExeHallCal(void);
+extern void EmoCcu_StartSine(void);
+extern void EmoCcu_ExeSine(void);
+extern void EmoCcu_SetPosSensor(uint8 PosSensor);
+extern void EmoCcu_ExeBemfRamp(void);
+extern void EmoCcu_Reverse(uint8 DirIdx);
 
 __STATIC_INLINE void EmoCcu_SetDirIdx(uint8 DirIdx);
 __STATIC_INLINE uint8 EmoCcu_GetDirIdx(void);
 __STATIC_INLINE uint16 EmoCcu_GetSpeed(void);
+__STATIC_INLINE bool EmoCcu_GetStall(void);
+__STATIC_INLINE uint8 EmoCcu_GetHallCalState(void);
+__STATIC_INLINE uint8 EmoCcu_GetHallPtn(void);
+__STATIC_INLINE uint8 EmoCcu_GetPosSensor(void);
+__STATIC_INLINE uint16 EmoCcu_UpdateAngle(void);
+__STATIC_INLINE void EmoCcu_SetSineAmp(uint16 SineAmp);
+__STATIC_INLINE uint32 EmoCcu_SpeedFromPeriod(uint32 Period);
+__STATIC_INLINE uint32 EmoCcu_GetDelayFac(const TEmoCcu_DelayCurve *pCurve, uint32 Speed);
 
 /*******************************************************************************
 **                      Global Inline Function Definitions                    **
@@ -134,6 +285,153 @@ __STATIC_INLINE uint16 EmoCcu_GetSpeed(void)
   return EmoCcu_HallStatus.Speed;
 } /* End of Ccu6_GetSpeed */
 
+/** \brief Gets the result of the stall detection.
+ *
+ * \return true if the started motor had no Hall event for the stall time
+ *
+ * \ingroup emo_ccu_api
+ */
+__STATIC_INLINE bool EmoCcu_GetStall(void)
+{
+  return (EmoCcu_HallStatus.Stall != 0u) ? true : false;
+} /* End of EmoCcu_GetStall */
+
+/** \brief Gets the state of the Hall sector calibration.
+ *
+ * \return EMOCCU_HALLCAL_x
+ *
+ * \ingroup emo_ccu_api
+ */
+__STATIC_INLINE uint8 EmoCcu_GetHallCalState(void)
+{
+  return EmoCcu_HallCal.State;
+} /* End of EmoCcu_GetHallCalState */
+
+/** \brief Gets the current Hall pattern.
+ *
+ * \return Hall pattern of the last correct Hall event (1..6)
+ *
+ * \ingroup emo_ccu_api
+ */
+__STATIC_INLINE uint8 EmoCcu_GetHallPtn(void)
+{
+  return EmoCcu_HallStatus.HallPtn;
+} /* End of EmoCcu_GetHallPtn */
+
+/** \brief Gets the active position sensor.
+ *
+ * \return EMO_POS_SENSOR_HALL or EMO_POS_SENSOR_BEMF
+ *
+ * \ingroup emo_ccu_api
+ */
+__STATIC_INLINE uint8 EmoCcu_GetPosSensor(void)
+{
+  return EmoCcu_HallStatus.PosSensor;
+} /* End of EmoCcu_GetPosSensor */
+
+/** \brief Interpolates the electrical angle for the next PWM period.
+ *
+ * The angle is extrapolated from the last Hall event with the speed of the
+ * last Hall sector and held at the sector end until the next Hall event.
+ * With EMOPLL_EN the angle is taken from the Hall PLL observer instead.
+ *
+ * \return Electrical angle (0..65535 = 0..360 degrees)
+ *
+ * \note Called once per PWM period from the CCU6 interrupt.
+ *
+ * \ingroup emo_ccu_api
+ */
+__STATIC_INLINE uint16 EmoCcu_UpdateAngle(void)
+{
+  uint16 Angle;
+#if (EMOPLL_EN == 1u)
+
+  /* Angle predicted by the observer, also limited to one Hall sector */
+  Angle = EmoPll_GetAngle(Timebase_GetTicks());
+#else
+  uint32 AngleAdv;
+
+  /* Advance angle, limit to one Hall sector */
+  AngleAdv = EmoCcu_HallStatus.AngleAdv + EmoCcu_HallStatus.AngleInc;
+  if(AngleAdv > EMO_ANGLE_60DEG_LONG)
+  {
+    AngleAdv = EMO_ANGLE_60DEG_LONG;
+  }
+  EmoCcu_HallStatus.AngleAdv = AngleAdv;
+
+  if(EmoCcu_HallStatus.DirIdx == 0u)
+  {
+    Angle = (uint16)(EmoCcu_HallStatus.HallAngle + (AngleAdv >> 16u));
+  }
+  else
+  {
+    Angle = (uint16)(EmoCcu_HallStatus.HallAngle - (AngleAdv >> 16u));
+  }
+#endif
+  EmoCcu_HallStatus.Angle = Angle;
+
+  return Angle;
+} /* End of EmoCcu_UpdateAngle */
+
+/** \brief Sets the phase voltage amplitude for sine commutation.
+ *
+ * \param[in] SineAmp Amplitude [T12 timer ticks], 0..EMO_PWM_PERIOD_TICKS/2
+ * \return None
+ *
+ * \ingroup emo_ccu_api
+ */
+__STATIC_INLINE void EmoCcu_SetSineAmp(uint16 SineAmp)
+{
+  EmoCcu_HallStatus.SineAmp = SineAmp;
+} /* End of EmoCcu_SetSineAmp */
+
+/** \brief Calculates the speed from a commutation period.
+ *
+ * A single UDIV on the Cortex-M3 (2..12 cycles, exact), periods shorter than
+ * EMOCCU_SPEED_PERIOD_MIN saturate.
+ *
+ * \param[in] Period Commutation period [T6 timer ticks]
+ * \return Speed [rpm], 0..65535
+ *
+ * \ingroup emo_ccu_api
+ */
+__STATIC_INLINE uint32 EmoCcu_SpeedFromPeriod(uint32 Period)
+{
+  uint32 Speed;
+
+  if(Period >= EMOCCU_SPEED_PERIOD_MIN)
+  {
+    Speed = EMOCCU_SPEED_FROM_PERIOD_NUM / Period;
+  }
+  else
+  {
+    Speed = 0xFFFFu;
+  }
+  return Speed;
+} /* End of EmoCcu_SpeedFromPeriod */
+
+/** \brief Looks up the commutation delay of a speed.
+ *
+ * One shift, a clamp and a table load.
+ *
+ * \param[in] pCurve Delay curve
+ * \param[in] Speed Sector speed [rpm]
+ * \return Delay time / commutation period, 65535 = 60 degrees
+ *
+ * \ingroup emo_ccu_api
+ */
+__STATIC_INLINE uint32 EmoCcu_GetDelayFac(const TEmoCcu_DelayCurve *pCurve, uint32 Speed)
+{
+  uint32 Idx;
+
+  Idx = Speed >> EMOCCU_DELAY_SPEED_SHIFT;
+  if(Idx >= EMOCCU_DELAY_TAB_NUM)
+  {
+    Idx = EMOCCU_DELAY_TAB_NUM - 1u;
+  }
+  return pCurve->Fac[Idx];
+} /* End of EmoCcu_GetDelayFac */
+
 
 #endif /* #ifndef EMO_CCU_H_ */
 
@@ -41,6 +41,16 @@
   (((uint32)(EXPHS)) << 8u) | \
   (((uint32)(CURHS)) << 11U ) )
 
+/* Electrical angle in degrees to angle format (0..65535 = 0..360 degrees) */
+#define Ccu6_SetAngle(DEG) \
+  ((uint16)(((((uint32)(DEG)) * 65536u) + 180u) / 360u))
+
+/* Delay angle of the BC Hall configuration [degrees] */
+#define EMOCCU_HALL_DELAY_ANGLE ((BCHALL_ANGLE_DELAY_EN == 0) ? 0u : BCHALL_DELAY_ANGLE)
+
+/* Commutation delay after BEMF zero crossing [degrees] */
+#define EMOCCU_BEMF_DELAY_ANGLE (30u)
+
 /*******************************************************************************
 **                      Global Constant Definitions to be changed             **
 *******************************************************************************/
@@ -131,5 +141,141 @@ const TEmoCcu_Cfg EmoCcu_Cfg =
     (uint8)(0x00)         /* Hall pattern=7, reverse direction (error) */
   },
 #endif /* (BCHALL_OFFSET_60DEGREE_EN == 1) */
+
+  /* HallAngles[16] - Electrical angles at entry of Hall patterns
+   * Forward: angle at the start of the Hall sector, reverse: angle at its end.
+   * Used for angle interpolation, must match the rotor flux angle for FOC */
+#if (BCHALL_OFFSET_60DEGREE_EN == 0) 
+  {
+    Ccu6_SetAngle(0),   /* Hall pattern=0, forward direction (error) */
+    Ccu6_SetAngle(0),   /* Hall pattern=1, forward direction */
+    Ccu6_SetAngle(120), /* Hall pattern=2, forward direction */
+    Ccu6_SetAngle(60),  /* Hall pattern=3, forward direction */
+    Ccu6_SetAngle(240), /* Hall pattern=4, forward direction */
+    Ccu6_SetAngle(300), /* Hall pattern=5, forward direction */
+    Ccu6_SetAngle(180), /* Hall pattern=6, forward direction */
+    Ccu6_SetAngle(0),   /* Hall pattern=7, forward direction (error) */
+    Ccu6_SetAngle(0),   /* Hall pattern=0, reverse direction (error) */
+    Ccu6_SetAngle(60),  /* Hall pattern=1, reverse direction */
+    Ccu6_SetAngle(180), /* Hall pattern=2, reverse direction */
+    Ccu6_SetAngle(120), /* Hall pattern=3, reverse direction */
+    Ccu6_SetAngle(300), /* Hall pattern=4, reverse direction */
+    Ccu6_SetAngle(0),   /* Hall pattern=5, reverse direction */
+    Ccu6_SetAngle(240), /* Hall pattern=6, reverse direction */
+    Ccu6_SetAngle(0)    /* Hall pattern=7, reverse direction (error) */
+  },
+#else /* (BCHALL_OFFSET_60DEGREE_EN == 1) */
+  {
+    Ccu6_SetAngle(0),   /* Hall pattern=0, forward direction (error) */
+    Ccu6_SetAngle(60),  /* Hall pattern=1, forward direction */
+    Ccu6_SetAngle(180), /* Hall pattern=2, forward direction */
+    Ccu6_SetAngle(120), /* Hall pattern=3, forward direction */
+    Ccu6_SetAngle(300), /* Hall pattern=4, forward direction */
+    Ccu6_SetAngle(0),   /* Hall pattern=5, forward direction */
+    Ccu6_SetAngle(240), /* Hall pattern=6, forward direction */
+    Ccu6_SetAngle(0),   /* Hall pattern=7, forward direction (error) */
+    Ccu6_SetAngle(0),   /* Hall pattern=0, reverse direction (error) */
+    Ccu6_SetAngle(120), /* Hall pattern=1, reverse direction */
+    Ccu6_SetAngle(240), /* Hall pattern=2, reverse direction */
+    Ccu6_SetAngle(180), /* Hall pattern=3, reverse direction */
+    Ccu6_SetAngle(0),   /* Hall pattern=4, reverse direction */
+    Ccu6_SetAngle(60),  /* Hall pattern=5, reverse direction */
+    Ccu6_SetAngle(300), /* Hall pattern=6, reverse direction */
+    Ccu6_SetAngle(0)    /* Hall pattern=7, reverse direction (error) */
+  },
+#endif /* (BCHALL_OFFSET_60DEGREE_EN == 1) */
 }; /* End of EmoCcu_Cfg */
 
+
+/* BEMF comparator patterns: bit 0 = phase U, bit 1 = phase V, bit 2 = phase W,
+ * a bit is set while the phase voltage is above the star point. The pattern
+ * changes at the zero crossing of the floating phase; the output switches to the
+ * next step after the T13 delay of 30 degrees. Electrical angles are only
+ * informative, BEMF sensing is used for block commutation only. */
+const TEmoCcu_Cfg EmoCcu_BemfCfg =
+{
+  /* HallOutPtns[16] - BEMF and output patterns
+   * Value = f(current BEMF pattern, expected BEMF pattern, output pattern)
+   */
+  { 
+    (uint16)Ccu6_SetPtns(0, 0, 0x00), /* BEMF pattern=0, forward direction (error) */
+    (uint16)Ccu6_SetPtns(1, 3, 0x31), /* BEMF pattern=1, forward direction */
+    (uint16)Ccu6_SetPtns(2, 6, 0x07), /* BEMF pattern=2, forward direction */
+    (uint16)Ccu6_SetPtns(3, 2, 0x34), /* BEMF pattern=3, forward direction */
+    (uint16)Ccu6_SetPtns(4, 5, 0x1C), /* BEMF pattern=4, forward direction */
+    (uint16)Ccu6_SetPtns(5, 1, 0x0D), /* BEMF pattern=5, forward direction */
+    (uint16)Ccu6_SetPtns(6, 4, 0x13), /* BEMF pattern=6, forward direction */
+    (uint16)Ccu6_SetPtns(0, 0, 0x00), /* BEMF pattern=7, forward direction (error) */
+    (uint16)Ccu6_SetPtns(0, 0, 0x00), /* BEMF pattern=0, reverse direction (error) */
+    (uint16)Ccu6_SetPtns(1, 5, 0x0D), /* BEMF pattern=1, reverse direction */
+    (uint16)Ccu6_SetPtns(2, 3, 0x34), /* BEMF pattern=2, reverse direction */
+    (uint16)Ccu6_SetPtns(3, 1, 0x31), /* BEMF pattern=3, reverse direction */
+    (uint16)Ccu6_SetPtns(4, 6, 0x13), /* BEMF pattern=4, reverse direction */
+    (uint16)Ccu6_SetPtns(5, 4, 0x1C), /* BEMF pattern=5, reverse direction */
+    (uint16)Ccu6_SetPtns(6, 2, 0x07), /* BEMF pattern=6, reverse direction */
+    (uint16)Ccu6_SetPtns(0, 0, 0x00)  /* BEMF pattern=7, reverse direction (error) */
+  },
+
+  /* T12Moden - T12 modulation enable patterns 
+   * Table value = 0x80(MCMEN) + pattern for T12MODEN
+   * Pattern = COUT62*32 + CC62*16 + COUT61*8 + CC61*4 + COUT60*2 + CC60 */
+  {
+    (uint8)(0x00),        /* BEMF pattern=0, forward direction (error) */
+    (uint8)(0x80 + 0x30), /* BEMF pattern=1, forward direction */
+    (uint8)(0x80 + 0x03), /* BEMF pattern=2, forward direction */
+    (uint8)(0x80 + 0x30), /* BEMF pattern=3, forward direction */
+    (uint8)(0x80 + 0x0C), /* BEMF pattern=4, forward direction */
+    (uint8)(0x80 + 0x0C), /* BEMF pattern=5, forward direction */
+    (uint8)(0x80 + 0x03), /* BEMF pattern=6, forward direction */
+    (uint8)(0x00),        /* BEMF pattern=7, forward direction (error) */
+    (uint8)(0x00),        /* BEMF pattern=0, reverse direction (error) */
+    (uint8)(0x80 + 0x0C), /* BEMF pattern=1, reverse direction */
+    (uint8)(0x80 + 0x30), /* BEMF pattern=2, reverse direction */
+    (uint8)(0x80 + 0x30), /* BEMF pattern=3, reverse direction */
+    (uint8)(0x80 + 0x03), /* BEMF pattern=4, reverse direction */
+    (uint8)(0x80 + 0x0C), /* BEMF pattern=5, reverse direction */
+    (uint8)(0x80 + 0x03), /* BEMF pattern=6, reverse direction */
+    (uint8)(0x00)         /* BEMF pattern=7, reverse direction (error) */
+  },
+
+  /* HallAngles[16] - Electrical angles at commutation after zero crossing */
+  {
+    Ccu6_SetAngle(0),   /* BEMF pattern=0, forward direction (error) */
+    Ccu6_SetAngle(120), /* BEMF pattern=1, forward direction */
+    Ccu6_SetAngle(240), /* BEMF pattern=2, forward direction */
+    Ccu6_SetAngle(180), /* BEMF pattern=3, forward direction */
+    Ccu6_SetAngle(0),   /* BEMF pattern=4, forward direction */
+    Ccu6_SetAngle(60),  /* BEMF pattern=5, forward direction */
+    Ccu6_SetAngle(300), /* BEMF pattern=6, forward direction */
+    Ccu6_SetAngle(0),   /* BEMF pattern=7, forward direction (error) */
+    Ccu6_SetAngle(0),   /* BEMF pattern=0, reverse direction (error) */
+    Ccu6_SetAngle(120), /* BEMF pattern=1, reverse direction */
+    Ccu6_SetAngle(240), /* BEMF pattern=2, reverse direction */
+    Ccu6_SetAngle(180), /* BEMF pattern=3, reverse direction */
+    Ccu6_SetAngle(0),   /* BEMF pattern=4, reverse direction */
+    Ccu6_SetAngle(60),  /* BEMF pattern=5, reverse direction */
+    Ccu6_SetAngle(300), /* BEMF pattern=6, reverse direction */
+    Ccu6_SetAngle(0)    /* BEMF pattern=7, reverse direction (error) */
+  },
+}; /* End of EmoCcu_BemfCfg */
+
+
+/* Commutation delay after the Hall event above BCHALL_DELAY_MINSPEED. The
+ * current lags the voltage by the winding time constant, which is a growing
+ * angle at high speed; a delay decreasing with speed advances commutation to
+ * keep the current in phase with the BEMF. Default: the constant BC Hall delay
+ * angle at all speeds. */
+const TEmoCcu_DelayCurve EmoCcu_DelayCurve =
+  /* Speed [rpm], delay angle [degrees] of the points */
+  EMOCCU_DELAY_CURVE(   0u, EMOCCU_HALL_DELAY_ANGLE,
+                     2000u, EMOCCU_HALL_DELAY_ANGLE,
+                     4000u, EMOCCU_HALL_DELAY_ANGLE,
+                     6000u, EMOCCU_HALL_DELAY_ANGLE); /* End of EmoCcu_DelayCurve */
+
+/* Commutation delay after the BEMF zero crossing at all speeds */
+const TEmoCcu_DelayCurve EmoCcu_BemfDelayCurve =
+  /* Speed [rpm], delay angle [degrees] of the points */
+  EMOCCU_DELAY_CURVE(0u, EMOCCU_BEMF_DELAY_ANGLE,
+                     0u, EMOCCU_BEMF_DELAY_ANGLE,
+                     0u, EMOCCU_BEMF_DELAY_ANGLE,
+                     0u, EMOCCU_BEMF_DELAY_ANGLE); /* End of EmoCcu_BemfDelayCurve */
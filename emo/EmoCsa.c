@@ -0,0 +1,155 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, single shunt current measurement taken from EmoFoc
+ */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include "EmoCsa.h"
+#include "adc1_defines.h"
+#include "csa_defines.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+/* Number of samples for CSA offset calibration = 2^shift */
+#define EMOCSA_OFFSET_CAL_SHIFT (4u)
+#define EMOCSA_OFFSET_CAL_SAMPLES (1u << EMOCSA_OFFSET_CAL_SHIFT)
+
+/* Factor from CSA sample [10-bit ADC counts] to current: 1.0 = 1024 ADC counts */
+#define EMOCSA_CURRENT_SCALE (32)
+
+/* Timer3 trigger input selection: CCU6 T12 period match */
+#define EMOCSA_T3_TRIGG_T12_PM (4u)
+
+/* Timer3 mode 1b: 16-bit timer started by trigger input */
+#define EMOCSA_T3_MODE_1B ((1u << TIMER3_MODE_CONF_T3M_Pos) | (1u << TIMER3_MODE_CONF_T3_SUBM_Pos))
+
+/*******************************************************************************
+**                      Global Variable Definitions                           **
+*******************************************************************************/
+TEmoCsa_Status EmoCsa_Status;
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+/** \brief Starts the single shunt current measurement.
+ *
+ * Timer3 is started by every T12 period match and its compare match triggers
+ * an ADC1 EIM conversion of the CSA. The first samples calibrate the CSA offset
+ * and should be taken at zero current.
+ *
+ * \param[in] SampleTick First sample point after T12 period match [Timer3 ticks]
+ * \return None
+ *
+ * \ingroup emo_csa_api
+ */
+void EmoCsa_Start(uint16 SampleTick)
+{
+  /* Enable CSA and connect it to ADC1 channel 1 */
+  CSA->CTRL.reg = (uint32)MF_CSA_CTRL | MF_CSA_CTRL_EN_Msk;
+  MF->P2_ADCSEL_CTRL.reg |= MF_P2_ADCSEL_CTRL_ADC1_CH1_SEL_Msk;
+
+  /* Timer3 in mode 1b, (re)started by T12 period match, compare match is the sample point */
+  TIMER3->CTRL.reg = TIMER3_CTRL_T3_PD_N_Msk;
+  TIMER3->MODE_CONF.reg = EMOCSA_T3_MODE_1B;
+  TIMER3->T3_TRIGG_CTRL.reg = (EMOCSA_T3_TRIGG_T12_PM << TIMER3_T3_TRIGG_CTRL_T3_TRIGG_INP_SEL_Pos) | TIMER3_T3_TRIGG_CTRL_RETRIG_Msk;
+  TIMER3->CMP.reg = SampleTick;
+  TIMER3->CTRL.reg = TIMER3_CTRL_T3_PD_N_Msk | TIMER3_CTRL_TR3L_Msk;
+
+  /* ADC1 EIM: one CSA conversion per Timer3 trigger */
+  ADC1->CHx_EIM.reg = (((uint32)ADC1_Trigg_Timer3) << ADC1_CHx_EIM_TRIG_SEL_Pos) |
+                      (((uint32)ADC1_1_Meas) << ADC1_CHx_EIM_REP_Pos) |
+                      (uint32)ADC1_CSA;
+
+  /* Start offset calibration */
+  EmoCsa_Status.OffsetSum = 0u;
+  EmoCsa_Status.OffsetCtr = (uint8)EMOCSA_OFFSET_CAL_SAMPLES;
+
+} /* End of EmoCsa_Start */
+
+/** \brief Stops the single shunt current measurement.
+ *
+ * \return None
+ *
+ * \ingroup emo_csa_api
+ */
+void EmoCsa_Stop(void)
+{
+  /* Restore configuration of Timer3, ADC1 EIM and CSA */
+  TIMER3->CTRL.reg = TIMER3_CTRL;
+  ADC1->CHx_EIM.reg = ADC1_CHx_EIM;
+  CSA->CTRL.reg = MF_CSA_CTRL;
+  MF->P2_ADCSEL_CTRL.reg = MF_P2_ADCSEL_CTRL;
+
+} /* End of EmoCsa_Stop */
+
+/** \brief Gets the current of the last sample.
+ *
+ * While the offset is calibrated, samples are accumulated and no current is returned.
+ *
+ * \param[out] pCurrent Current (1.0 = 1024 ADC counts), positive = from DC link into bridge
+ * \return true if a new current is valid
+ *
+ * \note Called once per PWM period from the CCU6 interrupt for T12 period match.
+ *
+ * \ingroup emo_csa_api
+ */
+bool EmoCsa_GetCurrent(sint16 *pCurrent)
+{
+  uint16 Sample;
+
+  if(ADC1_GetEIMResult(&Sample) == false)
+  {
+    /* No conversion */
+    return false;
+  }
+
+  if(EmoCsa_Status.OffsetCtr > 0u)
+  {
+    /* Average CSA output at zero current */
+    EmoCsa_Status.OffsetSum += Sample;
+    EmoCsa_Status.OffsetCtr--;
+    if(EmoCsa_Status.OffsetCtr == 0u)
+    {
+      EmoCsa_Status.Offset = EmoCsa_Status.OffsetSum >> EMOCSA_OFFSET_CAL_SHIFT;
+    }
+    return false;
+  }
+
+  *pCurrent = (sint16)(((sint32)Sample - (sint32)EmoCsa_Status.Offset) * EMOCSA_CURRENT_SCALE);
+  return true;
+
+} /* End of EmoCsa_GetCurrent */
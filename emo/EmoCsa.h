@@ -0,0 +1,110 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/* See EmoCsa.c */
+
+#ifndef EMO_CSA_H_
+#define EMO_CSA_H_
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include "tle_device.h"
+#include "timer3_defines.h"
+#include "Emo.h"
+
+/*******************************************************************************
+**                      Global Macro Definitions                              **
+*******************************************************************************/
+/* Timer3 compare value for no sample, not reached within a PWM period */
+#define EMOCSA_NO_SAMPLE (0xFFFFu)
+
+/* Function-like macro to convert T12 ticks to Timer3 ticks */
+#define EmoCsa_T3Ticks(T12Ticks) ((uint16)((((uint32)(T12Ticks)) * TIMER3_CLK) / CCU6_T12_CLK))
+
+/*******************************************************************************
+**                      Global Type Definitions                               **
+*******************************************************************************/
+/** \brief Current measurement status */
+typedef struct
+{
+  uint16 Offset;        /**< \brief CSA output at zero current [ADC counts] */
+  uint16 OffsetSum;     /**< \brief Sum of CSA samples during offset calibration */
+  uint8 OffsetCtr;      /**< \brief Remaining samples of offset calibration */
+} TEmoCsa_Status;
+
+/*******************************************************************************
+**                      Global Variable Declarations                          **
+*******************************************************************************/
+extern TEmoCsa_Status EmoCsa_Status;
+
+/*******************************************************************************
+**                      Global Function Declarations                          **
+*******************************************************************************/
+extern void EmoCsa_Start(uint16 SampleTick);
+extern void EmoCsa_Stop(void);
+extern bool EmoCsa_GetCurrent(sint16 *pCurrent);
+
+__STATIC_INLINE void EmoCsa_SetSampleTick(uint16 SampleTick);
+__STATIC_INLINE bool EmoCsa_IsOffsetValid(void);
+
+/*******************************************************************************
+**                      Global Inline Function Definitions                    **
+*******************************************************************************/
+/** \brief Sets the sample point in the PWM period.
+ *
+ * \param[in] SampleTick Sample point after T12 period match [Timer3 ticks],
+ *            EMOCSA_NO_SAMPLE for no sample
+ * \return None
+ *
+ * \note Takes effect for the running PWM period if written before the sample point.
+ *
+ * \ingroup emo_csa_api
+ */
+__STATIC_INLINE void EmoCsa_SetSampleTick(uint16 SampleTick)
+{
+  TIMER3->CMP.reg = SampleTick;
+} /* End of EmoCsa_SetSampleTick */
+
+/** \brief Checks if the CSA offset is calibrated.
+ *
+ * \return true if offset calibration is finished
+ *
+ * \ingroup emo_csa_api
+ */
+__STATIC_INLINE bool EmoCsa_IsOffsetValid(void)
+{
+  return (EmoCsa_Status.OffsetCtr == 0u);
+} /* End of EmoCsa_IsOffsetValid */
+
+
+#endif /* #ifndef EMO_CSA_H_ */
@@ -0,0 +1,106 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, EXINT1 and GPT12E incremental interface decoding
+ * V0.1.1: 2026-10-17: EXINT1 decoding on both edges of channel B
+ * V0.1.2: 2026-10-18: EXINT1 decoding on the rising edge of channel B again, GPT12E decoding
+ *                      selected in the project C defines
+ */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include "EmoEnc.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+/* T2 in incremental interface mode, counting any transition of T2IN and T2EUD,
+ * no interrupt on count edges */
+#define EMOENC_T2CON_INC ((3u << GPT12E_T2CON_T2I_Pos) | (6u << GPT12E_T2CON_T2M_Pos) | \
+                          GPT12E_T2CON_T2IRDIS_Msk | GPT12E_T2CON_T2R_Msk)
+
+/*******************************************************************************
+**                      Global Variable Definitions                           **
+*******************************************************************************/
+TEmoEnc_Status EmoEnc_Status;
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+/** \brief Initializes the encoder decoding and sets the position to zero.
+ *
+ * \return None
+ *
+ * \ingroup emo_enc_api
+ */
+void EmoEnc_Init(void)
+{
+  EmoEnc_Status.Pos = 0;
+
+#if (EMOENC_GPT12E_EN == 1u)
+  /* No interrupt per edge, decoding is done by T2 */
+  EXINT1_Rising_Edge_Int_Dis();
+
+  /* Channel A on T2INB (P1.4), channel B on T2EUDB (P2.4) */
+  GPT12E->PISEL.reg |= (uint16)(GPT12E_PISEL_IST2IN_Msk | GPT12E_PISEL_IST2EUD_Msk);
+
+  /* Start T2 at zero in incremental interface mode */
+  GPT12E->T2CON.reg = 0u;
+  GPT12E->T2.reg = 0u;
+  GPT12E->T2CON.reg = (uint16)EMOENC_T2CON_INC;
+#endif
+
+} /* End of EmoEnc_Init */
+
+/** \brief Handles EXINT1 interrupt for rising edge of channel B.
+ *
+ * \return None
+ *
+ * \note Only used with EXINT1 decoding: channel A (P2.0) high counts up. A
+ * bounce of channel B counts once more, GPT12E decoding follows every edge.
+ *
+ * \ingroup emo_enc_api
+ */
+void EmoEnc_HandleEdge(void)
+{
+  if((PORT->P2_DATA.reg & 0x1u) != 0u)
+  {
+    EmoEnc_Status.Pos++;
+  }
+  else
+  {
+    EmoEnc_Status.Pos--;
+  }
+
+} /* End of EmoEnc_HandleEdge */
@@ -0,0 +1,137 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/* See EmoEnc.c */
+
+#ifndef EMO_ENC_H_
+#define EMO_ENC_H_
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include "tle_device.h"
+#include "Neopx.h"
+
+/*******************************************************************************
+**                      Global Macro Definitions                              **
+*******************************************************************************/
+/* Quadrature decoding: 1 = GPT12E T2 incremental interface with 4x decoding,
+ * 0 = EXINT1 interrupt per rising edge of channel B with 1x decoding.
+ * GPT12E decoding needs channel A on T2INB (P1.4) and channel B on T2EUDB (P2.4),
+ * and T2 must not be used otherwise (NEOPX_GPT12E_T2_EN = 0).
+ * May be set in the project C defines */
+#ifndef EMOENC_GPT12E_EN
+#define EMOENC_GPT12E_EN (0u)
+#endif
+
+#if ((EMOENC_GPT12E_EN == 1u) && (NEOPX_GPT12E_T2_EN == 1u))
+#error "GPT12E T2 is used by the Neopixel backend, encoder decoding by T2 needs NEOPX_GPT12E_T2_EN = 0"
+#endif
+
+/* Encoder lines per motor revolution */
+#define EMOENC_LINES_PER_REV (512u)
+
+/* Encoder ticks per motor revolution */
+#if (EMOENC_GPT12E_EN == 1u)
+#define EMOENC_TICKS_PER_REV (EMOENC_LINES_PER_REV * 4u)
+#else
+#define EMOENC_TICKS_PER_REV (EMOENC_LINES_PER_REV)
+#endif
+
+/*******************************************************************************
+**                      Global Type Definitions                               **
+*******************************************************************************/
+/** \brief Encoder status */
+typedef struct
+{
+  volatile sint32 Pos;  /**< \brief Position [encoder ticks], with GPT12E: position at last
+                         *   extension, lower 16 bit equal to T2 at that time */
+} TEmoEnc_Status;
+
+/*******************************************************************************
+**                      Global Variable Declarations                          **
+*******************************************************************************/
+extern TEmoEnc_Status EmoEnc_Status;
+
+/*******************************************************************************
+**                      Global Function Declarations                          **
+*******************************************************************************/
+extern void EmoEnc_Init(void);
+extern void EmoEnc_HandleEdge(void);
+
+__STATIC_INLINE sint32 EmoEnc_GetPos(void);
+__STATIC_INLINE void EmoEnc_Update(void);
+
+/*******************************************************************************
+**                      Global Inline Function Definitions                    **
+*******************************************************************************/
+/** \brief Gets the encoder position.
+ *
+ * With GPT12E decoding the 16 bit T2 count is extended by the 32 bit position
+ * of the last extension: one 32 bit load and one timer read, safe in any
+ * interrupt context as long as less than 32768 ticks passed since the last
+ * EmoEnc_Update.
+ *
+ * \return Position [encoder ticks]
+ *
+ * \ingroup emo_enc_api
+ */
+__STATIC_INLINE sint32 EmoEnc_GetPos(void)
+{
+#if (EMOENC_GPT12E_EN == 1u)
+  sint32 Pos;
+
+  Pos = EmoEnc_Status.Pos;
+  return Pos + (sint16)(uint16)((uint16)GPT12E->T2.reg - (uint16)Pos);
+#else
+  return EmoEnc_Status.Pos;
+#endif
+} /* End of EmoEnc_GetPos */
+
+/** \brief Extends the GPT12E count to 32 bit.
+ *
+ * \return None
+ *
+ * \note Called every ms, a single 32 bit store keeps the position consistent
+ * for readers in any interrupt context.
+ *
+ * \ingroup emo_enc_api
+ */
+__STATIC_INLINE void EmoEnc_Update(void)
+{
+#if (EMOENC_GPT12E_EN == 1u)
+  EmoEnc_Status.Pos = EmoEnc_GetPos();
+#endif
+} /* End of EmoEnc_Update */
+
+
+#endif /* #ifndef EMO_ENC_H_ */
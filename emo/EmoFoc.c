@@ -0,0 +1,427 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, FOC with single shunt current measurement
+ * V0.1.1: 2026-10-17: Current measurement moved to EmoCsa
+ * V0.1.2: 2026-10-18: Start current until the speed control takes over
+ */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include "Emo.h"
+#include "EmoCcu.h"
+#include "EmoCsa.h"
+#include "EmoFoc.h"
+#include "bchall_defines.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+/* Current PI parameters (see Mat_ExePi: P gain = Kp / 512, I gain = Ki / 32768 per PWM period) */
+#define EMOFOC_CURRENT_KP (1024)
+#define EMOFOC_CURRENT_KI (512)
+
+/* Limit for d and q voltage: 1/sqrt(2) keeps the voltage vector inside the linear SVPWM range */
+#define EMOFOC_VOLT_MAX (23170)
+
+/* Factor from phase voltage to PWM ticks: voltage 1.0 = PWM period / sqrt(3) */
+#define EMOFOC_VOLT_TO_TICKS ((sint32)((((uint32)EMO_PWM_PERIOD_TICKS) * MAT_ONE_OVER_SQRT_3) >> MAT_FIX_SHIFT))
+
+/* q current in the start state until Hall speed is valid (1.0 = 32768), the
+ * start duty cycle of BC. May be set in the project C defines. */
+#ifndef EMOFOC_START_IQ
+#define EMOFOC_START_IQ ((sint16)((((sint32)BCHALL_INIT_DUTY) << MAT_FIX_SHIFT) / 100))
+#endif
+
+/* T12 modulation of all six outputs, multi-channel mode disabled (T12MODEN = 0x3F, MCMEN = 0) */
+#define EMOFOC_T12MODEN_ALL (0x003Fu)
+
+/* Minimum width of a current sample window [T12 ticks]: CSA settling and ADC sampling */
+#define EMOFOC_MIN_WINDOW_TICKS (120u)
+
+/* Sample point before end of sample window [T12 ticks] */
+#define EMOFOC_SAMPLE_LEAD_TICKS (40u)
+
+/* Earliest sample point after T12 period match [T12 ticks], Timer3 compare is written at interrupt entry */
+#define EMOFOC_MIN_SAMPLE_TICKS (80u)
+
+/* Sample point during CSA offset calibration [T12 ticks] */
+#define EMOFOC_OFFSET_SAMPLE_TICKS (EMO_PWM_PERIOD_TICKS / 4u)
+
+/* Phase index for no valid sample */
+#define EMOFOC_PHASE_NONE (3u)
+
+/*******************************************************************************
+**                      Private Function Declarations                         **
+*******************************************************************************/
+static void EmoFoc_lInitVar(void);
+static void EmoFoc_lStoreCurrent(sint16 Current);
+static void EmoFoc_lSvpwm(sint32 Valpha, sint32 Vbeta);
+
+/*******************************************************************************
+**                      Global Variable Definitions                           **
+*******************************************************************************/
+TEmoFoc_Ctrl EmoFoc_Ctrl;
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+/** \brief Initializes FOC parameters.
+ *
+ * \return None
+ *
+ * \ingroup emo_foc_api
+ */
+void EmoFoc_InitPar(void)
+{
+  /* Initialize PI control parameters for d and q current */
+  EmoFoc_Ctrl.IdPi.Kp = (sint16)EMOFOC_CURRENT_KP;
+  EmoFoc_Ctrl.IdPi.Ki = (sint16)EMOFOC_CURRENT_KI;
+  EmoFoc_Ctrl.IqPi.Kp = (sint16)EMOFOC_CURRENT_KP;
+  EmoFoc_Ctrl.IqPi.Ki = (sint16)EMOFOC_CURRENT_KI;
+
+  /* Initialize PI control limits for d and q voltage */
+  EmoFoc_Ctrl.IdPi.IMin = (sint16)(-EMOFOC_VOLT_MAX);
+  EmoFoc_Ctrl.IdPi.IMax = (sint16)EMOFOC_VOLT_MAX;
+  EmoFoc_Ctrl.IdPi.PiMin = (sint16)(-EMOFOC_VOLT_MAX);
+  EmoFoc_Ctrl.IdPi.PiMax = (sint16)EMOFOC_VOLT_MAX;
+  EmoFoc_Ctrl.IqPi.IMin = (sint16)(-EMOFOC_VOLT_MAX);
+  EmoFoc_Ctrl.IqPi.IMax = (sint16)EMOFOC_VOLT_MAX;
+  EmoFoc_Ctrl.IqPi.PiMin = (sint16)(-EMOFOC_VOLT_MAX);
+  EmoFoc_Ctrl.IqPi.PiMax = (sint16)EMOFOC_VOLT_MAX;
+
+} /* End of EmoFoc_InitPar */
+
+/** \brief Switches running PWM from block commutation to FOC.
+ *
+ * Sets zero voltage, modulates all outputs with T12 and starts the single shunt
+ * current measurement. The start current EMOFOC_START_IQ in the direction of
+ * EmoCcu_GetDirIdx turns the rotor until the Hall events switch to RUN, where
+ * Emo_CtrlSpeed sets the q current reference.
+ *
+ * \return None
+ *
+ * \note Called after Ccu6_Start and before the bridge is enabled.
+ *
+ * \ingroup emo_foc_api
+ */
+void EmoFoc_Start(void)
+{
+  uint16 HalfPeriod;
+
+  /* Zero voltage: same duty cycle on all phases */
+  HalfPeriod = (uint16)(EMO_PWM_PERIOD_TICKS / 2u);
+  CCU6_LoadShadowRegister_CC60(HalfPeriod);
+  CCU6_LoadShadowRegister_CC61(HalfPeriod);
+  CCU6_LoadShadowRegister_CC62(HalfPeriod);
+  CCU6_EnableST_T12();
+
+  /* Modulate all outputs with T12, Hall patterns are still used for Hall event detection */
+  CCU6_ConfigureGlobalModulation(EMOFOC_T12MODEN_ALL);
+
+  /* Start current measurement, first samples at zero voltage calibrate the CSA offset */
+  EmoCsa_Start(EmoCsa_T3Ticks(EMOFOC_OFFSET_SAMPLE_TICKS));
+
+  /* Initialize variables */
+  EmoFoc_lInitVar();
+  EmoFoc_Ctrl.IqRef = (EmoCcu_GetDirIdx() == 0u) ? (sint16)EMOFOC_START_IQ : (sint16)(-EMOFOC_START_IQ);
+
+  /* Enable interrupts for T12 period match and Hall event */
+  CCU6_ClearIntStatus(CCU6_MASK_INT_T12PM);
+  CCU6_EnableInt((uint16)(CCU6_MASK_INT_T12PM | CCU6_MASK_INT_CHE));
+
+} /* End of EmoFoc_Start */
+
+/** \brief Stops the FOC current measurement.
+ *
+ * \return None
+ *
+ * \note Called after Ccu6_Stop.
+ *
+ * \ingroup emo_foc_api
+ */
+void EmoFoc_Stop(void)
+{
+  EmoCsa_Stop();
+
+} /* End of EmoFoc_Stop */
+
+/** \brief Executes FOC for one PWM period.
+ *
+ * Pipeline: the sample point planned in the last period is programmed for the
+ * running period, the sample of the last period is evaluated, and the duty
+ * cycles and sample point for the next period are calculated.
+ *
+ * \return None
+ *
+ * \note Called from the CCU6 interrupt for T12 period match.
+ *
+ * \ingroup emo_foc_api
+ */
+void EmoFoc_Exe(void)
+{
+  sint16 Current;
+  uint16 Angle;
+  sint32 Sin;
+  sint32 Cos;
+  sint32 Ialpha;
+  sint32 Ibeta;
+  sint32 Id;
+  sint32 Iq;
+  sint32 Vd;
+  sint32 Vq;
+
+  /* Program sample point of the PWM period just started */
+  EmoCsa_SetSampleTick(EmoFoc_Ctrl.SampleTick);
+
+  /* Evaluate sample of the last PWM period */
+  if((EmoCsa_GetCurrent(&Current) == true) && (EmoFoc_Ctrl.MeasPh != EMOFOC_PHASE_NONE))
+  {
+    EmoFoc_lStoreCurrent(Current);
+  }
+  EmoFoc_Ctrl.MeasPh = EmoFoc_Ctrl.SamplePh;
+  EmoFoc_Ctrl.MeasNeg = EmoFoc_Ctrl.SampleNeg;
+
+  if(EmoCsa_IsOffsetValid() == false)
+  {
+    /* Keep zero voltage until offset is calibrated */
+    return;
+  }
+
+  /* Get interpolated rotor angle */
+  Angle = EmoCcu_UpdateAngle();
+  Sin = (sint32)Mat_Sin(Angle);
+  Cos = (sint32)Mat_Cos(Angle);
+
+  /* Clarke transformation: Ialpha = Iu, Ibeta = (Iu + 2 * Iv) / sqrt(3) */
+  Ialpha = (sint32)EmoFoc_Ctrl.Iph[0];
+  Ibeta = Mat_FixMul(Ialpha + ((sint32)EmoFoc_Ctrl.Iph[1] * 2), MAT_ONE_OVER_SQRT_3);
+
+  /* Park transformation */
+  Id = __SSAT(Mat_FixMul(Ialpha, Cos) + Mat_FixMul(Ibeta, Sin), 16u);
+  Iq = __SSAT(Mat_FixMul(Ibeta, Cos) - Mat_FixMul(Ialpha, Sin), 16u);
+  EmoFoc_Ctrl.Id = (sint16)Id;
+  EmoFoc_Ctrl.Iq = (sint16)Iq;
+
+  /* PI control of d and q current */
+  Vd = (sint32)Mat_ExePi(&EmoFoc_Ctrl.IdPi, (sint16)__SSAT((sint32)EmoFoc_Ctrl.IdRef - Id, 16u));
+  Vq = (sint32)Mat_ExePi(&EmoFoc_Ctrl.IqPi, (sint16)__SSAT((sint32)EmoFoc_Ctrl.IqRef - Iq, 16u));
+  EmoFoc_Ctrl.Vd = (sint16)Vd;
+  EmoFoc_Ctrl.Vq = (sint16)Vq;
+
+  /* Inverse Park transformation and space vector modulation */
+  EmoFoc_lSvpwm(Mat_FixMul(Vd, Cos) - Mat_FixMul(Vq, Sin), Mat_FixMul(Vd, Sin) + Mat_FixMul(Vq, Cos));
+  EmoFoc_Ctrl.Angle = Angle;
+
+} /* End of EmoFoc_Exe */
+
+/*******************************************************************************
+**                      Private Function Definitions                          **
+*******************************************************************************/
+static void EmoFoc_lInitVar(void)
+{
+  EmoFoc_Ctrl.IdPi.IOut = 0;
+  EmoFoc_Ctrl.IqPi.IOut = 0;
+  EmoFoc_Ctrl.IdRef = 0;
+  EmoFoc_Ctrl.IqRef = 0;
+  EmoFoc_Ctrl.Id = 0;
+  EmoFoc_Ctrl.Iq = 0;
+  EmoFoc_Ctrl.Vd = 0;
+  EmoFoc_Ctrl.Vq = 0;
+  EmoFoc_Ctrl.Iph[0] = 0;
+  EmoFoc_Ctrl.Iph[1] = 0;
+  EmoFoc_Ctrl.Iph[2] = 0;
+
+  /* Sample at fixed point during offset calibration */
+  EmoFoc_Ctrl.SampleTick = EmoCsa_T3Ticks(EMOFOC_OFFSET_SAMPLE_TICKS);
+  EmoFoc_Ctrl.SamplePh = EMOFOC_PHASE_NONE;
+  EmoFoc_Ctrl.SampleNeg = 0u;
+  EmoFoc_Ctrl.MeasPh = EMOFOC_PHASE_NONE;
+  EmoFoc_Ctrl.MeasNeg = 0u;
+  EmoFoc_Ctrl.LastPh = EMOFOC_PHASE_NONE;
+  EmoFoc_Ctrl.Window = 0u;
+  EmoFoc_Ctrl.Shift[0] = 0;
+  EmoFoc_Ctrl.Shift[1] = 0;
+  EmoFoc_Ctrl.Shift[2] = 0;
+
+} /* End of EmoFoc_lInitVar */
+
+/* Stores a DC link current sample as phase current.
+ * The third phase current is calculated from the last two samples if they
+ * measured different phases (sum of phase currents = 0). */
+static void EmoFoc_lStoreCurrent(sint16 Current)
+{
+  sint32 PhCurrent;
+  uint32 Ph;
+  uint32 LastPh;
+
+  PhCurrent = (sint32)Current;
+  if(EmoFoc_Ctrl.MeasNeg != 0u)
+  {
+    PhCurrent = -PhCurrent;
+  }
+
+  Ph = EmoFoc_Ctrl.MeasPh;
+  LastPh = EmoFoc_Ctrl.LastPh;
+  EmoFoc_Ctrl.Iph[Ph] = (sint16)__SSAT(PhCurrent, 16u);
+
+  if((LastPh != EMOFOC_PHASE_NONE) && (LastPh != Ph))
+  {
+    EmoFoc_Ctrl.Iph[3u - Ph - LastPh] = (sint16)__SSAT(-((sint32)EmoFoc_Ctrl.Iph[Ph] + EmoFoc_Ctrl.Iph[LastPh]), 16u);
+  }
+  EmoFoc_Ctrl.LastPh = (uint8)Ph;
+
+} /* End of EmoFoc_lStoreCurrent */
+
+/* Sets the duty cycles for a voltage vector and plans the current sample.
+ * Duty cycle convention as in Emo_CtrlSpeed: CC6x = phase on-time in T12 ticks,
+ * so all phases are on after period match and switch off in order of duty cycle.
+ * The sample window alternates between the one-phase-on and the two-phases-on
+ * vector, each giving one phase current on the single shunt. A window shorter
+ * than EMOFOC_MIN_WINDOW_TICKS, as for all small voltages, is widened by moving
+ * the edge of one phase; the next PWM period moves it back by the same ticks,
+ * which keeps the mean voltage. */
+static void EmoFoc_lSvpwm(sint32 Valpha, sint32 Vbeta)
+{
+  sint32 V[3];
+  sint32 Cc[3];
+  sint32 VbetaPh;
+  sint32 VMax;
+  sint32 VMin;
+  sint32 VOff;
+  sint32 Ins;
+  uint32 Max;
+  uint32 Min;
+  uint32 Mid;
+  uint32 Start;
+  uint32 End;
+  uint32 Ph;
+  uint32 i;
+
+  /* Inverse Clarke transformation */
+  VbetaPh = Mat_FixMul(Vbeta, MAT_SQRT_3_OVER_2);
+  V[0] = Valpha;
+  V[1] = VbetaPh - (Valpha / 2);
+  V[2] = -VbetaPh - (Valpha / 2);
+
+  /* Min-max zero sequence injection, equivalent to SVPWM; voltage limits keep
+   * the duty cycles within 0..PWM period, the correction of the last window
+   * insertion is limited to it */
+  VMax = (V[0] > V[1]) ? V[0] : V[1];
+  VMax = (V[2] > VMax) ? V[2] : VMax;
+  VMin = (V[0] < V[1]) ? V[0] : V[1];
+  VMin = (V[2] < VMin) ? V[2] : VMin;
+  VOff = (VMax + VMin) / 2;
+  for(i = 0u; i < 3u; i++)
+  {
+    Cc[i] = (sint32)(EMO_PWM_PERIOD_TICKS / 2u) + Mat_FixMul(V[i] - VOff, EMOFOC_VOLT_TO_TICKS) + EmoFoc_Ctrl.Shift[i];
+    Cc[i] = (Cc[i] < 0) ? 0 : ((Cc[i] > (sint32)EMO_PWM_PERIOD_TICKS) ? (sint32)EMO_PWM_PERIOD_TICKS : Cc[i]);
+    EmoFoc_Ctrl.Shift[i] = 0;
+  }
+
+  /* Sort phases by duty cycle */
+  if(Cc[0] >= Cc[1])
+  {
+    Max = 0u;
+    Min = 1u;
+  }
+  else
+  {
+    Max = 1u;
+    Min = 0u;
+  }
+  if(Cc[2] > Cc[Max])
+  {
+    Max = 2u;
+  }
+  else if(Cc[2] < Cc[Min])
+  {
+    Min = 2u;
+  }
+  else
+  {
+    /* Phase W is in the middle */
+  }
+  Mid = 3u - Max - Min;
+
+  /* Plan current sample for next period */
+  EmoFoc_Ctrl.Window ^= 1u;
+  if(EmoFoc_Ctrl.Window == 0u)
+  {
+    /* Only phase with largest duty cycle on: DC link current = +I(max),
+     * a short window is widened by a later switch-off of this phase */
+    Ins = ((sint32)EMOFOC_MIN_WINDOW_TICKS + Cc[Mid]) - Cc[Max];
+    if((Ins > 0) && ((Cc[Max] + Ins) <= (sint32)EMO_PWM_PERIOD_TICKS))
+    {
+      Cc[Max] += Ins;
+      EmoFoc_Ctrl.Shift[Max] = (sint16)(-Ins);
+    }
+    Start = (uint32)Cc[Mid];
+    End = (uint32)Cc[Max];
+    Ph = Max;
+  }
+  else
+  {
+    /* Phase with smallest duty cycle off: DC link current = -I(min),
+     * a short window is widened by an earlier switch-off of this phase */
+    Ins = ((sint32)EMOFOC_MIN_WINDOW_TICKS + Cc[Min]) - Cc[Mid];
+    if((Ins > 0) && (Cc[Min] >= Ins))
+    {
+      Cc[Min] -= Ins;
+      EmoFoc_Ctrl.Shift[Min] = (sint16)Ins;
+    }
+    Start = (uint32)Cc[Min];
+    End = (uint32)Cc[Mid];
+    Ph = Min;
+  }
+
+  CCU6_LoadShadowRegister_CC60((uint16)Cc[0]);
+  CCU6_LoadShadowRegister_CC61((uint16)Cc[1]);
+  CCU6_LoadShadowRegister_CC62((uint16)Cc[2]);
+  CCU6_EnableST_T12();
+
+  if(((End - Start) >= EMOFOC_MIN_WINDOW_TICKS) && ((End - EMOFOC_SAMPLE_LEAD_TICKS) >= EMOFOC_MIN_SAMPLE_TICKS))
+  {
+    EmoFoc_Ctrl.SampleTick = EmoCsa_T3Ticks(End - EMOFOC_SAMPLE_LEAD_TICKS);
+    EmoFoc_Ctrl.SamplePh = (uint8)Ph;
+    EmoFoc_Ctrl.SampleNeg = EmoFoc_Ctrl.Window;
+  }
+  else
+  {
+    /* Window too short: keep last current of this phase */
+    EmoFoc_Ctrl.SampleTick = EMOCSA_NO_SAMPLE;
+    EmoFoc_Ctrl.SamplePh = EMOFOC_PHASE_NONE;
+  }
+
+} /* End of EmoFoc_lSvpwm */
@@ -0,0 +1,103 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/* See EmoFoc.c */
+
+#ifndef EMO_FOC_H_
+#define EMO_FOC_H_
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include "tle_device.h"
+#include "Emo.h"
+
+/*******************************************************************************
+**                      Global Type Definitions                               **
+*******************************************************************************/
+/** \brief FOC control status
+ *  Angles: 0..65535 = 0..360 degrees, currents and voltages in fixed-point format.
+ */
+typedef struct
+{
+  TMat_Pi IdPi;         /**< \brief d current PI control, output = d voltage */
+  TMat_Pi IqPi;         /**< \brief q current PI control, output = q voltage */
+  sint16 IdRef;         /**< \brief d current reference */
+  sint16 IqRef;         /**< \brief q current reference */
+  sint16 Id;            /**< \brief d current */
+  sint16 Iq;            /**< \brief q current */
+  sint16 Vd;            /**< \brief d voltage (1.0 = maximum linear SVPWM amplitude) */
+  sint16 Vq;            /**< \brief q voltage (1.0 = maximum linear SVPWM amplitude) */
+  sint16 Iph[3];        /**< \brief Phase currents U, V, W (1.0 = 1024 ADC counts) */
+  uint16 Angle;         /**< \brief Electrical angle of last transformation */
+  uint16 SampleTick;    /**< \brief Sample point planned for next PWM period [Timer3 ticks] */
+  uint8 SamplePh;       /**< \brief Phase measured by planned sample */
+  uint8 SampleNeg;      /**< \brief Planned sample measures negative phase current */
+  uint8 MeasPh;         /**< \brief Phase measured in running PWM period */
+  uint8 MeasNeg;        /**< \brief Running sample measures negative phase current */
+  uint8 LastPh;         /**< \brief Phase updated by last valid sample */
+  uint8 Window;         /**< \brief Sample window, 0=one phase on, 1=two phases on */
+  sint16 Shift[3];      /**< \brief Duty cycle correction of next period for the window insertion [T12 ticks] */
+} TEmoFoc_Ctrl;
+
+/*******************************************************************************
+**                      Global Variable Declarations                          **
+*******************************************************************************/
+extern TEmoFoc_Ctrl EmoFoc_Ctrl;
+
+/*******************************************************************************
+**                      Global Function Declarations                          **
+*******************************************************************************/
+extern void EmoFoc_InitPar(void);
+extern void EmoFoc_Start(void);
+extern void EmoFoc_Stop(void);
+extern void EmoFoc_Exe(void);
+
+__STATIC_INLINE void EmoFoc_SetIqRef(sint16 IqRef);
+
+/*******************************************************************************
+**                      Global Inline Function Definitions                    **
+*******************************************************************************/
+/** \brief Sets the q current (torque) reference.
+ *
+ * \param[in] IqRef q current reference, sign = torque direction
+ * \return None
+ *
+ * \ingroup emo_foc_api
+ */
+__STATIC_INLINE void EmoFoc_SetIqRef(sint16 IqRef)
+{
+  EmoFoc_Ctrl.IqRef = IqRef;
+} /* End of EmoFoc_SetIqRef */
+
+
+#endif /* #ifndef EMO_FOC_H_ */
@@ -59,6 +59,15 @@
 /* (1 / sqrt(3)) in fixed-point format */
 #define MAT_ONE_OVER_SQRT_3 (18919u)
 
+/* (sqrt(3) / 2) in fixed-point format */
+#define MAT_SQRT_3_OVER_2 (28378u)
+
+/* Number of entries in the sine table (one full period) */
+#define MAT_SIN_TAB_SIZE (256u)
+
+/* Angle offset of 90 degrees (angle 0..65535 = 0..360 degrees) */
+#define MAT_ANGLE_90DEG (16384u)
+
 /*******************************************************************************
 **                      Global Type Definitions                               **
 *******************************************************************************/
@@ -78,6 +87,7 @@ typedef struct
 /*******************************************************************************
 **                      Global Variable Declarations                          **
 *******************************************************************************/
+extern const sint16 Mat_SinTab[MAT_SIN_TAB_SIZE];
 
 /*******************************************************************************
 **                      Global Function Declarations                          **
@@ -85,6 +95,8 @@ typedef struct
 
 __STATIC_INLINE sint16 Mat_ExePi(TMat_Pi *pPi, sint16 Error);
 __STATIC_INLINE uint16 Mat_ExeSimpleLp(uint32 *pOutput, uint16 Input, uint16 Fac);
+__STATIC_INLINE sint16 Mat_Sin(uint16 Angle);
+__STATIC_INLINE sint16 Mat_Cos(uint16 Angle);
 
 
 /*******************************************************************************
@@ -180,4 +192,30 @@ uint16 Mat_ExeSimpleLp(uint32 *pOutput, uint16 Input, uint16 Fac)
 }
 
 
+/** \brief Gets the sine of an angle from the sine table.
+ *
+ * \param[in] Angle Angle (0..65535 = 0..360 degrees)
+ *
+ * \return Sine [fixed-point]
+ * \ingroup mat_api
+ */
+__STATIC_INLINE sint16 Mat_Sin(uint16 Angle)
+{
+  return Mat_SinTab[Angle >> 8u];
+} /* End of Mat_Sin */
+
+
+/** \brief Gets the cosine of an angle from the sine table.
+ *
+ * \param[in] Angle Angle (0..65535 = 0..360 degrees)
+ *
+ * \return Cosine [fixed-point]
+ * \ingroup mat_api
+ */
+__STATIC_INLINE sint16 Mat_Cos(uint16 Angle)
+{
+  return Mat_SinTab[(uint16)(Angle + MAT_ANGLE_90DEG) >> 8u];
+} /* End of Mat_Cos */
+
+
 #endif /* MAT.H */
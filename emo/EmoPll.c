@@ -0,0 +1,208 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, Hall edge driven speed and angle PLL
+ * V0.2.0: 2026-10-17: Speed factor from the T6 clock of the timebase
+ * V0.2.1: 2026-10-17: EMOPLL_EN may be set in the project C defines
+ */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include "Emo.h"
+#include "EmoPll.h"
+#include "Timebase.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+/* Factor for calculation of speed from the observer speed:
+ * speed [rpm] = (observer speed * factor) >> 24
+ * factor = 60 * T6 frequency [Hz] * 2^24 / (2^32 * pole pairs), round to nearest */
+#define EMOPLL_RPM_FAC ((uint32)((((60.0 * (EMO_FSYS_HZ / (float)TIMEBASE_T6_DIV)) / 256.0) / (float)BCHALL_POLE_PAIRS) + 0.5))
+
+/*******************************************************************************
+**                      Global Variable Definitions                           **
+*******************************************************************************/
+TEmoPll_Status EmoPll_Status;
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+/** \brief Initializes the observer, the next Hall event sets the angle.
+ *
+ * \return None
+ *
+ * \ingroup emo_pll_api
+ */
+void EmoPll_Init(void)
+{
+  EmoPll_Status.Angle = 0u;
+  EmoPll_Status.Time = 0u;
+  EmoPll_Status.Speed = 0;
+  EmoPll_Status.HallAngle = 0u;
+  EmoPll_Status.Edges = 0u;
+
+} /* End of EmoPll_Init */
+
+/** \brief Corrects angle and speed with a Hall event.
+ *
+ * The angle is predicted to the event time with the estimated speed, the
+ * error to the angle of the Hall pattern corrects the angle (Kp) and the
+ * speed (Ki per elapsed time). The first event sets the angle, the second
+ * one the speed of the measured sector.
+ *
+ * \param HallAngle Electrical angle at entry of the new Hall pattern (0..65535 = 0..360 degrees)
+ * \param Time Time of the event [T6 timer ticks, 32 bit]
+ * \return None
+ *
+ * \note Called from the Hall event, one SDIV per event.
+ *
+ * \ingroup emo_pll_api
+ */
+void EmoPll_Update(uint16 HallAngle, uint32 Time)
+{
+  uint32 Meas;
+  uint32 Pred;
+  uint32 Dt;
+  sint32 Err;
+  sint32 Corr;
+
+  Meas = ((uint32)HallAngle) << 16u;
+  Dt = Time - EmoPll_Status.Time;
+  if(Dt == 0u)
+  {
+    Dt = 1u;
+  }
+  else if(Dt > 0x7FFFFFFFu)
+  {
+    Dt = 0x7FFFFFFFu;
+  }
+
+  if(EmoPll_Status.Edges == 0u)
+  {
+    /* First event: angle known, speed not yet */
+    EmoPll_Status.Angle = Meas;
+    EmoPll_Status.Speed = 0;
+    EmoPll_Status.Edges = 1u;
+  }
+  else if(EmoPll_Status.Edges == 1u)
+  {
+    /* Second event: speed of the measured sector */
+    EmoPll_Status.Speed = ((sint32)(Meas - EmoPll_Status.HallAngle)) / (sint32)Dt;
+    EmoPll_Status.Angle = Meas;
+    EmoPll_Status.Edges = 2u;
+  }
+  else
+  {
+    Pred = EmoPll_Status.Angle + (uint32)((int64)EmoPll_Status.Speed * (int64)Dt);
+    Err = (sint32)(Meas - Pred);
+    EmoPll_Status.Angle = Pred + (uint32)(sint32)(((int64)Err * EMOPLL_KP) >> 15u);
+    Corr = (sint32)(((int64)Err * EMOPLL_KI) >> 15u);
+    EmoPll_Status.Speed += Corr / (sint32)Dt;
+  }
+
+  EmoPll_Status.Time = Time;
+  EmoPll_Status.HallAngle = Meas;
+
+} /* End of EmoPll_Update */
+
+/** \brief Sets the speed to 0 at standstill, the angle to the last Hall event.
+ *
+ * The next Hall event measures the speed again as after the first event.
+ *
+ * \return None
+ *
+ * \ingroup emo_pll_api
+ */
+void EmoPll_Stop(void)
+{
+  EmoPll_Status.Speed = 0;
+  EmoPll_Status.Angle = EmoPll_Status.HallAngle;
+  if(EmoPll_Status.Edges > 1u)
+  {
+    EmoPll_Status.Edges = 1u;
+  }
+
+} /* End of EmoPll_Stop */
+
+/** \brief Predicts the angle from the last Hall event with the estimated speed.
+ *
+ * The prediction is limited to one Hall sector from the angle of the last
+ * Hall event, the angle holds there until the next event.
+ *
+ * \param Time Time of the prediction [T6 timer ticks, 32 bit]
+ * \return Electrical angle (0..65535 = 0..360 degrees)
+ *
+ * \note Not interruptible by EmoPll_Update, e.g. called from the CCU6 interrupt.
+ *
+ * \ingroup emo_pll_api
+ */
+uint16 EmoPll_GetAngle(uint32 Time)
+{
+  int64 Adv;
+
+  /* Advance from the last Hall event */
+  Adv = ((int64)EmoPll_Status.Speed * (int64)(sint32)(Time - EmoPll_Status.Time)) +
+        (int64)(sint32)(EmoPll_Status.Angle - EmoPll_Status.HallAngle);
+  if(Adv > (int64)EMOPLL_ANGLE_60DEG)
+  {
+    Adv = (int64)EMOPLL_ANGLE_60DEG;
+  }
+  else if(Adv < -(int64)EMOPLL_ANGLE_60DEG)
+  {
+    Adv = -(int64)EMOPLL_ANGLE_60DEG;
+  }
+
+  return (uint16)((EmoPll_Status.HallAngle + (uint32)(sint32)Adv) >> 16u);
+} /* End of EmoPll_GetAngle */
+
+/** \brief Gets the estimated absolute speed.
+ *
+ * \return Speed [rpm], saturated at 65535
+ *
+ * \ingroup emo_pll_api
+ */
+uint16 EmoPll_GetSpeed(void)
+{
+  sint32 Speed;
+  uint64 Rpm;
+
+  Speed = EmoPll_Status.Speed;
+  if(Speed < 0)
+  {
+    Speed = -Speed;
+  }
+  Rpm = ((uint64)(uint32)Speed * EMOPLL_RPM_FAC) >> 24u;
+
+  return (uint16)((Rpm > 0xFFFFu) ? 0xFFFFu : Rpm);
+} /* End of EmoPll_GetSpeed */
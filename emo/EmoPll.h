@@ -0,0 +1,94 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/* See EmoPll.c */
+
+#ifndef EMO_PLL_H_
+#define EMO_PLL_H_
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include "tle_device.h"
+
+/*******************************************************************************
+**                      Global Macro Definitions                              **
+*******************************************************************************/
+/* Speed and angle observer: 1 = Emo_GetAbsSpeed and the angle of sine and FOC
+ * commutation come from the PLL, 0 = low-pass filtered Hall speed and angle
+ * interpolation with the speed of the last sector (observer compiled out).
+ * Host run (test_pll, sensors skewed by up to 4 degrees, 10 us edge jitter):
+ * on 3000 rpm/s ramps the observer lags 35..60 rpm against 118..138 rpm of
+ * the low pass, at constant speed it passes the sector width errors through
+ * Ki and is noisier (rms 90 against 33 rpm at 3000 rpm, 10 against 5 rpm at
+ * 300 rpm). May be set in the project C defines */
+#ifndef EMOPLL_EN
+#define EMOPLL_EN (0u)
+#endif
+
+/* Loop gains per Hall event (Q15): share of the angle error fed into the angle
+ * and, divided by the time since the last event, into the speed. Kp = 1 takes
+ * the Hall angle as it is, Ki = 0.5 averages sector width errors of the speed. */
+#define EMOPLL_KP (32768)   /* 1.0 */
+#define EMOPLL_KI (16384)   /* 0.5 */
+
+/* Electrical angle of one Hall sector (2^32 = 360 degrees) */
+#define EMOPLL_ANGLE_60DEG (0x2AAAAAABu)
+
+/*******************************************************************************
+**                      Global Type Definitions                               **
+*******************************************************************************/
+/** \brief Observer status, angles 0..2^32 = 0..360 degrees electrical */
+typedef struct
+{
+  uint32 Angle;         /**< \brief Estimated angle at Time */
+  uint32 Time;          /**< \brief Time of the last Hall event [T6 timer ticks] */
+  sint32 Speed;         /**< \brief Estimated speed [angle per T6 timer tick], sign = direction */
+  uint32 HallAngle;     /**< \brief Angle of the last Hall event */
+  uint8 Edges;          /**< \brief Hall events since EmoPll_Init, saturated at 2 */
+} TEmoPll_Status;
+
+/*******************************************************************************
+**                      Global Variable Declarations                          **
+*******************************************************************************/
+extern TEmoPll_Status EmoPll_Status;
+
+/*******************************************************************************
+**                      Global Function Declarations                          **
+*******************************************************************************/
+extern void EmoPll_Init(void);
+extern void EmoPll_Update(uint16 HallAngle, uint32 Time);
+extern void EmoPll_Stop(void);
+extern uint16 EmoPll_GetAngle(uint32 Time);
+extern uint16 EmoPll_GetSpeed(void);
+
+
+#endif /* EMO_PLL_H_ */
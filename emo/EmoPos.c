@@ -0,0 +1,342 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, PD position control with trapezoidal trajectory
+ * V0.1.1: 2026-10-17: Hold state at the target and reversal only near standstill
+ */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include "EmoPos.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+/* Trajectory limits: motor speed [rpm] and acceleration [rpm/ms] */
+#define EMOPOS_MAX_SPEED (3000)
+#define EMOPOS_MAX_ACC (10)
+
+/* PD gains: speed reference [rpm] = (Kp * error + Kd * error change per ms) >> shift,
+ * set for 512 ticks per revolution and scaled to the encoder resolution */
+#define EMOPOS_KP ((32 * 512) / (sint32)EMOENC_TICKS_PER_REV)
+#define EMOPOS_KD ((64 * 512) / (sint32)EMOENC_TICKS_PER_REV)
+#define EMOPOS_GAIN_SHIFT (4u)
+
+/* Limit of the speed reference [rpm] */
+#define EMOPOS_SPEED_LIMIT (4000)
+
+/* Hold band after the trajectory has settled [encoder ticks]: the motor is
+ * stopped once the error is within the deadband and restarted when the error
+ * exceeds the exit band, the gap keeps the position from hunting around the
+ * target */
+#define EMOPOS_DEADBAND (2)
+#define EMOPOS_HOLD_EXIT (8)
+
+/* Minimum speed reference to reverse the running motor [rpm], see
+ * EmoPos_lLimitReverse */
+#define EMOPOS_REVERSE_MIN (200)
+
+/* Function-like macro to convert a motor speed [rpm] to a trajectory velocity [encoder ticks/ms * 65536] */
+#define EmoPos_lRpmToVel(Rpm) ((sint32)((((float)(Rpm)) * (float)EMOENC_TICKS_PER_REV * 65536.0) / 60000.0))
+
+/* Factor for calculation of the feed-forward speed from the trajectory velocity:
+ * speed [rpm] = (velocity [encoder ticks/ms * 65536] * factor) >> 24
+ * factor = 60000 * 256 / encoder ticks per revolution, round to nearest */
+#define EMOPOS_FF_FAC ((sint32)(((60000.0 * 256.0) / (float)EMOENC_TICKS_PER_REV) + 0.5))
+
+/*******************************************************************************
+**                      Private Function Declarations                         **
+*******************************************************************************/
+static void EmoPos_lExeTrajectory(void);
+static sint32 EmoPos_lLimitReverse(sint32 Speed, sint32 ErrDiff);
+
+/*******************************************************************************
+**                      Global Variable Definitions                           **
+*******************************************************************************/
+TEmoPos_Ctrl EmoPos_Ctrl;
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+/** \brief Initializes position control parameters.
+ *
+ * \return None
+ *
+ * \ingroup emo_pos_api
+ */
+void EmoPos_InitPar(void)
+{
+  EmoPos_Ctrl.Enable = 0u;
+  EmoPos_Ctrl.MaxVel = EmoPos_lRpmToVel(EMOPOS_MAX_SPEED);
+  EmoPos_Ctrl.MaxAcc = EmoPos_lRpmToVel(EMOPOS_MAX_ACC);
+  EmoPos_Ctrl.Kp = (sint16)EMOPOS_KP;
+  EmoPos_Ctrl.Kd = (sint16)EMOPOS_KD;
+
+} /* End of EmoPos_InitPar */
+
+/** \brief Sets a new target position and enables position control.
+ *
+ * The trajectory continues from its current state if position control is
+ * enabled, otherwise it starts at rest at the actual position. Repeating the
+ * target keeps the hold state.
+ *
+ * \param[in] TargetPos Target position [encoder ticks]
+ * \param[in] ActPos Actual position [encoder ticks]
+ * \return None
+ *
+ * \ingroup emo_pos_api
+ */
+void EmoPos_SetTarget(sint32 TargetPos, sint32 ActPos)
+{
+  if(EmoPos_Ctrl.Enable == 0u)
+  {
+    /* Start trajectory at rest */
+    EmoPos_Ctrl.RefPos = (int64)ActPos << 16u;
+    EmoPos_Ctrl.RefVel = 0;
+    EmoPos_Ctrl.PosErr = 0;
+  }
+
+  EmoPos_Ctrl.TargetPos = TargetPos;
+  EmoPos_Ctrl.Enable = 1u;
+
+} /* End of EmoPos_SetTarget */
+
+/** \brief Disables position control and sets the speed reference to zero.
+ *
+ * \return None
+ *
+ * \ingroup emo_pos_api
+ */
+void EmoPos_Disable(void)
+{
+  EmoPos_Ctrl.Enable = 0u;
+  EmoPos_Ctrl.Hold = 0u;
+  EmoPos_Ctrl.RefSpeed = 0;
+  Emo_SetRefSpeed(0);
+
+} /* End of EmoPos_Disable */
+
+/** \brief Executes trajectory and position control.
+ *
+ * PD control of the tracking error with feed-forward of the trajectory
+ * velocity, the output is the reference of the speed control. The motor is
+ * started if it is stopped and the position has to be corrected. At the
+ * target the motor is stopped (hold) until the error leaves the hold band.
+ *
+ * \param[in] ActPos Actual position [encoder ticks]
+ * \return None
+ *
+ * \note Called every ms before Emo_CtrlSpeed.
+ *
+ * \ingroup emo_pos_api
+ */
+void EmoPos_Exe(sint32 ActPos)
+{
+  sint32 PosErr;
+  sint32 Speed;
+  sint32 AbsErr;
+  sint32 ErrDiff;
+
+  if(EmoPos_Ctrl.Enable == 0u)
+  {
+    return;
+  }
+
+  /* Advance trajectory by one ms */
+  EmoPos_lExeTrajectory();
+
+  /* Tracking error, limited to keep the PD terms within 32 bit */
+  PosErr = __SSAT((sint32)(EmoPos_Ctrl.RefPos >> 16u) - ActPos, 16u);
+  AbsErr = (PosErr < 0) ? -PosErr : PosErr;
+
+  /* Feed-forward of the trajectory velocity */
+  Speed = (sint32)(((int64)EmoPos_Ctrl.RefVel * EMOPOS_FF_FAC) >> 24u);
+
+  /* PD control */
+  ErrDiff = PosErr - EmoPos_Ctrl.PosErr;
+  Speed += ((PosErr * EmoPos_Ctrl.Kp) + (ErrDiff * EmoPos_Ctrl.Kd)) >> EMOPOS_GAIN_SHIFT;
+  EmoPos_Ctrl.PosErr = PosErr;
+
+  if((EmoPos_IsSettled() == false) || (AbsErr > EMOPOS_HOLD_EXIT))
+  {
+    /* Moving or pushed out of the hold band */
+    EmoPos_Ctrl.Hold = 0u;
+  }
+  else if((EmoPos_Ctrl.Hold == 0u) && (AbsErr <= EMOPOS_DEADBAND) && (ErrDiff == 0))
+  {
+    /* Target reached, no encoder edge in the last ms */
+    EmoPos_Ctrl.Hold = 1u;
+  }
+  else
+  {
+    /* Hold state unchanged */
+  }
+
+  if(EmoPos_Ctrl.Hold != 0u)
+  {
+    Speed = 0;
+  }
+  else
+  {
+    if(Speed > EMOPOS_SPEED_LIMIT)
+    {
+      Speed = EMOPOS_SPEED_LIMIT;
+    }
+    else if(Speed < -EMOPOS_SPEED_LIMIT)
+    {
+      Speed = -EMOPOS_SPEED_LIMIT;
+    }
+    else
+    {
+      /* Speed within limits */
+    }
+
+    Speed = EmoPos_lLimitReverse(Speed, ErrDiff);
+  }
+  EmoPos_Ctrl.RefSpeed = (sint16)Speed;
+
+  if(Speed == 0)
+  {
+    /* Coast, the minimum duty cycle of the speed control would keep the motor turning */
+    if(Emo_GetMotorState() != EMO_MOTOR_STATE_STOP)
+    {
+      (void)Emo_StopMotor();
+    }
+  }
+  else
+  {
+    Emo_SetRefSpeed((sint16)Speed);
+    if(Emo_GetMotorState() == EMO_MOTOR_STATE_STOP)
+    {
+      (void)Emo_StartMotor();
+    }
+  }
+
+} /* End of EmoPos_Exe */
+
+/*******************************************************************************
+**                      Private Function Definitions                          **
+*******************************************************************************/
+/* Trapezoidal trajectory: accelerates towards the target up to the maximum
+ * velocity and decelerates when the stopping distance reaches the remaining
+ * distance. Target changes are followed from the current velocity. */
+static void EmoPos_lExeTrajectory(void)
+{
+  int64 Dist;
+  int64 StopDist;
+  sint32 Vel;
+  sint32 Acc;
+  bool Reverse;
+
+  Acc = EmoPos_Ctrl.MaxAcc;
+
+  /* Remaining distance and velocity in direction of the target */
+  Dist = ((int64)EmoPos_Ctrl.TargetPos << 16u) - EmoPos_Ctrl.RefPos;
+  Vel = EmoPos_Ctrl.RefVel;
+  Reverse = (Dist < 0) ? true : false;
+  if(Reverse == true)
+  {
+    Dist = -Dist;
+    Vel = -Vel;
+  }
+
+  if((Dist <= (int64)Acc) && (Vel <= Acc) && (Vel >= -Acc))
+  {
+    /* Target reached within one acceleration step */
+    EmoPos_Ctrl.RefPos = (int64)EmoPos_Ctrl.TargetPos << 16u;
+    EmoPos_Ctrl.RefVel = 0;
+    return;
+  }
+
+  /* Distance to stop with maximum deceleration: v^2 / (2 * a) */
+  StopDist = ((int64)Vel * Vel) / (2 * (int64)Acc);
+
+  if(((Vel > 0) && (StopDist >= Dist)) || (Vel > EmoPos_Ctrl.MaxVel))
+  {
+    /* Decelerate */
+    Vel -= Acc;
+  }
+  else
+  {
+    /* Accelerate towards target */
+    Vel += Acc;
+    if(Vel > EmoPos_Ctrl.MaxVel)
+    {
+      Vel = EmoPos_Ctrl.MaxVel;
+    }
+  }
+
+  if(Reverse == true)
+  {
+    Vel = -Vel;
+  }
+
+  EmoPos_Ctrl.RefVel = Vel;
+  EmoPos_Ctrl.RefPos += Vel;
+
+} /* End of EmoPos_lExeTrajectory */
+
+/* Speed reference against the commutated direction: the running motor is
+ * reversed for large corrections and for braking only, smaller corrections
+ * stop the motor and start it in the new direction once the encoder stands
+ * still. Each reversal resynchronizes the commutation and restarts the Hall
+ * sector calibration. */
+static sint32 EmoPos_lLimitReverse(sint32 Speed, sint32 ErrDiff)
+{
+  bool Reverse;
+
+  Reverse = (EmoCcu_GetDirIdx() == 0u) ? (Speed < 0) : (Speed > 0);
+  if(Reverse == true)
+  {
+    if((Speed <= -EMOPOS_REVERSE_MIN) || (Speed >= EMOPOS_REVERSE_MIN))
+    {
+      if(Emo_GetMotorState() != EMO_MOTOR_STATE_STOP)
+      {
+        EmoPos_Ctrl.ReverseCtr++;
+      }
+    }
+    else if((Emo_GetMotorState() != EMO_MOTOR_STATE_STOP) || (ErrDiff != 0))
+    {
+      /* Coast to standstill */
+      Speed = 0;
+    }
+    else
+    {
+      /* Start in the new direction */
+    }
+  }
+
+  return Speed;
+
+} /* End of EmoPos_lLimitReverse */
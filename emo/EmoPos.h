@@ -0,0 +1,98 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/* See EmoPos.c */
+
+#ifndef EMO_POS_H_
+#define EMO_POS_H_
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include "tle_device.h"
+#include "Emo.h"
+#include "EmoCcu.h"
+#include "EmoEnc.h"
+
+/*******************************************************************************
+**                      Global Type Definitions                               **
+*******************************************************************************/
+/** \brief Position control with trapezoidal trajectory.
+ *  Positions in encoder ticks, trajectory values with 16 fractional bits.
+ */
+typedef struct
+{
+  sint32 TargetPos;     /**< \brief Target position [encoder ticks] */
+  int64 RefPos;         /**< \brief Trajectory position [encoder ticks * 65536] */
+  sint32 RefVel;        /**< \brief Trajectory velocity [encoder ticks/ms * 65536] */
+  sint32 MaxVel;        /**< \brief Maximum trajectory velocity [encoder ticks/ms * 65536] */
+  sint32 MaxAcc;        /**< \brief Maximum trajectory acceleration [encoder ticks/ms^2 * 65536] */
+  sint32 PosErr;        /**< \brief Position error of the last control step [encoder ticks] */
+  sint16 Kp;            /**< \brief P gain [rpm per encoder tick * 16] */
+  sint16 Kd;            /**< \brief D gain [rpm per encoder tick/ms * 16] */
+  sint16 RefSpeed;      /**< \brief Speed reference to the speed control [rpm] */
+  uint16 ReverseCtr;    /**< \brief Reversals of the running motor by the position control */
+  uint8 Hold;           /**< \brief Target reached, motor stopped until the error leaves the hold band */
+  uint8 Enable;         /**< \brief Position control enabled */
+} TEmoPos_Ctrl;
+
+/*******************************************************************************
+**                      Global Variable Declarations                          **
+*******************************************************************************/
+extern TEmoPos_Ctrl EmoPos_Ctrl;
+
+/*******************************************************************************
+**                      Global Function Declarations                          **
+*******************************************************************************/
+extern void EmoPos_InitPar(void);
+extern void EmoPos_SetTarget(sint32 TargetPos, sint32 ActPos);
+extern void EmoPos_Disable(void);
+extern void EmoPos_Exe(sint32 ActPos);
+
+__STATIC_INLINE bool EmoPos_IsSettled(void);
+
+/*******************************************************************************
+**                      Global Inline Function Definitions                    **
+*******************************************************************************/
+/** \brief Checks if the trajectory has reached the target position.
+ *
+ * \return true if the trajectory is at the target and stopped
+ *
+ * \ingroup emo_pos_api
+ */
+__STATIC_INLINE bool EmoPos_IsSettled(void)
+{
+  return ((EmoPos_Ctrl.RefVel == 0) && (EmoPos_Ctrl.RefPos == ((int64)EmoPos_Ctrl.TargetPos << 16u)));
+} /* End of EmoPos_IsSettled */
+
+
+#endif /* #ifndef EMO_POS_H_ */
@@ -0,0 +1,1103 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, host simulation kernel
+ * V0.1.1: 2026-10-18: Instruction count of a single call (Sim_InsnMeasure)
+ */
+
+/* Runs the firmware on the host against behavioural peripheral models.
+ *
+ * The device header is used with UNIT_TESTING_LV2, the peripheral pointers
+ * (CCU6, SCU, ...) point to the register addresses of the device, which are
+ * mapped without access rights. Every access of the firmware traps: the
+ * models refresh the register, the page is opened for one instruction (trap
+ * flag) and the models see the written words afterwards. A second, writable
+ * mapping of the same memory (Sim_Alias) is used by the models.
+ *
+ * Time advances per peripheral access, per interrupt entry and while the CPU
+ * waits (WFI, Delay_us). With Sim_InsnTiming the interrupt handlers run with
+ * the trap flag set, each host instruction takes SIM_INSN_CYCLES. Pending interrupts are taken after the access that
+ * raised them, at the events of the models and when PRIMASK is cleared, in
+ * NVIC priority order. The firmware main loop runs on its own stack and
+ * returns control to the test at WFI or Delay_us once the run time is over.
+ */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#define _GNU_SOURCE
+#include <signal.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include "Sim.h"
+#include "isr.h"
+#include "system_tle987x.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+#define SIM_PAGE        (0x1000u)
+#define SIM_STEP_MAX    (4u)
+#define SIM_WRITE_MAX   (8u)
+#define SIM_FW_STACK    (0x400000u)
+#define SIM_PRIO_NONE   (0x100u)
+#define SIM_PRIO_MSK    (0xF0u)
+#define SIM_EFL_TF      (0x100)
+#define SIM_ERR_WRITE   (0x2)
+
+#define SIM_SYSTICK_ENABLE  (1u << 0u)
+#define SIM_SYSTICK_TICKINT (1u << 1u)
+#define SIM_SYSTICK_COUNT   (1u << 16u)
+
+/*******************************************************************************
+**                      Private Type Definitions                              **
+*******************************************************************************/
+/** \brief Page opened for one instruction */
+typedef struct
+{
+  uint32 Rgn;
+  uint32 Addr;
+  bool Write;
+  uint32 Old[SIM_PAGE / 4u];
+} TSim_Step;
+
+/** \brief Word written by the stepped instruction */
+typedef struct
+{
+  uint32 Addr;
+  uint32 Old;
+  uint32 New;
+} TSim_Write;
+
+/*******************************************************************************
+**                      Global Variable Definitions                           **
+*******************************************************************************/
+/* Firmware view (UNIT_TESTING_LV2 pointers of the device header) */
+ADC1_Type *ADC1 = (ADC1_Type *)ADC1_BASE;
+ADC2_Type *ADC2 = (ADC2_Type *)ADC2_BASE;
+ADC34_Type *ADC34 = (ADC34_Type *)ADC34_BASE;
+BDRV_Type *BDRV = (BDRV_Type *)BDRV_BASE;
+CCU6_Type *CCU6 = (CCU6_Type *)CCU6_BASE;
+CSA_Type *CSA = (CSA_Type *)CSA_BASE;
+CPU_Type *CPU = (CPU_Type *)CPU_BASE;
+DMA_Type *DMA = (DMA_Type *)DMA_BASE;
+GPT12E_Type *GPT12E = (GPT12E_Type *)GPT12E_BASE;
+LIN_Type *LIN = (LIN_Type *)LIN_BASE;
+MF_Type *MF = (MF_Type *)MF_BASE;
+MON_Type *MON = (MON_Type *)MON_BASE;
+PMU_Type *PMU = (PMU_Type *)PMU_BASE;
+PORT_Type *PORT = (PORT_Type *)PORT_BASE;
+SCU_Type *SCU = (SCU_Type *)SCU_BASE;
+SCUPM_Type *SCUPM = (SCUPM_Type *)SCUPM_BASE;
+SSC1_Type *SSC1 = (SSC1_Type *)SSC1_BASE;
+SSC2_Type *SSC2 = (SSC2_Type *)SSC2_BASE;
+TIMER2x_Type *TIMER2 = (TIMER2x_Type *)TIMER2_BASE;
+TIMER2x_Type *TIMER21 = (TIMER2x_Type *)TIMER21_BASE;
+TIMER3_Type *TIMER3 = (TIMER3_Type *)TIMER3_BASE;
+UART_Type *UART1 = (UART_Type *)UART1_BASE;
+UART_Type *UART2 = (UART_Type *)UART2_BASE;
+
+volatile uint32_t Sim_PriMask;
+uint8 *Sim_Alias[SIM_RGN_NUM];
+
+/*******************************************************************************
+**                      Private Variable Definitions                          **
+*******************************************************************************/
+static const uint32 Sim_lRgnBase[SIM_RGN_NUM] =
+{
+  ADC1_BASE, ADC34_BASE, CCU6_BASE, GPT12E_BASE, BDRV_BASE, TIMER2_BASE, TIMER21_BASE,
+  TIMER3_BASE, MF_BASE, ADC2_BASE, LIN_BASE, UART1_BASE, UART2_BASE, SSC1_BASE, SSC2_BASE,
+  PORT_BASE, PMU_BASE, SCU_BASE, SCUPM_BASE, DMA_BASE, DWT_BASE, CPU_BASE
+};
+
+/* Models in processing order of simultaneous events */
+static const TSim_Model *const Sim_lModels[] =
+{
+  &Sim_Motor, &Sim_Port, &Sim_Ccu6, &Sim_Adc, &Sim_Gpt12e, &Sim_Ssc, &Sim_Dma, &Sim_Bdrv, &Sim_Scu
+};
+
+static bool Sim_lMapped;
+static TSim_Time Sim_lNow;
+static TSim_Time Sim_lTarget;
+
+/* Trap of the instruction being stepped */
+static TSim_Step Sim_lStep[SIM_STEP_MAX];
+static uint32 Sim_lStepNum;
+static uint32 Sim_lSigDepth;
+
+/* NVIC */
+static uint32 Sim_lEnabled;
+static uint32 Sim_lPending;
+static uint32 Sim_lActive[SIM_IRQ_NUM + 1u];
+static uint32 Sim_lActiveNum;
+
+/* SysTick: time of the last reload and of the next underflow */
+static TSim_Time Sim_lTickReload;
+static TSim_Time Sim_lTickNext;
+static bool Sim_lTickCount;
+
+/* DWT cycle counter offset */
+static TSim_Time Sim_lCycStart;
+
+/* Instruction timing of the interrupt handlers */
+static bool Sim_lInsnOn;
+static uint64_t Sim_lInsnNum;
+static bool Sim_lStepTf;
+
+/* Firmware main loop */
+static ucontext_t Sim_lTestCtx;
+static ucontext_t Sim_lFwCtx;
+static int (*Sim_lMain)(void);
+static bool Sim_lBooted;
+static bool Sim_lInFw;
+
+/*******************************************************************************
+**                      Private Function Declarations                         **
+*******************************************************************************/
+static sint32 Sim_lFindRgn(uintptr_t Addr);
+static void Sim_lModelRead(uint32 Addr);
+static void Sim_lModelWrite(uint32 Addr, uint32 Old, uint32 New);
+static void Sim_lCpuRead(uint32 Addr);
+static void Sim_lCpuWrite(uint32 Addr, uint32 Old, uint32 New);
+static uint32 Sim_lTickValue(void);
+static TSim_Time Sim_lNextEvent(void);
+static void Sim_lAdvance(TSim_Time Until);
+static void Sim_lIdle(TSim_Time Until);
+static uint32 Sim_lPrio(uint32 Irq);
+static sint32 Sim_lSelect(uint32 Above);
+static void Sim_lDispatch(void);
+static bool Sim_lYieldable(void);
+static void Sim_lFwEntry(void);
+static void Sim_lSegv(int Sig, siginfo_t *pInfo, void *pCtx);
+static void Sim_lTrap(int Sig, siginfo_t *pInfo, void *pCtx);
+static void Sim_lMap(void);
+static uint64_t Sim_lTfClear(void);
+static void Sim_lTfRestore(uint64_t Flags);
+
+/*******************************************************************************
+**                      Private Constant Definitions                          **
+*******************************************************************************/
+/* Vector table of the peripheral nodes and SysTick */
+static void (*const Sim_lVector[SIM_IRQ_NUM])(void) =
+{
+  GPT1_IRQHandler, GPT2_IRQHandler, ADC2_IRQHandler, ADC1_IRQHandler,
+  CCU6SR0_IRQHandler, CCU6SR1_IRQHandler, CCU6SR2_IRQHandler, CCU6SR3_IRQHandler,
+  SSC1_IRQHandler, SSC2_IRQHandler, UART1_IRQHandler, UART2_IRQHandler,
+  EXINT0_IRQHandler, EXINT1_IRQHandler, BDRV_IRQHandler, DMA_IRQHandler,
+  SysTick_Handler
+};
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+/** \brief Maps the registers (once) and resets time, NVIC and models.
+ *
+ * The firmware globals are not reset, each test case runs in its own process.
+ *
+ * \return None
+ */
+void Sim_Init(void)
+{
+  uint32 i;
+
+  Sim_lMap();
+  for(i = 0u; i < SIM_RGN_NUM; i++)
+  {
+    memset(Sim_Alias[i], 0, SIM_PAGE);
+  }
+  Sim_lNow = 0u;
+  Sim_lTarget = 0u;
+  Sim_lStepNum = 0u;
+  Sim_lEnabled = 0u;
+  Sim_lPending = 0u;
+  Sim_lActiveNum = 0u;
+  Sim_lTickNext = SIM_NEVER;
+  Sim_lTickCount = false;
+  Sim_lCycStart = 0u;
+  Sim_lInsnOn = false;
+  Sim_lInsnNum = 0u;
+  Sim_PriMask = 0u;
+  Sim_lBooted = false;
+  Sim_lInFw = false;
+
+  /* The SysTick reset value is unknown, the SDK writes it */
+  SIM_CPU->SYSTICK_CAL.reg = 0u;
+  for(i = 0u; i < (sizeof(Sim_lModels) / sizeof(Sim_lModels[0])); i++)
+  {
+    if(Sim_lModels[i]->Reset != NULL)
+    {
+      Sim_lModels[i]->Reset();
+    }
+  }
+} /* End of Sim_Init */
+
+/** \brief Prepares the firmware main loop, started by the first Sim_Run.
+ *
+ * \param[in] pMain Firmware main function, does not return
+ * \return None
+ */
+void Sim_Boot(int (*pMain)(void))
+{
+  void *pStack;
+
+  /* Below 2 GB like the other firmware data, addresses are taken as uint32 */
+  pStack = mmap(NULL, SIM_FW_STACK, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_32BIT, -1, 0);
+  if(pStack == MAP_FAILED)
+  {
+    Sim_Fail("no firmware stack");
+  }
+  Sim_lMain = pMain;
+  (void)getcontext(&Sim_lFwCtx);
+  Sim_lFwCtx.uc_stack.ss_sp = pStack;
+  Sim_lFwCtx.uc_stack.ss_size = SIM_FW_STACK;
+  Sim_lFwCtx.uc_link = NULL;
+  makecontext(&Sim_lFwCtx, Sim_lFwEntry, 0);
+  Sim_lBooted = true;
+} /* End of Sim_Boot */
+
+/** \brief Runs the firmware and the models for a time.
+ *
+ * Without Sim_Boot only the models and the interrupt handlers run.
+ *
+ * \param[in] Duration Time to run [cycles]
+ * \return None
+ */
+void Sim_Run(TSim_Time Duration)
+{
+  Sim_lTarget = Sim_lNow + Duration;
+  while(Sim_lNow < Sim_lTarget)
+  {
+    if(Sim_lBooted == true)
+    {
+      Sim_lInFw = true;
+      (void)swapcontext(&Sim_lTestCtx, &Sim_lFwCtx);
+      Sim_lInFw = false;
+    }
+    else
+    {
+      Sim_lDispatch();
+      Sim_lIdle(Sim_lTarget);
+    }
+  }
+} /* End of Sim_Run */
+
+/** \brief Returns the simulated time.
+ *
+ * \return Time [cycles]
+ */
+TSim_Time Sim_Now(void)
+{
+  return Sim_lNow;
+} /* End of Sim_Now */
+
+/** \brief Switches the instruction timing of the interrupt handlers.
+ *
+ * Handlers are single stepped, each instruction takes SIM_INSN_CYCLES. The
+ * count is that of the host build (x86-64, -O2), an estimate of the Thumb-2
+ * instructions; simulation code called by the firmware is not counted.
+ * About 100 times slower than without.
+ *
+ * \param[in] On true to count
+ * \return None
+ */
+void Sim_InsnTiming(bool On)
+{
+  Sim_lInsnOn = On;
+} /* End of Sim_InsnTiming */
+
+/** \brief Returns the instructions counted in interrupt handlers.
+ *
+ * \return Instructions since Sim_Init
+ */
+uint64_t Sim_InsnCount(void)
+{
+  return Sim_lInsnNum;
+} /* End of Sim_InsnCount */
+
+/** \brief Counts the instructions of one call as for a handler with
+ * Sim_InsnTiming, interrupts are held off during the call.
+ *
+ * \param[in] pFunc Function to call
+ * \return Instructions of the call, including call and return
+ */
+uint64_t Sim_InsnMeasure(void (*pFunc)(void))
+{
+  uint64_t Start;
+  bool On;
+  uint32 PriMask;
+
+  On = Sim_lInsnOn;
+  PriMask = Sim_PriMask;
+  Sim_lInsnOn = true;
+  Sim_PriMask = 1u;
+  Start = Sim_lInsnNum;
+  __builtin_ia32_writeeflags_u64(__builtin_ia32_readeflags_u64() | SIM_EFL_TF);
+  pFunc();
+  (void)Sim_lTfClear();
+  Start = Sim_lInsnNum - Start;
+  Sim_PriMask = PriMask;
+  Sim_lInsnOn = On;
+  return Start;
+} /* End of Sim_InsnMeasure */
+
+/** \brief Sets an interrupt pending, taken when enabled and unmasked.
+ *
+ * \param[in] Irq SIM_IRQ_x
+ * \return None
+ */
+void Sim_SetPending(uint32 Irq)
+{
+  Sim_lPending |= (1u << Irq);
+} /* End of Sim_SetPending */
+
+/** \brief Returns if an interrupt is pending.
+ *
+ * \param[in] Irq SIM_IRQ_x
+ * \return true if pending
+ */
+bool Sim_IsPending(uint32 Irq)
+{
+  return ((Sim_lPending & (1u << Irq)) != 0u) ? true : false;
+} /* End of Sim_IsPending */
+
+/** \brief Returns if an interrupt is enabled in the NVIC.
+ *
+ * \param[in] Irq SIM_IRQ_x
+ * \return true if enabled
+ */
+bool Sim_IsEnabled(uint32 Irq)
+{
+  return ((Sim_lEnabled & (1u << Irq)) != 0u) ? true : false;
+} /* End of Sim_IsEnabled */
+
+/** \brief Stops the test with a message.
+ *
+ * \param[in] pFmt printf format
+ * \return Does not return
+ */
+void Sim_Fail(const char *pFmt, ...)
+{
+  va_list Args;
+
+  va_start(Args, pFmt);
+  (void)fprintf(stderr, "SIM FAIL at %.3f ms: ", (double)Sim_lNow / (double)SIM_MS(1));
+  (void)vfprintf(stderr, pFmt, Args);
+  (void)fprintf(stderr, "\n");
+  va_end(Args);
+  _exit(2);
+} /* End of Sim_Fail */
+
+/** \brief Reads a bus address for a model, peripheral registers are refreshed.
+ *
+ * \param[in] Addr Address
+ * \param[in] Size Access size 1, 2 or 4 [bytes]
+ * \return Value
+ */
+uint32 Sim_BusRead(uint32 Addr, uint32 Size)
+{
+  sint32 Rgn;
+  volatile uint8 *p;
+
+  Rgn = Sim_lFindRgn(Addr);
+  if(Rgn >= 0)
+  {
+    Sim_lModelRead(Addr & ~3u);
+    p = &Sim_Alias[Rgn][Addr & (SIM_PAGE - 1u)];
+  }
+  else
+  {
+    p = (volatile uint8 *)(uintptr_t)Addr;
+  }
+  return (Size == 1u) ? *p : ((Size == 2u) ? *(volatile uint16 *)p : *(volatile uint32 *)p);
+} /* End of Sim_BusRead */
+
+/** \brief Writes a bus address for a model, peripheral writes go to the models.
+ *
+ * \param[in] Addr Address
+ * \param[in] Value Value
+ * \param[in] Size Access size 1, 2 or 4 [bytes]
+ * \return None
+ */
+void Sim_BusWrite(uint32 Addr, uint32 Value, uint32 Size)
+{
+  sint32 Rgn;
+  volatile uint8 *p;
+  volatile uint32 *pWord;
+  uint32 Old;
+
+  Rgn = Sim_lFindRgn(Addr);
+  p = (Rgn >= 0) ? &Sim_Alias[Rgn][Addr & (SIM_PAGE - 1u)] : (volatile uint8 *)(uintptr_t)Addr;
+  pWord = (volatile uint32 *)((uintptr_t)p & ~(uintptr_t)3u);
+  Old = *pWord;
+  if(Size == 1u)
+  {
+    *p = (uint8)Value;
+  }
+  else if(Size == 2u)
+  {
+    *(volatile uint16 *)p = (uint16)Value;
+  }
+  else
+  {
+    *(volatile uint32 *)p = Value;
+  }
+  if(Rgn >= 0)
+  {
+    Sim_lModelWrite(Addr & ~3u, Old, *pWord);
+  }
+} /* End of Sim_BusWrite */
+
+/** \brief CMSIS PRIMASK cleared: takes the pending interrupts.
+ *
+ * \return None
+ */
+void Sim_Unmask(void)
+{
+  uint64_t Flags;
+
+  Flags = Sim_lTfClear();
+  if(Sim_lSigDepth == 0u)
+  {
+    Sim_lDispatch();
+  }
+  Sim_lTfRestore(Flags);
+} /* End of Sim_Unmask */
+
+/** \brief CMSIS WFI: waits for an interrupt that would preempt.
+ *
+ * Wakes up also with PRIMASK set, the interrupt is taken when PRIMASK is
+ * cleared.
+ *
+ * \return None
+ */
+void Sim_Wfi(void)
+{
+  uint32 Above;
+  uint64_t Flags;
+
+  Flags = Sim_lTfClear();
+  Above = (Sim_lActiveNum == 0u) ? SIM_PRIO_NONE : Sim_lActive[Sim_lActiveNum - 1u];
+  while(Sim_lSelect(Above) < 0)
+  {
+    Sim_lIdle(SIM_NEVER);
+  }
+  Sim_lDispatch();
+  Sim_lTfRestore(Flags);
+} /* End of Sim_Wfi */
+
+/** \brief Delay_us of the SDK (linked with --wrap): the time passes with
+ * interrupts, without polling SysTick.
+ *
+ * \param[in] delay_time_us Delay [us]
+ * \return None
+ */
+void __wrap_Delay_us(uint32 delay_time_us)
+{
+  TSim_Time End;
+  uint64_t Flags;
+
+  Flags = Sim_lTfClear();
+  End = Sim_lNow + SIM_US(delay_time_us);
+  while(Sim_lNow < End)
+  {
+    Sim_lDispatch();
+    Sim_lIdle(End);
+  }
+  Sim_lTfRestore(Flags);
+} /* End of __wrap_Delay_us */
+
+/* CMSIS functions of the device header (cmsis_misra.h) for UNIT_TESTING_LV2 */
+sint32 CMSIS_Irq_Dis(void)
+{
+  return (sint32)__disable_irq();
+}
+
+void CMSIS_Irq_En(void)
+{
+  __enable_irq();
+}
+
+void CMSIS_NOP(void)
+{
+}
+
+void CMSIS_WFE(void)
+{
+  Sim_Wfi();
+}
+
+/* Nodes without handler in the configuration */
+#define SIM_UNUSED_HANDLER(Name) \
+  __attribute__((weak)) void Name(void) { Sim_Fail("interrupt without handler: " #Name); }
+SIM_UNUSED_HANDLER(GPT1_IRQHandler)
+SIM_UNUSED_HANDLER(GPT2_IRQHandler)
+SIM_UNUSED_HANDLER(ADC2_IRQHandler)
+SIM_UNUSED_HANDLER(ADC1_IRQHandler)
+SIM_UNUSED_HANDLER(CCU6SR0_IRQHandler)
+SIM_UNUSED_HANDLER(CCU6SR1_IRQHandler)
+SIM_UNUSED_HANDLER(CCU6SR2_IRQHandler)
+SIM_UNUSED_HANDLER(CCU6SR3_IRQHandler)
+SIM_UNUSED_HANDLER(SSC1_IRQHandler)
+SIM_UNUSED_HANDLER(SSC2_IRQHandler)
+SIM_UNUSED_HANDLER(UART1_IRQHandler)
+SIM_UNUSED_HANDLER(UART2_IRQHandler)
+SIM_UNUSED_HANDLER(EXINT0_IRQHandler)
+SIM_UNUSED_HANDLER(EXINT1_IRQHandler)
+SIM_UNUSED_HANDLER(BDRV_IRQHandler)
+SIM_UNUSED_HANDLER(DMA_IRQHandler)
+
+/* Boot ROM functions (bootrom.h) for UNIT_TESTING_LV2 */
+bool USER_CFLASH_WR_PROT_EN(uint16 cflash_pw) { (void)cflash_pw; return true; }
+bool USER_CFLASH_WR_PROT_DIS(uint16 cflash_pw) { (void)cflash_pw; return true; }
+bool USER_CFLASH_RD_PROT_EN(uint16 cflash_pw) { (void)cflash_pw; return true; }
+bool USER_CFLASH_RD_PROT_DIS(uint16 cflash_pw) { (void)cflash_pw; return true; }
+bool USER_DFLASH_WR_PROT_EN(uint16 dflash_pw) { (void)dflash_pw; return true; }
+bool USER_DFLASH_WR_PROT_DIS(uint16 dflash_pw) { (void)dflash_pw; return true; }
+bool USER_DFLASH_RD_PROT_EN(uint16 dflash_pw) { (void)dflash_pw; return true; }
+bool USER_DFLASH_RD_PROT_DIS(uint16 dflash_pw) { (void)dflash_pw; return true; }
+
+/*******************************************************************************
+**                      Private Function Definitions                          **
+*******************************************************************************/
+static sint32 Sim_lFindRgn(uintptr_t Addr)
+{
+  uint32 i;
+
+  for(i = 0u; i < SIM_RGN_NUM; i++)
+  {
+    if((Addr - Sim_lRgnBase[i]) < SIM_PAGE)
+    {
+      return (sint32)i;
+    }
+  }
+  return -1;
+}
+
+static void Sim_lModelRead(uint32 Addr)
+{
+  uint32 i;
+
+  Sim_lCpuRead(Addr);
+  for(i = 0u; i < (sizeof(Sim_lModels) / sizeof(Sim_lModels[0])); i++)
+  {
+    if(Sim_lModels[i]->Read != NULL)
+    {
+      Sim_lModels[i]->Read(Addr);
+    }
+  }
+}
+
+static void Sim_lModelWrite(uint32 Addr, uint32 Old, uint32 New)
+{
+  uint32 i;
+
+  Sim_lCpuWrite(Addr, Old, New);
+  for(i = 0u; i < (sizeof(Sim_lModels) / sizeof(Sim_lModels[0])); i++)
+  {
+    if(Sim_lModels[i]->Write != NULL)
+    {
+      Sim_lModels[i]->Write(Addr, Old, New);
+    }
+  }
+}
+
+/* Core registers: NVIC set/clear pairs, SysTick counter, DWT cycle counter */
+static void Sim_lCpuRead(uint32 Addr)
+{
+  if(Addr == SIM_ADDR(CPU, SYSTICK_CUR))
+  {
+    SIM_CPU->SYSTICK_CUR.reg = Sim_lTickValue();
+  }
+  else if(Addr == SIM_ADDR(CPU, SYSTICK_CS))
+  {
+    /* COUNTFLAG is cleared by the read */
+    SIM_CPU->SYSTICK_CS.reg = (SIM_CPU->SYSTICK_CS.reg & ~SIM_SYSTICK_COUNT) |
+                              ((Sim_lTickCount == true) ? SIM_SYSTICK_COUNT : 0u);
+    Sim_lTickCount = false;
+  }
+  else if(Addr == (DWT_BASE + 4u))
+  {
+    DWT_Type *pDwt = (DWT_Type *)Sim_Alias[SIM_RGN_DWT];
+    pDwt->CYCCNT = ((pDwt->CTRL & DWT_CTRL_CYCCNTENA_Msk) != 0u) ? (uint32)(Sim_lNow - Sim_lCycStart) : pDwt->CYCCNT;
+  }
+  else
+  {
+    /* Plain registers */
+  }
+}
+
+static void Sim_lCpuWrite(uint32 Addr, uint32 Old, uint32 New)
+{
+  uint32 Rl;
+
+  if(Addr == SIM_ADDR(CPU, NVIC_ISER0))
+  {
+    Sim_lEnabled |= New & 0xFFFFu;
+  }
+  else if(Addr == SIM_ADDR(CPU, NVIC_ICER0))
+  {
+    Sim_lEnabled &= ~New;
+  }
+  else if(Addr == SIM_ADDR(CPU, NVIC_ISPR0))
+  {
+    Sim_lPending |= New & 0xFFFFu;
+  }
+  else if(Addr == SIM_ADDR(CPU, NVIC_ICPR0))
+  {
+    Sim_lPending &= ~(New & 0xFFFFu);
+  }
+  else if(Addr == SIM_ADDR(CPU, SYSTICK_CUR))
+  {
+    /* Any write clears the counter, reloaded with the next clock */
+    Sim_lTickCount = false;
+    Sim_lTickReload = Sim_lNow + 1u;
+    Sim_lTickNext = ((SIM_CPU->SYSTICK_CS.reg & SIM_SYSTICK_ENABLE) != 0u) ?
+                    (Sim_lTickReload + SIM_CPU->SYSTICK_RL.reg) : SIM_NEVER;
+    SIM_CPU->SYSTICK_CUR.reg = 0u;
+  }
+  else if(Addr == SIM_ADDR(CPU, SYSTICK_CS))
+  {
+    Rl = SIM_CPU->SYSTICK_RL.reg;
+    if(((Old & SIM_SYSTICK_ENABLE) == 0u) && ((New & SIM_SYSTICK_ENABLE) != 0u))
+    {
+      /* Counts on from the current value, from the reload value after 0 */
+      if(SIM_CPU->SYSTICK_CUR.reg == 0u)
+      {
+        Sim_lTickReload = Sim_lNow + 1u;
+      }
+      else
+      {
+        Sim_lTickReload = Sim_lNow - (TSim_Time)(Rl - SIM_CPU->SYSTICK_CUR.reg);
+      }
+      Sim_lTickNext = Sim_lTickReload + Rl;
+    }
+    else if(((Old & SIM_SYSTICK_ENABLE) != 0u) && ((New & SIM_SYSTICK_ENABLE) == 0u))
+    {
+      SIM_CPU->SYSTICK_CUR.reg = Sim_lTickValue();
+      Sim_lTickNext = SIM_NEVER;
+    }
+    else
+    {
+      /* TICKINT, CLKSOURCE */
+    }
+  }
+  else if(Addr == DWT_BASE)
+  {
+    if(((Old & DWT_CTRL_CYCCNTENA_Msk) == 0u) && ((New & DWT_CTRL_CYCCNTENA_Msk) != 0u))
+    {
+      Sim_lCycStart = Sim_lNow - ((DWT_Type *)Sim_Alias[SIM_RGN_DWT])->CYCCNT;
+    }
+  }
+  else if(Addr == (DWT_BASE + 4u))
+  {
+    Sim_lCycStart = Sim_lNow - New;
+  }
+  else
+  {
+    return;
+  }
+
+  /* Set/clear registers read the state */
+  SIM_CPU->NVIC_ISER0.reg = Sim_lEnabled;
+  SIM_CPU->NVIC_ICER0.reg = Sim_lEnabled;
+  SIM_CPU->NVIC_ISPR0.reg = Sim_lPending & 0xFFFFu;
+  SIM_CPU->NVIC_ICPR0.reg = Sim_lPending & 0xFFFFu;
+}
+
+static uint32 Sim_lTickValue(void)
+{
+  uint32 Rl;
+
+  if((SIM_CPU->SYSTICK_CS.reg & SIM_SYSTICK_ENABLE) == 0u)
+  {
+    return SIM_CPU->SYSTICK_CUR.reg;
+  }
+  if(Sim_lNow < Sim_lTickReload)
+  {
+    return 0u;
+  }
+  Rl = SIM_CPU->SYSTICK_RL.reg;
+  return Rl - (uint32)((Sim_lNow - Sim_lTickReload) % ((TSim_Time)Rl + 1u));
+}
+
+static TSim_Time Sim_lNextEvent(void)
+{
+  TSim_Time Next;
+  TSim_Time t;
+  uint32 i;
+
+  Next = Sim_lTickNext;
+  for(i = 0u; i < (sizeof(Sim_lModels) / sizeof(Sim_lModels[0])); i++)
+  {
+    if(Sim_lModels[i]->Next != NULL)
+    {
+      t = Sim_lModels[i]->Next();
+      if(t < Next)
+      {
+        Next = t;
+      }
+    }
+  }
+  return Next;
+}
+
+/* Processes the events up to Until, interrupts are only set pending */
+static void Sim_lAdvance(TSim_Time Until)
+{
+  TSim_Time Next;
+  uint32 i;
+
+  for(;;)
+  {
+    Next = Sim_lNextEvent();
+    if(Next > Until)
+    {
+      break;
+    }
+    if(Next > Sim_lNow)
+    {
+      Sim_lNow = Next;
+    }
+    if(Sim_lTickNext <= Sim_lNow)
+    {
+      /* Underflow to 0, reload with the next clock */
+      Sim_lTickReload = Sim_lTickNext + 1u;
+      Sim_lTickNext = Sim_lTickReload + SIM_CPU->SYSTICK_RL.reg;
+      Sim_lTickCount = true;
+      if((SIM_CPU->SYSTICK_CS.reg & SIM_SYSTICK_TICKINT) != 0u)
+      {
+        Sim_SetPending(SIM_IRQ_SYSTICK);
+      }
+    }
+    for(i = 0u; i < (sizeof(Sim_lModels) / sizeof(Sim_lModels[0])); i++)
+    {
+      if((Sim_lModels[i]->Next != NULL) && (Sim_lModels[i]->Next() <= Sim_lNow))
+      {
+        Sim_lModels[i]->Step(Sim_lNow);
+      }
+    }
+  }
+  if(Until > Sim_lNow)
+  {
+    Sim_lNow = Until;
+  }
+}
+
+/* Waits up to the next event, Until or the end of the run (firmware returns
+ * to the test there) */
+static void Sim_lIdle(TSim_Time Until)
+{
+  TSim_Time Next;
+
+  if(Sim_lYieldable() == true)
+  {
+    if(Sim_lNow >= Sim_lTarget)
+    {
+      (void)swapcontext(&Sim_lFwCtx, &Sim_lTestCtx);
+      return;
+    }
+    if(Sim_lTarget < Until)
+    {
+      Until = Sim_lTarget;
+    }
+  }
+  Next = Sim_lNextEvent();
+  if(Next < Sim_lNow)
+  {
+    Next = Sim_lNow;
+  }
+  if(Until < Next)
+  {
+    Next = Until;
+  }
+  if(Next == SIM_NEVER)
+  {
+    Sim_Fail("waiting without any event");
+  }
+  Sim_lAdvance(Next);
+}
+
+static uint32 Sim_lPrio(uint32 Irq)
+{
+  uint32 Ipr;
+
+  if(Irq == SIM_IRQ_SYSTICK)
+  {
+    return (SIM_CPU->SHPR3.reg >> 24u) & SIM_PRIO_MSK;
+  }
+  Ipr = (&SIM_CPU->NVIC_IPR0.reg)[Irq >> 2u];
+  return (Ipr >> ((Irq & 3u) * 8u)) & SIM_PRIO_MSK;
+}
+
+/* Highest priority pending and enabled interrupt above a priority, SysTick
+ * before the peripheral nodes of the same priority */
+static sint32 Sim_lSelect(uint32 Above)
+{
+  sint32 Best;
+  uint32 BestPrio;
+  uint32 Prio;
+  uint32 Irq;
+  uint32 Ready;
+
+  Best = -1;
+  BestPrio = Above;
+  Ready = Sim_lPending & (Sim_lEnabled | (1u << SIM_IRQ_SYSTICK));
+  if((Ready & (1u << SIM_IRQ_SYSTICK)) != 0u)
+  {
+    Prio = Sim_lPrio(SIM_IRQ_SYSTICK);
+    if(Prio < BestPrio)
+    {
+      Best = (sint32)SIM_IRQ_SYSTICK;
+      BestPrio = Prio;
+    }
+  }
+  for(Irq = 0u; Irq < SIM_IRQ_SYSTICK; Irq++)
+  {
+    if((Ready & (1u << Irq)) != 0u)
+    {
+      Prio = Sim_lPrio(Irq);
+      if(Prio < BestPrio)
+      {
+        Best = (sint32)Irq;
+        BestPrio = Prio;
+      }
+    }
+  }
+  return Best;
+}
+
+/* Takes the pending interrupts that preempt the running code */
+static void Sim_lDispatch(void)
+{
+  sint32 Irq;
+  uint32 Above;
+
+  while(Sim_PriMask == 0u)
+  {
+    Above = (Sim_lActiveNum == 0u) ? SIM_PRIO_NONE : Sim_lActive[Sim_lActiveNum - 1u];
+    Irq = Sim_lSelect(Above);
+    if(Irq < 0)
+    {
+      break;
+    }
+    Sim_lPending &= ~(1u << (uint32)Irq);
+    Sim_lActive[Sim_lActiveNum] = Sim_lPrio((uint32)Irq);
+    Sim_lActiveNum++;
+    Sim_lAdvance(Sim_lNow + SIM_ISR_CYCLES);
+    if(Sim_lInsnOn == true)
+    {
+      /* Steps from the instruction after the next one on, the call */
+      __builtin_ia32_writeeflags_u64(__builtin_ia32_readeflags_u64() | SIM_EFL_TF);
+    }
+    Sim_lVector[Irq]();
+    (void)Sim_lTfClear();
+    Sim_lAdvance(Sim_lNow + SIM_ISR_CYCLES);
+    Sim_lActiveNum--;
+  }
+}
+
+/* The main loop returns to the test from thread mode only */
+static bool Sim_lYieldable(void)
+{
+  return ((Sim_lInFw == true) && (Sim_lSigDepth == 0u) && (Sim_lActiveNum == 0u)) ? true : false;
+}
+
+/* Reset handler of the startup code */
+static void Sim_lFwEntry(void)
+{
+  SystemInit();
+  (void)Sim_lMain();
+  Sim_Fail("firmware main returned");
+}
+
+/* Access of a register page: refresh, open the page for one instruction */
+static void Sim_lSegv(int Sig, siginfo_t *pInfo, void *pCtx)
+{
+  ucontext_t *pUc;
+  sint32 Rgn;
+  uint32 Addr;
+  TSim_Step *pStep;
+
+  (void)Sig;
+  pUc = (ucontext_t *)pCtx;
+  Rgn = Sim_lFindRgn((uintptr_t)pInfo->si_addr);
+  if((Rgn < 0) || (Sim_lStepNum >= SIM_STEP_MAX))
+  {
+    (void)fprintf(stderr, "SIM: segmentation fault at %p, rip %p\n", pInfo->si_addr,
+                  (void *)pUc->uc_mcontext.gregs[REG_RIP]);
+    (void)signal(SIGSEGV, SIG_DFL);
+    return;
+  }
+  Sim_lSigDepth++;
+  Addr = (uint32)(uintptr_t)pInfo->si_addr & ~3u;
+  Sim_lAdvance(Sim_lNow + SIM_ACCESS_CYCLES);
+  Sim_lModelRead(Addr);
+
+  pStep = &Sim_lStep[Sim_lStepNum];
+  Sim_lStepNum++;
+  pStep->Rgn = (uint32)Rgn;
+  pStep->Addr = Addr;
+  pStep->Write = ((pUc->uc_mcontext.gregs[REG_ERR] & SIM_ERR_WRITE) != 0) ? true : false;
+  Sim_lStepTf = ((pUc->uc_mcontext.gregs[REG_EFL] & SIM_EFL_TF) != 0) ? true : false;
+  memcpy(pStep->Old, Sim_Alias[Rgn], SIM_PAGE);
+  (void)mprotect((void *)(uintptr_t)Sim_lRgnBase[Rgn], SIM_PAGE, PROT_READ | PROT_WRITE);
+  pUc->uc_mcontext.gregs[REG_EFL] |= SIM_EFL_TF;
+  Sim_lSigDepth--;
+}
+
+/* Instruction done: close the pages, pass the writes, take interrupts */
+static void Sim_lTrap(int Sig, siginfo_t *pInfo, void *pCtx)
+{
+  ucontext_t *pUc;
+  TSim_Step *pStep;
+  const uint32 *pNew;
+  TSim_Write Writes[SIM_WRITE_MAX];
+  uint32 Num;
+  uint32 Addr;
+  uint32 i;
+  uint32 w;
+
+  (void)Sig;
+  (void)pInfo;
+  pUc = (ucontext_t *)pCtx;
+  /* With instruction timing also after the instruction that clears the flag */
+  if((Sim_lStepNum == 0u) && (Sim_lInsnOn == false))
+  {
+    (void)fprintf(stderr, "SIM: unexpected trap at %p\n", (void *)pUc->uc_mcontext.gregs[REG_RIP]);
+    abort();
+  }
+  Sim_lSigDepth++;
+  if((Sim_lStepNum == 0u) || (Sim_lStepTf == true))
+  {
+    /* Instruction of a handler with instruction timing, the trap flag stays */
+    Sim_lInsnNum++;
+    Sim_lAdvance(Sim_lNow + SIM_INSN_CYCLES);
+  }
+  else
+  {
+    pUc->uc_mcontext.gregs[REG_EFL] &= ~SIM_EFL_TF;
+  }
+
+  /* The words written by the instruction are collected first, the write
+   * hooks update other registers of the page (read back of set/clear pairs).
+   * The hooks may raise interrupts but run no firmware code. */
+  Num = 0u;
+  for(i = 0u; i < Sim_lStepNum; i++)
+  {
+    pStep = &Sim_lStep[i];
+    (void)mprotect((void *)(uintptr_t)Sim_lRgnBase[pStep->Rgn], SIM_PAGE, PROT_NONE);
+    pNew = (const uint32 *)Sim_Alias[pStep->Rgn];
+    for(w = 0u; w < (SIM_PAGE / 4u); w++)
+    {
+      Addr = Sim_lRgnBase[pStep->Rgn] + (w * 4u);
+      if(((pNew[w] != pStep->Old[w]) || ((pStep->Write == true) && (Addr == pStep->Addr))) &&
+         (Num < SIM_WRITE_MAX))
+      {
+        Writes[Num].Addr = Addr;
+        Writes[Num].Old = pStep->Old[w];
+        Writes[Num].New = pNew[w];
+        Num++;
+      }
+    }
+  }
+  Sim_lStepNum = 0u;
+  for(i = 0u; i < Num; i++)
+  {
+    Sim_lModelWrite(Writes[i].Addr, Writes[i].Old, Writes[i].New);
+  }
+
+  Sim_lSigDepth--;
+  Sim_lDispatch();
+}
+
+static void Sim_lMap(void)
+{
+  struct sigaction Sa;
+  void *p;
+  int Fd;
+  uint32 i;
+
+  if(Sim_lMapped == true)
+  {
+    return;
+  }
+  Fd = memfd_create("sim_regs", 0);
+  if((Fd < 0) || (ftruncate(Fd, (off_t)SIM_RGN_NUM * SIM_PAGE) != 0))
+  {
+    Sim_Fail("no register memory");
+  }
+  for(i = 0u; i < SIM_RGN_NUM; i++)
+  {
+    Sim_Alias[i] = mmap(NULL, SIM_PAGE, PROT_READ | PROT_WRITE, MAP_SHARED, Fd, (off_t)i * SIM_PAGE);
+    p = mmap((void *)(uintptr_t)Sim_lRgnBase[i], SIM_PAGE, PROT_NONE, MAP_SHARED | MAP_FIXED_NOREPLACE, Fd,
+             (off_t)i * SIM_PAGE);
+    if((Sim_Alias[i] == MAP_FAILED) || (p != (void *)(uintptr_t)Sim_lRgnBase[i]))
+    {
+      Sim_Fail("register page 0x%08X not mapped", Sim_lRgnBase[i]);
+    }
+  }
+  memset(&Sa, 0, sizeof(Sa));
+  Sa.sa_flags = SA_SIGINFO | SA_NODEFER;
+  Sa.sa_sigaction = Sim_lSegv;
+  (void)sigaction(SIGSEGV, &Sa, NULL);
+  Sa.sa_sigaction = Sim_lTrap;
+  (void)sigaction(SIGTRAP, &Sa, NULL);
+  Sim_lMapped = true;
+}
+
+/* Trap flag off for simulation code called from a stepped handler, returns
+ * the flags to restore */
+static uint64_t Sim_lTfClear(void)
+{
+  uint64_t Flags;
+
+  Flags = __builtin_ia32_readeflags_u64();
+  if((Flags & SIM_EFL_TF) != 0u)
+  {
+    __builtin_ia32_writeeflags_u64(Flags & ~(uint64_t)SIM_EFL_TF);
+  }
+  return Flags;
+}
+
+static void Sim_lTfRestore(uint64_t Flags)
+{
+  if((Flags & SIM_EFL_TF) != 0u)
+  {
+    __builtin_ia32_writeeflags_u64(__builtin_ia32_readeflags_u64() | SIM_EFL_TF);
+  }
+}
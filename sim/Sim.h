@@ -0,0 +1,241 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/* See Sim.c */
+
+#ifndef SIM_H
+#define SIM_H
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include <stddef.h>
+#include <stdint.h>
+#include "tle_device.h"
+
+/*******************************************************************************
+**                      Global Macro Definitions                              **
+*******************************************************************************/
+/* Simulated time is counted in CPU cycles */
+#define SIM_FSYS_HZ       (40000000u)
+#define SIM_CYCLES_PER_US (SIM_FSYS_HZ / 1000000u)
+#define SIM_US(Us)        ((TSim_Time)(Us) * SIM_CYCLES_PER_US)
+#define SIM_MS(Ms)        (SIM_US(Ms) * 1000u)
+#define SIM_NEVER         (~(TSim_Time)0u)
+
+/* Cycles charged per peripheral access and per interrupt entry/exit, the CPU
+ * itself takes no simulated time unless Sim_InsnTiming is on: then each
+ * instruction of an interrupt handler takes SIM_INSN_CYCLES */
+#define SIM_ACCESS_CYCLES (2u)
+#define SIM_ISR_CYCLES    (12u)
+#define SIM_INSN_CYCLES   (1u)
+
+/* Interrupt nodes (NVIC numbers), SysTick after the peripheral nodes */
+#define SIM_IRQ_GPT1    (0u)
+#define SIM_IRQ_GPT2    (1u)
+#define SIM_IRQ_ADC2    (2u)
+#define SIM_IRQ_ADC1    (3u)
+#define SIM_IRQ_CCU6SR0 (4u)
+#define SIM_IRQ_CCU6SR1 (5u)
+#define SIM_IRQ_CCU6SR2 (6u)
+#define SIM_IRQ_CCU6SR3 (7u)
+#define SIM_IRQ_SSC1    (8u)
+#define SIM_IRQ_SSC2    (9u)
+#define SIM_IRQ_UART1   (10u)
+#define SIM_IRQ_UART2   (11u)
+#define SIM_IRQ_EXINT0  (12u)
+#define SIM_IRQ_EXINT1  (13u)
+#define SIM_IRQ_BDRV    (14u)
+#define SIM_IRQ_DMA     (15u)
+#define SIM_IRQ_SYSTICK (16u)
+#define SIM_IRQ_NUM     (17u)
+
+/* Peripheral regions, one 4 KB page each */
+#define SIM_RGN_ADC1    (0u)
+#define SIM_RGN_ADC34   (1u)
+#define SIM_RGN_CCU6    (2u)
+#define SIM_RGN_GPT12E  (3u)
+#define SIM_RGN_BDRV    (4u)
+#define SIM_RGN_TIMER2  (5u)
+#define SIM_RGN_TIMER21 (6u)
+#define SIM_RGN_TIMER3  (7u)
+#define SIM_RGN_MF      (8u)
+#define SIM_RGN_ADC2    (9u)
+#define SIM_RGN_LIN     (10u)
+#define SIM_RGN_UART1   (11u)
+#define SIM_RGN_UART2   (12u)
+#define SIM_RGN_SSC1    (13u)
+#define SIM_RGN_SSC2    (14u)
+#define SIM_RGN_PORT    (15u)
+#define SIM_RGN_PMU     (16u)
+#define SIM_RGN_SCU     (17u)
+#define SIM_RGN_SCUPM   (18u)
+#define SIM_RGN_DMA     (19u)
+#define SIM_RGN_DWT     (20u)
+#define SIM_RGN_CPU     (21u)
+#define SIM_RGN_NUM     (22u)
+
+/* Model side views of the registers, the firmware pointers (CCU6, ...) trap */
+#define SIM_ADC1   ((ADC1_Type *)Sim_Alias[SIM_RGN_ADC1])
+#define SIM_ADC2   ((ADC2_Type *)Sim_Alias[SIM_RGN_ADC2])
+#define SIM_BDRV   ((BDRV_Type *)Sim_Alias[SIM_RGN_BDRV])
+#define SIM_CCU6   ((CCU6_Type *)Sim_Alias[SIM_RGN_CCU6])
+#define SIM_CPU    ((CPU_Type *)Sim_Alias[SIM_RGN_CPU])
+#define SIM_DMA    ((DMA_Type *)Sim_Alias[SIM_RGN_DMA])
+#define SIM_GPT12E ((GPT12E_Type *)Sim_Alias[SIM_RGN_GPT12E])
+#define SIM_LIN    ((LIN_Type *)Sim_Alias[SIM_RGN_LIN])
+#define SIM_MF     ((MF_Type *)Sim_Alias[SIM_RGN_MF])
+#define SIM_PMU    ((PMU_Type *)Sim_Alias[SIM_RGN_PMU])
+#define SIM_PORT   ((PORT_Type *)Sim_Alias[SIM_RGN_PORT])
+#define SIM_SCU    ((SCU_Type *)Sim_Alias[SIM_RGN_SCU])
+#define SIM_SCUPM  ((SCUPM_Type *)Sim_Alias[SIM_RGN_SCUPM])
+#define SIM_SSC1   ((SSC1_Type *)Sim_Alias[SIM_RGN_SSC1])
+#define SIM_SSC2   ((SSC2_Type *)Sim_Alias[SIM_RGN_SSC2])
+#define SIM_TIMER3 ((TIMER3_Type *)Sim_Alias[SIM_RGN_TIMER3])
+#define SIM_UART1  ((UART_Type *)Sim_Alias[SIM_RGN_UART1])
+
+/* Register address of a peripheral pointer member, as passed to the models */
+#define SIM_ADDR(Periph, Member) ((uint32)(uintptr_t)&(Periph)->Member)
+
+/*******************************************************************************
+**                      Global Type Definitions                               **
+*******************************************************************************/
+/** \brief Simulated time [CPU cycles] */
+typedef uint64_t TSim_Time;
+
+/** \brief Behavioural model of a peripheral or of the plant.
+ *
+ * Read is called before the firmware reads a register (refresh of counters
+ * derived from the time), Write after the firmware or the DMA wrote a word,
+ * also if the value did not change. Next returns the time of the next own
+ * event, Step processes the events due at Now. Unused members are NULL.
+ */
+typedef struct
+{
+  void (*Reset)(void);                                /**< \brief Reset values */
+  void (*Read)(uint32 Addr);                          /**< \brief Before a read of the word at Addr */
+  void (*Write)(uint32 Addr, uint32 Old, uint32 New); /**< \brief After a write of the word at Addr */
+  TSim_Time (*Next)(void);                            /**< \brief Time of the next event */
+  void (*Step)(TSim_Time Now);                        /**< \brief Processes the events due */
+} TSim_Model;
+
+/** \brief Parameters of the motor model, see SimMotor.c */
+typedef struct
+{
+  float64 R;          /**< \brief Phase resistance [Ohm] */
+  float64 L;          /**< \brief Phase inductance [H] */
+  float64 Ke;         /**< \brief Back EMF constant, phase peak [V s/rad electrical] */
+  uint32 PolePairs;   /**< \brief Pole pairs */
+  float64 J;          /**< \brief Rotor and load inertia [kg m^2] */
+  float64 B;          /**< \brief Viscous friction [Nm s/rad] */
+  float64 Friction;   /**< \brief Coulomb friction [Nm] */
+  float64 Vdc;        /**< \brief DC link voltage [V] */
+  float64 HallErr[6]; /**< \brief Hall edge errors, edge n nominal at 30 + 60 n [degrees electrical] */
+} TSim_MotorCfg;
+
+/*******************************************************************************
+**                      Global Variable Declarations                          **
+*******************************************************************************/
+extern uint8 *Sim_Alias[SIM_RGN_NUM];
+
+extern const TSim_Model Sim_Scu;
+extern const TSim_Model Sim_Ccu6;
+extern const TSim_Model Sim_Gpt12e;
+extern const TSim_Model Sim_Ssc;
+extern const TSim_Model Sim_Dma;
+extern const TSim_Model Sim_Adc;
+extern const TSim_Model Sim_Bdrv;
+extern const TSim_Model Sim_Port;
+extern const TSim_Model Sim_Motor;
+
+extern const TSim_MotorCfg Sim_MotorDefault;
+
+/*******************************************************************************
+**                      Global Function Declarations                          **
+*******************************************************************************/
+/* Kernel */
+void Sim_Init(void);
+void Sim_Boot(int (*pMain)(void));
+void Sim_Run(TSim_Time Duration);
+TSim_Time Sim_Now(void);
+void Sim_InsnTiming(bool On);
+uint64_t Sim_InsnCount(void);
+uint64_t Sim_InsnMeasure(void (*pFunc)(void));
+void Sim_SetPending(uint32 Irq);
+bool Sim_IsPending(uint32 Irq);
+bool Sim_IsEnabled(uint32 Irq);
+void Sim_Fail(const char *pFmt, ...) __attribute__((noreturn, format(printf, 1, 2)));
+
+/* Bus access of the models (DMA), peripheral words go through the models */
+uint32 Sim_BusRead(uint32 Addr, uint32 Size);
+void Sim_BusWrite(uint32 Addr, uint32 Value, uint32 Size);
+
+/* Models, see the model files */
+void Sim_AdcT12Pm(void);
+uint32 Sim_BdrvGates(void);
+TSim_Time Sim_BdrvOffTime(void);
+void Sim_BdrvOvercurrent(uint32 Msk);
+void Sim_BdrvLimit(uint32 Msk);
+void Sim_Ccu6SetHall(uint32 Ptn);
+void Sim_Ccu6SetBemf(uint32 Ptn);
+void Sim_Ccu6Outputs(float64 *pOn);
+uint32 Sim_Ccu6OutputsNow(void);
+TSim_Time Sim_Ccu6Period(void);
+TSim_Time Sim_Ccu6PatternTime(void);
+void Sim_DmaRequest(uint32 Ch);
+void Sim_GptPinEdge(uint32 Port, uint32 Pin);
+bool Sim_PortGetPin(uint32 Port, uint32 Pin);
+void Sim_PortSetPin(uint32 Port, uint32 Pin, bool Level);
+void Sim_PortSetExint(uint32 Exint, bool Level);
+void Sim_SpiStart(const uint16 *pTx, uint16 *pRx, uint32 Num, TSim_Time WordTime);
+bool Sim_SpiBusy(void);
+uint32 Sim_UartRead(uint8 *pBuf, uint32 Max);
+
+/* Plant */
+void Sim_MotorInit(const TSim_MotorCfg *pCfg, float64 Angle);
+void Sim_MotorSetAngle(float64 Angle);
+void Sim_MotorSetLoad(float64 Torque);
+void Sim_MotorLock(bool Lock);
+float64 Sim_MotorSpeed(void);
+float64 Sim_MotorAngle(void);
+float64 Sim_MotorTorque(void);
+float64 Sim_MotorPhaseCurrent(uint32 Ph);
+float64 Sim_MotorBusCurrent(void);
+uint32 Sim_MotorHall(void);
+TSim_Time Sim_MotorHallEdge(uint32 *pNum);
+uint32 Sim_MotorBemf(void);
+TSim_Time Sim_MotorBemfEdge(uint32 *pNum);
+
+/* Firmware entry, Main.c is built with main renamed */
+int Main_Firmware(void);
+
+#endif /* SIM_H */
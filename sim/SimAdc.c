@@ -0,0 +1,172 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, ADC1 and Timer3 model of the current measurement
+ */
+
+/* Current measurement of the firmware: Timer3 in mode 1b is retriggered by the
+ * T12 period match, its compare match starts the ADC1 EIM conversion of the
+ * current sense amplifier. The DC link current of the motor model is taken at
+ * the compare match, the result is valid one conversion time later and its
+ * valid flag is cleared by the read. Other ADC1 channels are not modelled. */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include <stddef.h>
+#include "Sim.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+/* Timer3 counts with fSYS / 2 */
+#define SIM_T3_DIV          (2u)
+#define SIM_T3_MODE_1B      ((1u << TIMER3_MODE_CONF_T3M_Pos) | (1u << TIMER3_MODE_CONF_T3_SUBM_Pos))
+#define SIM_T3_TRIGG_T12PM  (4u)
+
+/* ADC1 EIM trigger Timer3, conversion time */
+#define SIM_ADC_TRIGG_T3    (6u)
+#define SIM_ADC_CONV_CYCLES (40u)
+
+/* CSA: 10 bit result at 5 V reference, offset VAREF / 2, 2.5 mOhm shunt with gain 40 (MF_CSA_CTRL) */
+#define SIM_CSA_OFFSET      (512.0)
+#define SIM_CSA_COUNTS_PER_A (20.48)
+#define SIM_CSA_MAX         (1023.0)
+
+/*******************************************************************************
+**                      Private Variable Definitions                          **
+*******************************************************************************/
+static TSim_Time Sim_lAdcTrigg;
+static TSim_Time Sim_lAdcDone;
+static uint32 Sim_lAdcResult;
+static bool Sim_lAdcRead;
+
+/*******************************************************************************
+**                      Private Function Declarations                         **
+*******************************************************************************/
+static void Sim_lAdcReset(void);
+static void Sim_lAdcReadHook(uint32 Addr);
+static TSim_Time Sim_lAdcNext(void);
+static void Sim_lAdcStep(TSim_Time Now);
+static void Sim_lAdcClearVf(void);
+
+/*******************************************************************************
+**                      Global Constant Definitions                           **
+*******************************************************************************/
+const TSim_Model Sim_Adc =
+{
+  Sim_lAdcReset, Sim_lAdcReadHook, NULL, Sim_lAdcNext, Sim_lAdcStep
+};
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+/** \brief T12 period match of the CCU6 model: retriggers Timer3.
+ *
+ * \return None
+ */
+void Sim_AdcT12Pm(void)
+{
+  uint32 Cmp;
+
+  if(((SIM_TIMER3->CTRL.reg & TIMER3_CTRL_TR3L_Msk) == 0u) ||
+     ((SIM_TIMER3->MODE_CONF.reg & (TIMER3_MODE_CONF_T3M_Msk | TIMER3_MODE_CONF_T3_SUBM_Msk)) != SIM_T3_MODE_1B) ||
+     ((SIM_TIMER3->T3_TRIGG_CTRL.reg & TIMER3_T3_TRIGG_CTRL_T3_TRIGG_INP_SEL_Msk) != SIM_T3_TRIGG_T12PM))
+  {
+    return;
+  }
+  /* A compare value beyond the PWM period is not reached before the next trigger */
+  Cmp = SIM_TIMER3->CMP.reg;
+  Sim_lAdcTrigg = Sim_Now() + ((TSim_Time)Cmp * SIM_T3_DIV);
+  if((Sim_Ccu6Period() != 0u) && (((TSim_Time)Cmp * SIM_T3_DIV) >= Sim_Ccu6Period()))
+  {
+    Sim_lAdcTrigg = SIM_NEVER;
+  }
+} /* End of Sim_AdcT12Pm */
+
+/*******************************************************************************
+**                      Private Function Definitions                          **
+*******************************************************************************/
+static void Sim_lAdcReset(void)
+{
+  Sim_lAdcTrigg = SIM_NEVER;
+  Sim_lAdcDone = SIM_NEVER;
+  Sim_lAdcRead = false;
+}
+
+/* The valid flag is cleared after the read of the result, at the next access */
+static void Sim_lAdcReadHook(uint32 Addr)
+{
+  Sim_lAdcClearVf();
+  if(Addr == SIM_ADDR(ADC1, RES_OUT_EIM))
+  {
+    Sim_lAdcRead = true;
+  }
+}
+
+static TSim_Time Sim_lAdcNext(void)
+{
+  Sim_lAdcClearVf();
+  return (Sim_lAdcTrigg < Sim_lAdcDone) ? Sim_lAdcTrigg : Sim_lAdcDone;
+}
+
+static void Sim_lAdcStep(TSim_Time Now)
+{
+  float64 Counts;
+
+  if(Sim_lAdcTrigg <= Now)
+  {
+    Sim_lAdcTrigg = SIM_NEVER;
+    if((((uint32)SIM_ADC1->CHx_EIM.reg & ADC1_CHx_EIM_TRIG_SEL_Msk) >> ADC1_CHx_EIM_TRIG_SEL_Pos) == SIM_ADC_TRIGG_T3)
+    {
+      Counts = SIM_CSA_OFFSET + (Sim_MotorBusCurrent() * SIM_CSA_COUNTS_PER_A);
+      Counts = (Counts < 0.0) ? 0.0 : ((Counts > SIM_CSA_MAX) ? SIM_CSA_MAX : Counts);
+      Sim_lAdcResult = (uint32)(Counts + 0.5);
+      Sim_lAdcDone = Now + SIM_ADC_CONV_CYCLES;
+    }
+  }
+  if(Sim_lAdcDone <= Now)
+  {
+    Sim_lAdcDone = SIM_NEVER;
+    SIM_ADC1->RES_OUT_EIM.reg = (Sim_lAdcResult << 2u) | ADC1_RES_OUT_EIM_VF8_Msk;
+  }
+}
+
+static void Sim_lAdcClearVf(void)
+{
+  if(Sim_lAdcRead == true)
+  {
+    Sim_lAdcRead = false;
+    SIM_ADC1->RES_OUT_EIM.reg &= ~ADC1_RES_OUT_EIM_VF8_Msk;
+  }
+}
@@ -0,0 +1,171 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, bridge driver model
+ * V0.1.1: 2026-10-18: ADC2 supply limits of VCP and VSD
+ */
+
+/* Bridge driver: the enabled high and low side channels gate the CCU6 outputs
+ * for the motor model. An overcurrent or ADC2 supply limit injected by a test
+ * sets the interrupt status in SCUPM; the time the last enabled channel was switched off is kept
+ * for the measurement of the fault reaction. */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include <stddef.h>
+#include "Sim.h"
+
+/*******************************************************************************
+**                      Private Variable Definitions                          **
+*******************************************************************************/
+static uint32 Sim_lBdrvGates;
+static TSim_Time Sim_lBdrvOff;
+
+/*******************************************************************************
+**                      Private Function Declarations                         **
+*******************************************************************************/
+static void Sim_lBdrvReset(void);
+static void Sim_lBdrvFlag(uint32 Msk);
+static void Sim_lBdrvWrite(uint32 Addr, uint32 Old, uint32 New);
+
+/*******************************************************************************
+**                      Global Constant Definitions                           **
+*******************************************************************************/
+const TSim_Model Sim_Bdrv =
+{
+  Sim_lBdrvReset, NULL, Sim_lBdrvWrite, NULL, NULL
+};
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+/** \brief Returns the enabled channels in the order of the CCU6 outputs.
+ *
+ * \return Bit mask, bit 0 = HS1 (CC60), bit 1 = LS1 (COUT60) .. bit 5 = LS3
+ */
+uint32 Sim_BdrvGates(void)
+{
+  return Sim_lBdrvGates;
+} /* End of Sim_BdrvGates */
+
+/** \brief Returns the time all channels were switched off last.
+ *
+ * \return Time [cycles], SIM_NEVER while a channel is enabled
+ */
+TSim_Time Sim_BdrvOffTime(void)
+{
+  return Sim_lBdrvOff;
+} /* End of Sim_BdrvOffTime */
+
+/** \brief Overcurrent of bridge driver channels.
+ *
+ * \param[in] Msk SCUPM_BDRV_IS_xSy_OC_IS_Msk bits
+ * \return None
+ */
+void Sim_BdrvOvercurrent(uint32 Msk)
+{
+  Sim_lBdrvFlag(Msk);
+} /* End of Sim_BdrvOvercurrent */
+
+/** \brief ADC2 supply limit of VCP or VSD, the limit comparison of ADC2 is
+ * not modelled.
+ *
+ * \param[in] Msk SCUPM_BDRV_IS_Vxx_yyTH_IS_Msk bits
+ * \return None
+ */
+void Sim_BdrvLimit(uint32 Msk)
+{
+  Sim_lBdrvFlag(Msk);
+} /* End of Sim_BdrvLimit */
+
+/*******************************************************************************
+**                      Private Function Definitions                          **
+*******************************************************************************/
+static void Sim_lBdrvReset(void)
+{
+  Sim_lBdrvGates = 0u;
+  Sim_lBdrvOff = 0u;
+}
+
+/* Interrupt status and enable share the bit positions */
+static void Sim_lBdrvFlag(uint32 Msk)
+{
+  SIM_SCUPM->BDRV_IS.reg |= Msk;
+  if((SIM_SCUPM->BDRV_IRQ_CTRL.reg & Msk) != 0u)
+  {
+    Sim_SetPending(SIM_IRQ_BDRV);
+  }
+}
+
+static void Sim_lBdrvWrite(uint32 Addr, uint32 Old, uint32 New)
+{
+  uint32 Ctrl1;
+  uint32 Ctrl2;
+  uint32 Gates;
+
+  (void)Old;
+  if((Addr == SIM_ADDR(BDRV, CTRL1)) || (Addr == SIM_ADDR(BDRV, CTRL2)))
+  {
+    Ctrl1 = SIM_BDRV->CTRL1.reg;
+    Ctrl2 = SIM_BDRV->CTRL2.reg;
+    Gates = ((Ctrl1 & BDRV_CTRL1_HS1_EN_Msk) != 0u) ? 0x01u : 0u;
+    Gates |= ((Ctrl1 & BDRV_CTRL1_LS1_EN_Msk) != 0u) ? 0x02u : 0u;
+    Gates |= ((Ctrl1 & BDRV_CTRL1_HS2_EN_Msk) != 0u) ? 0x04u : 0u;
+    Gates |= ((Ctrl1 & BDRV_CTRL1_LS2_EN_Msk) != 0u) ? 0x08u : 0u;
+    Gates |= ((Ctrl2 & BDRV_CTRL2_HS3_EN_Msk) != 0u) ? 0x10u : 0u;
+    Gates |= ((Ctrl2 & BDRV_CTRL2_LS3_EN_Msk) != 0u) ? 0x20u : 0u;
+    if(Gates != 0u)
+    {
+      Sim_lBdrvOff = SIM_NEVER;
+    }
+    else if(Sim_lBdrvGates != 0u)
+    {
+      Sim_lBdrvOff = Sim_Now();
+    }
+    else
+    {
+      /* Still off */
+    }
+    Sim_lBdrvGates = Gates;
+  }
+  else if(Addr == SIM_ADDR(SCUPM, BDRV_ISCLR))
+  {
+    SIM_SCUPM->BDRV_IS.reg &= ~New;
+    SIM_SCUPM->BDRV_ISCLR.reg = 0u;
+  }
+  else
+  {
+    /* Plain register */
+  }
+}
@@ -0,0 +1,636 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, CCU6 model
+ * V0.1.1: 2026-10-18: CCPOSx input selection of the Hall inputs and the BEMF comparators
+ */
+
+/* CCU6 in the configuration of the firmware: T12 edge-aligned PWM with period
+ * match and shadow transfer, T13 single shot started by a Hall input edge and
+ * the Hall sampling at its period match (T12MSEL HSYNC), CCPOSx from the Hall
+ * input or, with PISEL0 ISPOSx = BEMF and the comparator of the phase enabled
+ * towards the CCU6 in MF BEMFC_CTRL_STS, from the BEMF comparator, multi-channel mode
+ * with the correct/wrong Hall event and the pattern shadow transfer. The
+ * outputs are passed to the motor model: a T12 modulated CC6x output is active
+ * from the compare value to the period match, its COUT6x in the rest of the
+ * period, an output with the pattern bit set but without modulation is
+ * active for the whole period. Dead time and the trap function are not
+ * modelled. */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include <stddef.h>
+#include "Sim.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+#define SIM_CCU_CH_NUM      (3u)
+#define SIM_CCU_OUT_NUM     (6u)
+
+/* T12MSEL HSYNC: Hall sampling at any edge, T13 period match, off */
+#define SIM_CCU_HSYNC_EDGE  (0u)
+#define SIM_CCU_HSYNC_T13PM (2u)
+#define SIM_CCU_HSYNC_OFF   (3u)
+
+/* TCTR2 T13TEC: T13 started by any edge of CCPOSx */
+#define SIM_CCU_T13TEC_HALL (7u)
+
+/* MCMCTR SWSEL: pattern transfer with the correct Hall event */
+#define SIM_CCU_SWSEL_CHE   (1u)
+
+/* PISEL0 ISPOSx: CCPOSx from the BEMF comparator */
+#define SIM_CCU_ISPOS_BEMF  (3u)
+
+/*******************************************************************************
+**                      Private Type Definitions                              **
+*******************************************************************************/
+/** \brief Counter of T12 or T13, counting up from 0 to the period */
+typedef struct
+{
+  bool Run;
+  TSim_Time Base;  /**< \brief Time of count 0 of the current period */
+  uint16 Val;      /**< \brief Count while stopped */
+  uint16 Period;   /**< \brief Active period value */
+} TSim_CcuTmr;
+
+/*******************************************************************************
+**                      Private Variable Definitions                          **
+*******************************************************************************/
+static TSim_CcuTmr Sim_lT12;
+static TSim_CcuTmr Sim_lT13;
+static uint16 Sim_lCc[SIM_CCU_CH_NUM];
+static uint32 Sim_lHall;   /* Hall inputs */
+static uint32 Sim_lBemf;   /* BEMF comparators */
+static uint32 Sim_lPos;    /* CCPOS0..2 after the input selection */
+static TSim_Time Sim_lPtnTime;
+
+/*******************************************************************************
+**                      Private Function Declarations                         **
+*******************************************************************************/
+static void Sim_lCcuReset(void);
+static void Sim_lCcuRead(uint32 Addr);
+static void Sim_lCcuWrite(uint32 Addr, uint32 Old, uint32 New);
+static TSim_Time Sim_lCcuNext(void);
+static void Sim_lCcuStep(TSim_Time Now);
+static TSim_Time Sim_lCcuDiv12(void);
+static TSim_Time Sim_lCcuDiv13(void);
+static uint16 Sim_lCcuCount(const TSim_CcuTmr *pTmr, TSim_Time Div, TSim_Time Now);
+static TSim_Time Sim_lCcuPm(const TSim_CcuTmr *pTmr, TSim_Time Div);
+static void Sim_lCcuStart(TSim_CcuTmr *pTmr, TSim_Time Div);
+static void Sim_lCcuStop(TSim_CcuTmr *pTmr, TSim_Time Div);
+static void Sim_lCcuShadow12(void);
+static void Sim_lCcuShadow13(void);
+static void Sim_lCcuTctr0(void);
+static void Sim_lCcuFlag(uint32 Msk);
+static void Sim_lCcuInputs(void);
+static void Sim_lCcuHallSample(void);
+static void Sim_lCcuMcmout(uint32 Mcm);
+
+/*******************************************************************************
+**                      Global Constant Definitions                           **
+*******************************************************************************/
+const TSim_Model Sim_Ccu6 =
+{
+  Sim_lCcuReset, Sim_lCcuRead, Sim_lCcuWrite, Sim_lCcuNext, Sim_lCcuStep
+};
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+/** \brief Sets the Hall inputs CCPOS0..2.
+ *
+ * \param[in] Ptn Hall pattern, bit 0 = CCPOS0
+ * \return None
+ */
+void Sim_Ccu6SetHall(uint32 Ptn)
+{
+  Sim_lHall = Ptn & 0x7u;
+  Sim_lCcuInputs();
+} /* End of Sim_Ccu6SetHall */
+
+/** \brief Sets the BEMF comparator outputs.
+ *
+ * \param[in] Ptn BEMF pattern, bit 0 = phase U
+ * \return None
+ */
+void Sim_Ccu6SetBemf(uint32 Ptn)
+{
+  Sim_lBemf = Ptn & 0x7u;
+  Sim_lCcuInputs();
+} /* End of Sim_Ccu6SetBemf */
+
+/** \brief Returns the active time of the outputs over a T12 period.
+ *
+ * \param[out] pOn Fraction 0..1 of CC60, COUT60, CC61, COUT61, CC62, COUT62
+ * \return None
+ */
+void Sim_Ccu6Outputs(float64 *pOn)
+{
+  uint32 Mod;
+  uint32 Ptn;
+  uint32 o;
+  float64 Cmp;
+
+  Mod = SIM_CCU6->MODCTR.reg;
+  Ptn = ((Mod & CCU6_MODCTR_MCMEN_Msk) != 0u) ? ((uint32)SIM_CCU6->MCMOUT.reg & CCU6_MCMOUT_MCMP_Msk) : 0x3Fu;
+  for(o = 0u; o < SIM_CCU_OUT_NUM; o++)
+  {
+    if((Ptn & (1u << o)) == 0u)
+    {
+      pOn[o] = 0.0;
+    }
+    else if((Mod & (1u << o)) == 0u)
+    {
+      /* Pattern only: static in multi-channel mode, passive otherwise */
+      pOn[o] = ((Mod & CCU6_MODCTR_MCMEN_Msk) != 0u) ? 1.0 : 0.0;
+    }
+    else if(Sim_lT12.Run == false)
+    {
+      pOn[o] = 0.0;
+    }
+    else
+    {
+      Cmp = (float64)Sim_lCc[o >> 1u] / ((float64)Sim_lT12.Period + 1.0);
+      Cmp = (Cmp > 1.0) ? 1.0 : Cmp;
+      pOn[o] = ((o & 1u) == 0u) ? (1.0 - Cmp) : Cmp;
+    }
+  }
+} /* End of Sim_Ccu6Outputs */
+
+/** \brief Returns the outputs active now.
+ *
+ * \return Bit mask, bit 0 = CC60 .. bit 5 = COUT62
+ */
+uint32 Sim_Ccu6OutputsNow(void)
+{
+  float64 On[SIM_CCU_OUT_NUM];
+  uint32 Count;
+  uint32 Act;
+  uint32 o;
+  bool Cc;
+
+  Sim_Ccu6Outputs(On);
+  Count = Sim_lCcuCount(&Sim_lT12, Sim_lCcuDiv12(), Sim_Now());
+  Act = 0u;
+  for(o = 0u; o < SIM_CCU_OUT_NUM; o++)
+  {
+    if(On[o] > 0.0)
+    {
+      Cc = (Count >= Sim_lCc[o >> 1u]) ? true : false;
+      if((((uint32)SIM_CCU6->MODCTR.reg & (1u << o)) == 0u) || (Cc == (((o & 1u) == 0u) ? true : false)))
+      {
+        Act |= 1u << o;
+      }
+    }
+  }
+  return Act;
+} /* End of Sim_Ccu6OutputsNow */
+
+/** \brief Returns the T12 period [CPU cycles].
+ *
+ * \return Period, 0 while T12 is stopped
+ */
+TSim_Time Sim_Ccu6Period(void)
+{
+  return (Sim_lT12.Run == true) ? (((TSim_Time)Sim_lT12.Period + 1u) * Sim_lCcuDiv12()) : 0u;
+} /* End of Sim_Ccu6Period */
+
+/** \brief Returns the time of the last change of the output pattern (MCMP).
+ *
+ * \return Time [cycles]
+ */
+TSim_Time Sim_Ccu6PatternTime(void)
+{
+  return Sim_lPtnTime;
+} /* End of Sim_Ccu6PatternTime */
+
+/*******************************************************************************
+**                      Private Function Definitions                          **
+*******************************************************************************/
+static void Sim_lCcuReset(void)
+{
+  Sim_lT12.Run = false;
+  Sim_lT12.Val = 0u;
+  Sim_lT12.Period = 0u;
+  Sim_lT13 = Sim_lT12;
+  Sim_lCc[0] = 0u;
+  Sim_lCc[1] = 0u;
+  Sim_lCc[2] = 0u;
+  Sim_lHall = 0u;
+  Sim_lBemf = 0u;
+  Sim_lPos = 0u;
+  Sim_lPtnTime = 0u;
+}
+
+/* Counters, compare states and the sampled Hall inputs before a read */
+static void Sim_lCcuRead(uint32 Addr)
+{
+  uint32 Count;
+  uint32 Sts;
+  uint32 i;
+
+  if((Addr - CCU6_BASE) >= sizeof(CCU6_Type))
+  {
+    return;
+  }
+  Count = Sim_lCcuCount(&Sim_lT12, Sim_lCcuDiv12(), Sim_Now());
+  SIM_CCU6->T12.reg = (uint16)Count;
+  SIM_CCU6->T13.reg = Sim_lCcuCount(&Sim_lT13, Sim_lCcuDiv13(), Sim_Now());
+  Sts = (uint32)SIM_CCU6->CMPSTAT.reg & ~(CCU6_CMPSTAT_CC60ST_Msk | CCU6_CMPSTAT_CC61ST_Msk | CCU6_CMPSTAT_CC62ST_Msk);
+  for(i = 0u; i < SIM_CCU_CH_NUM; i++)
+  {
+    if((Sim_lT12.Run == true) && (Count >= Sim_lCc[i]))
+    {
+      Sts |= CCU6_CMPSTAT_CC60ST_Msk << i;
+    }
+  }
+  SIM_CCU6->CMPSTAT.reg = (uint16)Sts;
+  Sim_lCcuTctr0();
+}
+
+static void Sim_lCcuWrite(uint32 Addr, uint32 Old, uint32 New)
+{
+  uint32 Mcm;
+
+  (void)Old;
+  if(Addr == SIM_ADDR(CCU6, TCTR4))
+  {
+    if((New & CCU6_TCTR4_T12RR_Msk) != 0u)
+    {
+      Sim_lCcuStop(&Sim_lT12, Sim_lCcuDiv12());
+    }
+    if((New & CCU6_TCTR4_T12RES_Msk) != 0u)
+    {
+      Sim_lT12.Val = 0u;
+      Sim_lT12.Base = Sim_Now();
+    }
+    if((New & CCU6_TCTR4_T12STR_Msk) != 0u)
+    {
+      SIM_CCU6->TCTR0.reg |= (uint16)CCU6_TCTR0_STE12_Msk;
+    }
+    if((New & CCU6_TCTR4_T12STD_Msk) != 0u)
+    {
+      SIM_CCU6->TCTR0.reg &= (uint16)~CCU6_TCTR0_STE12_Msk;
+    }
+    if((New & CCU6_TCTR4_T13RR_Msk) != 0u)
+    {
+      Sim_lCcuStop(&Sim_lT13, Sim_lCcuDiv13());
+    }
+    if((New & CCU6_TCTR4_T13RES_Msk) != 0u)
+    {
+      Sim_lT13.Val = 0u;
+      Sim_lT13.Base = Sim_Now();
+    }
+    if((New & CCU6_TCTR4_T13STR_Msk) != 0u)
+    {
+      SIM_CCU6->TCTR0.reg |= (uint16)CCU6_TCTR0_STE13_Msk;
+    }
+    if((New & CCU6_TCTR4_T13STD_Msk) != 0u)
+    {
+      SIM_CCU6->TCTR0.reg &= (uint16)~CCU6_TCTR0_STE13_Msk;
+    }
+    /* Shadow transfer at once while stopped, then start */
+    if(Sim_lT12.Run == false)
+    {
+      Sim_lCcuShadow12();
+    }
+    if(Sim_lT13.Run == false)
+    {
+      Sim_lCcuShadow13();
+    }
+    if((New & CCU6_TCTR4_T12RS_Msk) != 0u)
+    {
+      Sim_lCcuStart(&Sim_lT12, Sim_lCcuDiv12());
+    }
+    if((New & CCU6_TCTR4_T13RS_Msk) != 0u)
+    {
+      Sim_lCcuStart(&Sim_lT13, Sim_lCcuDiv13());
+    }
+    SIM_CCU6->TCTR4.reg = 0u;
+    Sim_lCcuTctr0();
+  }
+  else if(Addr == SIM_ADDR(CCU6, MCMOUTS))
+  {
+    /* Immediate transfer of the output and of the Hall patterns */
+    Mcm = SIM_CCU6->MCMOUT.reg;
+    if((New & CCU6_MCMOUTS_STRMCM_Msk) != 0u)
+    {
+      Mcm = (Mcm & ~CCU6_MCMOUT_MCMP_Msk) | (New & CCU6_MCMOUTS_MCMPS_Msk);
+    }
+    if((New & CCU6_MCMOUTS_STRHP_Msk) != 0u)
+    {
+      Mcm = (Mcm & ~(CCU6_MCMOUT_EXPH_Msk | CCU6_MCMOUT_CURH_Msk)) |
+            (New & (CCU6_MCMOUTS_EXPHS_Msk | CCU6_MCMOUTS_CURHS_Msk));
+    }
+    Sim_lCcuMcmout(Mcm);
+    SIM_CCU6->MCMOUTS.reg = (uint16)(New & ~(CCU6_MCMOUTS_STRMCM_Msk | CCU6_MCMOUTS_STRHP_Msk));
+  }
+  else if(Addr == SIM_ADDR(CCU6, ISS))
+  {
+    SIM_CCU6->ISS.reg = 0u;
+    if((New & CCU6_ISS_SWHC_Msk) != 0u)
+    {
+      Sim_lCcuHallSample();
+    }
+    Sim_lCcuFlag(New & ~CCU6_ISS_SWHC_Msk);
+  }
+  else if(Addr == SIM_ADDR(CCU6, ISR))
+  {
+    SIM_CCU6->IS.reg &= (uint16)~New;
+    SIM_CCU6->ISR.reg = 0u;
+  }
+  else if(Addr == SIM_ADDR(CCU6, TCTR0))
+  {
+    /* Run and shadow enable bits are read only */
+    Sim_lCcuTctr0();
+  }
+  else if((Addr == SIM_ADDR(CCU6, PISEL0)) || (Addr == SIM_ADDR(MF, BEMFC_CTRL_STS)))
+  {
+    /* Input selection */
+    Sim_lCcuInputs();
+  }
+  else
+  {
+    /* Plain register */
+  }
+}
+
+static TSim_Time Sim_lCcuNext(void)
+{
+  TSim_Time T12;
+  TSim_Time T13;
+
+  T12 = Sim_lCcuPm(&Sim_lT12, Sim_lCcuDiv12());
+  T13 = Sim_lCcuPm(&Sim_lT13, Sim_lCcuDiv13());
+  return (T12 < T13) ? T12 : T13;
+}
+
+/* Period matches: T12 shadow transfer and PWM interrupt, T13 single shot end
+ * and Hall sampling */
+static void Sim_lCcuStep(TSim_Time Now)
+{
+  TSim_Time Div;
+  uint32 Hsync;
+
+  Div = Sim_lCcuDiv12();
+  if(Sim_lCcuPm(&Sim_lT12, Div) <= Now)
+  {
+    Sim_lT12.Base += ((TSim_Time)Sim_lT12.Period + 1u) * Div;
+    Sim_lCcuShadow12();
+    Sim_lCcuFlag(CCU6_IS_T12PM_Msk);
+    Sim_AdcT12Pm();
+  }
+  Div = Sim_lCcuDiv13();
+  if(Sim_lCcuPm(&Sim_lT13, Div) <= Now)
+  {
+    if((SIM_CCU6->TCTR2.reg & CCU6_TCTR2_T13SSC_Msk) != 0u)
+    {
+      Sim_lT13.Run = false;
+      Sim_lT13.Val = 0u;
+    }
+    else
+    {
+      Sim_lT13.Base += ((TSim_Time)Sim_lT13.Period + 1u) * Div;
+    }
+    Sim_lCcuShadow13();
+    Sim_lCcuFlag(CCU6_IS_T13PM_Msk);
+    Hsync = ((uint32)SIM_CCU6->T12MSEL.reg & CCU6_T12MSEL_HSYNC_Msk) >> CCU6_T12MSEL_HSYNC_Pos;
+    if(Hsync == SIM_CCU_HSYNC_T13PM)
+    {
+      Sim_lCcuHallSample();
+    }
+    Sim_lCcuTctr0();
+  }
+}
+
+/* CPU cycles per count: 2^TxCLK, times 256 with TxPRE */
+static TSim_Time Sim_lCcuDiv12(void)
+{
+  uint32 Tctr0;
+
+  Tctr0 = SIM_CCU6->TCTR0.reg;
+  return (TSim_Time)(1u << (Tctr0 & CCU6_TCTR0_T12CLK_Msk)) << (((Tctr0 & CCU6_TCTR0_T12PRE_Msk) != 0u) ? 8u : 0u);
+}
+
+static TSim_Time Sim_lCcuDiv13(void)
+{
+  uint32 Tctr0;
+
+  Tctr0 = SIM_CCU6->TCTR0.reg;
+  return (TSim_Time)(1u << ((Tctr0 & CCU6_TCTR0_T13CLK_Msk) >> CCU6_TCTR0_T13CLK_Pos)) <<
+         (((Tctr0 & CCU6_TCTR0_T13PRE_Msk) != 0u) ? 8u : 0u);
+}
+
+static uint16 Sim_lCcuCount(const TSim_CcuTmr *pTmr, TSim_Time Div, TSim_Time Now)
+{
+  if(pTmr->Run == false)
+  {
+    return pTmr->Val;
+  }
+  return (Now > pTmr->Base) ? (uint16)((Now - pTmr->Base) / Div) : 0u;
+}
+
+/* Time of the next period match */
+static TSim_Time Sim_lCcuPm(const TSim_CcuTmr *pTmr, TSim_Time Div)
+{
+  return (pTmr->Run == true) ? (pTmr->Base + ((TSim_Time)pTmr->Period * Div)) : SIM_NEVER;
+}
+
+static void Sim_lCcuStart(TSim_CcuTmr *pTmr, TSim_Time Div)
+{
+  if(pTmr->Run == false)
+  {
+    pTmr->Run = true;
+    pTmr->Base = Sim_Now() - ((TSim_Time)pTmr->Val * Div);
+  }
+}
+
+static void Sim_lCcuStop(TSim_CcuTmr *pTmr, TSim_Time Div)
+{
+  if(pTmr->Run == true)
+  {
+    pTmr->Val = Sim_lCcuCount(pTmr, Div, Sim_Now());
+    pTmr->Run = false;
+  }
+}
+
+/* Compare values and period from the shadow registers, if enabled */
+static void Sim_lCcuShadow12(void)
+{
+  if((SIM_CCU6->TCTR0.reg & CCU6_TCTR0_STE12_Msk) != 0u)
+  {
+    Sim_lCc[0] = SIM_CCU6->CC60SR.reg;
+    Sim_lCc[1] = SIM_CCU6->CC61SR.reg;
+    Sim_lCc[2] = SIM_CCU6->CC62SR.reg;
+    Sim_lT12.Period = SIM_CCU6->T12PR.reg;
+    SIM_CCU6->CC60R.reg = Sim_lCc[0];
+    SIM_CCU6->CC61R.reg = Sim_lCc[1];
+    SIM_CCU6->CC62R.reg = Sim_lCc[2];
+    SIM_CCU6->TCTR0.reg &= (uint16)~CCU6_TCTR0_STE12_Msk;
+  }
+}
+
+static void Sim_lCcuShadow13(void)
+{
+  if((SIM_CCU6->TCTR0.reg & CCU6_TCTR0_STE13_Msk) != 0u)
+  {
+    Sim_lT13.Period = SIM_CCU6->T13PR.reg;
+    SIM_CCU6->CC63R.reg = SIM_CCU6->CC63SR.reg;
+    SIM_CCU6->TCTR0.reg &= (uint16)~CCU6_TCTR0_STE13_Msk;
+  }
+}
+
+static void Sim_lCcuTctr0(void)
+{
+  uint32 Tctr0;
+
+  Tctr0 = (uint32)SIM_CCU6->TCTR0.reg & ~(CCU6_TCTR0_T12R_Msk | CCU6_TCTR0_T13R_Msk);
+  Tctr0 |= (Sim_lT12.Run == true) ? CCU6_TCTR0_T12R_Msk : 0u;
+  Tctr0 |= (Sim_lT13.Run == true) ? CCU6_TCTR0_T13R_Msk : 0u;
+  SIM_CCU6->TCTR0.reg = (uint16)Tctr0;
+}
+
+/* Interrupt flags, the node of an enabled flag is selected by INP */
+static void Sim_lCcuFlag(uint32 Msk)
+{
+  static const uint8 Inp[16] =
+  {
+    CCU6_INP_INPCC60_Pos, CCU6_INP_INPCC60_Pos, CCU6_INP_INPCC61_Pos, CCU6_INP_INPCC61_Pos,
+    CCU6_INP_INPCC62_Pos, CCU6_INP_INPCC62_Pos, CCU6_INP_INPT12_Pos, CCU6_INP_INPT12_Pos,
+    CCU6_INP_INPT13_Pos, CCU6_INP_INPT13_Pos, CCU6_INP_INPERR_Pos, CCU6_INP_INPERR_Pos,
+    CCU6_INP_INPCHE_Pos, CCU6_INP_INPCHE_Pos, CCU6_INP_INPCHE_Pos, CCU6_INP_INPERR_Pos
+  };
+  uint32 Bit;
+
+  SIM_CCU6->IS.reg |= (uint16)Msk;
+  Msk &= SIM_CCU6->IEN.reg;
+  for(Bit = 0u; Bit < 16u; Bit++)
+  {
+    if((Msk & (1u << Bit)) != 0u)
+    {
+      Sim_SetPending(SIM_IRQ_CCU6SR0 + (((uint32)SIM_CCU6->INP.reg >> Inp[Bit]) & 0x3u));
+    }
+  }
+}
+
+/* CCPOSx by the input selection, an edge starts T13 with T13TEC and is
+ * sampled at once unless HSYNC waits for the T13 period match */
+static void Sim_lCcuInputs(void)
+{
+  uint32 Bemfc;
+  uint32 Pos;
+  uint32 Tec;
+  uint32 Hsync;
+  uint32 i;
+
+  Bemfc = SIM_MF->BEMFC_CTRL_STS.reg;
+  Pos = 0u;
+  for(i = 0u; i < 3u; i++)
+  {
+    if(((((uint32)SIM_CCU6->PISEL0.reg >> (CCU6_PISEL0_ISPOS0_Pos + (2u * i))) & 0x3u) == SIM_CCU_ISPOS_BEMF) &&
+       ((Bemfc & MF_BEMFC_CTRL_STS_CCPOS_INSEL_Msk) != 0u) &&
+       ((Bemfc & (MF_BEMFC_CTRL_STS_PHUCOMP_EN_Msk << i)) != 0u) &&
+       ((Bemfc & (MF_BEMFC_CTRL_STS_PHUCOMP_ON_Msk << i)) != 0u))
+    {
+      Pos |= Sim_lBemf & (1u << i);
+    }
+    else
+    {
+      Pos |= Sim_lHall & (1u << i);
+    }
+  }
+  if(Pos == Sim_lPos)
+  {
+    return;
+  }
+  Sim_lPos = Pos;
+  Tec = ((uint32)SIM_CCU6->TCTR2.reg & CCU6_TCTR2_T13TEC_Msk) >> CCU6_TCTR2_T13TEC_Pos;
+  if((Tec == SIM_CCU_T13TEC_HALL) && (Sim_lT13.Run == false))
+  {
+    Sim_lT13.Val = 0u;
+    Sim_lCcuStart(&Sim_lT13, Sim_lCcuDiv13());
+  }
+  Hsync = ((uint32)SIM_CCU6->T12MSEL.reg & CCU6_T12MSEL_HSYNC_Msk) >> CCU6_T12MSEL_HSYNC_Pos;
+  if((Hsync != SIM_CCU_HSYNC_T13PM) && (Hsync != SIM_CCU_HSYNC_OFF))
+  {
+    Sim_lCcuHallSample();
+  }
+}
+
+/* Hall compare: expected pattern = correct Hall event with the transfer of the
+ * shadow patterns, other than the current pattern = wrong Hall event */
+static void Sim_lCcuHallSample(void)
+{
+  uint32 Mcm;
+  uint32 Mcms;
+  uint32 Cur;
+  uint32 Exp;
+
+  SIM_CCU6->CMPSTAT.reg = (uint16)(((uint32)SIM_CCU6->CMPSTAT.reg & ~(0x7u << CCU6_CMPSTAT_CCPOS0_Pos)) |
+                                   (Sim_lPos << CCU6_CMPSTAT_CCPOS0_Pos));
+  Mcm = SIM_CCU6->MCMOUT.reg;
+  Cur = (Mcm & CCU6_MCMOUT_CURH_Msk) >> CCU6_MCMOUT_CURH_Pos;
+  Exp = (Mcm & CCU6_MCMOUT_EXPH_Msk) >> CCU6_MCMOUT_EXPH_Pos;
+  if(Sim_lPos == Exp)
+  {
+    Mcms = SIM_CCU6->MCMOUTS.reg;
+    Mcm = (Mcm & ~(CCU6_MCMOUT_EXPH_Msk | CCU6_MCMOUT_CURH_Msk)) |
+          (Mcms & (CCU6_MCMOUTS_EXPHS_Msk | CCU6_MCMOUTS_CURHS_Msk));
+    if((((uint32)SIM_CCU6->MCMCTR.reg & CCU6_MCMCTR_SWSEL_Msk) >> CCU6_MCMCTR_SWSEL_Pos) == SIM_CCU_SWSEL_CHE)
+    {
+      Mcm = (Mcm & ~CCU6_MCMOUT_MCMP_Msk) | (Mcms & CCU6_MCMOUTS_MCMPS_Msk);
+    }
+    Sim_lCcuMcmout(Mcm);
+    Sim_lCcuFlag(CCU6_IS_CHE_Msk);
+  }
+  else if(Sim_lPos != Cur)
+  {
+    Sim_lCcuFlag(CCU6_IS_WHE_Msk);
+  }
+  else
+  {
+    /* No Hall event */
+  }
+}
+
+/* Output and Hall patterns, with the time of an output pattern change */
+static void Sim_lCcuMcmout(uint32 Mcm)
+{
+  if(((Mcm ^ (uint32)SIM_CCU6->MCMOUT.reg) & CCU6_MCMOUT_MCMP_Msk) != 0u)
+  {
+    Sim_lPtnTime = Sim_Now();
+  }
+  SIM_CCU6->MCMOUT.reg = (uint16)Mcm;
+}
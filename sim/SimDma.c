@@ -0,0 +1,246 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, DMA controller model
+ */
+
+/* DMA controller (PL230) in basic mode: a request of a peripheral transfers
+ * 2^R_Power items of the primary control entry of its channel at once, the
+ * last item stops the cycle, disables the channel and sets the done flag in
+ * SCU DMAIRC1/DMAIRC2. Peripheral words are read and written through the
+ * models like firmware accesses. */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include <stddef.h>
+#include "Sim.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+#define SIM_DMA_CH_NUM      (16u)
+#define SIM_DMA_ENTRY_SIZE  (16u)
+#define SIM_DMA_INC_NONE    (3u)
+
+/* Control word of a channel entry */
+#define SIM_DMA_CYCLE_MSK   (0x7u)
+#define SIM_DMA_N_POS       (4u)
+#define SIM_DMA_N_MSK       (0x3FFu)
+#define SIM_DMA_R_POS       (14u)
+#define SIM_DMA_R_MSK       (0xFu)
+#define SIM_DMA_SSIZE_POS   (24u)
+#define SIM_DMA_SINC_POS    (26u)
+#define SIM_DMA_DINC_POS    (30u)
+#define SIM_DMA_FLD_MSK     (0x3u)
+
+#define SIM_DMA_CYCLE_BASIC (1u)
+
+/*******************************************************************************
+**                      Private Variable Definitions                          **
+*******************************************************************************/
+static uint32 Sim_lDmaEnabled;
+
+/*******************************************************************************
+**                      Private Function Declarations                         **
+*******************************************************************************/
+static void Sim_lDmaReset(void);
+static void Sim_lDmaWrite(uint32 Addr, uint32 Old, uint32 New);
+static void Sim_lDmaDone(uint32 Ch);
+
+/*******************************************************************************
+**                      Global Constant Definitions                           **
+*******************************************************************************/
+const TSim_Model Sim_Dma =
+{
+  Sim_lDmaReset, NULL, Sim_lDmaWrite, NULL, NULL
+};
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+/** \brief Request of a peripheral to a DMA channel.
+ *
+ * Ignored while the controller or the channel is disabled.
+ *
+ * \param[in] Ch DMA channel
+ * \return None
+ */
+void Sim_DmaRequest(uint32 Ch)
+{
+  uint32 Entry;
+  uint32 Ctrl;
+  uint32 Size;
+  uint32 SrcInc;
+  uint32 DstInc;
+  uint32 Left;
+  uint32 Num;
+  uint32 Src;
+  uint32 Dst;
+
+  if(((SIM_DMA->CFG.reg & DMA_CFG_MASTER_ENABLE_Msk) == 0u) || ((Sim_lDmaEnabled & (1u << Ch)) == 0u))
+  {
+    return;
+  }
+  Entry = SIM_DMA->CTRL_BASE_PTR.reg + (Ch * SIM_DMA_ENTRY_SIZE);
+  Ctrl = Sim_BusRead(Entry + offsetof(TDMA_Entry, Control), 4u);
+  if((Ctrl & SIM_DMA_CYCLE_MSK) != SIM_DMA_CYCLE_BASIC)
+  {
+    /* Stopped or a mode not used by the firmware */
+    return;
+  }
+  Size = (Ctrl >> SIM_DMA_SSIZE_POS) & SIM_DMA_FLD_MSK;
+  SrcInc = (Ctrl >> SIM_DMA_SINC_POS) & SIM_DMA_FLD_MSK;
+  DstInc = (Ctrl >> SIM_DMA_DINC_POS) & SIM_DMA_FLD_MSK;
+  Num = 1u << ((Ctrl >> SIM_DMA_R_POS) & SIM_DMA_R_MSK);
+  do
+  {
+    /* Item address counted back from the end pointer by the items left */
+    Left = (Ctrl >> SIM_DMA_N_POS) & SIM_DMA_N_MSK;
+    Src = Sim_BusRead(Entry + offsetof(TDMA_Entry, Src_End_Ptr), 4u);
+    Dst = Sim_BusRead(Entry + offsetof(TDMA_Entry, Dst_End_Ptr), 4u);
+    if(SrcInc != SIM_DMA_INC_NONE)
+    {
+      Src -= Left << SrcInc;
+    }
+    if(DstInc != SIM_DMA_INC_NONE)
+    {
+      Dst -= Left << DstInc;
+    }
+    Sim_BusWrite(Dst, Sim_BusRead(Src, 1u << Size), 1u << Size);
+    if(Left == 0u)
+    {
+      Ctrl &= ~SIM_DMA_CYCLE_MSK;
+    }
+    else
+    {
+      Ctrl = (Ctrl & ~(SIM_DMA_N_MSK << SIM_DMA_N_POS)) | ((Left - 1u) << SIM_DMA_N_POS);
+    }
+    Sim_BusWrite(Entry + offsetof(TDMA_Entry, Control), Ctrl, 4u);
+    Num--;
+  } while((Num > 0u) && (Left > 0u));
+  if(Left == 0u)
+  {
+    Sim_lDmaDone(Ch);
+  }
+} /* End of Sim_DmaRequest */
+
+/*******************************************************************************
+**                      Private Function Definitions                          **
+*******************************************************************************/
+static void Sim_lDmaReset(void)
+{
+  Sim_lDmaEnabled = 0u;
+}
+
+/* Enable set/clear registers read the enabled channels, software requests
+ * run the channel */
+static void Sim_lDmaWrite(uint32 Addr, uint32 Old, uint32 New)
+{
+  uint32 Ch;
+
+  (void)Old;
+  if(Addr == SIM_ADDR(DMA, CHNL_ENABLE_SET))
+  {
+    Sim_lDmaEnabled |= New & 0xFFFFu;
+  }
+  else if(Addr == SIM_ADDR(DMA, CHNL_ENABLE_CLR))
+  {
+    Sim_lDmaEnabled &= ~New;
+  }
+  else if(Addr == SIM_ADDR(DMA, CHNL_SW_REQUEST))
+  {
+    SIM_DMA->CHNL_SW_REQUEST.reg = 0u;
+    for(Ch = 0u; Ch < SIM_DMA_CH_NUM; Ch++)
+    {
+      if((New & (1u << Ch)) != 0u)
+      {
+        Sim_DmaRequest(Ch);
+      }
+    }
+  }
+  else
+  {
+    return;
+  }
+  SIM_DMA->CHNL_ENABLE_SET.reg = Sim_lDmaEnabled;
+  SIM_DMA->CHNL_ENABLE_CLR.reg = Sim_lDmaEnabled;
+}
+
+/* Cycle complete: channel disabled, done flag of the request source */
+static void Sim_lDmaDone(uint32 Ch)
+{
+  uint32 Irc1;
+  uint32 Irc2;
+
+  Sim_lDmaEnabled &= ~(1u << Ch);
+  SIM_DMA->CHNL_ENABLE_SET.reg = Sim_lDmaEnabled;
+  SIM_DMA->CHNL_ENABLE_CLR.reg = Sim_lDmaEnabled;
+
+  Irc1 = 0u;
+  Irc2 = 0u;
+  if(Ch == 0u)
+  {
+    Irc2 = SCU_DMAIRC2_TRSEQ1DY_Msk;
+  }
+  else if(Ch == 1u)
+  {
+    Irc2 = SCU_DMAIRC2_TRSEQ2DY_Msk;
+  }
+  else if(Ch == 2u)
+  {
+    Irc2 = SCU_DMAIRC2_SSC1RDY_Msk;
+  }
+  else if(Ch == 3u)
+  {
+    Irc2 = SCU_DMAIRC2_SSC2RDY_Msk;
+  }
+  else if(Ch <= 11u)
+  {
+    Irc1 = 1u << (Ch - 4u);
+  }
+  else if(Ch == 12u)
+  {
+    Irc2 = SCU_DMAIRC2_GPT12_Msk;
+  }
+  else
+  {
+    Irc2 = SCU_DMAIRC2_SDADC_Msk;
+  }
+  SIM_SCU->DMAIRC1.reg |= (uint8)Irc1;
+  SIM_SCU->DMAIRC2.reg |= (uint8)Irc2;
+  if(((SIM_SCU->DMAIEN1.reg & Irc1) != 0u) || ((SIM_SCU->DMAIEN2.reg & Irc2) != 0u))
+  {
+    Sim_SetPending(SIM_IRQ_DMA);
+  }
+}
@@ -0,0 +1,401 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, GPT12E timer model
+ * V0.1.1: 2026-10-18: T2 incremental interface mode on T2INB and T2EUDB
+ */
+
+/* GPT12E core timers T2..T6 in timer mode, counted from the simulated time
+ * (value at the last write plus the prescaler ticks since). T3 over- or
+ * underflow toggles T3OTL, which reloads T3 from T2/T4 in reload mode and
+ * requests DMA channel 12; T6 overflow reloads from CAPREL with T6SR. T2 in
+ * incremental interface mode counts the edges of T2INB (P1.4) and T2EUDB
+ * (P2.4) set by the tests, with the direction from the levels (4x decoding
+ * with T2I = 3). Other counter and capture modes have no input and stand
+ * still. */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include <stddef.h>
+#include "Sim.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+#define SIM_GPT_NUM       (5u)
+#define SIM_GPT_T2        (0u)
+#define SIM_GPT_T3        (1u)
+#define SIM_GPT_T4        (2u)
+#define SIM_GPT_T6        (4u)
+#define SIM_GPT_CON_OFS   (offsetof(GPT12E_Type, T2CON))
+#define SIM_GPT_TMR_OFS   (offsetof(GPT12E_Type, T2))
+#define SIM_GPT_STRIDE    (offsetof(GPT12E_Type, T3) - offsetof(GPT12E_Type, T2))
+
+/* TxCON fields common to T2..T6 */
+#define SIM_GPT_I_MSK     (0x7u)
+#define SIM_GPT_M_POS     (3u)
+#define SIM_GPT_M_MSK     (0x7u)
+#define SIM_GPT_R_MSK     (0x40u)
+#define SIM_GPT_UD_MSK    (0x80u)
+#define SIM_GPT_OTL_MSK   (0x400u)
+#define SIM_GPT_BPS_POS   (11u)
+#define SIM_GPT_BPS_MSK   (0x3u)
+
+#define SIM_GPT_M_TIMER   (0u)
+#define SIM_GPT_M_RELOAD  (4u)
+#define SIM_GPT_M_INC     (6u)
+
+/* Incremental interface inputs by T2I: T2IN edges, T2EUD edges; T2IRDIS */
+#define SIM_GPT_INC_IN    (1u)
+#define SIM_GPT_INC_EUD   (2u)
+#define SIM_GPT_IRDIS_MSK (0x1000u)
+
+/* Reload trigger TxI in reload mode: T3OTL rising, falling, any edge */
+#define SIM_GPT_RL_RISE   (5u)
+#define SIM_GPT_RL_FALL   (6u)
+#define SIM_GPT_RL_ANY    (7u)
+
+/* DMASRCSEL2 GPT12_DMAEN: T3 over-/underflow requests channel 12 */
+#define SIM_GPT_DMA_T3    (1u)
+#define SIM_GPT_DMA_CH    (12u)
+
+/*******************************************************************************
+**                      Private Type Definitions                              **
+*******************************************************************************/
+/** \brief Count of a timer, valid from Base on */
+typedef struct
+{
+  TSim_Time Base;
+  uint16 Val;
+} TSim_GptTmr;
+
+/*******************************************************************************
+**                      Private Variable Definitions                          **
+*******************************************************************************/
+static TSim_GptTmr Sim_lGpt[SIM_GPT_NUM];
+
+/*******************************************************************************
+**                      Private Constant Definitions                          **
+*******************************************************************************/
+/* Block prescalers by register value: BPS1 for T2..T4, BPS2 for T5/T6 */
+static const uint32 Sim_lGptBps1[4] = {8u, 4u, 32u, 16u};
+static const uint32 Sim_lGptBps2[4] = {4u, 2u, 16u, 8u};
+
+/*******************************************************************************
+**                      Private Function Declarations                         **
+*******************************************************************************/
+static void Sim_lGptReset(void);
+static void Sim_lGptRead(uint32 Addr);
+static void Sim_lGptWrite(uint32 Addr, uint32 Old, uint32 New);
+static TSim_Time Sim_lGptNext(void);
+static void Sim_lGptStep(TSim_Time Now);
+static volatile uint16 *Sim_lGptCon(uint32 Tmr);
+static volatile uint16 *Sim_lGptReg(uint32 Tmr);
+static uint32 Sim_lGptDiv(uint32 Tmr, uint32 Con);
+static bool Sim_lGptRunning(uint32 Con);
+static uint16 Sim_lGptCount(uint32 Tmr, uint32 Con, TSim_Time Now);
+static TSim_Time Sim_lGptWrap(uint32 Tmr);
+static void Sim_lGptFlag(uint32 Msk);
+static void Sim_lGptT3Otl(uint32 Edge);
+
+/*******************************************************************************
+**                      Global Constant Definitions                           **
+*******************************************************************************/
+const TSim_Model Sim_Gpt12e =
+{
+  Sim_lGptReset, Sim_lGptRead, Sim_lGptWrite, Sim_lGptNext, Sim_lGptStep
+};
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+/** \brief Counts a pin edge in T2 incremental interface mode.
+ *
+ * \param[in] Port Port 0..2 of the pin that changed
+ * \param[in] Pin Pin 0..7
+ * \return None
+ *
+ * \note Called by the port model. Only the B inputs selected in PISEL are
+ * modeled: T2INB on P1.4, T2EUDB on P2.4.
+ */
+void Sim_GptPinEdge(uint32 Port, uint32 Pin)
+{
+  uint32 Con;
+  uint32 Src;
+  bool In;
+  bool Eud;
+
+  Con = *Sim_lGptCon(SIM_GPT_T2);
+  if((((Con >> SIM_GPT_M_POS) & SIM_GPT_M_MSK) != SIM_GPT_M_INC) || ((Con & SIM_GPT_R_MSK) == 0u) ||
+     ((SIM_GPT12E->PISEL.reg & (GPT12E_PISEL_IST2IN_Msk | GPT12E_PISEL_IST2EUD_Msk)) !=
+      (GPT12E_PISEL_IST2IN_Msk | GPT12E_PISEL_IST2EUD_Msk)))
+  {
+    return;
+  }
+  if((Port == 1u) && (Pin == 4u))
+  {
+    Src = SIM_GPT_INC_IN;
+  }
+  else if((Port == 2u) && (Pin == 4u))
+  {
+    Src = SIM_GPT_INC_EUD;
+  }
+  else
+  {
+    return;
+  }
+  if((Con & SIM_GPT_I_MSK & Src) == 0u)
+  {
+    return;
+  }
+
+  /* Up when T2IN leads: T2IN edge to the other level of T2EUD, T2EUD edge to the level of T2IN */
+  In = Sim_PortGetPin(1u, 4u);
+  Eud = Sim_PortGetPin(2u, 4u);
+  if((Src == SIM_GPT_INC_IN) ? (In != Eud) : (In == Eud))
+  {
+    Sim_lGpt[SIM_GPT_T2].Val++;
+  }
+  else
+  {
+    Sim_lGpt[SIM_GPT_T2].Val--;
+  }
+  if((Con & SIM_GPT_IRDIS_MSK) == 0u)
+  {
+    Sim_lGptFlag(1u << SIM_GPT_T2);
+  }
+} /* End of Sim_GptPinEdge */
+
+/*******************************************************************************
+**                      Private Function Definitions                          **
+*******************************************************************************/
+static void Sim_lGptReset(void)
+{
+  uint32 i;
+
+  for(i = 0u; i < SIM_GPT_NUM; i++)
+  {
+    Sim_lGpt[i].Base = 0u;
+    Sim_lGpt[i].Val = 0u;
+  }
+}
+
+/* Counters are brought up to date before any read of the block */
+static void Sim_lGptRead(uint32 Addr)
+{
+  uint32 i;
+
+  if((Addr - GPT12E_BASE) < sizeof(GPT12E_Type))
+  {
+    for(i = 0u; i < SIM_GPT_NUM; i++)
+    {
+      *Sim_lGptReg(i) = Sim_lGptCount(i, *Sim_lGptCon(i), Sim_Now());
+    }
+  }
+}
+
+static void Sim_lGptWrite(uint32 Addr, uint32 Old, uint32 New)
+{
+  uint32 i;
+
+  for(i = 0u; i < SIM_GPT_NUM; i++)
+  {
+    if(Addr == (GPT12E_BASE + SIM_GPT_CON_OFS + (i * SIM_GPT_STRIDE)))
+    {
+      /* Count up to now with the old mode, on from now with the new one */
+      Sim_lGpt[i].Val = Sim_lGptCount(i, Old, Sim_Now());
+      Sim_lGpt[i].Base = Sim_Now();
+    }
+    else if(Addr == (GPT12E_BASE + SIM_GPT_TMR_OFS + (i * SIM_GPT_STRIDE)))
+    {
+      Sim_lGpt[i].Val = (uint16)New;
+      Sim_lGpt[i].Base = Sim_Now();
+    }
+    else
+    {
+      /* Other timer */
+    }
+  }
+}
+
+static TSim_Time Sim_lGptNext(void)
+{
+  TSim_Time Next;
+  TSim_Time t;
+  uint32 i;
+
+  Next = SIM_NEVER;
+  for(i = 0u; i < SIM_GPT_NUM; i++)
+  {
+    t = Sim_lGptWrap(i);
+    if(t < Next)
+    {
+      Next = t;
+    }
+  }
+  return Next;
+}
+
+/* Over-/underflow: the count wraps, T3 and T6 toggle their output latch */
+static void Sim_lGptStep(TSim_Time Now)
+{
+  volatile uint16 *pCon;
+  TSim_Time t;
+  uint32 i;
+
+  for(i = 0u; i < SIM_GPT_NUM; i++)
+  {
+    t = Sim_lGptWrap(i);
+    if(t > Now)
+    {
+      continue;
+    }
+    pCon = Sim_lGptCon(i);
+    Sim_lGpt[i].Val = ((*pCon & SIM_GPT_UD_MSK) != 0u) ? 0xFFFFu : 0u;
+    Sim_lGpt[i].Base = t;
+    Sim_lGptFlag(1u << i);
+    if(i == SIM_GPT_T3)
+    {
+      *pCon ^= (uint16)SIM_GPT_OTL_MSK;
+      Sim_lGptT3Otl(((*pCon & SIM_GPT_OTL_MSK) != 0u) ? SIM_GPT_RL_RISE : SIM_GPT_RL_FALL);
+      if((SIM_SCU->DMASRCSEL2.reg & SCU_DMASRCSEL2_GPT12_DMAEN_Msk) == SIM_GPT_DMA_T3)
+      {
+        Sim_DmaRequest(SIM_GPT_DMA_CH);
+      }
+    }
+    else if(i == SIM_GPT_T6)
+    {
+      *pCon ^= (uint16)SIM_GPT_OTL_MSK;
+      if((*pCon & GPT12E_T6CON_T6SR_Msk) != 0u)
+      {
+        Sim_lGpt[i].Val = SIM_GPT12E->CAPREL.reg;
+      }
+    }
+    else
+    {
+      /* No output latch */
+    }
+  }
+}
+
+static volatile uint16 *Sim_lGptCon(uint32 Tmr)
+{
+  return (volatile uint16 *)(Sim_Alias[SIM_RGN_GPT12E] + SIM_GPT_CON_OFS + (Tmr * SIM_GPT_STRIDE));
+}
+
+static volatile uint16 *Sim_lGptReg(uint32 Tmr)
+{
+  return (volatile uint16 *)(Sim_Alias[SIM_RGN_GPT12E] + SIM_GPT_TMR_OFS + (Tmr * SIM_GPT_STRIDE));
+}
+
+/* CPU cycles per count: block prescaler of GPT1 (T3CON) or GPT2 (T6CON) and TxI */
+static uint32 Sim_lGptDiv(uint32 Tmr, uint32 Con)
+{
+  uint32 Bps;
+
+  if(Tmr <= SIM_GPT_T4)
+  {
+    Bps = Sim_lGptBps1[(*Sim_lGptCon(SIM_GPT_T3) >> SIM_GPT_BPS_POS) & SIM_GPT_BPS_MSK];
+  }
+  else
+  {
+    Bps = Sim_lGptBps2[(*Sim_lGptCon(SIM_GPT_T6) >> SIM_GPT_BPS_POS) & SIM_GPT_BPS_MSK];
+  }
+  return Bps << (Con & SIM_GPT_I_MSK);
+}
+
+static bool Sim_lGptRunning(uint32 Con)
+{
+  return ((((Con >> SIM_GPT_M_POS) & SIM_GPT_M_MSK) == SIM_GPT_M_TIMER) && ((Con & SIM_GPT_R_MSK) != 0u)) ? true : false;
+}
+
+static uint16 Sim_lGptCount(uint32 Tmr, uint32 Con, TSim_Time Now)
+{
+  TSim_Time Div;
+  uint32 Ticks;
+
+  if(Sim_lGptRunning(Con) == false)
+  {
+    return Sim_lGpt[Tmr].Val;
+  }
+  Div = Sim_lGptDiv(Tmr, Con);
+  Ticks = (uint32)((Now / Div) - (Sim_lGpt[Tmr].Base / Div));
+  return ((Con & SIM_GPT_UD_MSK) != 0u) ? (uint16)(Sim_lGpt[Tmr].Val - Ticks) : (uint16)(Sim_lGpt[Tmr].Val + Ticks);
+}
+
+/* Time of the next over-/underflow */
+static TSim_Time Sim_lGptWrap(uint32 Tmr)
+{
+  TSim_Time Div;
+  uint32 Con;
+  uint32 Ticks;
+
+  Con = *Sim_lGptCon(Tmr);
+  if(Sim_lGptRunning(Con) == false)
+  {
+    return SIM_NEVER;
+  }
+  Div = Sim_lGptDiv(Tmr, Con);
+  Ticks = ((Con & SIM_GPT_UD_MSK) != 0u) ? ((uint32)Sim_lGpt[Tmr].Val + 1u) : (0x10000u - Sim_lGpt[Tmr].Val);
+  return ((Sim_lGpt[Tmr].Base / Div) + Ticks) * Div;
+}
+
+/* Interrupt flags in SCU GPT12IRC, node GPT1 for T2..T4, GPT2 for T5, T6, CAPREL */
+static void Sim_lGptFlag(uint32 Msk)
+{
+  SIM_SCU->GPT12IRC.reg |= (uint8)Msk;
+  if((SIM_SCU->GPT12IEN.reg & Msk) != 0u)
+  {
+    Sim_SetPending(((Msk & (SCU_GPT12IRC_T2_Msk | SCU_GPT12IRC_T3_Msk | SCU_GPT12IRC_T4_Msk)) != 0u) ?
+                   SIM_IRQ_GPT1 : SIM_IRQ_GPT2);
+  }
+}
+
+/* T3OTL edge: reload of T3 from T2 and T4 in reload mode */
+static void Sim_lGptT3Otl(uint32 Edge)
+{
+  uint32 Con;
+  uint32 Tmr;
+
+  for(Tmr = 0u; Tmr <= SIM_GPT_T4; Tmr += SIM_GPT_T4)
+  {
+    Con = *Sim_lGptCon(Tmr);
+    if((((Con >> SIM_GPT_M_POS) & SIM_GPT_M_MSK) == SIM_GPT_M_RELOAD) &&
+       (((Con & SIM_GPT_I_MSK) == Edge) || ((Con & SIM_GPT_I_MSK) == SIM_GPT_RL_ANY)))
+    {
+      Sim_lGpt[SIM_GPT_T3].Val = Sim_lGpt[Tmr].Val;
+      Sim_lGptFlag(1u << Tmr);
+    }
+  }
+}
@@ -0,0 +1,491 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, BLDC motor model
+ * V0.1.1: 2026-10-18: BEMF comparators
+ */
+
+/* Plant: three phase BLDC motor with sinusoidal back EMF in star connection,
+ * supplied from the bridge with the on-time averaged phase voltages of the
+ * CCU6 outputs gated by the bridge driver. A phase with neither side switched
+ * on floats and carries no current. The rotor has inertia, viscous and
+ * Coulomb friction and a load torque, or is locked. The Hall sensors switch
+ * at 30 + 60 * n electrical degrees plus a mounting error per edge, in the
+ * forward sequence 1, 3, 2, 6, 4, 5 of the block commutation table. The BEMF
+ * comparators (bit n = phase n above the star point) follow the sign of the
+ * back EMF with a hysteresis, i.e. the zero crossings at 60 * n electrical
+ * degrees; the PWM of the driven phases is taken as filtered out. Euler
+ * integration with a fixed step, off until Sim_MotorInit. */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include <math.h>
+#include <stddef.h>
+#include "Sim.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+#define SIM_MOTOR_STEP      (SIM_US(1))
+#define SIM_MOTOR_DT        ((float64)SIM_MOTOR_STEP / (float64)SIM_FSYS_HZ)
+#define SIM_MOTOR_PH_NUM    (3u)
+#define SIM_MOTOR_HALL_NUM  (6u)
+#define SIM_MOTOR_PI        (3.14159265358979323846)
+#define SIM_MOTOR_DEG       (SIM_MOTOR_PI / 180.0)
+
+/* Hysteresis of the BEMF comparators around the star point [V] */
+#define SIM_MOTOR_BEMF_HYST (0.05)
+
+/*******************************************************************************
+**                      Private Variable Definitions                          **
+*******************************************************************************/
+static TSim_MotorCfg Sim_lMotorCfg;
+static bool Sim_lMotorOn;
+static bool Sim_lMotorLocked;
+static TSim_Time Sim_lMotorNext;
+static float64 Sim_lMotorAngle;   /* Electrical angle [rad] 0..2 pi */
+static float64 Sim_lMotorSpeed;   /* Mechanical speed [rad/s] */
+static float64 Sim_lMotorI[SIM_MOTOR_PH_NUM];
+static float64 Sim_lMotorTorque;
+static float64 Sim_lMotorLoad;
+static uint32 Sim_lMotorHall;
+static TSim_Time Sim_lMotorEdge;
+static uint32 Sim_lMotorEdges;
+static uint32 Sim_lMotorBemf;
+static TSim_Time Sim_lMotorBemfEdge;
+static uint32 Sim_lMotorBemfEdges;
+
+/*******************************************************************************
+**                      Private Constant Definitions                          **
+*******************************************************************************/
+/* Hall pattern of the sector after edge n */
+static const uint8 Sim_lMotorHallSeq[SIM_MOTOR_HALL_NUM] = {1u, 3u, 2u, 6u, 4u, 5u};
+
+/*******************************************************************************
+**                      Private Function Declarations                         **
+*******************************************************************************/
+static void Sim_lMotorReset(void);
+static TSim_Time Sim_lMotorNextEv(void);
+static void Sim_lMotorStep(TSim_Time Now);
+static uint32 Sim_lMotorHallPtn(void);
+static void Sim_lMotorUpdateHall(void);
+static void Sim_lMotorUpdateBemf(const float64 *pEmf);
+
+/*******************************************************************************
+**                      Global Constant Definitions                           **
+*******************************************************************************/
+const TSim_Model Sim_Motor =
+{
+  Sim_lMotorReset, NULL, NULL, Sim_lMotorNextEv, Sim_lMotorStep
+};
+
+/** \brief Small 12 V motor, 1 pole pair (BCHALL_POLE_PAIRS), about 8000 rpm
+ * no-load speed, 14 mNm/A */
+const TSim_MotorCfg Sim_MotorDefault =
+{
+  0.3,      /* R */
+  100e-6,   /* L */
+  0.00827,  /* Ke */
+  1u,       /* PolePairs */
+  1e-5,     /* J */
+  2e-6,     /* B */
+  0.002,    /* Friction */
+  12.0,     /* Vdc */
+  {0.0, 0.0, 0.0, 0.0, 0.0, 0.0} /* HallErr */
+};
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+/** \brief Starts the motor model at standstill.
+ *
+ * \param[in] pCfg Parameters, Sim_MotorDefault or a copy changed by the test
+ * \param[in] Angle Electrical rotor angle [degrees]
+ * \return None
+ */
+void Sim_MotorInit(const TSim_MotorCfg *pCfg, float64 Angle)
+{
+  Sim_lMotorCfg = *pCfg;
+  Sim_lMotorOn = true;
+  Sim_lMotorNext = Sim_Now();
+  Sim_lMotorSpeed = 0.0;
+  Sim_MotorSetAngle(Angle);
+} /* End of Sim_MotorInit */
+
+/** \brief Sets the electrical rotor angle, the Hall inputs follow.
+ *
+ * \param[in] Angle Electrical angle [degrees]
+ * \return None
+ */
+void Sim_MotorSetAngle(float64 Angle)
+{
+  Sim_lMotorAngle = fmod(fmod(Angle, 360.0) + 360.0, 360.0) * SIM_MOTOR_DEG;
+  Sim_lMotorUpdateHall();
+} /* End of Sim_MotorSetAngle */
+
+/** \brief Sets the load torque, against the direction of rotation.
+ *
+ * \param[in] Torque Load [Nm]
+ * \return None
+ */
+void Sim_MotorSetLoad(float64 Torque)
+{
+  Sim_lMotorLoad = Torque;
+} /* End of Sim_MotorSetLoad */
+
+/** \brief Locks or releases the rotor (stall).
+ *
+ * \param[in] Lock true to hold the rotor
+ * \return None
+ */
+void Sim_MotorLock(bool Lock)
+{
+  Sim_lMotorLocked = Lock;
+  if(Lock == true)
+  {
+    Sim_lMotorSpeed = 0.0;
+  }
+} /* End of Sim_MotorLock */
+
+/** \brief Returns the mechanical speed.
+ *
+ * \return Speed [rpm], negative in reverse
+ */
+float64 Sim_MotorSpeed(void)
+{
+  return Sim_lMotorSpeed * (60.0 / (2.0 * SIM_MOTOR_PI));
+} /* End of Sim_MotorSpeed */
+
+/** \brief Returns the electrical rotor angle.
+ *
+ * \return Angle [degrees] 0..360
+ */
+float64 Sim_MotorAngle(void)
+{
+  return Sim_lMotorAngle / SIM_MOTOR_DEG;
+} /* End of Sim_MotorAngle */
+
+/** \brief Returns the electromagnetic torque.
+ *
+ * \return Torque [Nm]
+ */
+float64 Sim_MotorTorque(void)
+{
+  return Sim_lMotorTorque;
+} /* End of Sim_MotorTorque */
+
+/** \brief Returns a phase current.
+ *
+ * \param[in] Ph Phase 0..2 (U, V, W)
+ * \return Current into the motor [A]
+ */
+float64 Sim_MotorPhaseCurrent(uint32 Ph)
+{
+  return Sim_lMotorI[Ph];
+} /* End of Sim_MotorPhaseCurrent */
+
+/** \brief Returns the DC link current through the shunt now.
+ *
+ * \return Current [A], positive from the DC link into the bridge
+ */
+float64 Sim_MotorBusCurrent(void)
+{
+  uint32 Out;
+  uint32 Ph;
+  float64 I;
+
+  Out = Sim_Ccu6OutputsNow() & Sim_BdrvGates();
+  I = 0.0;
+  for(Ph = 0u; Ph < SIM_MOTOR_PH_NUM; Ph++)
+  {
+    if((Out & (1u << (2u * Ph))) != 0u)
+    {
+      I += Sim_lMotorI[Ph];
+    }
+  }
+  return I;
+} /* End of Sim_MotorBusCurrent */
+
+/** \brief Returns the Hall pattern of the rotor angle.
+ *
+ * \return Hall pattern 1..6, bit 0 = CCPOS0
+ */
+uint32 Sim_MotorHall(void)
+{
+  return Sim_lMotorHall;
+} /* End of Sim_MotorHall */
+
+/** \brief Returns the time of the last Hall edge.
+ *
+ * \param[out] pNum Number of Hall edges since Sim_MotorInit, NULL if not needed
+ * \return Time [cycles]
+ */
+TSim_Time Sim_MotorHallEdge(uint32 *pNum)
+{
+  if(pNum != NULL)
+  {
+    *pNum = Sim_lMotorEdges;
+  }
+  return Sim_lMotorEdge;
+} /* End of Sim_MotorHallEdge */
+
+/** \brief Returns the pattern of the BEMF comparators.
+ *
+ * \return BEMF pattern, bit 0 = phase U, 0 at standstill
+ */
+uint32 Sim_MotorBemf(void)
+{
+  return Sim_lMotorBemf;
+} /* End of Sim_MotorBemf */
+
+/** \brief Returns the time of the last BEMF comparator edge (zero crossing).
+ *
+ * \param[out] pNum Number of zero crossings since Sim_MotorInit, NULL if not needed
+ * \return Time [cycles]
+ */
+TSim_Time Sim_MotorBemfEdge(uint32 *pNum)
+{
+  if(pNum != NULL)
+  {
+    *pNum = Sim_lMotorBemfEdges;
+  }
+  return Sim_lMotorBemfEdge;
+} /* End of Sim_MotorBemfEdge */
+
+/*******************************************************************************
+**                      Private Function Definitions                          **
+*******************************************************************************/
+static void Sim_lMotorReset(void)
+{
+  uint32 Ph;
+
+  Sim_lMotorOn = false;
+  Sim_lMotorLocked = false;
+  Sim_lMotorNext = SIM_NEVER;
+  Sim_lMotorAngle = 0.0;
+  Sim_lMotorSpeed = 0.0;
+  Sim_lMotorTorque = 0.0;
+  Sim_lMotorLoad = 0.0;
+  Sim_lMotorHall = 0u;
+  Sim_lMotorEdge = 0u;
+  Sim_lMotorEdges = 0u;
+  Sim_lMotorBemf = 0u;
+  Sim_lMotorBemfEdge = 0u;
+  Sim_lMotorBemfEdges = 0u;
+  for(Ph = 0u; Ph < SIM_MOTOR_PH_NUM; Ph++)
+  {
+    Sim_lMotorI[Ph] = 0.0;
+  }
+}
+
+static TSim_Time Sim_lMotorNextEv(void)
+{
+  return (Sim_lMotorOn == true) ? Sim_lMotorNext : SIM_NEVER;
+}
+
+static void Sim_lMotorStep(TSim_Time Now)
+{
+  const TSim_MotorCfg *pCfg;
+  float64 On[6];
+  float64 V[SIM_MOTOR_PH_NUM];
+  float64 Emf[SIM_MOTOR_PH_NUM];
+  float64 Shape[SIM_MOTOR_PH_NUM];
+  float64 We;
+  float64 Vn;
+  float64 I;
+  float64 Acc;
+  float64 Fric;
+  uint32 Gates;
+  uint32 Conn[SIM_MOTOR_PH_NUM];
+  uint32 Num;
+  uint32 Ph;
+
+  pCfg = &Sim_lMotorCfg;
+  Sim_lMotorNext = Now + SIM_MOTOR_STEP;
+
+  /* Bridge: averaged phase voltages of the connected phases */
+  Sim_Ccu6Outputs(On);
+  Gates = Sim_BdrvGates();
+  Num = 0u;
+  We = Sim_lMotorSpeed * (float64)pCfg->PolePairs;
+  for(Ph = 0u; Ph < SIM_MOTOR_PH_NUM; Ph++)
+  {
+    if((Gates & (1u << (2u * Ph))) == 0u)
+    {
+      On[2u * Ph] = 0.0;
+    }
+    if((Gates & (2u << (2u * Ph))) == 0u)
+    {
+      On[(2u * Ph) + 1u] = 0.0;
+    }
+    V[Ph] = On[2u * Ph] * pCfg->Vdc;
+    Shape[Ph] = sin(Sim_lMotorAngle - ((float64)Ph * (120.0 * SIM_MOTOR_DEG)));
+    Emf[Ph] = pCfg->Ke * We * Shape[Ph];
+    if((On[2u * Ph] + On[(2u * Ph) + 1u]) > 0.0)
+    {
+      Conn[Num] = Ph;
+      Num++;
+    }
+    else
+    {
+      Sim_lMotorI[Ph] = 0.0;
+    }
+  }
+
+  Sim_lMotorUpdateBemf(Emf);
+
+  /* Phase currents */
+  if(Num == 2u)
+  {
+    I = (Sim_lMotorI[Conn[0]] - Sim_lMotorI[Conn[1]]) / 2.0;
+    I += ((V[Conn[0]] - V[Conn[1]]) - (Emf[Conn[0]] - Emf[Conn[1]]) - (2.0 * pCfg->R * I)) /
+         (2.0 * pCfg->L) * SIM_MOTOR_DT;
+    Sim_lMotorI[Conn[0]] = I;
+    Sim_lMotorI[Conn[1]] = -I;
+  }
+  else if(Num == 3u)
+  {
+    Vn = ((V[0] - Emf[0]) + (V[1] - Emf[1]) + (V[2] - Emf[2])) / 3.0;
+    for(Ph = 0u; Ph < SIM_MOTOR_PH_NUM; Ph++)
+    {
+      Sim_lMotorI[Ph] += (V[Ph] - Emf[Ph] - Vn - (pCfg->R * Sim_lMotorI[Ph])) / pCfg->L * SIM_MOTOR_DT;
+    }
+  }
+  else
+  {
+    for(Ph = 0u; Ph < SIM_MOTOR_PH_NUM; Ph++)
+    {
+      Sim_lMotorI[Ph] = 0.0;
+    }
+  }
+
+  /* Rotor */
+  Sim_lMotorTorque = (float64)pCfg->PolePairs * pCfg->Ke *
+                     ((Shape[0] * Sim_lMotorI[0]) + (Shape[1] * Sim_lMotorI[1]) + (Shape[2] * Sim_lMotorI[2]));
+  if(Sim_lMotorLocked == true)
+  {
+    Sim_lMotorSpeed = 0.0;
+  }
+  else
+  {
+    Fric = pCfg->Friction + Sim_lMotorLoad;
+    Acc = Sim_lMotorTorque - (pCfg->B * Sim_lMotorSpeed);
+    if(Sim_lMotorSpeed > 0.0)
+    {
+      Acc -= Fric;
+    }
+    else if(Sim_lMotorSpeed < 0.0)
+    {
+      Acc += Fric;
+    }
+    else
+    {
+      /* Breakaway */
+      Acc = (fabs(Acc) <= Fric) ? 0.0 : (Acc - copysign(Fric, Acc));
+    }
+    Acc /= pCfg->J;
+    I = Sim_lMotorSpeed + (Acc * SIM_MOTOR_DT);
+    /* Friction stops, it does not reverse */
+    Sim_lMotorSpeed = (((I > 0.0) && (Sim_lMotorSpeed < 0.0)) || ((I < 0.0) && (Sim_lMotorSpeed > 0.0))) ? 0.0 : I;
+    Sim_lMotorAngle = fmod(Sim_lMotorAngle + (Sim_lMotorSpeed * (float64)pCfg->PolePairs * SIM_MOTOR_DT) +
+                           (2.0 * SIM_MOTOR_PI), 2.0 * SIM_MOTOR_PI);
+  }
+  Sim_lMotorUpdateHall();
+}
+
+/* Sector of the angle between the Hall edges */
+static uint32 Sim_lMotorHallPtn(void)
+{
+  float64 Deg;
+  float64 Edge;
+  uint32 n;
+  uint32 Ptn;
+
+  Deg = Sim_lMotorAngle / SIM_MOTOR_DEG;
+  Ptn = Sim_lMotorHallSeq[SIM_MOTOR_HALL_NUM - 1u];
+  for(n = 0u; n < SIM_MOTOR_HALL_NUM; n++)
+  {
+    Edge = 30.0 + (60.0 * (float64)n) + Sim_lMotorCfg.HallErr[n];
+    if(Deg >= Edge)
+    {
+      Ptn = Sim_lMotorHallSeq[n];
+    }
+  }
+  return Ptn;
+}
+
+static void Sim_lMotorUpdateHall(void)
+{
+  uint32 Ptn;
+
+  Ptn = Sim_lMotorHallPtn();
+  if(Ptn != Sim_lMotorHall)
+  {
+    Sim_lMotorHall = Ptn;
+    Sim_lMotorEdge = Sim_Now();
+    Sim_lMotorEdges++;
+    Sim_Ccu6SetHall(Ptn);
+  }
+}
+
+/* Comparators with hysteresis, an edge is passed on to the CCU6 */
+static void Sim_lMotorUpdateBemf(const float64 *pEmf)
+{
+  uint32 Ptn;
+  uint32 Ph;
+
+  Ptn = Sim_lMotorBemf;
+  for(Ph = 0u; Ph < SIM_MOTOR_PH_NUM; Ph++)
+  {
+    if(pEmf[Ph] > SIM_MOTOR_BEMF_HYST)
+    {
+      Ptn |= 1u << Ph;
+    }
+    else if(pEmf[Ph] < -SIM_MOTOR_BEMF_HYST)
+    {
+      Ptn &= ~(1u << Ph);
+    }
+    else
+    {
+      /* Within the hysteresis */
+    }
+  }
+  if(Ptn != Sim_lMotorBemf)
+  {
+    Sim_lMotorBemf = Ptn;
+    Sim_lMotorBemfEdge = Sim_Now();
+    Sim_lMotorBemfEdges++;
+    Sim_Ccu6SetBemf(Ptn);
+  }
+}
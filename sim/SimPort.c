@@ -0,0 +1,190 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, port and external interrupt model
+ * V0.1.1: 2026-10-18: Pin edges counted by the GPT12E model
+ */
+
+/* Ports: the data registers read the pin levels set by the tests or the other
+ * models where the pin is an input, the output latch where it is an output
+ * (port 2 is input only). External interrupts: a level change on an EXINTn
+ * input sets the rising or falling flag in IRCON0 if that edge is selected in
+ * EXICON0, and requests the node of the input if enabled in MODIENx (EXINT2
+ * shares the UART2 node). Pin edges are passed on to the GPT12E model, which
+ * counts the encoder inputs of T2. */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include <stddef.h>
+#include "Sim.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+#define SIM_PORT_NUM  (3u)
+#define SIM_EXINT_NUM (3u)
+
+/*******************************************************************************
+**                      Private Variable Definitions                          **
+*******************************************************************************/
+static uint8 Sim_lPin[SIM_PORT_NUM];
+static bool Sim_lExint[SIM_EXINT_NUM];
+
+/*******************************************************************************
+**                      Private Function Declarations                         **
+*******************************************************************************/
+static void Sim_lPortReset(void);
+static void Sim_lPortRead(uint32 Addr);
+
+/*******************************************************************************
+**                      Global Constant Definitions                           **
+*******************************************************************************/
+const TSim_Model Sim_Port =
+{
+  Sim_lPortReset, Sim_lPortRead, NULL, NULL, NULL
+};
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+/** \brief Sets the level of a pin.
+ *
+ * \param[in] Port Port 0..2
+ * \param[in] Pin Pin 0..7
+ * \param[in] Level true = high
+ * \return None
+ */
+void Sim_PortSetPin(uint32 Port, uint32 Pin, bool Level)
+{
+  if(Level == Sim_PortGetPin(Port, Pin))
+  {
+    return;
+  }
+  if(Level == true)
+  {
+    Sim_lPin[Port] |= (uint8)(1u << Pin);
+  }
+  else
+  {
+    Sim_lPin[Port] &= (uint8)~(1u << Pin);
+  }
+  Sim_GptPinEdge(Port, Pin);
+} /* End of Sim_PortSetPin */
+
+/** \brief Gets the level of a pin set by Sim_PortSetPin.
+ *
+ * \param[in] Port Port 0..2
+ * \param[in] Pin Pin 0..7
+ * \return true = high
+ */
+bool Sim_PortGetPin(uint32 Port, uint32 Pin)
+{
+  return ((Sim_lPin[Port] & (1u << Pin)) != 0u) ? true : false;
+} /* End of Sim_PortGetPin */
+
+/** \brief Sets the level of an external interrupt input.
+ *
+ * \param[in] Exint EXINT0..2
+ * \param[in] Level true = high
+ * \return None
+ */
+void Sim_PortSetExint(uint32 Exint, bool Level)
+{
+  static const uint8 Irq[SIM_EXINT_NUM] = {SIM_IRQ_EXINT0, SIM_IRQ_EXINT1, SIM_IRQ_UART2};
+  uint32 Flag;
+  uint32 En;
+
+  if(Level == Sim_lExint[Exint])
+  {
+    return;
+  }
+  Sim_lExint[Exint] = Level;
+
+  /* EXICON0 and IRCON0: rising edge bit 2n, falling edge bit 2n+1 */
+  Flag = ((Level == true) ? 1u : 2u) << (2u * Exint);
+  if(((uint32)SIM_SCU->EXICON0.reg & Flag) == 0u)
+  {
+    return;
+  }
+  SIM_SCU->IRCON0.reg |= (uint8)Flag;
+  if(Exint == 0u)
+  {
+    En = (uint32)SIM_SCU->MODIEN3.reg & SCU_MODIEN3_IE0_Msk;
+  }
+  else if(Exint == 1u)
+  {
+    En = (uint32)SIM_SCU->MODIEN4.reg & SCU_MODIEN4_IE1_Msk;
+  }
+  else
+  {
+    En = (uint32)SIM_SCU->MODIEN2.reg & SCU_MODIEN2_EXINT2_EN_Msk;
+  }
+  if(En != 0u)
+  {
+    Sim_SetPending(Irq[Exint]);
+  }
+} /* End of Sim_PortSetExint */
+
+/*******************************************************************************
+**                      Private Function Definitions                          **
+*******************************************************************************/
+static void Sim_lPortReset(void)
+{
+  uint32 i;
+
+  for(i = 0u; i < SIM_PORT_NUM; i++)
+  {
+    Sim_lPin[i] = 0u;
+  }
+  for(i = 0u; i < SIM_EXINT_NUM; i++)
+  {
+    Sim_lExint[i] = false;
+  }
+}
+
+/* Inputs into the data registers before a read */
+static void Sim_lPortRead(uint32 Addr)
+{
+  uint32 Dir;
+
+  if((Addr - PORT_BASE) >= sizeof(PORT_Type))
+  {
+    return;
+  }
+  Dir = SIM_PORT->P0_DIR.reg;
+  SIM_PORT->P0_DATA.reg = (uint8)((SIM_PORT->P0_DATA.reg & Dir) | (Sim_lPin[0] & ~Dir));
+  Dir = SIM_PORT->P1_DIR.reg;
+  SIM_PORT->P1_DATA.reg = (uint8)((SIM_PORT->P1_DATA.reg & Dir) | (Sim_lPin[1] & ~Dir));
+  SIM_PORT->P2_DATA.reg = Sim_lPin[2];
+}
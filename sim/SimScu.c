@@ -0,0 +1,235 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, SCU, SCUPM, LIN, ADC2 and UART1 models
+ * V0.1.1: 2026-10-18: ADC2 VSD result
+ */
+
+/* System control: interrupt flag clear registers, PLL lock, LIN transceiver
+ * mode feedback, the supply values of ADC2 and the UART1 transmitter, whose
+ * bytes are collected for the tests. */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include <stddef.h>
+#include <string.h>
+#include "Sim.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+#define SIM_UART_BUF_SIZE (0x100000u)
+
+/* ADC2 filter results at 12 V supply, 5 V VAREF, 25 degC */
+#define SIM_ADC2_VS      (540u)
+#define SIM_ADC2_VSD     (540u)
+#define SIM_ADC2_VAREF   (925u)
+#define SIM_ADC2_VCP     (700u)
+#define SIM_ADC2_TEMP    (500u)
+
+/*******************************************************************************
+**                      Private Variable Definitions                          **
+*******************************************************************************/
+static TSim_Time Sim_lUartDone;
+static uint8 Sim_lUartBuf[SIM_UART_BUF_SIZE];
+static uint32 Sim_lUartNum;
+static uint32 Sim_lUartRd;
+
+/*******************************************************************************
+**                      Private Function Declarations                         **
+*******************************************************************************/
+static void Sim_lScuReset(void);
+static void Sim_lScuWrite(uint32 Addr, uint32 Old, uint32 New);
+static TSim_Time Sim_lScuNext(void);
+static void Sim_lScuStep(TSim_Time Now);
+static TSim_Time Sim_lUartByteTime(void);
+
+/*******************************************************************************
+**                      Global Constant Definitions                           **
+*******************************************************************************/
+const TSim_Model Sim_Scu =
+{
+  Sim_lScuReset, NULL, Sim_lScuWrite, Sim_lScuNext, Sim_lScuStep
+};
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+/** \brief Returns the bytes sent on UART1 since the last call.
+ *
+ * \param[out] pBuf Bytes
+ * \param[in] Max Size of pBuf
+ * \return Number of bytes
+ */
+uint32 Sim_UartRead(uint8 *pBuf, uint32 Max)
+{
+  uint32 Num;
+
+  Num = Sim_lUartNum - Sim_lUartRd;
+  if(Num > Max)
+  {
+    Num = Max;
+  }
+  memcpy(pBuf, &Sim_lUartBuf[Sim_lUartRd], Num);
+  Sim_lUartRd += Num;
+  return Num;
+} /* End of Sim_UartRead */
+
+/*******************************************************************************
+**                      Private Function Definitions                          **
+*******************************************************************************/
+static void Sim_lScuReset(void)
+{
+  Sim_lUartDone = SIM_NEVER;
+  Sim_lUartNum = 0u;
+  Sim_lUartRd = 0u;
+
+  SIM_ADC2->FILT_OUT1.reg = SIM_ADC2_VS;
+  SIM_ADC2->FILT_OUT2.reg = SIM_ADC2_VSD;
+  SIM_ADC2->FILT_OUT6.reg = SIM_ADC2_VAREF;
+  SIM_ADC2->FILT_OUT3.reg = SIM_ADC2_VCP;
+  SIM_ADC2->FILT_OUT9.reg = SIM_ADC2_TEMP;
+}
+
+/* Clear registers act on their status register and read as 0 */
+static void Sim_lScuWrite(uint32 Addr, uint32 Old, uint32 New)
+{
+  static const struct
+  {
+    uint32 Clr;
+    uint32 Sts;
+  } Clr[] =
+  {
+    {offsetof(SCU_Type, IRCON0CLR), offsetof(SCU_Type, IRCON0)},
+    {offsetof(SCU_Type, IRCON1CLR), offsetof(SCU_Type, IRCON1)},
+    {offsetof(SCU_Type, IRCON2CLR), offsetof(SCU_Type, IRCON2)},
+    {offsetof(SCU_Type, IRCON3CLR), offsetof(SCU_Type, IRCON3)},
+    {offsetof(SCU_Type, IRCON4CLR), offsetof(SCU_Type, IRCON4)},
+    {offsetof(SCU_Type, NMICLR), offsetof(SCU_Type, NMISR)},
+    {offsetof(SCU_Type, GPT12ICLR), offsetof(SCU_Type, GPT12IRC)},
+    {offsetof(SCU_Type, DMAIRC1CLR), offsetof(SCU_Type, DMAIRC1)},
+    {offsetof(SCU_Type, DMAIRC2CLR), offsetof(SCU_Type, DMAIRC2)},
+    {offsetof(SCU_Type, LINSCLR), offsetof(SCU_Type, LINST)},
+    {offsetof(SCU_Type, EDCSCLR), offsetof(SCU_Type, EDCSTAT)}
+  };
+  uint8 *pScu;
+  uint32 i;
+  uint32 Mode;
+
+  (void)Old;
+  if((Addr - SCU_BASE) < 0x1000u)
+  {
+    pScu = (uint8 *)SIM_SCU;
+    for(i = 0u; i < (sizeof(Clr) / sizeof(Clr[0])); i++)
+    {
+      if(Addr == (SCU_BASE + Clr[i].Clr))
+      {
+        pScu[Clr[i].Sts] &= (uint8)~New;
+        pScu[Clr[i].Clr] = 0u;
+      }
+    }
+    if(Addr == SIM_ADDR(SCU, PLL_CON))
+    {
+      SIM_SCU->PLL_CON.reg |= (uint8)SCU_PLL_CON_LOCK_Msk;
+    }
+  }
+  else if(Addr == SIM_ADDR(SCUPM, SYS_ISCLR))
+  {
+    SIM_SCUPM->SYS_IS.reg &= ~New;
+    SIM_SCUPM->SYS_ISCLR.reg = 0u;
+  }
+  else if(Addr == SIM_ADDR(LIN, CTRL_STS))
+  {
+    /* Mode feedback follows the mode at once: sleep 1, receive only 5, normal 7 */
+    Mode = (New & LIN_CTRL_STS_MODE_Msk) >> LIN_CTRL_STS_MODE_Pos;
+    SIM_LIN->CTRL_STS.reg = (New & ~LIN_CTRL_STS_MODE_FB_Msk) |
+                            ((uint32)((Mode == 0u) ? 1u : ((Mode == 1u) ? 5u : 7u)) << LIN_CTRL_STS_MODE_FB_Pos);
+  }
+  else if(Addr == SIM_ADDR(UART1, SBUF))
+  {
+    /* One byte on the line at a time, a write while busy is lost */
+    if(Sim_lUartDone == SIM_NEVER)
+    {
+      if(Sim_lUartNum < SIM_UART_BUF_SIZE)
+      {
+        Sim_lUartBuf[Sim_lUartNum] = (uint8)New;
+        Sim_lUartNum++;
+      }
+      Sim_lUartDone = Sim_Now() + Sim_lUartByteTime();
+    }
+  }
+  else if(Addr == SIM_ADDR(UART1, SCONCLR))
+  {
+    SIM_UART1->SCON.reg &= (uint8)~New;
+    SIM_UART1->SCONCLR.reg = 0u;
+  }
+  else
+  {
+    /* Plain register */
+  }
+}
+
+static TSim_Time Sim_lScuNext(void)
+{
+  return Sim_lUartDone;
+}
+
+static void Sim_lScuStep(TSim_Time Now)
+{
+  (void)Now;
+  if(Sim_lUartDone <= Now)
+  {
+    Sim_lUartDone = SIM_NEVER;
+    SIM_UART1->SCON.reg |= (uint8)UART1_SCON_TI_Msk;
+    if((SIM_SCU->MODIEN1.reg & SCU_MODIEN1_TIEN1_Msk) != 0u)
+    {
+      Sim_SetPending(SIM_IRQ_UART1);
+    }
+  }
+}
+
+/* Start, 8 data and stop bit, baud rate fSYS / (16 * (BR_VALUE + FD_SEL / 32)) */
+static TSim_Time Sim_lUartByteTime(void)
+{
+  uint32 Br;
+  uint32 Fd;
+
+  Br = ((uint32)SIM_SCU->BGH1.reg << 3u) | (((uint32)SIM_SCU->BGL1.reg & SCU_BGL1_BR_VALUE_Msk) >> SCU_BGL1_BR_VALUE_Pos);
+  Fd = (uint32)SIM_SCU->BGL1.reg & SCU_BGL1_FD_SEL_Msk;
+  if((Br == 0u) && (Fd == 0u))
+  {
+    Br = 1u;
+  }
+  return ((TSim_Time)10u * 16u * ((Br * 32u) + Fd)) / 32u;
+}
@@ -0,0 +1,214 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, SSC2 slave model and SPI master
+ */
+
+/* SSC2 as SPI slave, clocked by the SPI master of the tests: chip select low
+ * is a falling edge on EXINT2, then each word exchanges the shift register
+ * with the master word. The received word goes to RB with the receive request
+ * (RIR, DMA channel 3), the shift register reloads from TB with the transmit
+ * request (TIR, DMA channel 2) as soon as it is empty, as on the device. The
+ * DMA channels follow the SSC2 selection in DMASRCSEL. Without a reload in
+ * time the shift register sends its last word again. */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include <stddef.h>
+#include "Sim.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+#define SIM_SSC_DMA_TX (2u)
+#define SIM_SSC_DMA_RX (3u)
+
+/* Chip select setup and hold time of the master */
+#define SIM_SPI_CS_TIME (SIM_US(2))
+
+/*******************************************************************************
+**                      Private Type Definitions                              **
+*******************************************************************************/
+/** \brief SPI master frame in progress */
+typedef struct
+{
+  const uint16 *pTx;  /**< \brief Master words */
+  uint16 *pRx;        /**< \brief Slave words, NULL if not needed */
+  uint32 Num;         /**< \brief Words of the frame */
+  uint32 Idx;         /**< \brief Next word */
+  TSim_Time WordTime; /**< \brief Time per word [cycles] */
+  TSim_Time Next;     /**< \brief Next word or chip select high */
+} TSim_SpiFrame;
+
+/*******************************************************************************
+**                      Private Variable Definitions                          **
+*******************************************************************************/
+static TSim_SpiFrame Sim_lSpi;
+static uint16 Sim_lSscShift;
+static bool Sim_lSscShiftFull;
+static bool Sim_lSscTbFull;
+
+/*******************************************************************************
+**                      Private Function Declarations                         **
+*******************************************************************************/
+static void Sim_lSscReset(void);
+static void Sim_lSscWrite(uint32 Addr, uint32 Old, uint32 New);
+static TSim_Time Sim_lSscNext(void);
+static void Sim_lSscStep(TSim_Time Now);
+static void Sim_lSscLoad(void);
+static void Sim_lSscFlag(uint32 Msk, uint32 En, uint32 Ch, uint32 Sel);
+
+/*******************************************************************************
+**                      Global Constant Definitions                           **
+*******************************************************************************/
+const TSim_Model Sim_Ssc =
+{
+  Sim_lSscReset, NULL, Sim_lSscWrite, Sim_lSscNext, Sim_lSscStep
+};
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+/** \brief Starts an SPI frame of the master: chip select goes low now.
+ *
+ * The buffers are used while the simulation runs, until Sim_SpiBusy is false.
+ *
+ * \param[in] pTx Master words
+ * \param[out] pRx Slave words, NULL if not needed
+ * \param[in] Num Number of words
+ * \param[in] WordTime Time per word [cycles], 16 SPI clocks
+ * \return None
+ */
+void Sim_SpiStart(const uint16 *pTx, uint16 *pRx, uint32 Num, TSim_Time WordTime)
+{
+  Sim_lSpi.pTx = pTx;
+  Sim_lSpi.pRx = pRx;
+  Sim_lSpi.Num = Num;
+  Sim_lSpi.Idx = 0u;
+  Sim_lSpi.WordTime = WordTime;
+  Sim_lSpi.Next = Sim_Now() + SIM_SPI_CS_TIME + WordTime;
+  Sim_PortSetExint(2u, false);
+} /* End of Sim_SpiStart */
+
+/** \brief Returns whether a frame is in progress (chip select low).
+ *
+ * \return true while the frame runs
+ */
+bool Sim_SpiBusy(void)
+{
+  return (Sim_lSpi.Next != SIM_NEVER) ? true : false;
+} /* End of Sim_SpiBusy */
+
+/*******************************************************************************
+**                      Private Function Definitions                          **
+*******************************************************************************/
+static void Sim_lSscReset(void)
+{
+  Sim_lSpi.Next = SIM_NEVER;
+  Sim_lSscShift = 0u;
+  Sim_lSscShiftFull = false;
+  Sim_lSscTbFull = false;
+  Sim_PortSetExint(2u, true);
+}
+
+static void Sim_lSscWrite(uint32 Addr, uint32 Old, uint32 New)
+{
+  (void)Old;
+  (void)New;
+  if(Addr == SIM_ADDR(SSC2, TB))
+  {
+    Sim_lSscTbFull = true;
+    Sim_lSscLoad();
+  }
+  else if(Addr == SIM_ADDR(SSC2, ISRCLR))
+  {
+    SIM_SSC2->ISRCLR.reg = 0u;
+  }
+  else
+  {
+    /* Plain register */
+  }
+}
+
+static TSim_Time Sim_lSscNext(void)
+{
+  return Sim_lSpi.Next;
+}
+
+/* One word of the master, chip select high after the last */
+static void Sim_lSscStep(TSim_Time Now)
+{
+  if(Sim_lSpi.Idx >= Sim_lSpi.Num)
+  {
+    Sim_lSpi.Next = SIM_NEVER;
+    Sim_PortSetExint(2u, true);
+    return;
+  }
+  if(Sim_lSpi.pRx != NULL)
+  {
+    Sim_lSpi.pRx[Sim_lSpi.Idx] = Sim_lSscShift;
+  }
+  SIM_SSC2->RB.reg = Sim_lSpi.pTx[Sim_lSpi.Idx];
+  Sim_lSpi.Idx++;
+  Sim_lSscShiftFull = false;
+  Sim_lSpi.Next = Now + ((Sim_lSpi.Idx < Sim_lSpi.Num) ? Sim_lSpi.WordTime : SIM_SPI_CS_TIME);
+  Sim_lSscFlag(SCU_IRCON2_RIR_Msk, SCU_MODIEN2_RIREN2_Msk, SIM_SSC_DMA_RX, SCU_DMASRCSEL_SSCRXSRCSEL_Msk);
+  Sim_lSscLoad();
+}
+
+/* Empty shift register from TB if a word is waiting, then TB is free */
+static void Sim_lSscLoad(void)
+{
+  if((Sim_lSscShiftFull == false) && (Sim_lSscTbFull == true))
+  {
+    Sim_lSscShift = SIM_SSC2->TB.reg;
+    Sim_lSscShiftFull = true;
+    Sim_lSscTbFull = false;
+    Sim_lSscFlag(SCU_IRCON2_TIR_Msk, SCU_MODIEN2_TIREN2_Msk, SIM_SSC_DMA_TX, SCU_DMASRCSEL_SSCTXSRCSEL_Msk);
+  }
+}
+
+/* Request flag, interrupt node and DMA channel if SSC2 is selected */
+static void Sim_lSscFlag(uint32 Msk, uint32 En, uint32 Ch, uint32 Sel)
+{
+  SIM_SCU->IRCON2.reg |= (uint8)Msk;
+  if(((uint32)SIM_SCU->MODIEN2.reg & En) != 0u)
+  {
+    Sim_SetPending(SIM_IRQ_SSC2);
+  }
+  if(((uint32)SIM_SCU->DMASRCSEL.reg & Sel) != 0u)
+  {
+    Sim_DmaRequest(Ch);
+  }
+}
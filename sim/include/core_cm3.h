@@ -0,0 +1,198 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, CMSIS core replacement for the host simulation
+ */
+
+/* Replaces the CMSIS core_cm3.h of the Keil pack in the host build. The core
+ * registers (SysTick, NVIC, DWT) are plain memory at their Cortex-M3 addresses,
+ * see Sim.c; the intrinsics that change the interrupt state call into the
+ * simulation kernel so that pending interrupts are dispatched when they are
+ * unmasked. */
+
+#ifndef CORE_CM3_H
+#define CORE_CM3_H
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include <stdint.h>
+#include "types.h"
+
+/*******************************************************************************
+**                      Global Macro Definitions                              **
+*******************************************************************************/
+/* SDK inline functions: one static copy per translation unit as with ARMCC
+ * (static __forceinline), C99 inline would need an external definition */
+#undef INLINE
+#define INLINE static inline
+
+/* IO type qualifiers */
+#define __I   volatile const
+#define __O   volatile
+#define __IO  volatile
+#define __IM  volatile const
+#define __OM  volatile
+#define __IOM volatile
+
+#define __STATIC_INLINE static inline
+#define __INLINE inline
+#define __ASM __asm__
+
+/* Cortex-M3 core peripherals */
+#define DWT_BASE       (0xE0001000UL)
+#define CoreDebug_BASE (0xE000EDF0UL)
+
+#define DWT_CTRL_CYCCNTENA_Msk      (1UL)
+#define DWT_CTRL_NOCYCCNT_Msk       (1UL << 25u)
+#define CoreDebug_DEMCR_TRCENA_Msk  (1UL << 24u)
+
+#define DWT       ((DWT_Type *)DWT_BASE)
+#define CoreDebug ((CoreDebug_Type *)CoreDebug_BASE)
+
+/*******************************************************************************
+**                      Global Type Definitions                               **
+*******************************************************************************/
+/** \brief Data watchpoint and trace unit, registers up to the cycle counter */
+typedef struct
+{
+  volatile uint32_t CTRL;   /**< \brief Control register */
+  volatile uint32_t CYCCNT; /**< \brief Cycle count register */
+} DWT_Type;
+
+/** \brief Core debug registers */
+typedef struct
+{
+  volatile uint32_t DHCSR;  /**< \brief Debug halting control and status */
+  volatile uint32_t DCRSR;  /**< \brief Debug core register selector */
+  volatile uint32_t DCRDR;  /**< \brief Debug core register data */
+  volatile uint32_t DEMCR;  /**< \brief Debug exception and monitor control */
+} CoreDebug_Type;
+
+/*******************************************************************************
+**                      Global Variable Declarations                          **
+*******************************************************************************/
+extern volatile uint32_t Sim_PriMask;
+
+/*******************************************************************************
+**                      Global Function Declarations                          **
+*******************************************************************************/
+extern void Sim_Unmask(void);
+extern void Sim_Wfi(void);
+
+/*******************************************************************************
+**                      Global Inline Function Definitions                    **
+*******************************************************************************/
+static inline uint32_t __get_PRIMASK(void)
+{
+  return Sim_PriMask;
+}
+
+static inline void __set_PRIMASK(uint32_t PriMask)
+{
+  Sim_PriMask = PriMask & 1u;
+  if(Sim_PriMask == 0u)
+  {
+    Sim_Unmask();
+  }
+}
+
+static inline int __disable_irq(void)
+{
+  int Prev = (int)Sim_PriMask;
+  Sim_PriMask = 1u;
+  __asm__ volatile("" ::: "memory");
+  return Prev;
+}
+
+static inline void __enable_irq(void)
+{
+  __asm__ volatile("" ::: "memory");
+  Sim_PriMask = 0u;
+  Sim_Unmask();
+}
+
+static inline void __NOP(void)
+{
+  __asm__ volatile("" ::: "memory");
+}
+
+static inline void __DSB(void)
+{
+  __asm__ volatile("" ::: "memory");
+}
+
+static inline void __DMB(void)
+{
+  __asm__ volatile("" ::: "memory");
+}
+
+static inline void __ISB(void)
+{
+  __asm__ volatile("" ::: "memory");
+}
+
+static inline void __WFI(void)
+{
+  Sim_Wfi();
+}
+
+static inline void __WFE(void)
+{
+  Sim_Wfi();
+}
+
+static inline uint32_t __CLZ(uint32_t Value)
+{
+  return (Value == 0u) ? 32u : (uint32_t)__builtin_clz(Value);
+}
+
+static inline uint32_t __REV(uint32_t Value)
+{
+  return __builtin_bswap32(Value);
+}
+
+static inline int32_t __SSAT(int32_t Value, uint32_t Bits)
+{
+  int32_t Max = (int32_t)((1u << (Bits - 1u)) - 1u);
+  int32_t Min = -Max - 1;
+  return (Value > Max) ? Max : ((Value < Min) ? Min : Value);
+}
+
+static inline uint32_t __USAT(int32_t Value, uint32_t Bits)
+{
+  int32_t Max = (int32_t)((1u << Bits) - 1u);
+  return (Value > Max) ? (uint32_t)Max : ((Value < 0) ? 0u : (uint32_t)Value);
+}
+
+#endif /* CORE_CM3_H */
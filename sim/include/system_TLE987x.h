@@ -0,0 +1,3 @@
+/* Host build: the pack header is system_tle987x.h, the device header includes
+ * it with the spelling of the case-insensitive Keil file system */
+#include "system_tle987x.h"
@@ -0,0 +1,128 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, test case runner of the host tests
+ */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "Test.h"
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+/** \brief Runs the test cases, each in a child process with fresh firmware
+ * globals and simulation.
+ *
+ * \param[in] pCases Test cases
+ * \param[in] Num Number of test cases
+ * \param[in] argc Arguments: optional name of a single test case
+ * \param[in] argv Arguments
+ * \return 0 if all passed
+ */
+int Test_Main(const TTest_Case *pCases, uint32 Num, int argc, char **argv)
+{
+  uint32 i;
+  uint32 Failed;
+  pid_t Pid;
+  int Status;
+
+  Failed = 0u;
+  for(i = 0u; i < Num; i++)
+  {
+    if((argc > 1) && (strcmp(argv[1], pCases[i].pName) != 0))
+    {
+      continue;
+    }
+    (void)printf("%s\n", pCases[i].pName);
+    (void)fflush(stdout);
+    Pid = fork();
+    if(Pid == 0)
+    {
+      Sim_Init();
+      pCases[i].pFunc();
+      (void)fflush(stdout);
+      _exit(0);
+    }
+    Status = -1;
+    (void)waitpid(Pid, &Status, 0);
+    if((WIFEXITED(Status) == 0) || (WEXITSTATUS(Status) != 0))
+    {
+      (void)printf("FAIL %s\n", pCases[i].pName);
+      Failed++;
+    }
+    else
+    {
+      (void)printf("PASS %s\n", pCases[i].pName);
+    }
+  }
+  (void)fflush(stdout);
+  return (Failed == 0u) ? 0 : 1;
+} /* End of Test_Main */
+
+/** \brief Stops the test case.
+ *
+ * \param[in] pFile Source file
+ * \param[in] Line Source line
+ * \param[in] pFmt printf format of the message
+ * \return Does not return
+ */
+void Test_Fail(const char *pFile, int Line, const char *pFmt, ...)
+{
+  va_list Args;
+
+  va_start(Args, pFmt);
+  (void)printf("  %s:%d: at %.3f ms: ", pFile, Line, (double)Sim_Now() / (double)SIM_MS(1));
+  (void)vprintf(pFmt, Args);
+  (void)printf("\n");
+  va_end(Args);
+  (void)fflush(stdout);
+  _exit(1);
+} /* End of Test_Fail */
+
+/** \brief Starts the firmware main and runs it through the initialization
+ * into the scheduler.
+ *
+ * \return None
+ */
+void Test_BootFirmware(void)
+{
+  Sim_Boot(Main_Firmware);
+  Sim_Run(SIM_MS(20));
+} /* End of Test_BootFirmware */
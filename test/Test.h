@@ -0,0 +1,80 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/* See Test.c */
+
+#ifndef TEST_H
+#define TEST_H
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include <stdio.h>
+#include "Sim.h"
+
+/*******************************************************************************
+**                      Global Macro Definitions                              **
+*******************************************************************************/
+/* Checks stop the test case with the location and the values */
+#define TEST_ASSERT(Cond) \
+  do { if(!(Cond)) { Test_Fail(__FILE__, __LINE__, "%s", #Cond); } } while(0)
+
+#define TEST_ASSERT_EQ(Val, Exp) \
+  do { long long V_ = (long long)(Val); long long E_ = (long long)(Exp); \
+       if(V_ != E_) { Test_Fail(__FILE__, __LINE__, "%s = %lld, expected %lld", #Val, V_, E_); } } while(0)
+
+#define TEST_ASSERT_RANGE(Val, Min, Max) \
+  do { double V_ = (double)(Val); \
+       if((V_ < (double)(Min)) || (V_ > (double)(Max))) \
+       { Test_Fail(__FILE__, __LINE__, "%s = %g, expected %g..%g", #Val, V_, (double)(Min), (double)(Max)); } } while(0)
+
+/* Result lines, collected by ctest */
+#define TEST_LOG(...) do { (void)printf("  "); (void)printf(__VA_ARGS__); (void)printf("\n"); } while(0)
+
+/*******************************************************************************
+**                      Global Type Definitions                               **
+*******************************************************************************/
+/** \brief Test case, runs in its own process */
+typedef struct
+{
+  const char *pName;    /**< \brief Name */
+  void (*pFunc)(void);  /**< \brief Test function */
+} TTest_Case;
+
+/*******************************************************************************
+**                      Global Function Declarations                          **
+*******************************************************************************/
+int Test_Main(const TTest_Case *pCases, uint32 Num, int argc, char **argv);
+void Test_Fail(const char *pFile, int Line, const char *pFmt, ...) __attribute__((noreturn, format(printf, 3, 4)));
+void Test_BootFirmware(void);
+
+#endif /* TEST_H */
@@ -0,0 +1,219 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-18: Initial version, BEMF comparator commutation against the motor model
+ */
+
+/* The BEMF comparators of the motor model replace the Hall inputs of the CCU6
+ * (Emo_SetPosSensor). The motor is started with the open-loop ramp from
+ * standstill, commutated 30 degrees after each zero crossing, and the CCU6 SR0
+ * handler is measured against the Hall sensors at the same speed with
+ * Sim_InsnTiming, see TestIsr. */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+/* Statistics are declared for the profiled build only */
+#define ISR_PROF_EN (1)
+
+#include "Test.h"
+#include "Emo.h"
+#include "EmoCcu.h"
+#include "IsrProf.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+/* Speed reference [rpm], spin-up time and the tolerance of the mean speed */
+#define TESTBEMF_SPEED   (2000)
+#define TESTBEMF_SPIN_UP (SIM_MS(3000))
+#define TESTBEMF_TOL     (100.0)
+
+/* Latest handover from the open-loop ramp to the zero crossings [ms] */
+#define TESTBEMF_HANDOVER_MS (1000u)
+
+/* Commutation delay after the zero crossing [degrees] and its tolerance */
+#define TESTBEMF_DELAY_DEG (30.0)
+#define TESTBEMF_DELAY_TOL (5.0)
+
+/* Measurement window [ms] */
+#define TESTBEMF_WINDOW_MS (200u)
+
+/*******************************************************************************
+**                      Private Function Definitions                          **
+*******************************************************************************/
+/* Motor at standstill, commutated with PosSensor */
+static void TestBemf_Start(uint8 PosSensor)
+{
+  Test_BootFirmware();
+  Sim_MotorInit(&Sim_MotorDefault, 60.0);
+  Sim_Run(SIM_MS(1));
+  TEST_ASSERT_EQ(Emo_SetPosSensor(PosSensor), 0u);
+  Emo_SetRefSpeed(TESTBEMF_SPEED);
+  TEST_ASSERT_EQ(Emo_StartMotor(), 0u);
+}
+
+/* Mean speed of the window from the zero crossings, six per electrical revolution [rpm] */
+static float64 TestBemf_Speed(void)
+{
+  uint32 Edges;
+  uint32 Prev;
+
+  (void)Sim_MotorBemfEdge(&Prev);
+  Sim_Run(SIM_MS(TESTBEMF_WINDOW_MS));
+  (void)Sim_MotorBemfEdge(&Edges);
+  return (float64)(Edges - Prev) * 60000.0 / ((float64)TESTBEMF_WINDOW_MS * 6.0 * (float64)Sim_MotorDefault.PolePairs);
+}
+
+/* CCU6 SR0 statistics of the window with instruction timing */
+static void TestBemf_Isr(const char *pName, TIsrProf_Isr *pIsr)
+{
+  float64 Speed;
+
+  Sim_InsnTiming(true);
+  IsrProf_Reset(ISR_PROF_NUM);
+  Speed = TestBemf_Speed();
+  Sim_InsnTiming(false);
+  TEST_ASSERT(IsrProf_Get(ISR_PROF_ID_CCU6SR0, pIsr) == true);
+  TEST_LOG("%s: %.0f rpm, CCU6SR0 %u runs, cycles min %u max %u mean %u", pName, Speed, pIsr->Count, pIsr->Min,
+           pIsr->Max, pIsr->Sum / pIsr->Count);
+  TEST_ASSERT_RANGE(Speed, (float64)TESTBEMF_SPEED - TESTBEMF_TOL, (float64)TESTBEMF_SPEED + TESTBEMF_TOL);
+}
+
+/* Open-loop ramp from standstill, handover to the zero crossings and speed control */
+static void TestBemf_Ramp(void)
+{
+  uint32 t;
+  float64 Speed;
+
+  TestBemf_Start(EMO_POS_SENSOR_BEMF);
+  TEST_ASSERT_EQ(Emo_GetMotorState(), EMO_MOTOR_STATE_START);
+  for(t = 1u; (t <= TESTBEMF_HANDOVER_MS) && (Emo_GetMotorState() == EMO_MOTOR_STATE_START); t++)
+  {
+    Sim_Run(SIM_MS(1));
+  }
+  TEST_LOG("handover to run state after %u ms at %.0f rpm", t - 1u, Sim_MotorSpeed());
+  TEST_ASSERT_EQ(Emo_GetMotorState(), EMO_MOTOR_STATE_RUN);
+  TEST_ASSERT(Sim_MotorSpeed() > 0.0);
+
+  Sim_Run(TESTBEMF_SPIN_UP - SIM_MS(t));
+  TEST_ASSERT_EQ(Emo_GetMotorState(), EMO_MOTOR_STATE_RUN);
+  Speed = TestBemf_Speed();
+  TEST_LOG("rotor %.0f rpm, mean of the window %.0f rpm, reference %d rpm", Sim_MotorSpeed(), Speed, TESTBEMF_SPEED);
+  TEST_ASSERT_RANGE(Speed, (float64)TESTBEMF_SPEED - TESTBEMF_TOL, (float64)TESTBEMF_SPEED + TESTBEMF_TOL);
+}
+
+/* Steady state: one output pattern switch per zero crossing, 30 degrees of the
+ * zero crossing period after it */
+static void TestBemf_Delay(void)
+{
+  TSim_Time Edge;
+  TSim_Time PrevEdge;
+  float64 Deg;
+  float64 Min;
+  float64 Max;
+  float64 Sum;
+  uint32 Num;
+  uint32 Edges;
+  uint32 Prev;
+
+  TestBemf_Start(EMO_POS_SENSOR_BEMF);
+  Sim_Run(TESTBEMF_SPIN_UP);
+  TEST_ASSERT_EQ(Emo_GetMotorState(), EMO_MOTOR_STATE_RUN);
+  PrevEdge = Sim_MotorBemfEdge(&Prev);
+  Min = 360.0;
+  Max = 0.0;
+  Sum = 0.0;
+  Num = 0u;
+  while(Num < 200u)
+  {
+    Sim_Run(SIM_US(10));
+    Edge = Sim_MotorBemfEdge(&Edges);
+    if(Edges != Prev)
+    {
+      TEST_ASSERT_EQ(Edges, Prev + 1u);
+      Prev = Edges;
+      while((Sim_Ccu6PatternTime() < Edge) && ((Sim_Now() - Edge) < SIM_MS(10)))
+      {
+        Sim_Run(SIM_US(1));
+      }
+      TEST_ASSERT(Sim_Ccu6PatternTime() >= Edge);
+      Deg = (float64)(Sim_Ccu6PatternTime() - Edge) * 60.0 / (float64)(Edge - PrevEdge);
+      PrevEdge = Edge;
+      Min = (Deg < Min) ? Deg : Min;
+      Max = (Deg > Max) ? Deg : Max;
+      Sum += Deg;
+      Num++;
+    }
+  }
+  TEST_LOG("commutation %.1f..%.1f degrees after the zero crossing, mean %.1f at %.0f rpm", Min, Max, Sum / Num,
+           Sim_MotorSpeed());
+  TEST_ASSERT_RANGE(Min, TESTBEMF_DELAY_DEG - TESTBEMF_DELAY_TOL, TESTBEMF_DELAY_DEG + TESTBEMF_DELAY_TOL);
+  TEST_ASSERT_RANGE(Max, TESTBEMF_DELAY_DEG - TESTBEMF_DELAY_TOL, TESTBEMF_DELAY_DEG + TESTBEMF_DELAY_TOL);
+}
+
+/* Hall started motor switched to the BEMF comparators at speed: the zero
+ * crossing run of the CCU6 SR0 handler (EmoCcu_HandleHallEvent) costs no more
+ * than the Hall event run */
+static void TestBemf_Cost(void)
+{
+  TIsrProf_Isr Hall;
+  TIsrProf_Isr Bemf;
+
+  TestBemf_Start(EMO_POS_SENSOR_HALL);
+  Sim_Run(TESTBEMF_SPIN_UP);
+  TestBemf_Isr("Hall", &Hall);
+
+  TEST_ASSERT_EQ(Emo_SetPosSensor(EMO_POS_SENSOR_BEMF), 0u);
+  Sim_Run(SIM_MS(500));
+  TEST_ASSERT_EQ(Emo_GetMotorState(), EMO_MOTOR_STATE_RUN);
+  TestBemf_Isr("BEMF", &Bemf);
+
+  TEST_ASSERT(Bemf.Max <= Hall.Max);
+  TEST_ASSERT((Bemf.Sum / Bemf.Count) <= (Hall.Sum / Hall.Count));
+}
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+int main(int argc, char **argv)
+{
+  static const TTest_Case Cases[] =
+  {
+    {"TestBemf_Ramp", TestBemf_Ramp},
+    {"TestBemf_Delay", TestBemf_Delay},
+    {"TestBemf_Cost", TestBemf_Cost}
+  };
+
+  return Test_Main(Cases, sizeof(Cases) / sizeof(Cases[0]), argc, argv);
+}
@@ -0,0 +1,101 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, firmware start and main loop on the host
+ */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include "Test.h"
+#include "Sched.h"
+#include "Timebase.h"
+
+/*******************************************************************************
+**                      Private Function Definitions                          **
+*******************************************************************************/
+/* Initialization completes, SysTick releases the main loop tasks */
+static void TestBoot_Tasks(void)
+{
+  uint16 Runs[4];
+  uint32 i;
+
+  Test_BootFirmware();
+  TEST_ASSERT_EQ(Sched_Status.NumTasks, 4u);
+  for(i = 0u; i < 4u; i++)
+  {
+    Runs[i] = Sched_Status.Task[i].Runs;
+  }
+  Sim_Run(SIM_MS(100));
+  TEST_LOG("runs diag %u supply %u telem %u led %u, load %u %%",
+           Sched_Status.Task[0].Runs - Runs[0], Sched_Status.Task[1].Runs - Runs[1],
+           Sched_Status.Task[2].Runs - Runs[2], Sched_Status.Task[3].Runs - Runs[3], Sched_Status.Load);
+  TEST_ASSERT_RANGE(Sched_Status.Task[0].Runs - Runs[0], 9, 11);
+  TEST_ASSERT_RANGE(Sched_Status.Task[1].Runs - Runs[1], 19, 21);
+  TEST_ASSERT_RANGE(Sched_Status.Task[2].Runs - Runs[2], 9, 11);
+  TEST_ASSERT_RANGE(Sched_Status.Task[3].Runs - Runs[3], 4, 6);
+  for(i = 0u; i < 4u; i++)
+  {
+    TEST_ASSERT_EQ(Sched_Status.Task[i].Overruns, 0u);
+  }
+}
+
+/* The microsecond timebase follows the simulated time */
+static void TestBoot_Timebase(void)
+{
+  uint32 Us;
+  TSim_Time t;
+
+  Test_BootFirmware();
+  Us = Timebase_GetUs();
+  t = Sim_Now();
+  Sim_Run(SIM_MS(250));
+  Us = Timebase_GetUs() - Us;
+  t = Sim_Now() - t;
+  TEST_LOG("timebase %u us in %.1f us", Us, (double)t / SIM_CYCLES_PER_US);
+  TEST_ASSERT_RANGE((double)Us, ((double)t / SIM_CYCLES_PER_US) - 2.0, ((double)t / SIM_CYCLES_PER_US) + 2.0);
+}
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+int main(int argc, char **argv)
+{
+  static const TTest_Case Cases[] =
+  {
+    {"TestBoot_Tasks", TestBoot_Tasks},
+    {"TestBoot_Timebase", TestBoot_Timebase}
+  };
+
+  return Test_Main(Cases, sizeof(Cases) / sizeof(Cases[0]), argc, argv);
+}
@@ -0,0 +1,196 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, block commutation with inner current control against the motor model
+ */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+/* Statistics are declared for the profiled build only */
+#define ISR_PROF_EN (1)
+
+#include "Test.h"
+#include "Emo.h"
+#include "IsrProf.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+/* Steady state band [rpm] */
+#define TESTCURRENT_BAND_RPM (40.0)
+
+/* Load for the current steps [Nm], about 2.2 A at 2000 rpm */
+#define TESTCURRENT_LOAD (0.03)
+
+/* Current step to 3 A: full PWM period = stall current 20 A = 32768 */
+#define TESTCURRENT_STEP_REF (4915)
+
+/* PWM period [us] */
+#define TESTCURRENT_PWM_US (50u)
+
+/*******************************************************************************
+**                      Private Function Definitions                          **
+*******************************************************************************/
+static void TestCurrent_Start(sint16 Ref)
+{
+  Test_BootFirmware();
+  Sim_MotorInit(&Sim_MotorDefault, 60.0);
+  Sim_Run(SIM_MS(1));
+  Emo_SetRefSpeed(Ref);
+  TEST_ASSERT_EQ(Emo_StartMotor(), 0u);
+}
+
+/* Runs at about 2000 rpm under load, returns 1 ms after a Hall edge */
+static void TestCurrent_Load(void)
+{
+  uint32 Edges;
+  uint32 Prev;
+
+  TestCurrent_Start(2000);
+  Sim_Run(SIM_MS(800));
+  Sim_MotorSetLoad(TESTCURRENT_LOAD);
+  Sim_Run(SIM_MS(700));
+  TEST_ASSERT_RANGE(Sim_MotorSpeed(), 1900.0, 2100.0);
+
+  (void)Sim_MotorHallEdge(&Prev);
+  do
+  {
+    Sim_Run(SIM_US(10));
+    (void)Sim_MotorHallEdge(&Edges);
+  } while(Edges == Prev);
+  Sim_Run(SIM_MS(1));
+}
+
+/* Current PI: step of the current reference between two commutations */
+static void TestCurrent_Step(void)
+{
+  sint32 Start;
+  sint32 Ref;
+  sint32 Max;
+  uint32 Rise;
+  uint32 i;
+
+  TestCurrent_Load();
+  Ref = Emo_Ctrl.CurrentRef;
+  Emo_SetRefCurrent(TESTCURRENT_STEP_REF);
+
+  /* Taken over by the next run of Emo_CtrlSpeed (SysTick) */
+  for(i = 0u; (i < 40u) && (Emo_Ctrl.CurrentRef == Ref); i++)
+  {
+    Sim_Run(SIM_US(TESTCURRENT_PWM_US));
+  }
+  Start = Emo_Ctrl.Current;
+  Ref = Emo_Ctrl.CurrentRef;
+  Max = Start;
+  Rise = 0u;
+  for(i = 1u; i <= 40u; i++)
+  {
+    Sim_Run(SIM_US(TESTCURRENT_PWM_US));
+    if((Rise == 0u) && (((sint32)Emo_Ctrl.Current - Start) >= (((Ref - Start) * 9) / 10)))
+    {
+      Rise = i;
+    }
+    Max = (Emo_Ctrl.Current > Max) ? Emo_Ctrl.Current : Max;
+  }
+  TEST_LOG("step %d to %d (%.2f to %.2f A): 90%% after %u PWM periods, overshoot %d, end %d", (int)Start, (int)Ref,
+           Start / 655.36, Ref / 655.36, Rise, (int)(Max - Ref), Emo_Ctrl.Current);
+  TEST_ASSERT_RANGE(Ref - Start, 300, 600);
+  TEST_ASSERT_RANGE(Rise, 1u, 10u);
+  TEST_ASSERT(Max - Ref <= (Ref - Start) / 5);
+  TEST_ASSERT_RANGE(Emo_Ctrl.Current, Ref - 64, Ref + 64);
+}
+
+/* Speed PI on the current reference: no runaway, steps settle */
+static void TestCurrent_Speed(void)
+{
+  float64 Dev;
+  float64 Over;
+  float64 Settle;
+  sint16 Ref;
+  uint32 t;
+
+  TestCurrent_Start(1000);
+  for(Ref = 1000; Ref <= 2000; Ref += 1000)
+  {
+    Emo_SetRefSpeed(Ref);
+    Over = 0.0;
+    Settle = 0.0;
+    for(t = 1u; t <= 1200u; t++)
+    {
+      Sim_Run(SIM_MS(1));
+      Dev = Sim_MotorSpeed() - (float64)Ref;
+      Over = (Dev > Over) ? Dev : Over;
+      if((Dev > TESTCURRENT_BAND_RPM) || (Dev < -TESTCURRENT_BAND_RPM))
+      {
+        Settle = (float64)t;
+      }
+    }
+    TEST_LOG("to %d rpm: overshoot %.0f rpm, settled after %.0f ms, current reference %d", Ref, Over, Settle,
+             Emo_Ctrl.CurrentRef);
+    TEST_ASSERT(Over <= 400.0);
+    TEST_ASSERT_RANGE(Settle, 1.0, 1000.0);
+  }
+}
+
+/* Run time of the CCU6 SR0 handler, T12 period match with Emo_lCtrlCurrent
+ * and the Hall events, with instruction timing: mean below 20 % of a PWM period */
+static void TestCurrent_Isr(void)
+{
+  TIsrProf_Isr Isr;
+
+  TestCurrent_Load();
+  Sim_InsnTiming(true);
+  IsrProf_Reset(ISR_PROF_NUM);
+  Sim_Run(SIM_MS(20));
+  TEST_ASSERT(IsrProf_Get(ISR_PROF_ID_CCU6SR0, &Isr) == true);
+  TEST_LOG("CCU6SR0 %u runs, cycles min %u max %u mean %u, %.1f%% of a PWM period", Isr.Count, Isr.Min, Isr.Max,
+           Isr.Sum / Isr.Count, (float64)(Isr.Sum / Isr.Count) * 100.0 / (float64)SIM_US(TESTCURRENT_PWM_US));
+  TEST_ASSERT(Isr.Count >= 400u);
+  TEST_ASSERT((Isr.Sum / Isr.Count) <= (SIM_US(TESTCURRENT_PWM_US) / 5u));
+}
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+int main(int argc, char **argv)
+{
+  static const TTest_Case Cases[] =
+  {
+    {"TestCurrent_Step", TestCurrent_Step},
+    {"TestCurrent_Speed", TestCurrent_Speed},
+    {"TestCurrent_Isr", TestCurrent_Isr}
+  };
+
+  return Test_Main(Cases, sizeof(Cases) / sizeof(Cases[0]), argc, argv);
+}
@@ -0,0 +1,89 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, Hall latency of the interrupt dispatch
+ * V0.1.1: 2026-10-18: Benchmark variants with ISR_DISPATCH_BENCH_EN
+ */
+
+/* Built twice with ISR_DISPATCH_BENCH_EN = 1: test_dispatch_cascade against
+ * the isr.c cascades (fw_bench), test_dispatch_table against the callback
+ * tables of IsrDispatch.c (fw_disp, ISR_DISPATCH_EN = 1). The firmware boots with Sim_InsnTiming on,
+ * so IsrDispatch_BenchHall at start-up measures the cycles from the software
+ * Hall event to the Hall callback with the handler instructions counted, see
+ * TestIsr. */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+/* Benchmark as in the fw_bench and fw_disp builds */
+#define ISR_DISPATCH_BENCH_EN (1)
+
+#include "Test.h"
+#include "IsrDispatch.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+/* Budget of the Hall event latency [CPU cycles], 2 us */
+#define TESTDISP_HALL_MAX (SIM_US(2))
+
+/*******************************************************************************
+**                      Private Function Definitions                          **
+*******************************************************************************/
+/* Latency of the benchmark run at start-up */
+static void TestDisp_BenchHall(void)
+{
+  Sim_InsnTiming(true);
+  Test_BootFirmware();
+  Sim_InsnTiming(false);
+
+  TEST_LOG("Hall event to callback: min %u max %u last %u cycles, %u runs", IsrDispatch_Status.HallMin,
+           IsrDispatch_Status.HallMax, IsrDispatch_Status.HallLast, IsrDispatch_Status.Runs);
+  TEST_ASSERT_EQ(IsrDispatch_Status.Runs, ISR_DISPATCH_BENCH_RUNS);
+  TEST_ASSERT_EQ(IsrDispatch_Status.Pending, 0u);
+  TEST_ASSERT(IsrDispatch_Status.HallMin <= IsrDispatch_Status.HallMax);
+  TEST_ASSERT(IsrDispatch_Status.HallMax <= TESTDISP_HALL_MAX);
+}
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+int main(int argc, char **argv)
+{
+  static const TTest_Case Cases[] =
+  {
+    {"TestDisp_BenchHall", TestDisp_BenchHall}
+  };
+
+  return Test_Main(Cases, sizeof(Cases) / sizeof(Cases[0]), argc, argv);
+}
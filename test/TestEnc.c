@@ -0,0 +1,268 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, replay of encoder edge streams into the EXINT1 decoding
+ * V0.1.1: 2026-10-18: Replay into the GPT12E T2 decoding as test_enc_t2
+ */
+
+/* Built twice: test_enc against the EXINT1 decoding of the rising edge of
+ * channel B (fw), test_enc_t2 against the T2 incremental interface (fw_enc,
+ * EMOENC_GPT12E_EN = 1). The channels are driven on the inputs of both. */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include "Test.h"
+#include "Emo.h"
+#include "EmoEnc.h"
+#include "bchall_defines.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+/* Quarter lines per decoded tick */
+#define TESTENC_QUARTERS ((sint32)((4u * EMOENC_LINES_PER_REV) / EMOENC_TICKS_PER_REV))
+
+/* Largest difference between the decoded and the quadrature count [quarter
+ * lines]: T2 counts every edge, the rising edge of B is counted one quarter
+ * line apart in the two directions, which leaves up to one line of hysteresis.
+ * Difference after the recording: every bounce of B counts once more with
+ * EXINT1 decoding. */
+#if (EMOENC_GPT12E_EN == 1u)
+#define TESTENC_LAG_MAX (0)
+#define TESTENC_REC_ERR (0)
+#else
+#define TESTENC_LAG_MAX (4)
+#define TESTENC_REC_ERR (-4)
+#endif
+
+/* Encoder speed of the rate test [rpm] and speed of the motor at the same time */
+#define TESTENC_RATE_RPM  (6000.0)
+#define TESTENC_MOTOR_RPM (3000)
+
+/*******************************************************************************
+**                      Private Type Definitions                              **
+*******************************************************************************/
+/** \brief Level change of the encoder channels in a stream */
+typedef struct
+{
+  uint16 Dt;  /**< \brief Time since the last change [0.1 us] */
+  uint8 A;    /**< \brief Channel A level after the change */
+  uint8 B;    /**< \brief Channel B level after the change */
+} TTestEnc_Edge;
+
+/** \brief Section of a generated stream */
+typedef struct
+{
+  sint32 Quarters;  /**< \brief Quarter lines, sign = direction */
+  float64 Us;       /**< \brief Mean time per quarter line [us] */
+  float64 Phase;    /**< \brief Quadrature phase error, A to B spacing shortened by this fraction */
+} TTestEnc_Section;
+
+/*******************************************************************************
+**                      Private Variable Definitions                          **
+*******************************************************************************/
+static uint8 TestEnc_lAb;     /* Channel levels, A in bit 1, B in bit 0 */
+static sint32 TestEnc_lQuad;  /* Reference quadrature count [quarter lines] */
+static sint32 TestEnc_lLag;   /* Largest difference of the decoded count [quarter lines] */
+
+/* Synthetic stream, written by hand after the slow motion of the shaft at
+ * standstill (not a capture): forward, chatter of A around its edge,
+ * reversal, a bounce of B, forward to the start */
+static const TTestEnc_Edge TestEnc_lRec[] =
+{
+  {2000u, 1u, 0u}, {1800u, 1u, 1u}, {1650u, 0u, 1u}, {1500u, 0u, 0u},
+  {1400u, 1u, 0u}, {1350u, 1u, 1u}, {1300u, 0u, 1u}, {1300u, 0u, 0u},
+  {  35u, 1u, 0u}, {  12u, 0u, 0u}, {  20u, 1u, 0u}, {   9u, 0u, 0u},
+  {  41u, 1u, 0u}, {1500u, 1u, 1u}, {1900u, 0u, 1u}, {2600u, 1u, 1u},
+  {2200u, 1u, 0u}, {1900u, 0u, 0u}, {1700u, 0u, 1u}, {1600u, 1u, 1u},
+  {1500u, 1u, 0u}, {1500u, 0u, 0u}, {1450u, 0u, 1u}, {  18u, 0u, 0u},
+  {  25u, 0u, 1u}, {1400u, 1u, 1u}, {1500u, 1u, 0u}, {1700u, 0u, 0u},
+  {3100u, 0u, 1u}, {2500u, 0u, 0u}, {1800u, 1u, 0u}, {1500u, 1u, 1u},
+  {1400u, 0u, 1u}, {1400u, 0u, 0u}, {1300u, 1u, 0u}, {1300u, 1u, 1u},
+  {1300u, 0u, 1u}, {1300u, 0u, 0u}
+};
+
+/*******************************************************************************
+**                      Private Function Definitions                          **
+*******************************************************************************/
+/* Sets the channels after Cycles: A on P2.0 and T2INB (P1.4), B on EXINT1 and
+ * T2EUDB (P2.4), and follows them with the reference quadrature decoder */
+static void TestEnc_Set(TSim_Time Cycles, uint8 A, uint8 B)
+{
+  /* Quarter steps by old and new level (A, B), forward 00 10 11 01 */
+  static const sint8 Step[4][4] =
+  {
+    { 0, -1,  1,  0},
+    { 1,  0,  0, -1},
+    {-1,  0,  0,  1},
+    { 0,  1, -1,  0}
+  };
+  uint8 Ab;
+  sint32 Lag;
+
+  Sim_Run(Cycles);
+
+  /* The edge before has been decoded */
+  Lag = (EmoEnc_GetPos() * TESTENC_QUARTERS) - TestEnc_lQuad;
+  Lag = (Lag < 0) ? -Lag : Lag;
+  TestEnc_lLag = (Lag > TestEnc_lLag) ? Lag : TestEnc_lLag;
+
+  Ab = (uint8)((A << 1u) | B);
+  TEST_ASSERT((Ab ^ TestEnc_lAb) != 3u);
+  TestEnc_lQuad += Step[TestEnc_lAb][Ab];
+  TestEnc_lAb = Ab;
+  Sim_PortSetPin(2u, 0u, (A != 0u) ? true : false);
+  Sim_PortSetPin(1u, 4u, (A != 0u) ? true : false);
+  Sim_PortSetPin(2u, 4u, (B != 0u) ? true : false);
+  Sim_PortSetExint(1u, (B != 0u) ? true : false);
+}
+
+/* Replays a stream of level changes */
+static void TestEnc_Replay(const TTestEnc_Edge *pRec, uint32 Num)
+{
+  uint32 i;
+
+  for(i = 0u; i < Num; i++)
+  {
+    TestEnc_Set(((TSim_Time)pRec[i].Dt * SIM_CYCLES_PER_US) / 10u, pRec[i].A, pRec[i].B);
+  }
+}
+
+/* Generates a stream section by section */
+static void TestEnc_Generate(const TTestEnc_Section *pSec, uint32 Num)
+{
+  /* Level (A, B) by quarter position, forward 00 10 11 01 */
+  static const uint8 Ab[4] = {0u, 2u, 3u, 1u};
+  float64 Us;
+  sint32 Pos;
+  sint32 i;
+  uint32 s;
+
+  for(s = 0u; s < Num; s++)
+  {
+    for(i = 0; i < ((pSec[s].Quarters < 0) ? -pSec[s].Quarters : pSec[s].Quarters); i++)
+    {
+      Pos = TestEnc_lQuad + ((pSec[s].Quarters < 0) ? -1 : 1);
+      /* A to B edge shortened, B to A edge lengthened by the phase error */
+      Us = ((Ab[Pos & 3] & 1u) != (TestEnc_lAb & 1u)) ? (pSec[s].Us * (1.0 - pSec[s].Phase)) :
+                                                          (pSec[s].Us * (1.0 + pSec[s].Phase));
+      TestEnc_Set((TSim_Time)(Us * (float64)SIM_CYCLES_PER_US), (uint8)(Ab[Pos & 3] >> 1u), (uint8)(Ab[Pos & 3] & 1u));
+    }
+  }
+}
+
+/* Firmware with the motor at standstill, encoder at position 0 with A and B low */
+static void TestEnc_Start(void)
+{
+  TSim_MotorCfg Cfg;
+
+  Test_BootFirmware();
+  Cfg = Sim_MotorDefault;
+  Cfg.PolePairs = BCHALL_POLE_PAIRS;
+  Sim_MotorInit(&Cfg, 60.0);
+  Sim_Run(SIM_MS(1));
+  TestEnc_lAb = 0u;
+  TestEnc_lQuad = 0;
+  TestEnc_lLag = 0;
+  TEST_ASSERT_EQ(EmoEnc_GetPos(), 0);
+}
+
+/* Synthetic slow motion with chatter and reversals */
+static void TestEnc_Rec(void)
+{
+  TestEnc_Start();
+  TestEnc_Replay(TestEnc_lRec, sizeof(TestEnc_lRec) / sizeof(TestEnc_lRec[0]));
+  Sim_Run(SIM_US(10));
+  TEST_LOG("%u synthetic changes: quadrature count %d, decoded %d ticks, largest difference %d quarters",
+           (uint32)(sizeof(TestEnc_lRec) / sizeof(TestEnc_lRec[0])), TestEnc_lQuad, EmoEnc_GetPos(), TestEnc_lLag);
+  TEST_ASSERT_EQ(TestEnc_lQuad, 8);
+  TEST_ASSERT_EQ(EmoEnc_GetPos() * TESTENC_QUARTERS, TestEnc_lQuad + TESTENC_REC_ERR);
+  TEST_ASSERT_RANGE(TestEnc_lLag, 0, TESTENC_LAG_MAX - TESTENC_REC_ERR);
+}
+
+/* Acceleration, reversal and deceleration with quadrature phase error */
+static void TestEnc_Profile(void)
+{
+  static const TTestEnc_Section Sec[] =
+  {
+    {  400,  50.0, 0.2}, { 2000, 10.0, 0.2}, { 8000,  5.0, 0.3}, { 2000, 20.0, 0.1},
+    { -800, 40.0, 0.2}, {-4000,  6.0, 0.3}, {-1200, 30.0, 0.2}, {  400, 50.0, 0.0}
+  };
+
+  TestEnc_Start();
+  TestEnc_Generate(Sec, sizeof(Sec) / sizeof(Sec[0]));
+  Sim_Run(SIM_US(10));
+  TEST_LOG("profile: quadrature count %d, decoded %d ticks, largest difference %d quarters",
+           TestEnc_lQuad, EmoEnc_GetPos(), TestEnc_lLag);
+  TEST_ASSERT_EQ(EmoEnc_GetPos() * TESTENC_QUARTERS, TestEnc_lQuad);
+  TEST_ASSERT_RANGE(TestEnc_lLag, 0, TESTENC_LAG_MAX);
+}
+
+/* No edge lost at TESTENC_RATE_RPM while the motor runs with the Hall
+ * interrupts. The edges are applied between the handlers, so this checks the
+ * counting and not the latency: the EXINT1 handler has to read channel A
+ * within a quarter line, see tools/isr_rta.csv. */
+static void TestEnc_Rate(void)
+{
+  TTestEnc_Section Sec;
+
+  TestEnc_Start();
+  Emo_SetRefSpeed(TESTENC_MOTOR_RPM);
+  TEST_ASSERT_EQ(Emo_StartMotor(), 0u);
+  Sim_Run(SIM_MS(1500));
+  TEST_ASSERT_EQ(Emo_GetMotorState(), EMO_MOTOR_STATE_RUN);
+  Sec.Quarters = 20 * 4 * (sint32)EMOENC_LINES_PER_REV;
+  Sec.Us = 60e6 / (TESTENC_RATE_RPM * 4.0 * (float64)EMOENC_LINES_PER_REV);
+  Sec.Phase = 0.2;
+  TestEnc_Generate(&Sec, 1u);
+  Sim_Run(SIM_US(10));
+  TEST_LOG("%.0f rpm, %.2f us per quarter line, motor at %.0f rpm: decoded %d of %d ticks",
+           TESTENC_RATE_RPM, Sec.Us, Sim_MotorSpeed(), EmoEnc_GetPos(), TestEnc_lQuad / TESTENC_QUARTERS);
+  TEST_ASSERT_EQ(EmoEnc_GetPos() * TESTENC_QUARTERS, TestEnc_lQuad);
+}
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+int main(int argc, char **argv)
+{
+  static const TTest_Case Cases[] =
+  {
+    {"TestEnc_Rec", TestEnc_Rec},
+    {"TestEnc_Profile", TestEnc_Profile},
+    {"TestEnc_Rate", TestEnc_Rate}
+  };
+
+  return Test_Main(Cases, sizeof(Cases) / sizeof(Cases[0]), argc, argv);
+}
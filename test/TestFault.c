@@ -0,0 +1,148 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, bridge off time of the fault handlers
+ */
+
+/* Overcurrent faults are injected at random phases of the PWM, the Hall
+ * commutation and the speed loop while the motor runs. The handlers run with
+ * Sim_InsnTiming, see TestIsr. Two figures are reported: the time from the
+ * interrupt request to the last gate switched off (Sim_BdrvOffTime) and
+ * Fault_Status.OffCyclesMax, the figure the firmware measures itself from
+ * handler entry to bridge off. The injection is seen by the firmware between
+ * handlers; a request during a handler of a lower level adds the exception
+ * entry only, BDRV has level 0. */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include "Test.h"
+#include "Emo.h"
+#include "Fault.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+/* Injected faults */
+#define TESTFAULT_NUM (40u)
+
+/* Motor speed [rpm] and spin-up time */
+#define TESTFAULT_SPEED   (3000)
+#define TESTFAULT_SPIN_UP (SIM_MS(400))
+
+/* Budget from the interrupt request to bridge off [cycles], handler entry to
+ * bridge off is FAULT_OFF_CYCLES_MAX */
+#define TESTFAULT_REQ_MAX (SIM_US(5))
+
+/*******************************************************************************
+**                      Private Variable Definitions                          **
+*******************************************************************************/
+static uint32 TestFault_lRand = 0x2545F491u;
+
+/*******************************************************************************
+**                      Private Function Definitions                          **
+*******************************************************************************/
+/* xorshift32, the same sequence on every run */
+static uint32 TestFault_Rand(void)
+{
+  TestFault_lRand ^= TestFault_lRand << 13u;
+  TestFault_lRand ^= TestFault_lRand >> 17u;
+  TestFault_lRand ^= TestFault_lRand << 5u;
+  return TestFault_lRand;
+}
+
+/* Starts the motor and waits until it runs */
+static void TestFault_Start(void)
+{
+  Fault_Clear();
+  Emo_SetRefSpeed(TESTFAULT_SPEED);
+  TEST_ASSERT_EQ(Emo_StartMotor(), 0u);
+  Sim_Run(TESTFAULT_SPIN_UP);
+  TEST_ASSERT(Emo_GetMotorState() == EMO_MOTOR_STATE_RUN);
+}
+
+/* Overcurrent of one channel at a random time, the gates go off at once and
+ * the motor stops */
+static void TestFault_GatesOff(void)
+{
+  TSim_Time Req;
+  TSim_Time Lat;
+  TSim_Time LatMax = 0u;
+  uint32 i;
+
+  Test_BootFirmware();
+  Sim_MotorInit(&Sim_MotorDefault, 60.0);
+  Sim_Run(SIM_MS(1));
+  for(i = 0u; i < TESTFAULT_NUM; i++)
+  {
+    TestFault_Start();
+    /* Random phase within a speed loop period */
+    Sim_Run(TestFault_Rand() % SIM_MS(1));
+    TEST_ASSERT(Sim_BdrvGates() != 0u);
+
+    Sim_InsnTiming(true);
+    Req = Sim_Now();
+    Sim_BdrvOvercurrent(SCUPM_BDRV_IS_LS1_OC_IS_Msk << (TestFault_Rand() % 6u));
+    Sim_Run(SIM_US(50));
+    Sim_InsnTiming(false);
+    TEST_ASSERT(Sim_BdrvGates() == 0u);
+    TEST_ASSERT(Sim_BdrvOffTime() != SIM_NEVER);
+    Lat = Sim_BdrvOffTime() - Req;
+    LatMax = (Lat > LatMax) ? Lat : LatMax;
+    TEST_ASSERT((Fault_Status.Active & FAULT_OC_Msk) != 0u);
+
+    Sim_Run(SIM_MS(5));
+    TEST_ASSERT(Emo_GetMotorState() < EMO_MOTOR_STATE_START);
+    TEST_ASSERT(Sim_BdrvGates() == 0u);
+  }
+
+  TEST_LOG("%u faults: request to bridge off max %llu cycles, handler entry to bridge off (OffCyclesMax) %u cycles",
+           TESTFAULT_NUM, (unsigned long long)LatMax, Fault_Status.OffCyclesMax);
+  TEST_ASSERT_EQ(Fault_Status.OcCtr, TESTFAULT_NUM);
+  TEST_ASSERT(Fault_Status.OffCyclesMax != 0u);
+  TEST_ASSERT(Fault_Status.OffCyclesMax <= FAULT_OFF_CYCLES_MAX);
+  TEST_ASSERT(LatMax <= TESTFAULT_REQ_MAX);
+}
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+int main(int argc, char **argv)
+{
+  static const TTest_Case Cases[] =
+  {
+    {"TestFault_GatesOff", TestFault_GatesOff}
+  };
+
+  return Test_Main(Cases, sizeof(Cases) / sizeof(Cases[0]), argc, argv);
+}
@@ -0,0 +1,240 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-18: Initial version, trigger and SPI readback of the flight recorder
+ */
+
+/* The motor runs in block commutation, the default build, until a bridge
+ * driver overcurrent or an ADC2 supply limit triggers the recorder. The
+ * frozen buffer is read back by the SPI master with SPIPROT_CMD_FREC as the
+ * host tool does: each frame requests the records answered in the next. */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include <string.h>
+#include "Test.h"
+#include "Emo.h"
+#include "EmoCcu.h"
+#include "FlightRec.h"
+#include "SpiProt.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+/* Motor speed [rpm] and spin-up time */
+#define TESTFREC_SPEED   (2000)
+#define TESTFREC_SPIN_UP (SIM_MS(400))
+
+/* SPI master: 8 MHz clock, 1 kHz frame rate */
+#define TESTFREC_WORD_TIME (SIM_US(2))
+#define TESTFREC_PERIOD    (SIM_MS(1))
+
+/* Speed of the records before the trigger, rpm of a running motor */
+#define TESTFREC_SPEED_MIN (TESTFREC_SPEED / 2)
+
+/*******************************************************************************
+**                      Private Function Definitions                          **
+*******************************************************************************/
+/* One frame of the SPI master, returns at the end of the frame period */
+static void TestFrec_Frame(const uint16 *pTx, uint16 *pRx)
+{
+  TSim_Time Start;
+
+  Start = Sim_Now();
+  Sim_SpiStart(pTx, pRx, SPIPROT_FRAME_WORDS, TESTFREC_WORD_TIME);
+  while(Sim_SpiBusy() == true)
+  {
+    Sim_Run(SIM_US(10));
+  }
+  Sim_Run(TESTFREC_PERIOD - (Sim_Now() - Start));
+}
+
+/* Boots, starts the motor in block commutation and waits until it runs */
+static void TestFrec_Start(void)
+{
+  uint16 Tx[SPIPROT_FRAME_WORDS];
+  uint16 Rx[SPIPROT_FRAME_WORDS];
+  TSpiProt_Cmd Cmd;
+
+  Test_BootFirmware();
+  Sim_MotorInit(&Sim_MotorDefault, 60.0);
+
+  /* The slave receives from its second frame on */
+  memset(&Cmd, 0, sizeof(Cmd));
+  Cmd.CmdId = SPIPROT_CMD_NONE;
+  SpiProt_EncodeCmd(Tx, &Cmd);
+  TestFrec_Frame(Tx, Rx);
+
+  TEST_ASSERT_EQ(Emo_Status.Mode, EMO_MODE_BC);
+  Emo_SetRefSpeed(TESTFREC_SPEED);
+  TEST_ASSERT_EQ(Emo_StartMotor(), 0u);
+  Sim_Run(TESTFREC_SPIN_UP);
+  TEST_ASSERT_EQ(Emo_GetMotorState(), EMO_MOTOR_STATE_RUN);
+
+  /* Recording from the PWM period interrupt of BC */
+  TEST_ASSERT_EQ(FlightRec_Status.Count, FLIGHTREC_DEPTH);
+  TEST_ASSERT_EQ(FlightRec_Status.Cause, FLIGHTREC_CAUSE_NONE);
+}
+
+/* Reads the buffer over SPI, checks the dump frames against the recorder and
+ * returns the records */
+static void TestFrec_Read(uint8 Cause, uint16 (*pRec)[FLIGHTREC_REC_WORDS])
+{
+  uint16 Tx[SPIPROT_FRAME_WORDS];
+  uint16 Rx[SPIPROT_FRAME_WORDS];
+  uint16 Words[FLIGHTREC_REC_WORDS];
+  TSpiProt_Cmd Cmd;
+  TSpiProt_Dump Dump;
+  uint32 Idx;
+  uint32 i;
+
+  memset(&Cmd, 0, sizeof(Cmd));
+  Cmd.CmdId = SPIPROT_CMD_FREC;
+  for(Idx = 0u; Idx <= FLIGHTREC_DEPTH; Idx += SPIPROT_DUMP_NUM_RECORDS)
+  {
+    /* Request of the next records, answer of the last request */
+    Cmd.Payload[0] = (uint16)Idx;
+    SpiProt_EncodeCmd(Tx, &Cmd);
+    TestFrec_Frame(Tx, Rx);
+    if(Idx == 0u)
+    {
+      continue;
+    }
+
+    TEST_ASSERT(SpiProt_DecodeDump(Rx, &Dump) == true);
+    TEST_ASSERT_EQ(Dump.Index, Idx - SPIPROT_DUMP_NUM_RECORDS);
+    TEST_ASSERT_EQ(Dump.Cause, Cause);
+    TEST_ASSERT_EQ(Dump.Frozen, 1u);
+    TEST_ASSERT_EQ(Dump.Count, FLIGHTREC_DEPTH);
+    TEST_ASSERT((Dump.Status & SPIPROT_STATUS_FREC_TRIG) != 0u);
+    for(i = 0u; i < SPIPROT_DUMP_NUM_RECORDS; i++)
+    {
+      TEST_ASSERT(FlightRec_GetRecord((uint16)(Dump.Index + i), Words) == true);
+      TEST_ASSERT(memcmp(Dump.Rec[i], Words, sizeof(Words)) == 0);
+      memcpy(pRec[Dump.Index + i], Words, sizeof(Words));
+    }
+  }
+}
+
+/* Records of the running motor before the trigger */
+static void TestFrec_CheckRun(uint16 (*pRec)[FLIGHTREC_REC_WORDS], uint32 Num)
+{
+  uint32 Ptn;
+  uint32 i;
+
+  for(i = 0u; i < Num; i++)
+  {
+    Ptn = (uint32)pRec[i][3] >> FLIGHTREC_PTN_Pos;
+    TEST_ASSERT(pRec[i][0] != 0u);
+    TEST_ASSERT((sint16)pRec[i][2] >= TESTFREC_SPEED_MIN);
+    TEST_ASSERT_RANGE(Ptn, 1u, 6u);
+    TEST_ASSERT((pRec[i][3] & FLIGHTREC_VSD_Msk) != 0u);
+  }
+}
+
+/* Overcurrent: the bridge goes off, the buffer freezes with the periods before
+ * the trigger and is read back over SPI */
+static void TestFrec_Overcurrent(void)
+{
+  static uint16 Rec[FLIGHTREC_DEPTH][FLIGHTREC_REC_WORDS];
+  uint32 Post;
+
+  TestFrec_Start();
+  /* Between two SysTicks, the stop follows in Fault_Handle */
+  Sim_Run(SIM_US(430));
+  Sim_BdrvOvercurrent(SCUPM_BDRV_IS_HS2_OC_IS_Msk);
+  Sim_Run(SIM_MS(5));
+  TEST_ASSERT(Emo_GetMotorState() < EMO_MOTOR_STATE_START);
+  TEST_ASSERT_EQ(FlightRec_Status.Cause, FLIGHTREC_CAUSE_BDRV_OC);
+  TEST_ASSERT_EQ(FlightRec_Status.Frozen, 1u);
+  TEST_ASSERT_EQ(FlightRec_Status.Count, FLIGHTREC_DEPTH);
+
+  /* Frozen by the stop, before the post-trigger records are complete */
+  Post = FLIGHTREC_POST_TRIGGER - FlightRec_Status.PostCtr;
+  TestFrec_Read(FLIGHTREC_CAUSE_BDRV_OC, Rec);
+  TestFrec_CheckRun(Rec, FLIGHTREC_DEPTH - Post);
+  TEST_LOG("%u records read, %u after the trigger, speed at the trigger %d rpm",
+           FLIGHTREC_DEPTH, Post, (sint16)Rec[FLIGHTREC_DEPTH - Post - 1u][2]);
+}
+
+/* ADC2 VSD limit: the motor keeps running, the buffer freezes after the
+ * post-trigger periods, the limit interrupts stay off until the re-arm */
+static void TestFrec_Limit(void)
+{
+  static uint16 Rec[FLIGHTREC_DEPTH][FLIGHTREC_REC_WORDS];
+  uint16 Tx[SPIPROT_FRAME_WORDS];
+  uint16 Rx[SPIPROT_FRAME_WORDS];
+  TSpiProt_Cmd Cmd;
+
+  TestFrec_Start();
+  TEST_ASSERT((SCUPM->BDRV_IRQ_CTRL.reg & SCUPM_BDRV_IRQ_CTRL_VSD_LOWTH_IE_Msk) != 0u);
+  Sim_BdrvLimit(SCUPM_BDRV_IS_VSD_LOWTH_IS_Msk);
+  Sim_Run(SIM_MS(2));
+  TEST_ASSERT_EQ(Emo_GetMotorState(), EMO_MOTOR_STATE_RUN);
+  TEST_ASSERT_EQ(FlightRec_Status.Cause, FLIGHTREC_CAUSE_ADC2);
+  TEST_ASSERT_EQ(FlightRec_Status.Frozen, 1u);
+  TEST_ASSERT_EQ(FlightRec_Status.PostCtr, 0u);
+  TEST_ASSERT((SCUPM->BDRV_IRQ_CTRL.reg & SCUPM_BDRV_IRQ_CTRL_VSD_LOWTH_IE_Msk) == 0u);
+
+  TestFrec_Read(FLIGHTREC_CAUSE_ADC2, Rec);
+  TestFrec_CheckRun(Rec, FLIGHTREC_DEPTH);
+
+  /* Re-arm after the report: recording again, limit interrupts enabled */
+  memset(&Cmd, 0, sizeof(Cmd));
+  Cmd.CmdId = SPIPROT_CMD_FREC;
+  Cmd.Payload[1] = 2u;
+  SpiProt_EncodeCmd(Tx, &Cmd);
+  TestFrec_Frame(Tx, Rx);
+  Cmd.CmdId = SPIPROT_CMD_NONE;
+  SpiProt_EncodeCmd(Tx, &Cmd);
+  TestFrec_Frame(Tx, Rx);
+  TEST_ASSERT_EQ(FlightRec_Status.Cause, FLIGHTREC_CAUSE_NONE);
+  TEST_ASSERT_EQ(FlightRec_Status.Frozen, 0u);
+  TEST_ASSERT(FlightRec_Status.Count != 0u);
+  TEST_ASSERT((SCUPM->BDRV_IRQ_CTRL.reg & SCUPM_BDRV_IRQ_CTRL_VSD_LOWTH_IE_Msk) != 0u);
+}
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+int main(int argc, char **argv)
+{
+  static const TTest_Case Cases[] =
+  {
+    {"TestFrec_Overcurrent", TestFrec_Overcurrent},
+    {"TestFrec_Limit", TestFrec_Limit}
+  };
+
+  return Test_Main(Cases, sizeof(Cases) / sizeof(Cases[0]), argc, argv);
+}
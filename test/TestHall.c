@@ -0,0 +1,226 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, block commutation with Hall sensors against the motor model
+ */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include "Test.h"
+#include "Emo.h"
+#include "EmoCcu.h"
+#include "bchall_defines.h"
+#include "ccu6_defines.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+/* Steady state band [rpm] */
+#define TESTHALL_BAND_RPM (40.0)
+
+/* Hall filter before the pattern switch: T13 period match, 256 CPU cycles per T13 tick */
+#define TESTHALL_FILTER_US ((float64)CCU6_T13PERIOD * 256.0 / (float64)SIM_CYCLES_PER_US)
+
+/*******************************************************************************
+**                      Private Type Definitions                              **
+*******************************************************************************/
+/** \brief Speed response to a reference or load step */
+typedef struct
+{
+  float64 Over;   /**< \brief Largest speed above the reference [rpm] */
+  float64 Under;  /**< \brief Largest speed below the reference [rpm] */
+  float64 Settle; /**< \brief Time from which the speed stays in the band [ms] */
+} TTestHall_Resp;
+
+/*******************************************************************************
+**                      Private Function Definitions                          **
+*******************************************************************************/
+/* Motor from standstill to the reference speed */
+static void TestHall_Start(sint16 Ref)
+{
+  TSim_MotorCfg Cfg;
+
+  Test_BootFirmware();
+  Cfg = Sim_MotorDefault;
+  Cfg.PolePairs = BCHALL_POLE_PAIRS;
+  Sim_MotorInit(&Cfg, 60.0);
+  Sim_Run(SIM_MS(1));
+  Emo_SetRefSpeed(Ref);
+  TEST_ASSERT_EQ(Emo_StartMotor(), 0u);
+}
+
+/* Speed response over Ms, sampled every ms */
+static void TestHall_Track(float64 Ref, uint32 Ms, TTestHall_Resp *pResp)
+{
+  float64 Dev;
+  uint32 t;
+
+  pResp->Over = 0.0;
+  pResp->Under = 0.0;
+  pResp->Settle = 0.0;
+  for(t = 1u; t <= Ms; t++)
+  {
+    Sim_Run(SIM_MS(1));
+    Dev = Sim_MotorSpeed() - Ref;
+    pResp->Over = (Dev > pResp->Over) ? Dev : pResp->Over;
+    pResp->Under = (-Dev > pResp->Under) ? -Dev : pResp->Under;
+    if((Dev > TESTHALL_BAND_RPM) || (Dev < -TESTHALL_BAND_RPM))
+    {
+      pResp->Settle = (float64)t;
+    }
+  }
+}
+
+/* The commutated Hall pattern follows the rotor within the Hall filter time */
+static void TestHall_Ptn(void)
+{
+  uint32 Late;
+  uint32 Miss;
+  uint32 i;
+
+  TestHall_Start(1500);
+  TEST_ASSERT_EQ(EmoCcu_GetHallPtn(), Sim_MotorHall());
+  Sim_Run(SIM_MS(1500));
+  Late = 0u;
+  Miss = 0u;
+  for(i = 0u; i < 2000u; i++)
+  {
+    Sim_Run(SIM_US(97));
+    if(EmoCcu_GetHallPtn() != Sim_MotorHall())
+    {
+      if((Sim_Now() - Sim_MotorHallEdge(NULL)) < SIM_US(2u * TESTHALL_FILTER_US))
+      {
+        Late++;
+      }
+      else
+      {
+        Miss++;
+      }
+    }
+  }
+  TEST_LOG("%u of 2000 samples within the filter time after an edge, %u wrong", Late, Miss);
+  TEST_ASSERT_EQ(Miss, 0u);
+}
+
+/* Hall edge to output pattern switch */
+static void TestHall_Latency(void)
+{
+  TSim_Time Edge;
+  float64 Lat;
+  float64 Min;
+  float64 Max;
+  float64 Sum;
+  uint32 Num;
+  uint32 Edges;
+  uint32 Prev;
+
+  TestHall_Start(2000);
+  Sim_Run(SIM_MS(1500));
+  (void)Sim_MotorHallEdge(&Prev);
+  Min = 1e9;
+  Max = 0.0;
+  Sum = 0.0;
+  Num = 0u;
+  while(Num < 200u)
+  {
+    Sim_Run(SIM_US(100));
+    Edge = Sim_MotorHallEdge(&Edges);
+    if(Edges != Prev)
+    {
+      TEST_ASSERT_EQ(Edges, Prev + 1u);
+      Prev = Edges;
+      while((Sim_Ccu6PatternTime() < Edge) && ((Sim_Now() - Edge) < SIM_US(500)))
+      {
+        Sim_Run(SIM_US(1));
+      }
+      Lat = (float64)(Sim_Ccu6PatternTime() - Edge) / SIM_CYCLES_PER_US;
+      Min = (Lat < Min) ? Lat : Min;
+      Max = (Lat > Max) ? Lat : Max;
+      Sum += Lat;
+      Num++;
+    }
+  }
+  TEST_LOG("commutation latency %.1f..%.1f us, mean %.1f us at %.0f rpm", Min, Max, Sum / Num, Sim_MotorSpeed());
+  TEST_ASSERT_RANGE(Min, TESTHALL_FILTER_US, TESTHALL_FILTER_US + 1.0);
+  TEST_ASSERT_RANGE(Max, TESTHALL_FILTER_US, TESTHALL_FILTER_US + 1.0);
+}
+
+/* Speed PI: step of the reference */
+static void TestHall_SpeedStep(void)
+{
+  TTestHall_Resp Resp;
+
+  TestHall_Start(1000);
+  TestHall_Track(1000.0, 2500u, &Resp);
+  TEST_LOG("start to 1000 rpm: overshoot %.0f rpm, settled after %.0f ms", Resp.Over, Resp.Settle);
+  TEST_ASSERT_RANGE(Resp.Over, 0.0, TESTHALL_BAND_RPM);
+  TEST_ASSERT_RANGE(Resp.Settle, 1.0, 2000.0);
+  Emo_SetRefSpeed(2000);
+  TestHall_Track(2000.0, 2500u, &Resp);
+  TEST_LOG("step 1000 to 2000 rpm: overshoot %.0f rpm, settled after %.0f ms", Resp.Over, Resp.Settle);
+  TEST_ASSERT_RANGE(Resp.Over, 0.0, TESTHALL_BAND_RPM);
+  TEST_ASSERT_RANGE(Resp.Settle, 1.0, 2000.0);
+  TEST_ASSERT_RANGE(Sim_MotorSpeed(), 2000.0 - TESTHALL_BAND_RPM, 2000.0 + TESTHALL_BAND_RPM);
+}
+
+/* Speed PI: load torque step */
+static void TestHall_LoadStep(void)
+{
+  TTestHall_Resp Resp;
+
+  TestHall_Start(2000);
+  TestHall_Track(2000.0, 2500u, &Resp);
+  Sim_MotorSetLoad(0.005);
+  TestHall_Track(2000.0, 2500u, &Resp);
+  TEST_LOG("load step 5 mNm at 2000 rpm: dip %.0f rpm, settled after %.0f ms", Resp.Under, Resp.Settle);
+  TEST_ASSERT_RANGE(Resp.Under, TESTHALL_BAND_RPM, 200.0);
+  TEST_ASSERT_RANGE(Resp.Settle, 1.0, 1000.0);
+  TEST_ASSERT_RANGE(Sim_MotorSpeed(), 2000.0 - TESTHALL_BAND_RPM, 2000.0 + TESTHALL_BAND_RPM);
+}
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+int main(int argc, char **argv)
+{
+  static const TTest_Case Cases[] =
+  {
+    {"TestHall_Ptn", TestHall_Ptn},
+    {"TestHall_Latency", TestHall_Latency},
+    {"TestHall_SpeedStep", TestHall_SpeedStep},
+    {"TestHall_LoadStep", TestHall_LoadStep}
+  };
+
+  return Test_Main(Cases, sizeof(Cases) / sizeof(Cases[0]), argc, argv);
+}
@@ -0,0 +1,255 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, Hall sector calibration
+ */
+
+/* The Hall sensors of the simulated motor are skewed by up to 4 degrees. The
+ * motor is started, then the rotor is locked and turned by the test in random
+ * steps of 5..15 us (edge jitter). At every Hall event the sector speed of
+ * the handler (AngleInc, before the low pass) and the entry angle (HallAngle)
+ * are compared with the true speed and the rotor angle at the sensor edge. The common offset of all
+ * edges is not visible in the timing, the angle error is taken about its
+ * mean. The calibration learns over 64 electrical revolutions. */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include <math.h>
+#include "Test.h"
+#include "Emo.h"
+#include "EmoCcu.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+/* Hall sector speed from the angle increment per PWM period, as in EmoCcu.c */
+#define TESTCAL_ANGLE_INC_FAC ((65536.0 * 65536.0 * (float64)BCHALL_POLE_PAIRS) / (60.0 * (float64)BCHALL_PWM_FREQ))
+
+/* Rotor steps [us] */
+#define TESTCAL_STEP_MIN_US (5u)
+#define TESTCAL_STEP_MAX_US (15u)
+
+/* Electrical revolutions of the learning and of a measurement */
+#define TESTCAL_REVS (64u)
+#define TESTCAL_MEAS_REVS (16u)
+
+/* Residual after the calibration: sector speed ripple [share of the speed],
+ * edge angle [degrees] */
+#define TESTCAL_RIPPLE_MAX (0.005)
+#define TESTCAL_ANGLE_MAX  (0.5)
+
+/*******************************************************************************
+**                      Private Type Definitions                              **
+*******************************************************************************/
+/** \brief Errors at the Hall edges */
+typedef struct
+{
+  float64 SpeedSq;  /**< \brief Sum of the squared sector speed errors [rpm^2] */
+  float64 Angle;    /**< \brief Sum of the entry angle errors [degrees] */
+  float64 AngleSq;  /**< \brief Sum of the squared entry angle errors [degrees^2] */
+  uint32 Num;       /**< \brief Hall edges */
+} TTestCal_Meas;
+
+/*******************************************************************************
+**                      Private Variable Definitions                          **
+*******************************************************************************/
+static uint32 TestCal_lRand = 0x2545F491u;
+
+/* Angle of the turned rotor [degrees electrical], not wrapped */
+static float64 TestCal_lAngle;
+
+/*******************************************************************************
+**                      Private Function Definitions                          **
+*******************************************************************************/
+/* xorshift32, the same sequence on every run */
+static uint32 TestCal_Rand(void)
+{
+  TestCal_lRand ^= TestCal_lRand << 13u;
+  TestCal_lRand ^= TestCal_lRand >> 17u;
+  TestCal_lRand ^= TestCal_lRand << 5u;
+  return TestCal_lRand;
+}
+
+static float64 TestCal_SpeedRms(const TTestCal_Meas *pMeas)
+{
+  return sqrt(pMeas->SpeedSq / (float64)pMeas->Num);
+}
+
+static float64 TestCal_AngleRms(const TTestCal_Meas *pMeas)
+{
+  float64 Mean;
+
+  Mean = pMeas->Angle / (float64)pMeas->Num;
+  return sqrt((pMeas->AngleSq / (float64)pMeas->Num) - (Mean * Mean));
+}
+
+/* Motor with skewed Hall sensors started, rotor locked */
+static void TestCal_Start(float64 Speed)
+{
+  static const float64 Skew[6] = {0.0, 3.0, -2.0, 4.0, -3.0, 1.0};
+  TSim_MotorCfg Cfg;
+  uint32 i;
+
+  Test_BootFirmware();
+  Cfg = Sim_MotorDefault;
+  Cfg.PolePairs = BCHALL_POLE_PAIRS;
+  for(i = 0u; i < 6u; i++)
+  {
+    Cfg.HallErr[i] = Skew[i];
+  }
+  Sim_MotorInit(&Cfg, 60.0);
+  Sim_Run(SIM_MS(1));
+  Emo_SetRefSpeed((sint16)Speed);
+  TEST_ASSERT_EQ(Emo_StartMotor(), 0u);
+  Sim_Run(SIM_MS(1000));
+  TEST_ASSERT(Emo_GetMotorState() == EMO_MOTOR_STATE_RUN);
+  Sim_MotorLock(true);
+  TestCal_lAngle = Sim_MotorAngle();
+}
+
+/* Turns the rotor for Revs electrical revolutions from speed From to To
+ * [rpm], the errors at the Hall events go into pMeas (NULL: not measured).
+ * The event follows the sensor edge after the Hall filter time, its entry
+ * angle is compared with the rotor angle at the edge. */
+static void TestCal_Turn(float64 From, float64 To, uint32 Revs, TTestCal_Meas *pMeas)
+{
+  const float64 End = TestCal_lAngle + (360.0 * (float64)Revs);
+  const float64 Begin = TestCal_lAngle;
+  TSim_Time Step;
+  float64 Speed;
+  float64 EdgeAngle;
+  float64 Err;
+  uint32 EventTime;
+  uint32 Edges;
+  uint32 Prev;
+
+  (void)Sim_MotorHallEdge(&Prev);
+  EdgeAngle = Sim_MotorAngle();
+  EventTime = EmoCcu_HallStatus.EventTime;
+  while(TestCal_lAngle < End)
+  {
+    Speed = From + (((To - From) * (TestCal_lAngle - Begin)) / (End - Begin));
+    Step = SIM_US(TESTCAL_STEP_MIN_US + (TestCal_Rand() % (TESTCAL_STEP_MAX_US - TESTCAL_STEP_MIN_US + 1u)));
+    TestCal_lAngle += (Speed * (float64)BCHALL_POLE_PAIRS * 6.0 * (float64)Step) / (float64)SIM_US(1000000);
+    Sim_MotorSetAngle(TestCal_lAngle);
+    (void)Sim_MotorHallEdge(&Edges);
+    if(Edges != Prev)
+    {
+      EdgeAngle = Sim_MotorAngle();
+      Prev = Edges;
+    }
+    Sim_Run(Step);
+    if((EmoCcu_HallStatus.EventTime != EventTime) && (pMeas != NULL))
+    {
+      Err = ((float64)EmoCcu_HallStatus.AngleInc / TESTCAL_ANGLE_INC_FAC) - Speed;
+      pMeas->SpeedSq += Err * Err;
+      Err = ((float64)EmoCcu_HallStatus.HallAngle * (360.0 / 65536.0)) - EdgeAngle;
+      Err = fmod(Err + 540.0, 360.0) - 180.0;
+      pMeas->Angle += Err;
+      pMeas->AngleSq += Err * Err;
+      pMeas->Num++;
+    }
+    EventTime = EmoCcu_HallStatus.EventTime;
+  }
+}
+
+/* Sector speed ripple and edge angle before and after the calibration */
+static void TestCal_Learn(float64 Speed)
+{
+  TTestCal_Meas Before = {0};
+  TTestCal_Meas After = {0};
+  uint32 i;
+
+  TestCal_Start(Speed);
+  TestCal_Turn(Speed, Speed, TESTCAL_MEAS_REVS, NULL);
+  TestCal_Turn(Speed, Speed, TESTCAL_MEAS_REVS, &Before);
+
+  EmoCcu_StartHallCal();
+  TestCal_Turn(Speed, Speed, TESTCAL_REVS + 1u, NULL);
+  TEST_ASSERT_EQ(EmoCcu_GetHallCalState(), EMOCCU_HALLCAL_DONE);
+  TestCal_Turn(Speed, Speed, TESTCAL_MEAS_REVS, &After);
+
+  TEST_LOG("%.0f rpm: sector speed ripple rms %.1f -> %.1f rpm, edge angle rms %.2f -> %.2f deg", Speed,
+           TestCal_SpeedRms(&Before), TestCal_SpeedRms(&After), TestCal_AngleRms(&Before), TestCal_AngleRms(&After));
+  for(i = 1u; i <= 6u; i++)
+  {
+    TEST_LOG("  pattern %u: width %.2f deg", i,
+             ((float64)EmoCcu_HallCal.SpeedGain[i] * 60.0) / (float64)EMOCCU_HALLCAL_GAIN_ONE);
+  }
+  TEST_ASSERT(TestCal_SpeedRms(&After) < (TESTCAL_RIPPLE_MAX * Speed));
+  TEST_ASSERT(TestCal_SpeedRms(&After) < (TestCal_SpeedRms(&Before) / 5.0));
+  TEST_ASSERT(TestCal_AngleRms(&After) < TESTCAL_ANGLE_MAX);
+}
+
+static void TestCal_Learn1000(void)
+{
+  TestCal_Learn(1000.0);
+}
+
+static void TestCal_Learn3000(void)
+{
+  TestCal_Learn(3000.0);
+}
+
+/* A ramp during the learning is rejected, the table stays ideal */
+static void TestCal_Ramp(void)
+{
+  uint32 i;
+
+  TestCal_Start(1000.0);
+  TestCal_Turn(1000.0, 1000.0, TESTCAL_MEAS_REVS, NULL);
+  EmoCcu_StartHallCal();
+  TestCal_Turn(1000.0, 1400.0, TESTCAL_REVS + 1u, NULL);
+  Sim_Run(SIM_MS(2));
+  TEST_ASSERT_EQ(EmoCcu_GetHallCalState(), EMOCCU_HALLCAL_FAIL);
+  for(i = 1u; i <= 6u; i++)
+  {
+    TEST_ASSERT_EQ(EmoCcu_HallCal.SpeedGain[i], EMOCCU_HALLCAL_GAIN_ONE);
+  }
+}
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+int main(int argc, char **argv)
+{
+  static const TTest_Case Cases[] =
+  {
+    {"TestCal_Learn1000", TestCal_Learn1000},
+    {"TestCal_Learn3000", TestCal_Learn3000},
+    {"TestCal_Ramp", TestCal_Ramp}
+  };
+
+  return Test_Main(Cases, sizeof(Cases) / sizeof(Cases[0]), argc, argv);
+}
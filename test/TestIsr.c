@@ -0,0 +1,262 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, handler run time statistics under motor, SPI and Neopixel load
+ * V0.1.1: 2026-10-18: Budget of the SPI chip select and its sample latch
+ * V0.1.2: 2026-10-18: FOC start from standstill and its PWM period budget
+ * V0.1.3: 2026-10-18: Sine commutation start and its PWM period budget
+ */
+
+/* The firmware is built with ISR_PROF_EN = 1 and runs the motor at speed with
+ * SPI frames at 1 kHz and Neopixel writes every 10 ms. The statistics are read
+ * back from IsrProf like the SPIPROT_CMD_PROF readout on the device.
+ * The modes with per-PWM-period control start from standstill in a second
+ * run each and are measured at the speed reference.
+ *
+ * The handlers run with Sim_InsnTiming: one cycle per instruction on top of
+ * the peripheral accesses and the interrupt entry. The instructions are those
+ * of the host build (x86-64, -O2), the cycles are an estimate of the Thumb-2
+ * build without flash wait states; the device figures come from the same
+ * statistics over SPI. */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+/* Statistics are declared for the profiled build only */
+#define ISR_PROF_EN (1)
+
+#include "Test.h"
+#include "Main.h"
+#include "Emo.h"
+#include "IsrProf.h"
+#include "Neopx.h"
+#include "SpiProt.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+/* SPI master as in TestSim: 8 MHz clock, 1 kHz frame rate */
+#define TESTISR_SPI_WORD_TIME (SIM_US(2))
+#define TESTISR_SPI_PERIOD    (SIM_MS(1))
+
+/* Measurement window [ms], one SPI frame per ms */
+#define TESTISR_WINDOW_MS (200u)
+
+/* Neopixel write period [ms] */
+#define TESTISR_NEOPX_MS (10u)
+
+/* Budgets of the longest run [CPU cycles]: Hall ISR 10 us, speed loop 50 us,
+ * SPI chip select 2 us */
+#define TESTISR_HALL_MAX    (400u)
+#define TESTISR_SYSTICK_MAX (2000u)
+#define TESTISR_EXINT2_MAX  (80u)
+
+/* Budget of the CCU6 SR0 handler with per-PWM-period control [CPU cycles]:
+ * half of the 50 us period at 20 kHz */
+#define TESTISR_PWM_MAX (1000u)
+#define TESTISR_PWM_PER_MS (20u)
+
+/* Speed reference of the modes with per-PWM-period control [rpm], spin-up
+ * time and the tolerance of the mean speed */
+#define TESTISR_MODE_SPEED   (2000)
+#define TESTISR_MODE_SPIN_UP (SIM_MS(3000))
+#define TESTISR_MODE_TOL     (100)
+
+/* Budget of the sample latch in the chip select [CPU cycles], 500 ns */
+#define TESTISR_LATCH_MAX (20u)
+
+/*******************************************************************************
+**                      Private Function Definitions                          **
+*******************************************************************************/
+/* One frame of the SPI master, returns at the end of the frame period */
+static void TestIsr_SpiFrame(const uint16 *pTx, uint16 *pRx)
+{
+  TSim_Time Start;
+
+  Start = Sim_Now();
+  Sim_SpiStart(pTx, pRx, SPIPROT_FRAME_WORDS, TESTISR_SPI_WORD_TIME);
+  while(Sim_SpiBusy() == true)
+  {
+    Sim_Run(SIM_US(10));
+  }
+  Sim_Run(TESTISR_SPI_PERIOD - (Sim_Now() - Start));
+}
+
+/* Empty call, the overhead of Sim_InsnMeasure */
+static void TestIsr_None(void)
+{
+}
+
+/* Logs the statistics of one handler, returns the runs */
+static uint32 TestIsr_Report(const char *pName, uint32 Id, uint32 Budget)
+{
+  TIsrProf_Isr Isr;
+  uint32 Mean;
+
+  TEST_ASSERT(IsrProf_Get(Id, &Isr) == true);
+  Mean = (Isr.Count != 0u) ? (Isr.Sum / Isr.Count) : 0u;
+  TEST_LOG("%-8s %6u runs (%6.0f/s), cycles min %4u max %4u mean %4u, load %.3f%%", pName, Isr.Count,
+           (float64)Isr.Count * 1000.0 / (float64)TESTISR_WINDOW_MS, (Isr.Count != 0u) ? Isr.Min : 0u, Isr.Max, Mean,
+           (float64)Isr.Sum * 100.0 / ((float64)TESTISR_WINDOW_MS * (float64)SIM_MS(1)));
+  if(Isr.Count != 0u)
+  {
+    TEST_ASSERT(Isr.Min <= Isr.Max);
+    TEST_ASSERT_RANGE(Mean, Isr.Min, Isr.Max);
+    TEST_ASSERT(Isr.Max <= Budget);
+  }
+  return Isr.Count;
+}
+
+/* Hall ISR (CCU6 SR0), SysTick speed loop, SPI chip select (EXINT2 on the
+ * UART2 node) and Neopixel bit timing (GPT12E T4 on GPT1) */
+static void TestIsr_Load(void)
+{
+  static const uint8 Rgb[3] = {0x10u, 0x80u, 0xF0u};
+  uint16 Tx[SPIPROT_FRAME_WORDS];
+  uint16 Rx[SPIPROT_FRAME_WORDS];
+  TSpiProt_Cmd Cmd = {0};
+  uint32 Edges;
+  uint32 Prev;
+  uint32 Hall;
+  uint32 Insns;
+  uint32 Cycles;
+  TSim_Time Start;
+  uint32 i;
+
+  Test_BootFirmware();
+  TEST_ASSERT(IsrProf_ClockOk == true);
+  Sim_MotorInit(&Sim_MotorDefault, 60.0);
+  Sim_Run(SIM_MS(1));
+  Emo_SetRefSpeed(4000);
+  TEST_ASSERT_EQ(Emo_StartMotor(), 0u);
+  Sim_Run(SIM_MS(1500));
+
+  Cmd.CmdId = SPIPROT_CMD_NONE;
+  SpiProt_EncodeCmd(Tx, &Cmd);
+  Sim_InsnTiming(true);
+  IsrProf_Reset(ISR_PROF_NUM);
+  (void)Sim_MotorHallEdge(&Prev);
+  for(i = 0u; i < TESTISR_WINDOW_MS; i++)
+  {
+    if((i % TESTISR_NEOPX_MS) == 0u)
+    {
+      (void)Neopx_Write(Rgb, 1u);
+    }
+    TestIsr_SpiFrame(Tx, Rx);
+  }
+  (void)Sim_MotorHallEdge(&Edges);
+
+  TEST_LOG("rotor %.0f rpm, %u Hall edges in %u ms", Sim_MotorSpeed(), Edges - Prev, TESTISR_WINDOW_MS);
+  TEST_LOG("%llu handler instructions", (unsigned long long)Sim_InsnCount());
+  Hall = TestIsr_Report("CCU6SR0", ISR_PROF_ID_CCU6SR0, TESTISR_HALL_MAX);
+  TEST_ASSERT(Hall >= (Edges - Prev));
+  TEST_ASSERT_RANGE(TestIsr_Report("SysTick", ISR_PROF_ID_SYSTICK, TESTISR_SYSTICK_MAX),
+                    TESTISR_WINDOW_MS - 1u, TESTISR_WINDOW_MS + 1u);
+  TEST_ASSERT(TestIsr_Report("EXINT2", ISR_PROF_ID_UART2, TESTISR_EXINT2_MAX) >= TESTISR_WINDOW_MS);
+  TEST_ASSERT(TestIsr_Report("GPT1 T4", ISR_PROF_ID_GPT1, 0xFFFFu) >= ((TESTISR_WINDOW_MS / TESTISR_NEOPX_MS) * 24u));
+  (void)TestIsr_Report("DMA", ISR_PROF_ID_DMA, 0xFFFFu);
+  Sim_InsnTiming(false);
+
+  /* Latch alone: instructions and peripheral accesses, net of the call */
+  Start = Sim_Now();
+  Insns = (uint32)Sim_InsnMeasure(SPI_slave_latch);
+  Cycles = (uint32)(Sim_Now() - Start);
+  Start = Sim_Now();
+  Insns -= (uint32)Sim_InsnMeasure(TestIsr_None);
+  Cycles -= (uint32)(Sim_Now() - Start);
+  TEST_LOG("chip select latch: %u instructions, %u cycles (%.0f ns)", Insns, Cycles,
+           (float64)Cycles * 1000.0 / (float64)SIM_CYCLES_PER_US);
+  TEST_ASSERT(Cycles <= TESTISR_LATCH_MAX);
+}
+
+/* Motor started from standstill in Mode reaches the speed reference, the CCU6
+ * SR0 handler runs every PWM period within TESTISR_PWM_MAX */
+static void TestIsr_Mode(uint8 Mode, const char *pName)
+{
+  TIsrProf_Isr Isr;
+  uint32 Edges;
+  uint32 Prev;
+  float64 Speed;
+
+  Test_BootFirmware();
+  Sim_MotorInit(&Sim_MotorDefault, 60.0);
+  Sim_Run(SIM_MS(1));
+  Emo_SetMode(Mode);
+  Emo_SetRefSpeed(TESTISR_MODE_SPEED);
+  TEST_ASSERT_EQ(Emo_StartMotor(), 0u);
+  Sim_Run(TESTISR_MODE_SPIN_UP);
+  TEST_ASSERT_EQ(Emo_GetMotorState(), EMO_MOTOR_STATE_RUN);
+
+  Sim_InsnTiming(true);
+  IsrProf_Reset(ISR_PROF_NUM);
+  (void)Sim_MotorHallEdge(&Prev);
+  Sim_Run(SIM_MS(TESTISR_WINDOW_MS));
+  (void)Sim_MotorHallEdge(&Edges);
+  Sim_InsnTiming(false);
+
+  /* Six Hall edges per electrical revolution */
+  Speed = (float64)(Edges - Prev) * 60000.0 / ((float64)TESTISR_WINDOW_MS * 6.0 * (float64)Sim_MotorDefault.PolePairs);
+  TEST_LOG("%s: rotor %.0f rpm, mean of the window %.0f rpm, reference %d rpm", pName, Sim_MotorSpeed(), Speed,
+           TESTISR_MODE_SPEED);
+  TEST_ASSERT_RANGE(Speed, (float64)(TESTISR_MODE_SPEED - TESTISR_MODE_TOL), (float64)(TESTISR_MODE_SPEED + TESTISR_MODE_TOL));
+
+  /* One run per PWM period at least, the Hall events on top */
+  TEST_ASSERT(IsrProf_Get(ISR_PROF_ID_CCU6SR0, &Isr) == true);
+  TEST_ASSERT(Isr.Count >= (TESTISR_WINDOW_MS * TESTISR_PWM_PER_MS));
+  (void)TestIsr_Report("CCU6SR0", ISR_PROF_ID_CCU6SR0, TESTISR_PWM_MAX);
+}
+
+static void TestIsr_Foc(void)
+{
+  TestIsr_Mode(EMO_MODE_FOC, "FOC");
+}
+
+static void TestIsr_Sine(void)
+{
+  TestIsr_Mode(EMO_MODE_SINE, "Sine");
+}
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+int main(int argc, char **argv)
+{
+  static const TTest_Case Cases[] =
+  {
+    {"TestIsr_Load", TestIsr_Load},
+    {"TestIsr_Foc", TestIsr_Foc},
+    {"TestIsr_Sine", TestIsr_Sine}
+  };
+
+  return Test_Main(Cases, sizeof(Cases) / sizeof(Cases[0]), argc, argv);
+}
@@ -0,0 +1,293 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, WS2812 timing of the SSC1 + DMA backend
+ */
+
+/* The firmware is built with the SSC1 backend for a chain of 4 LEDs (fw_npx).
+ * A frame is written and streamed by the GPT12E and DMA models; the line
+ * level is then computed from the SSC words of the frame, the SSC1 bit time
+ * and the T3 period as programmed, and decoded like a WS2812 does. */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+/* Backend as in the fw_npx build */
+#define NEOPX_SSC_EN (1u)
+#define NEOPX_NUM_LEDS (4u)
+
+#include <string.h>
+#include "Test.h"
+#include "Neopx.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+/* WS2812 bit timing [ns]: high times of the datasheet (350/700 ns +-150 ns),
+ * low time from 450 ns up to 5 us before the LEDs take it for the latch */
+#define TESTNPX_T0H_MIN (200.0)
+#define TESTNPX_T0H_MAX (500.0)
+#define TESTNPX_T1H_MIN (550.0)
+#define TESTNPX_T1H_MAX (850.0)
+#define TESTNPX_TL_MIN  (450.0)
+#define TESTNPX_TL_MAX  (5000.0)
+
+/* Time for the completion interrupt to stop T3 after the last word [us] */
+#define TESTNPX_STOP_US (5u)
+
+/* SSC bits per word */
+#define TESTNPX_WORD_BITS (16u)
+
+/* Timeout of a frame, 6 SSC words per LED at twice the 5 us pacing [us] */
+#define TESTNPX_FRAME_US (NEOPX_NUM_LEDS * 6u * 10u)
+
+/*******************************************************************************
+**                      Private Type Definitions                              **
+*******************************************************************************/
+/** \brief Decoded WS2812 bit stream */
+typedef struct
+{
+  uint8 Data[NEOPX_NUM_LEDS * 3u];  /**< \brief Bytes in line order (GRB) */
+  uint32 Bits;                      /**< \brief Decoded bits */
+  float64 HighMin[2];               /**< \brief Shortest high time of 0 and 1 [ns] */
+  float64 HighMax[2];               /**< \brief Longest high time of 0 and 1 [ns] */
+  float64 LowMin;                   /**< \brief Shortest low time [ns] */
+  float64 LowMax;                   /**< \brief Longest low time, without the last bit [ns] */
+  float64 ExtMin;                   /**< \brief Shortest low time of every 4th bit minus its nibble pattern [ns] */
+} TTestNpx_Stream;
+
+/*******************************************************************************
+**                      Private Constant Definitions                          **
+*******************************************************************************/
+/* GPT1 prescaler by T3CON BPS1 */
+static const uint32 TestNpx_lBps1[4] = {8u, 4u, 32u, 16u};
+
+/*******************************************************************************
+**                      Private Function Definitions                          **
+*******************************************************************************/
+/* Writes a frame of NEOPX_NUM_LEDS and returns the SSC words in pWords and
+ * the word period [ns] of the T3 pacing */
+static float64 TestNpx_Frame(const uint8 *pRgb, uint16 *pWords)
+{
+  const volatile TDMA_Entry *pEntry;
+  const uint16 *pSrc;
+  TSim_Time Start;
+  float64 Period;
+  uint32 Num;
+  uint32 i;
+
+  /* Boot frame done */
+  Start = Sim_Now();
+  while(Neopx_Write(pRgb, (uint8)NEOPX_NUM_LEDS) == false)
+  {
+    TEST_ASSERT(Sim_Now() < (Start + SIM_MS(1)));
+    Sim_Run(SIM_US(1));
+  }
+
+  /* Words as set up for DMA channel 12, source end pointer at the last word */
+  pEntry = (const volatile TDMA_Entry *)(DMA_BASE_ADDR + (DMA_CH12 * sizeof(TDMA_Entry)));
+  Num = NEOPX_NUM_LEDS * 6u;
+  pSrc = (const uint16 *)(uintptr_t)pEntry->Src_End_Ptr - (Num - 1u);
+  TEST_ASSERT_EQ(pEntry->Dst_End_Ptr, (uint32)&SSC1->TB.reg);
+  for(i = 0u; i < Num; i++)
+  {
+    pWords[i] = pSrc[i];
+  }
+
+  /* T3 underflows every T2 + 1 ticks of the GPT1 prescaler */
+  Period = ((float64)GPT12E->T2.reg + 1.0) * (float64)TestNpx_lBps1[(GPT12E->T3CON.reg & GPT12E_T3CON_BPS1_Msk) >> GPT12E_T3CON_BPS1_Pos] *
+           (float64)(1u << (GPT12E->T3CON.reg & GPT12E_T3CON_T3I_Msk)) * (1e9 / (float64)SIM_FSYS_HZ);
+
+  /* Last word after Num periods, then the completion interrupt stops T3 */
+  Start = Sim_Now();
+  while((GPT12E->T3CON.reg & GPT12E_T3CON_T3R_Msk) != 0u)
+  {
+    TEST_ASSERT(Sim_Now() < (Start + SIM_US(TESTNPX_FRAME_US)));
+    Sim_Run(SIM_US(1));
+  }
+  TEST_ASSERT_RANGE((float64)(Sim_Now() - Start) * (1e9 / (float64)SIM_FSYS_HZ), (float64)Num * Period,
+                    ((float64)Num * Period) + (TESTNPX_STOP_US * 1000.0));
+  return Period;
+}
+
+/* Decodes the line level of the SSC words as the LEDs see it: MSB first at
+ * the SSC1 bit time, the line stays low between the words */
+static void TestNpx_Decode(const uint16 *pWords, uint32 Num, float64 Period, TTestNpx_Stream *pStr)
+{
+  float64 BitNs;
+  float64 High;
+  float64 Low;
+  uint32 Bit;
+  uint32 Val;
+  uint32 w;
+  uint32 b;
+  bool Last;
+
+  BitNs = (2.0 * ((float64)SSC1->BR.reg + 1.0) * 1e9) / (float64)SIM_FSYS_HZ;
+  memset(pStr, 0, sizeof(*pStr));
+  pStr->HighMin[0] = pStr->HighMin[1] = pStr->LowMin = pStr->ExtMin = 1e9;
+  High = 0.0;
+  Low = 0.0;
+  Last = false;
+  for(w = 0u; w < Num; w++)
+  {
+    for(b = 0u; b <= TESTNPX_WORD_BITS; b++)
+    {
+      /* Rising edge or end of the frame: a bit is complete */
+      Bit = (b < TESTNPX_WORD_BITS) ? ((pWords[w] >> (TESTNPX_WORD_BITS - 1u - b)) & 1u) : 0u;
+      if(((Bit != 0u) && (Last == false) && (High > 0.0)) || ((w == (Num - 1u)) && (b == TESTNPX_WORD_BITS)))
+      {
+        Val = (High > (TESTNPX_T0H_MAX + TESTNPX_T1H_MIN) / 2.0) ? 1u : 0u;
+        pStr->HighMin[Val] = (High < pStr->HighMin[Val]) ? High : pStr->HighMin[Val];
+        pStr->HighMax[Val] = (High > pStr->HighMax[Val]) ? High : pStr->HighMax[Val];
+        if((w < (Num - 1u)) || (b < TESTNPX_WORD_BITS))
+        {
+          pStr->LowMin = (Low < pStr->LowMin) ? Low : pStr->LowMin;
+          pStr->LowMax = (Low > pStr->LowMax) ? Low : pStr->LowMax;
+          /* Low time of the 4th bit of a nibble beyond its 1000b/1100b pattern */
+          if((pStr->Bits % 4u) == 3u)
+          {
+            Low -= (Val != 0u) ? (2.0 * BitNs) : (3.0 * BitNs);
+            pStr->ExtMin = (Low < pStr->ExtMin) ? Low : pStr->ExtMin;
+          }
+        }
+        pStr->Data[pStr->Bits / 8u] |= (uint8)(Val << (7u - (pStr->Bits % 8u)));
+        pStr->Bits++;
+        High = 0.0;
+        Low = 0.0;
+      }
+      if(b == TESTNPX_WORD_BITS)
+      {
+        /* Line low from the end of the word to the next T3 underflow */
+        Low += Period - ((float64)TESTNPX_WORD_BITS * BitNs);
+        Last = false;
+      }
+      else if(Bit != 0u)
+      {
+        High += BitNs;
+        Last = true;
+      }
+      else
+      {
+        Low += BitNs;
+        Last = false;
+      }
+    }
+  }
+}
+
+/* Checks a frame: data in GRB order, high and low times within the WS2812
+ * limits, the pacing difference only in the low time of every 4th bit */
+static void TestNpx_Check(const uint8 *pRgb)
+{
+  static uint16 Words[NEOPX_NUM_LEDS * 6u];
+  TTestNpx_Stream Str;
+  float64 Period;
+  uint32 i;
+
+  Period = TestNpx_Frame(pRgb, Words);
+  TestNpx_Decode(Words, NEOPX_NUM_LEDS * 6u, Period, &Str);
+  for(i = 0u; i < 2u; i++)
+  {
+    /* No bit of this value in the frame */
+    Str.HighMin[i] = (Str.HighMax[i] > 0.0) ? Str.HighMin[i] : 0.0;
+  }
+  TEST_LOG("word period %.0f ns: T0H %.0f..%.0f ns, T1H %.0f..%.0f ns, low %.0f..%.0f ns, every 4th bit +%.0f ns",
+           Period, Str.HighMin[0], Str.HighMax[0], Str.HighMin[1], Str.HighMax[1], Str.LowMin, Str.LowMax, Str.ExtMin);
+  TEST_ASSERT_EQ(Str.Bits, NEOPX_NUM_LEDS * 24u);
+  for(i = 0u; i < NEOPX_NUM_LEDS; i++)
+  {
+    TEST_ASSERT_EQ(Str.Data[(3u * i) + 0u], pRgb[(3u * i) + 1u]);
+    TEST_ASSERT_EQ(Str.Data[(3u * i) + 1u], pRgb[(3u * i) + 0u]);
+    TEST_ASSERT_EQ(Str.Data[(3u * i) + 2u], pRgb[(3u * i) + 2u]);
+  }
+  if(Str.HighMax[0] > 0.0)
+  {
+    TEST_ASSERT_RANGE(Str.HighMin[0], TESTNPX_T0H_MIN, TESTNPX_T0H_MAX);
+    TEST_ASSERT_RANGE(Str.HighMax[0], TESTNPX_T0H_MIN, TESTNPX_T0H_MAX);
+  }
+  if(Str.HighMax[1] > 0.0)
+  {
+    TEST_ASSERT_RANGE(Str.HighMin[1], TESTNPX_T1H_MIN, TESTNPX_T1H_MAX);
+    TEST_ASSERT_RANGE(Str.HighMax[1], TESTNPX_T1H_MIN, TESTNPX_T1H_MAX);
+  }
+  TEST_ASSERT_RANGE(Str.LowMin, TESTNPX_TL_MIN, TESTNPX_TL_MAX);
+  TEST_ASSERT_RANGE(Str.LowMax, TESTNPX_TL_MIN, TESTNPX_TL_MAX);
+  /* 5.0 us pacing against 4.8 us per word */
+  TEST_ASSERT_RANGE(Str.ExtMin, 150.0, 250.0);
+}
+
+/* All nibble patterns, both orders of the color bytes */
+static void TestNpx_Patterns(void)
+{
+  static uint8 Rgb[NEOPX_NUM_LEDS * 3u];
+  uint32 i;
+
+  Test_BootFirmware();
+  for(i = 0u; i < sizeof(Rgb); i++)
+  {
+    Rgb[i] = (uint8)((i * 0x11u) ^ 0x0Fu);
+  }
+  TestNpx_Check(Rgb);
+  for(i = 0u; i < sizeof(Rgb); i++)
+  {
+    Rgb[i] = (uint8)~Rgb[i];
+  }
+  TestNpx_Check(Rgb);
+}
+
+/* All bits 0 and all bits 1: the longest low and high times */
+static void TestNpx_Extremes(void)
+{
+  static uint8 Rgb[NEOPX_NUM_LEDS * 3u];
+
+  Test_BootFirmware();
+  memset(Rgb, 0x00, sizeof(Rgb));
+  TestNpx_Check(Rgb);
+  memset(Rgb, 0xFF, sizeof(Rgb));
+  TestNpx_Check(Rgb);
+}
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+int main(int argc, char **argv)
+{
+  static const TTest_Case Cases[] =
+  {
+    {"TestNpx_Patterns", TestNpx_Patterns},
+    {"TestNpx_Extremes", TestNpx_Extremes}
+  };
+
+  return Test_Main(Cases, sizeof(Cases) / sizeof(Cases[0]), argc, argv);
+}
@@ -0,0 +1,263 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, PLL observer against the low pass speed
+ */
+
+/* Built with EMOPLL_EN = 1 (fw_pll): the Hall handler feeds the observer and
+ * still calculates the low pass speed, both are compared in the same run.
+ * The motor is started, then the rotor is locked and turned by the test along
+ * a speed profile, so the true speed is known exactly. The Hall sensors are
+ * skewed and the rotor is moved in random steps of 5..15 us, which puts that
+ * much jitter on the edges. Lag is the mean speed error on the ramps, noise
+ * the rms error at constant speed. */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include <math.h>
+#include "Test.h"
+#include "Emo.h"
+#include "EmoCcu.h"
+#include "EmoPll.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+/* Speed profile [rpm], ramps at TESTPLL_ACCEL [rpm/s], holds of TESTPLL_HOLD_MS */
+#define TESTPLL_SPEED_LO (300.0)
+#define TESTPLL_SPEED_HI (3000.0)
+#define TESTPLL_ACCEL    (3000.0)
+#define TESTPLL_HOLD_MS  (1500u)
+
+/* Start of a hold not taken into the noise [ms]: the low pass speed is
+ * averaged over 6 sectors, 200 ms at 300 rpm */
+#define TESTPLL_SETTLE_MS (1000u)
+
+/* Largest rms speed error at constant speed [share of the speed] */
+#define TESTPLL_NOISE_MAX (0.05)
+
+/* Rotor steps [us] */
+#define TESTPLL_STEP_MIN_US (5u)
+#define TESTPLL_STEP_MAX_US (15u)
+
+/* Profile segments */
+#define TESTPLL_SEG_LO   (0u)
+#define TESTPLL_SEG_UP   (1u)
+#define TESTPLL_SEG_HI   (2u)
+#define TESTPLL_SEG_DOWN (3u)
+#define TESTPLL_SEG_END  (4u)
+#define TESTPLL_SEG_NUM  (5u)
+
+/*******************************************************************************
+**                      Private Type Definitions                              **
+*******************************************************************************/
+/** \brief Speed error of one estimate in one segment */
+typedef struct
+{
+  float64 Sum;    /**< \brief Sum of the errors [rpm] */
+  float64 Sq;     /**< \brief Sum of the squared errors [rpm^2] */
+  float64 Max;    /**< \brief Largest absolute error [rpm] */
+  uint32 Num;     /**< \brief Samples */
+} TTestPll_Err;
+
+/*******************************************************************************
+**                      Private Variable Definitions                          **
+*******************************************************************************/
+static uint32 TestPll_lRand = 0x2545F491u;
+
+static TTestPll_Err TestPll_lLp[TESTPLL_SEG_NUM];
+static TTestPll_Err TestPll_lPll[TESTPLL_SEG_NUM];
+
+/*******************************************************************************
+**                      Private Function Definitions                          **
+*******************************************************************************/
+/* xorshift32, the same sequence on every run */
+static uint32 TestPll_Rand(void)
+{
+  TestPll_lRand ^= TestPll_lRand << 13u;
+  TestPll_lRand ^= TestPll_lRand >> 17u;
+  TestPll_lRand ^= TestPll_lRand << 5u;
+  return TestPll_lRand;
+}
+
+static void TestPll_Add(TTestPll_Err *pErr, float64 Err)
+{
+  pErr->Sum += Err;
+  pErr->Sq += Err * Err;
+  pErr->Max = (fabs(Err) > pErr->Max) ? fabs(Err) : pErr->Max;
+  pErr->Num++;
+}
+
+static float64 TestPll_Mean(const TTestPll_Err *pErr)
+{
+  return pErr->Sum / (float64)pErr->Num;
+}
+
+static float64 TestPll_Rms(const TTestPll_Err *pErr)
+{
+  return sqrt(pErr->Sq / (float64)pErr->Num);
+}
+
+/* Speed of the profile [rpm] at Ms, segment in pSeg, settled hold in pHold */
+static float64 TestPll_Profile(float64 Ms, uint32 *pSeg, bool *pHold)
+{
+  const float64 Ramp = ((TESTPLL_SPEED_HI - TESTPLL_SPEED_LO) * 1000.0) / TESTPLL_ACCEL;
+  const float64 Hold = (float64)TESTPLL_HOLD_MS;
+  float64 Speed;
+
+  *pHold = false;
+  if(Ms < Hold)
+  {
+    *pSeg = TESTPLL_SEG_LO;
+    *pHold = true;
+    Speed = TESTPLL_SPEED_LO;
+  }
+  else if(Ms < (Hold + Ramp))
+  {
+    *pSeg = TESTPLL_SEG_UP;
+    Speed = TESTPLL_SPEED_LO + (((Ms - Hold) * TESTPLL_ACCEL) / 1000.0);
+  }
+  else if(Ms < ((2.0 * Hold) + Ramp))
+  {
+    *pSeg = TESTPLL_SEG_HI;
+    *pHold = true;
+    Ms -= Hold + Ramp;
+    Speed = TESTPLL_SPEED_HI;
+  }
+  else if(Ms < ((2.0 * Hold) + (2.0 * Ramp)))
+  {
+    *pSeg = TESTPLL_SEG_DOWN;
+    Speed = TESTPLL_SPEED_HI - (((Ms - (2.0 * Hold) - Ramp) * TESTPLL_ACCEL) / 1000.0);
+  }
+  else
+  {
+    *pSeg = TESTPLL_SEG_END;
+    *pHold = true;
+    Ms -= (2.0 * Hold) + (2.0 * Ramp);
+    Speed = TESTPLL_SPEED_LO;
+  }
+  if((*pHold == true) && (Ms < (float64)TESTPLL_SETTLE_MS))
+  {
+    *pSeg = TESTPLL_SEG_NUM;
+  }
+  return Speed;
+}
+
+/* Speed profile with skewed and jittered Hall edges, errors of both estimates */
+static void TestPll_Profile300To3000(void)
+{
+  static const char *const Names[TESTPLL_SEG_NUM] = {"300 rpm", "ramp up", "3000 rpm", "ramp down", "300 rpm"};
+  static const float64 Skew[6] = {0.0, 3.0, -2.0, 4.0, -3.0, 1.0};
+  const float64 Ramp = ((TESTPLL_SPEED_HI - TESTPLL_SPEED_LO) * 1000.0) / TESTPLL_ACCEL;
+  const float64 End = (3.0 * (float64)TESTPLL_HOLD_MS) + (2.0 * Ramp);
+  TSim_MotorCfg Cfg;
+  TSim_Time Start;
+  TSim_Time NextMs;
+  TSim_Time Step;
+  float64 Angle;
+  float64 Speed;
+  float64 Ms;
+  uint32 Seg;
+  bool Hold;
+  uint32 i;
+
+  Test_BootFirmware();
+  Cfg = Sim_MotorDefault;
+  Cfg.PolePairs = BCHALL_POLE_PAIRS;
+  for(i = 0u; i < 6u; i++)
+  {
+    Cfg.HallErr[i] = Skew[i];
+  }
+  Sim_MotorInit(&Cfg, 60.0);
+  Sim_Run(SIM_MS(1));
+  Emo_SetRefSpeed((sint16)TESTPLL_SPEED_LO);
+  TEST_ASSERT_EQ(Emo_StartMotor(), 0u);
+  Sim_Run(SIM_MS(1000));
+  TEST_ASSERT(Emo_GetMotorState() == EMO_MOTOR_STATE_RUN);
+
+  Sim_MotorLock(true);
+  Angle = Sim_MotorAngle();
+  Start = Sim_Now();
+  NextMs = Start + SIM_MS(1);
+  Ms = 0.0;
+  while(Ms < End)
+  {
+    Speed = TestPll_Profile(Ms, &Seg, &Hold);
+    Step = SIM_US(TESTPLL_STEP_MIN_US + (TestPll_Rand() % (TESTPLL_STEP_MAX_US - TESTPLL_STEP_MIN_US + 1u)));
+    Angle += (Speed * (float64)BCHALL_POLE_PAIRS * 6.0 * (float64)Step) / (float64)SIM_US(1000000);
+    Sim_MotorSetAngle(Angle);
+    Sim_Run(Step);
+    Ms = (float64)(Sim_Now() - Start) / (float64)SIM_MS(1);
+    if((Sim_Now() >= NextMs) && (Seg < TESTPLL_SEG_NUM))
+    {
+      NextMs += SIM_MS(1);
+      TestPll_Add(&TestPll_lLp[Seg], (float64)EmoCcu_GetSpeed() - Speed);
+      TestPll_Add(&TestPll_lPll[Seg], (float64)EmoPll_GetSpeed() - Speed);
+    }
+  }
+  TEST_ASSERT(Emo_GetMotorState() == EMO_MOTOR_STATE_RUN);
+
+  TEST_LOG("speed error [rpm]      low pass mean/rms/max       PLL mean/rms/max");
+  for(i = 0u; i < TESTPLL_SEG_NUM; i++)
+  {
+    TEST_ASSERT(TestPll_lLp[i].Num > 0u);
+    TEST_LOG("%-10s %10.1f %7.1f %7.1f    %10.1f %7.1f %7.1f", Names[i], TestPll_Mean(&TestPll_lLp[i]),
+             TestPll_Rms(&TestPll_lLp[i]), TestPll_lLp[i].Max, TestPll_Mean(&TestPll_lPll[i]),
+             TestPll_Rms(&TestPll_lPll[i]), TestPll_lPll[i].Max);
+  }
+
+  /* The observer lags less on the ramps */
+  TEST_ASSERT(fabs(TestPll_Mean(&TestPll_lPll[TESTPLL_SEG_UP])) < (fabs(TestPll_Mean(&TestPll_lLp[TESTPLL_SEG_UP])) / 2.0));
+  TEST_ASSERT(fabs(TestPll_Mean(&TestPll_lPll[TESTPLL_SEG_DOWN])) < (fabs(TestPll_Mean(&TestPll_lLp[TESTPLL_SEG_DOWN])) / 2.0));
+  /* Both are within the noise budget at constant speed */
+  TEST_ASSERT(TestPll_Rms(&TestPll_lLp[TESTPLL_SEG_LO]) < (TESTPLL_NOISE_MAX * TESTPLL_SPEED_LO));
+  TEST_ASSERT(TestPll_Rms(&TestPll_lPll[TESTPLL_SEG_LO]) < (TESTPLL_NOISE_MAX * TESTPLL_SPEED_LO));
+  TEST_ASSERT(TestPll_Rms(&TestPll_lLp[TESTPLL_SEG_HI]) < (TESTPLL_NOISE_MAX * TESTPLL_SPEED_HI));
+  TEST_ASSERT(TestPll_Rms(&TestPll_lPll[TESTPLL_SEG_HI]) < (TESTPLL_NOISE_MAX * TESTPLL_SPEED_HI));
+  TEST_ASSERT(TestPll_Rms(&TestPll_lLp[TESTPLL_SEG_END]) < (TESTPLL_NOISE_MAX * TESTPLL_SPEED_LO));
+  TEST_ASSERT(TestPll_Rms(&TestPll_lPll[TESTPLL_SEG_END]) < (TESTPLL_NOISE_MAX * TESTPLL_SPEED_LO));
+}
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+int main(int argc, char **argv)
+{
+  static const TTest_Case Cases[] =
+  {
+    {"TestPll_Profile300To3000", TestPll_Profile300To3000}
+  };
+
+  return Test_Main(Cases, sizeof(Cases) / sizeof(Cases[0]), argc, argv);
+}
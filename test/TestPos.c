@@ -0,0 +1,286 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, position control with the encoder driven by the motor model
+ */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include <math.h>
+#include "Test.h"
+#include "Emo.h"
+#include "EmoEnc.h"
+#include "EmoPos.h"
+#include "bchall_defines.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+/* Encoder sample step, one edge per step at most: 5 us is below the edge
+ * period at the speed limit of the position control */
+#define TESTPOS_STEP_US (5u)
+
+/* Coulomb friction of the load [Nm] */
+#define TESTPOS_FRICTION (0.005)
+
+/* Hold exit band of the position control [encoder ticks] */
+#define TESTPOS_HOLD_EXIT (8)
+
+/* Limits: tracking error while the trajectory moves [encoder ticks], time
+ * from the end of the trajectory to the hold [ms] */
+#define TESTPOS_TRACK_MAX (700)
+#define TESTPOS_SETTLE_MS (600.0)
+
+/* Target ramp [rpm] and limit of the tracking error on the ramp [encoder
+ * ticks]; the trajectory itself stays behind a moving target by its stopping
+ * distance */
+#define TESTPOS_RAMP_RPM (1000.0)
+#define TESTPOS_RAMP_ERR (40.0)
+
+/*******************************************************************************
+**                      Private Type Definitions                              **
+*******************************************************************************/
+/** \brief Response to a position move */
+typedef struct
+{
+  sint32 TrackMax;  /**< \brief Largest trajectory tracking error while moving [encoder ticks] */
+  float64 Settle;   /**< \brief Time from the end of the trajectory to the hold [ms] */
+  sint32 Err;       /**< \brief Position error at the end [encoder ticks] */
+  uint16 Reversals; /**< \brief Commutation reversals by the position control */
+} TTestPos_Resp;
+
+/*******************************************************************************
+**                      Private Variable Definitions                          **
+*******************************************************************************/
+static float64 TestPos_lAngle;  /* Unwrapped mechanical angle [degrees] */
+static float64 TestPos_lLast;   /* Last electrical angle of the model [degrees] */
+static sint32 TestPos_lCount;   /* Edges sent to the firmware [encoder ticks] */
+
+/*******************************************************************************
+**                      Private Function Definitions                          **
+*******************************************************************************/
+/* Encoder on the motor shaft: rising edge of channel B (EXINT1) per line,
+ * channel A (P2.0) high in forward direction, one edge per call */
+static void TestPos_Encoder(void)
+{
+  float64 Angle;
+  float64 Delta;
+  sint32 Count;
+
+  Angle = Sim_MotorAngle();
+  Delta = Angle - TestPos_lLast;
+  Delta = (Delta > 180.0) ? (Delta - 360.0) : ((Delta < -180.0) ? (Delta + 360.0) : Delta);
+  TestPos_lLast = Angle;
+  TestPos_lAngle += Delta / (float64)BCHALL_POLE_PAIRS;
+
+  Count = (sint32)floor((TestPos_lAngle * (float64)EMOENC_TICKS_PER_REV) / 360.0);
+  if(Count != TestPos_lCount)
+  {
+    Sim_PortSetPin(2u, 0u, (Count > TestPos_lCount) ? true : false);
+    Sim_PortSetExint(1u, true);
+    Sim_PortSetExint(1u, false);
+    TestPos_lCount += (Count > TestPos_lCount) ? 1 : -1;
+  }
+}
+
+/* Runs Ms with the encoder */
+static void TestPos_Run(uint32 Ms)
+{
+  uint32 i;
+
+  for(i = 0u; i < ((Ms * 1000u) / TESTPOS_STEP_US); i++)
+  {
+    Sim_Run(SIM_US(TESTPOS_STEP_US));
+    TestPos_Encoder();
+  }
+}
+
+/* Motor with the friction of a geared load at standstill at encoder position 0:
+ * the unloaded model coasts further from the start speed than the hold band */
+static void TestPos_Start(void)
+{
+  TSim_MotorCfg Cfg;
+
+  Test_BootFirmware();
+  Cfg = Sim_MotorDefault;
+  Cfg.PolePairs = BCHALL_POLE_PAIRS;
+  Cfg.Friction = TESTPOS_FRICTION;
+  Sim_MotorInit(&Cfg, 60.0);
+  TestPos_lAngle = 0.0;
+  TestPos_lLast = Sim_MotorAngle();
+  TestPos_lCount = 0;
+  Sim_Run(SIM_MS(1));
+  TEST_ASSERT_EQ(EmoEnc_GetPos(), 0);
+}
+
+/* Response to the target set before over Ms, sampled every ms */
+static void TestPos_Track(uint32 Ms, TTestPos_Resp *pResp)
+{
+  uint16 Reversals;
+  sint32 Err;
+  uint32 End;
+  uint32 t;
+
+  Reversals = EmoPos_Ctrl.ReverseCtr;
+  pResp->TrackMax = 0;
+  pResp->Settle = -1.0;
+  End = 0u;
+  for(t = 1u; t <= Ms; t++)
+  {
+    TestPos_Run(1u);
+    if(EmoPos_IsSettled() == false)
+    {
+      Err = (sint32)(EmoPos_Ctrl.RefPos >> 16u) - TestPos_lCount;
+      Err = (Err < 0) ? -Err : Err;
+      pResp->TrackMax = (Err > pResp->TrackMax) ? Err : pResp->TrackMax;
+      End = 0u;
+    }
+    else if(End == 0u)
+    {
+      End = t;
+    }
+    else
+    {
+      /* Trajectory at the target */
+    }
+    if(EmoPos_Ctrl.Hold == 0u)
+    {
+      pResp->Settle = -1.0;
+    }
+    else if(pResp->Settle < 0.0)
+    {
+      pResp->Settle = (float64)(t - End);
+    }
+    else
+    {
+      /* Holding */
+    }
+  }
+  pResp->Err = EmoPos_Ctrl.TargetPos - TestPos_lCount;
+  pResp->Reversals = (uint16)(EmoPos_Ctrl.ReverseCtr - Reversals);
+  TEST_ASSERT_EQ(EmoEnc_GetPos(), TestPos_lCount);
+}
+
+/* Hold reached and kept with the motor stopped */
+static void TestPos_CheckHold(const TTestPos_Resp *pResp)
+{
+  TEST_ASSERT_RANGE(pResp->Settle, 0.0, TESTPOS_SETTLE_MS);
+  TEST_ASSERT_RANGE(pResp->Err, -TESTPOS_HOLD_EXIT, TESTPOS_HOLD_EXIT);
+  TEST_ASSERT_EQ(Emo_GetMotorState(), EMO_MOTOR_STATE_STOP);
+}
+
+/* Step of 4 revolutions from standstill */
+static void TestPos_Step(void)
+{
+  TTestPos_Resp Resp;
+
+  TestPos_Start();
+  EmoPos_SetTarget(4 * (sint32)EMOENC_TICKS_PER_REV, EmoEnc_GetPos());
+  TestPos_Track(1500u, &Resp);
+  TEST_LOG("step 4 rev: tracking error %d ticks, hold %.0f ms after the trajectory, error %d ticks, %u reversals",
+           Resp.TrackMax, Resp.Settle, Resp.Err, Resp.Reversals);
+  TestPos_CheckHold(&Resp);
+  TEST_ASSERT_RANGE(Resp.TrackMax, 0, TESTPOS_TRACK_MAX);
+  TEST_ASSERT_EQ(Resp.Reversals, 0u);
+}
+
+/* Step back by 1 revolution from the hold: new direction from standstill */
+static void TestPos_StepBack(void)
+{
+  TTestPos_Resp Resp;
+
+  TestPos_Start();
+  EmoPos_SetTarget(2 * (sint32)EMOENC_TICKS_PER_REV, EmoEnc_GetPos());
+  TestPos_Track(1500u, &Resp);
+  TestPos_CheckHold(&Resp);
+  EmoPos_SetTarget((sint32)EMOENC_TICKS_PER_REV, EmoEnc_GetPos());
+  TestPos_Track(1500u, &Resp);
+  TEST_LOG("step back 1 rev: tracking error %d ticks, hold %.0f ms after the trajectory, error %d ticks, %u reversals",
+           Resp.TrackMax, Resp.Settle, Resp.Err, Resp.Reversals);
+  TestPos_CheckHold(&Resp);
+  TEST_ASSERT_RANGE(Resp.TrackMax, 0, TESTPOS_TRACK_MAX);
+  TEST_ASSERT_EQ(Resp.Reversals, 0u);
+}
+
+/* Target ramp at TESTPOS_RAMP_RPM, then stop of the ramp */
+static void TestPos_Ramp(void)
+{
+  TTestPos_Resp Resp;
+  float64 Target;
+  float64 Err;
+  float64 ErrMin;
+  float64 ErrMax;
+  uint32 t;
+
+  TestPos_Start();
+  Target = 0.0;
+  ErrMin = 1e9;
+  ErrMax = -1e9;
+  for(t = 1u; t <= 2000u; t++)
+  {
+    Target += (TESTPOS_RAMP_RPM * (float64)EMOENC_TICKS_PER_REV) / 60000.0;
+    EmoPos_SetTarget((sint32)Target, EmoEnc_GetPos());
+    TestPos_Run(1u);
+    if(t > 1000u)
+    {
+      Err = (float64)((sint32)(EmoPos_Ctrl.RefPos >> 16u) - TestPos_lCount);
+      ErrMin = (Err < ErrMin) ? Err : ErrMin;
+      ErrMax = (Err > ErrMax) ? Err : ErrMax;
+    }
+  }
+  TEST_LOG("ramp %.0f rpm: tracking error %.0f..%.0f ticks, trajectory %.0f ticks behind the target, motor %.0f rpm",
+           TESTPOS_RAMP_RPM, ErrMin, ErrMax, Target - (float64)(EmoPos_Ctrl.RefPos >> 16u), Sim_MotorSpeed());
+  TEST_ASSERT_RANGE(ErrMin, -TESTPOS_RAMP_ERR, TESTPOS_RAMP_ERR);
+  TEST_ASSERT_RANGE(ErrMax, -TESTPOS_RAMP_ERR, TESTPOS_RAMP_ERR);
+  TestPos_Track(1500u, &Resp);
+  TEST_LOG("end of ramp: hold %.0f ms after the trajectory, error %d ticks, %u reversals",
+           Resp.Settle, Resp.Err, Resp.Reversals);
+  TestPos_CheckHold(&Resp);
+  TEST_ASSERT_EQ(Resp.Reversals, 0u);
+}
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+int main(int argc, char **argv)
+{
+  static const TTest_Case Cases[] =
+  {
+    {"TestPos_Step", TestPos_Step},
+    {"TestPos_StepBack", TestPos_StepBack},
+    {"TestPos_Ramp", TestPos_Ramp}
+  };
+
+  return Test_Main(Cases, sizeof(Cases) / sizeof(Cases[0]), argc, argv);
+}
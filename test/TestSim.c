@@ -0,0 +1,136 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, motor model and SPI master against the firmware
+ */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include "Test.h"
+#include "Emo.h"
+#include "SpiProt.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+/* SPI master: 8 MHz clock, 1 kHz frame rate */
+#define TESTSIM_SPI_WORD_TIME (SIM_US(2))
+#define TESTSIM_SPI_PERIOD    (SIM_MS(1))
+
+/*******************************************************************************
+**                      Private Function Definitions                          **
+*******************************************************************************/
+/* One frame of the SPI master, returns at the end of the frame period */
+static void TestSim_SpiFrame(const uint16 *pTx, uint16 *pRx)
+{
+  TSim_Time Start;
+
+  Start = Sim_Now();
+  Sim_SpiStart(pTx, pRx, SPIPROT_FRAME_WORDS, TESTSIM_SPI_WORD_TIME);
+  while(Sim_SpiBusy() == true)
+  {
+    Sim_Run(SIM_US(10));
+  }
+  Sim_Run(TESTSIM_SPI_PERIOD - (Sim_Now() - Start));
+}
+
+/* The first Hall pattern commutates from standstill, the measured speed
+ * follows the rotor at steady state */
+static void TestSim_HallStart(void)
+{
+  uint32 Edges;
+
+  Test_BootFirmware();
+  Sim_MotorInit(&Sim_MotorDefault, 60.0);
+  Sim_Run(SIM_MS(1));
+  Emo_SetRefSpeed(1000);
+  TEST_ASSERT_EQ(Emo_StartMotor(), 0u);
+  Sim_Run(SIM_MS(2000));
+  (void)Sim_MotorHallEdge(&Edges);
+  TEST_LOG("rotor %.0f rpm, measured %u rpm, %u Hall edges", Sim_MotorSpeed(), Emo_GetAbsSpeed(), Edges);
+  TEST_ASSERT_EQ(Emo_Status.MotorState, EMO_MOTOR_STATE_RUN);
+  TEST_ASSERT(Sim_MotorSpeed() > 100.0);
+  TEST_ASSERT_RANGE(Emo_GetAbsSpeed(), Sim_MotorSpeed() * 0.98, Sim_MotorSpeed() * 1.02);
+}
+
+/* Master frames reach the command decoder through SSC2 and DMA, the
+ * telemetry of each slave frame is consistent */
+static void TestSim_SpiFrames(void)
+{
+  uint16 Tx[SPIPROT_FRAME_WORDS];
+  uint16 Rx[SPIPROT_FRAME_WORDS];
+  TSpiProt_Cmd Cmd = {0};
+  TSpiProt_Telem Telem;
+  uint32 Time;
+  uint32 i;
+
+  Test_BootFirmware();
+  Cmd.CmdId = SPIPROT_CMD_NONE;
+  SpiProt_EncodeCmd(Tx, &Cmd);
+  TestSim_SpiFrame(Tx, Rx);
+  TEST_ASSERT(SpiProt_DecodeTelem(Rx, &Telem) == true);
+
+  /* Samples from here on are latched at the chip select of the previous frame */
+  TestSim_SpiFrame(Tx, Rx);
+  TEST_ASSERT(SpiProt_DecodeTelem(Rx, &Telem) == true);
+  Time = Telem.Time;
+  for(i = 1u; i <= 10u; i++)
+  {
+    Cmd.Seq = (uint8)i;
+    SpiProt_EncodeCmd(Tx, &Cmd);
+    TestSim_SpiFrame(Tx, Rx);
+    TEST_ASSERT(SpiProt_DecodeTelem(Rx, &Telem) == true);
+    TEST_ASSERT_EQ(Telem.Seq, i - 1u);
+    TEST_ASSERT_EQ(Telem.Status & (SPIPROT_STATUS_CMD_OK | SPIPROT_STATUS_CMD_ERR), SPIPROT_STATUS_CMD_OK);
+    TEST_ASSERT_EQ(Telem.FrameCtr, i + 1u);
+    TEST_ASSERT_RANGE(Telem.Time - Time, 900, 1100);
+    Time = Telem.Time;
+  }
+  TEST_LOG("%u frames, %u rejected", Telem.FrameCtr, Telem.ErrCtr);
+  TEST_ASSERT_EQ(Telem.ErrCtr, 0u);
+}
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+int main(int argc, char **argv)
+{
+  static const TTest_Case Cases[] =
+  {
+    {"TestSim_HallStart", TestSim_HallStart},
+    {"TestSim_SpiFrames", TestSim_SpiFrames}
+  };
+
+  return Test_Main(Cases, sizeof(Cases) / sizeof(Cases[0]), argc, argv);
+}
@@ -0,0 +1,253 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, speed from the Hall commutation period
+ * V0.1.1: 2026-10-18: Benchmark by instruction count instead of host time
+ */
+
+/* EmoCcu_SpeedFromPeriod is checked against a 64 bit reference for every
+ * period with a nonzero speed. The benchmark sets the division against the
+ * reciprocal table the Hall handler could use instead (normalisation by CLZ,
+ * 256 entry table, one Newton step, multiply and correction). Both are counted
+ * with Sim_InsnMeasure like the handlers in TestIsr: host instructions as the
+ * estimate of the Thumb-2 build, where the UDIV counted as one instruction
+ * takes 2..12 cycles. */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include <math.h>
+#include "Test.h"
+#include "EmoCcu.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+/* Reciprocal table entries, indexed by the 8 bits below the leading one */
+#define TESTSPEED_RCP_NUM (256u)
+
+/* Longest period with a nonzero speed [T6 ticks] */
+#define TESTSPEED_PERIOD_MAX (EMOCCU_SPEED_FROM_PERIOD_NUM)
+
+/* Cycles of the UDIV beyond the one counted, worst case of the Cortex-M3 */
+#define TESTSPEED_UDIV_EXTRA (11u)
+
+/* Periods of the instruction count, geometric from the shortest to the longest */
+#define TESTSPEED_BENCH_NUM (1000u)
+
+/*******************************************************************************
+**                      Private Variable Definitions                          **
+*******************************************************************************/
+/* 2^62 / normalised period (Q30 reciprocal of 0.5..1), midpoint of each entry */
+static uint32 TestSpeed_lRcp[TESTSPEED_RCP_NUM];
+
+/* Argument and result of the measured calls */
+static volatile uint32 TestSpeed_lPeriod;
+static volatile uint32 TestSpeed_lSpeed;
+static uint32 TestSpeed_lCorr;
+
+/*******************************************************************************
+**                      Private Function Definitions                          **
+*******************************************************************************/
+/* Reference: exact quotient, saturated */
+static uint32 TestSpeed_Ref(uint32 Period)
+{
+  uint64_t Speed;
+
+  Speed = (Period == 0u) ? 0xFFFFu : ((uint64_t)EMOCCU_SPEED_FROM_PERIOD_NUM / Period);
+  return (Speed > 0xFFFFu) ? 0xFFFFu : (uint32)Speed;
+}
+
+static void TestSpeed_RcpInit(void)
+{
+  uint32 i;
+
+  for(i = 0u; i < TESTSPEED_RCP_NUM; i++)
+  {
+    TestSpeed_lRcp[i] = (uint32)((1ull << 62u) / ((((uint64_t)(TESTSPEED_RCP_NUM + i) << 1u) + 1u) << 22u));
+  }
+}
+
+/* Speed by reciprocal, counts the correction steps */
+static uint32 TestSpeed_Rcp(uint32 Period, uint32 *pCorr)
+{
+  uint32 Shift;
+  uint32 Norm;
+  uint32 Y;
+  uint32 T;
+  uint32 Speed;
+
+  if(Period < EMOCCU_SPEED_PERIOD_MIN)
+  {
+    return 0xFFFFu;
+  }
+  if(Period > TESTSPEED_PERIOD_MAX)
+  {
+    return 0u;
+  }
+  Shift = __CLZ(Period);
+  Norm = Period << Shift;
+  Y = TestSpeed_lRcp[(Norm >> 23u) & (TESTSPEED_RCP_NUM - 1u)];
+  /* Newton: y = y (2 - f y) */
+  T = (uint32)(((uint64_t)Norm * Y) >> 32u);
+  Y = (uint32)(((uint64_t)Y * ((1u << 31u) - T)) >> 30u);
+  Speed = (uint32)(((uint64_t)EMOCCU_SPEED_FROM_PERIOD_NUM * Y) >> (62u - Shift));
+  while((Speed * Period) > EMOCCU_SPEED_FROM_PERIOD_NUM)
+  {
+    Speed--;
+    (*pCorr)++;
+  }
+  while(((Speed + 1u) * Period) <= EMOCCU_SPEED_FROM_PERIOD_NUM)
+  {
+    Speed++;
+    (*pCorr)++;
+  }
+  return (Speed > 0xFFFFu) ? 0xFFFFu : Speed;
+}
+
+/* Calls under Sim_InsnMeasure */
+static void TestSpeed_CallNone(void)
+{
+  TestSpeed_lSpeed = TestSpeed_lPeriod;
+}
+
+static void TestSpeed_CallDiv(void)
+{
+  TestSpeed_lSpeed = EmoCcu_SpeedFromPeriod(TestSpeed_lPeriod);
+}
+
+static void TestSpeed_CallRcp(void)
+{
+  TestSpeed_lSpeed = TestSpeed_Rcp(TestSpeed_lPeriod, &TestSpeed_lCorr);
+}
+
+/* Instructions of a call net of the argument and result transfer */
+static uint32 TestSpeed_Insns(void (*pCall)(void), uint32 Period)
+{
+  uint32 None;
+
+  TestSpeed_lPeriod = Period;
+  None = (uint32)Sim_InsnMeasure(TestSpeed_CallNone);
+  return (uint32)Sim_InsnMeasure(pCall) - None;
+}
+
+/* Every period with a nonzero speed, saturation below the shortest period */
+static void TestSpeed_Sweep(void)
+{
+  uint32 Period;
+  uint32 Errors = 0u;
+
+  TEST_LOG("numerator %u, shortest period %u ticks", EMOCCU_SPEED_FROM_PERIOD_NUM, EMOCCU_SPEED_PERIOD_MIN);
+  for(Period = 0u; Period <= (TESTSPEED_PERIOD_MAX + 1u); Period++)
+  {
+    if(EmoCcu_SpeedFromPeriod(Period) != TestSpeed_Ref(Period))
+    {
+      Errors++;
+    }
+  }
+  TEST_ASSERT_EQ(Errors, 0u);
+  TEST_ASSERT_EQ(EmoCcu_SpeedFromPeriod(0u), 0xFFFFu);
+  TEST_ASSERT_EQ(EmoCcu_SpeedFromPeriod(EMOCCU_SPEED_PERIOD_MIN - 1u), 0xFFFFu);
+  TEST_ASSERT(EmoCcu_SpeedFromPeriod(EMOCCU_SPEED_PERIOD_MIN) <= 0xFFFFu);
+  TEST_ASSERT_EQ(EmoCcu_SpeedFromPeriod(TESTSPEED_PERIOD_MAX), 1u);
+  TEST_ASSERT_EQ(EmoCcu_SpeedFromPeriod(TESTSPEED_PERIOD_MAX + 1u), 0u);
+  TEST_ASSERT_EQ(EmoCcu_SpeedFromPeriod(0xFFFFFFFFu), 0u);
+}
+
+/* Division against the reciprocal table: exact over all periods, instruction
+ * count over a geometric sample */
+static void TestSpeed_Bench(void)
+{
+  uint32 Period;
+  uint32 Corr = 0u;
+  uint32 CorrMax = 0u;
+  uint32 Prev;
+  uint32 Errors = 0u;
+  uint32 Insns;
+  uint32 DivMin = 0xFFFFFFFFu;
+  uint32 DivMax = 0u;
+  uint32 DivSum = 0u;
+  uint32 RcpMin = 0xFFFFFFFFu;
+  uint32 RcpMax = 0u;
+  uint32 RcpSum = 0u;
+  uint32 i;
+
+  TestSpeed_RcpInit();
+  for(Period = 0u; Period <= (TESTSPEED_PERIOD_MAX + 1u); Period++)
+  {
+    Prev = Corr;
+    if(TestSpeed_Rcp(Period, &Corr) != TestSpeed_Ref(Period))
+    {
+      Errors++;
+    }
+    CorrMax = ((Corr - Prev) > CorrMax) ? (Corr - Prev) : CorrMax;
+  }
+  TEST_ASSERT_EQ(Errors, 0u);
+
+  for(i = 0u; i < TESTSPEED_BENCH_NUM; i++)
+  {
+    Period = (uint32)((float64)EMOCCU_SPEED_PERIOD_MIN *
+                      pow((float64)TESTSPEED_PERIOD_MAX / (float64)EMOCCU_SPEED_PERIOD_MIN,
+                          (float64)i / (float64)(TESTSPEED_BENCH_NUM - 1u)));
+    Insns = TestSpeed_Insns(TestSpeed_CallDiv, Period);
+    DivMin = (Insns < DivMin) ? Insns : DivMin;
+    DivMax = (Insns > DivMax) ? Insns : DivMax;
+    DivSum += Insns;
+    Insns = TestSpeed_Insns(TestSpeed_CallRcp, Period);
+    RcpMin = (Insns < RcpMin) ? Insns : RcpMin;
+    RcpMax = (Insns > RcpMax) ? Insns : RcpMax;
+    RcpSum += Insns;
+  }
+
+  TEST_LOG("instructions per period: division %u..%u (mean %.1f), reciprocal %u..%u (mean %.1f)", DivMin, DivMax,
+           (float64)DivSum / (float64)TESTSPEED_BENCH_NUM, RcpMin, RcpMax, (float64)RcpSum / (float64)TESTSPEED_BENCH_NUM);
+  TEST_LOG("reciprocal table %u bytes, %u corrections over all periods (max %u per period)",
+           (uint32)sizeof(TestSpeed_lRcp), Corr, CorrMax);
+  TEST_LOG("division with the slowest UDIV: %u cycles", DivMax + TESTSPEED_UDIV_EXTRA);
+  TEST_ASSERT((DivMax + TESTSPEED_UDIV_EXTRA) < RcpMin);
+  TEST_ASSERT(CorrMax <= 2u);
+}
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+int main(int argc, char **argv)
+{
+  static const TTest_Case Cases[] =
+  {
+    {"TestSpeed_Sweep", TestSpeed_Sweep},
+    {"TestSpeed_Bench", TestSpeed_Bench}
+  };
+
+  return Test_Main(Cases, sizeof(Cases) / sizeof(Cases[0]), argc, argv);
+}
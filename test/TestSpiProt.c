@@ -0,0 +1,327 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, fuzzing of the master frame decoder
+ */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include <string.h>
+#include "Test.h"
+#include "Emo.h"
+#include "SpiProt.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+/* Random frames and commands per case */
+#define TESTSPI_RANDOM_NUM (100000u)
+#define TESTSPI_FRAMES_NUM (300u)
+
+/* SPI master: 8 MHz clock, 1 kHz frame rate */
+#define TESTSPI_WORD_TIME (SIM_US(2))
+#define TESTSPI_PERIOD    (SIM_MS(1))
+
+/* Motor commands are applied by the next SysTick after the frame */
+#define TESTSPI_SYSTICK (SIM_MS(1))
+
+/* Bits of a frame */
+#define TESTSPI_FRAME_BITS (SPIPROT_FRAME_WORDS * 16u)
+
+/* Largest command ID accepted by the firmware without the profile build */
+#define TESTSPI_CMD_MAX (SPIPROT_CMD_HALLCAL)
+
+/*******************************************************************************
+**                      Private Variable Definitions                          **
+*******************************************************************************/
+static uint32 TestSpi_lRand = 0x2545F491u;
+
+/*******************************************************************************
+**                      Private Function Definitions                          **
+*******************************************************************************/
+/* xorshift32, the same sequence on every run */
+static uint32 TestSpi_Rand(void)
+{
+  TestSpi_lRand ^= TestSpi_lRand << 13u;
+  TestSpi_lRand ^= TestSpi_lRand >> 17u;
+  TestSpi_lRand ^= TestSpi_lRand << 5u;
+  return TestSpi_lRand;
+}
+
+/* Random command */
+static void TestSpi_RandomCmd(TSpiProt_Cmd *pCmd)
+{
+  uint32 i;
+
+  pCmd->Seq = (uint8)TestSpi_Rand();
+  pCmd->CmdId = (uint8)TestSpi_Rand();
+  for(i = 0u; i < SPIPROT_PAYLOAD_WORDS; i++)
+  {
+    pCmd->Payload[i] = (uint16)TestSpi_Rand();
+  }
+}
+
+/* Inverts bit Bit of a frame, bit 0 = MSB of word 0 as shifted out */
+static void TestSpi_Flip(uint16 *pFrame, uint32 Bit)
+{
+  pFrame[Bit / 16u] ^= (uint16)(0x8000u >> (Bit % 16u));
+}
+
+/* Decodes a corrupted frame: rejected, the command untouched */
+static void TestSpi_Reject(const uint16 *pFrame)
+{
+  TSpiProt_Cmd Cmd;
+  TSpiProt_Cmd Ref;
+
+  memset(&Cmd, 0x5A, sizeof(Cmd));
+  Ref = Cmd;
+  TEST_ASSERT(SpiProt_DecodeCmd(pFrame, &Cmd) == false);
+  TEST_ASSERT(memcmp(&Cmd, &Ref, sizeof(Cmd)) == 0);
+}
+
+/* Encoded random commands decode to the same command */
+static void TestSpi_RoundTrip(void)
+{
+  uint16 Frame[SPIPROT_FRAME_WORDS];
+  TSpiProt_Cmd Cmd;
+  TSpiProt_Cmd Dec;
+  uint32 n;
+
+  for(n = 0u; n < TESTSPI_RANDOM_NUM; n++)
+  {
+    TestSpi_RandomCmd(&Cmd);
+    SpiProt_EncodeCmd(Frame, &Cmd);
+    TEST_ASSERT(SpiProt_DecodeCmd(Frame, &Dec) == true);
+    TEST_ASSERT_EQ(Dec.Seq, Cmd.Seq);
+    TEST_ASSERT_EQ(Dec.CmdId, Cmd.CmdId);
+    TEST_ASSERT(memcmp(Dec.Payload, Cmd.Payload, sizeof(Cmd.Payload)) == 0);
+  }
+  TEST_LOG("%u random commands", TESTSPI_RANDOM_NUM);
+}
+
+/* Every error of one or two bits and every burst up to 16 bits is rejected,
+ * as guaranteed by the CRC-16 for the frame length */
+static void TestSpi_BitErrors(void)
+{
+  uint16 Frame[SPIPROT_FRAME_WORDS];
+  uint16 Bad[SPIPROT_FRAME_WORDS];
+  TSpiProt_Cmd Cmd;
+  uint32 Num;
+  uint32 Len;
+  uint32 b;
+  uint32 c;
+  uint32 n;
+
+  TestSpi_RandomCmd(&Cmd);
+  SpiProt_EncodeCmd(Frame, &Cmd);
+  Num = 0u;
+  for(b = 0u; b < TESTSPI_FRAME_BITS; b++)
+  {
+    for(c = b; c < TESTSPI_FRAME_BITS; c++)
+    {
+      memcpy(Bad, Frame, sizeof(Bad));
+      TestSpi_Flip(Bad, b);
+      if(c != b)
+      {
+        TestSpi_Flip(Bad, c);
+      }
+      TestSpi_Reject(Bad);
+      Num++;
+    }
+  }
+
+  /* Bursts: first and last bit inverted, the bits between random */
+  for(n = 0u; n < TESTSPI_RANDOM_NUM; n++)
+  {
+    Len = 3u + (TestSpi_Rand() % 14u);
+    b = TestSpi_Rand() % (TESTSPI_FRAME_BITS - Len + 1u);
+    memcpy(Bad, Frame, sizeof(Bad));
+    TestSpi_Flip(Bad, b);
+    TestSpi_Flip(Bad, b + Len - 1u);
+    for(c = b + 1u; c < (b + Len - 1u); c++)
+    {
+      if((TestSpi_Rand() & 1u) != 0u)
+      {
+        TestSpi_Flip(Bad, c);
+      }
+    }
+    TestSpi_Reject(Bad);
+    Num++;
+  }
+  TEST_LOG("%u corrupted frames rejected", Num);
+}
+
+/* Random words, as from a master out of sync or a floating MISO line: only
+ * frames with header and CRC pass, i.e. none of a sample of this size */
+static void TestSpi_Random(void)
+{
+  uint16 Frame[SPIPROT_FRAME_WORDS];
+  uint32 Crc;
+  uint32 n;
+  uint32 i;
+
+  for(n = 0u; n < TESTSPI_RANDOM_NUM; n++)
+  {
+    for(i = 0u; i < SPIPROT_FRAME_WORDS; i++)
+    {
+      Frame[i] = (uint16)TestSpi_Rand();
+    }
+    TestSpi_Reject(Frame);
+
+    /* Valid CRC over a wrong header */
+    if(Frame[SPIPROT_WORD_HEADER] == SPIPROT_HEADER)
+    {
+      Frame[SPIPROT_WORD_HEADER] ^= 1u;
+    }
+    Crc = SpiProt_Crc16(Frame, SPIPROT_WORD_CRC);
+    Frame[SPIPROT_WORD_CRC] = (uint16)Crc;
+    TestSpi_Reject(Frame);
+  }
+
+  /* All zero and all one words */
+  memset(Frame, 0x00, sizeof(Frame));
+  TestSpi_Reject(Frame);
+  memset(Frame, 0xFF, sizeof(Frame));
+  TestSpi_Reject(Frame);
+  TEST_LOG("%u random frames rejected", 2u * TESTSPI_RANDOM_NUM);
+}
+
+/* One frame of the SPI master, returns at the end of the frame period */
+static void TestSpi_Frame(const uint16 *pTx, uint16 *pRx)
+{
+  TSim_Time Start;
+
+  Start = Sim_Now();
+  Sim_SpiStart(pTx, pRx, SPIPROT_FRAME_WORDS, TESTSPI_WORD_TIME);
+  while(Sim_SpiBusy() == true)
+  {
+    Sim_Run(SIM_US(10));
+  }
+  Sim_Run(TESTSPI_PERIOD - (Sim_Now() - Start));
+}
+
+/* Random valid frames into the running firmware: unknown command IDs are
+ * rejected, all others accepted, the motor commands are applied by the
+ * SysTick and the firmware keeps answering. The speed reference has to wait
+ * for the SysTick: the DMA interrupt only queues it. */
+static void TestSpi_Firmware(void)
+{
+  uint16 Tx[SPIPROT_FRAME_WORDS];
+  uint16 Rx[SPIPROT_FRAME_WORDS];
+  TSpiProt_Cmd Cmd;
+  TSpiProt_Telem Telem;
+  uint8 Status;
+  uint32 Err;
+  uint32 n;
+
+  Test_BootFirmware();
+  Sim_MotorInit(&Sim_MotorDefault, 60.0);
+  memset(&Cmd, 0, sizeof(Cmd));
+
+  /* The slave receives from its second frame on */
+  Cmd.CmdId = SPIPROT_CMD_NONE;
+  SpiProt_EncodeCmd(Tx, &Cmd);
+  TestSpi_Frame(Tx, Rx);
+
+  /* A speed reference starts the motor, stop stops it */
+  Cmd.CmdId = SPIPROT_CMD_SPEED;
+  Cmd.Payload[0] = 1000u;
+  SpiProt_EncodeCmd(Tx, &Cmd);
+  TestSpi_Frame(Tx, Rx);
+  TEST_ASSERT_EQ(Emo_GetMotorState(), EMO_MOTOR_STATE_STOP);
+  Sim_Run(TESTSPI_SYSTICK);
+  TEST_ASSERT(Emo_GetMotorState() != EMO_MOTOR_STATE_STOP);
+  Cmd.CmdId = SPIPROT_CMD_STOP;
+  SpiProt_EncodeCmd(Tx, &Cmd);
+  TestSpi_Frame(Tx, Rx);
+  Sim_Run(TESTSPI_SYSTICK);
+  TEST_ASSERT_EQ(Emo_GetMotorState(), EMO_MOTOR_STATE_STOP);
+
+  Err = 0u;
+  Status = SPIPROT_STATUS_CMD_OK;
+  for(n = 0u; n < TESTSPI_FRAMES_NUM; n++)
+  {
+    TestSpi_RandomCmd(&Cmd);
+    /* Mostly known commands, at small references */
+    if((n % 4u) != 0u)
+    {
+      Cmd.CmdId = (uint8)(Cmd.CmdId % (TESTSPI_CMD_MAX + 1u));
+      Cmd.Payload[0] = (uint16)((sint16)Cmd.Payload[0] / 16);
+    }
+    if(Cmd.CmdId == SPIPROT_CMD_GAINS)
+    {
+      Cmd.CmdId = SPIPROT_CMD_NONE;
+    }
+    SpiProt_EncodeCmd(Tx, &Cmd);
+    TestSpi_Frame(Tx, Rx);
+    if((SpiProt_DecodeTelem(Rx, &Telem) == true) && (n > 0u))
+    {
+      /* Telemetry frame: status of the frame before */
+      TEST_ASSERT_EQ(Telem.Status & (SPIPROT_STATUS_CMD_OK | SPIPROT_STATUS_CMD_ERR), Status);
+    }
+    Status = ((Cmd.CmdId <= TESTSPI_CMD_MAX) && (Cmd.CmdId != SPIPROT_CMD_PROF)) ? SPIPROT_STATUS_CMD_OK :
+                                                                                    SPIPROT_STATUS_CMD_ERR;
+    Err += (Status == SPIPROT_STATUS_CMD_ERR) ? 1u : 0u;
+  }
+
+  /* Still answering */
+  Cmd.CmdId = SPIPROT_CMD_STOP;
+  SpiProt_EncodeCmd(Tx, &Cmd);
+  TestSpi_Frame(Tx, Rx);
+  Cmd.CmdId = SPIPROT_CMD_NONE;
+  SpiProt_EncodeCmd(Tx, &Cmd);
+  TestSpi_Frame(Tx, Rx);
+  TestSpi_Frame(Tx, Rx);
+  Sim_Run(TESTSPI_SYSTICK);
+  TEST_ASSERT(SpiProt_DecodeTelem(Rx, &Telem) == true);
+  TEST_LOG("%u random commands, %u rejected", TESTSPI_FRAMES_NUM, Err);
+  TEST_ASSERT_EQ(Telem.ErrCtr, Err);
+  TEST_ASSERT_EQ(Emo_GetMotorState(), EMO_MOTOR_STATE_STOP);
+}
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+int main(int argc, char **argv)
+{
+  static const TTest_Case Cases[] =
+  {
+    {"TestSpi_RoundTrip", TestSpi_RoundTrip},
+    {"TestSpi_BitErrors", TestSpi_BitErrors},
+    {"TestSpi_Random", TestSpi_Random},
+    {"TestSpi_Firmware", TestSpi_Firmware}
+  };
+
+  return Test_Main(Cases, sizeof(Cases) / sizeof(Cases[0]), argc, argv);
+}
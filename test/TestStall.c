@@ -0,0 +1,173 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version, Hall speed at standstill and stall
+ */
+
+/* The motor runs at speed, then the rotor is locked. Slow sectors are made by
+ * turning the locked rotor 60 degrees at a time: their period is longer than
+ * the 16 bit T6 range (52 ms) and the speed must not alias. Without turning,
+ * the speed reads 0 after EMOCCU_ZERO_SPEED_MS and the stall is latched after
+ * EMOCCU_STALL_MS, both counted from the last Hall edge. */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include "Test.h"
+#include "Emo.h"
+#include "EmoCcu.h"
+#include "Fault.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+/* Speed before the rotor is locked [rpm] */
+#define TESTSTALL_SPEED (1000)
+
+/* Period of the turned sectors [ms], between the T6 range and the zero speed
+ * time; the Hall speed is averaged over about 6 sectors (POS_SPEED_LP_COEF),
+ * from TESTSTALL_SETTLE on it is within the tolerance of the sector speed */
+#define TESTSTALL_SECTOR_MS (150u)
+#define TESTSTALL_SECTORS   (45u)
+#define TESTSTALL_SETTLE    (40u)
+
+/* Speed of the turned sectors [rpm] and the tolerance */
+#define TESTSTALL_SECTOR_RPM (60000.0 / (6.0 * (float64)TESTSTALL_SECTOR_MS * (float64)BCHALL_POLE_PAIRS))
+#define TESTSTALL_SECTOR_TOL (1.0)
+
+/* Detection after the time: the speed loop checks every ms, the fault is
+ * latched in the same or the next SysTick */
+#define TESTSTALL_LATE_MS (3u)
+
+/*******************************************************************************
+**                      Private Function Definitions                          **
+*******************************************************************************/
+/* Motor running at TESTSTALL_SPEED, then the rotor locked */
+static void TestStall_Lock(void)
+{
+  TSim_MotorCfg Cfg;
+
+  Test_BootFirmware();
+  Cfg = Sim_MotorDefault;
+  Cfg.PolePairs = BCHALL_POLE_PAIRS;
+  Sim_MotorInit(&Cfg, 60.0);
+  Sim_Run(SIM_MS(1));
+  Emo_SetRefSpeed(TESTSTALL_SPEED);
+  TEST_ASSERT_EQ(Emo_StartMotor(), 0u);
+  Sim_Run(SIM_MS(800));
+  TEST_ASSERT(Emo_GetMotorState() == EMO_MOTOR_STATE_RUN);
+  TEST_ASSERT(EmoCcu_GetSpeed() > (TESTSTALL_SPEED / 2));
+  Sim_MotorLock(true);
+}
+
+/* Sectors longer than the T6 range give their true speed */
+static void TestStall_SlowSectors(void)
+{
+  uint32 Ticks;
+  uint32 Edges;
+  uint32 Prev;
+  uint32 i;
+
+  TestStall_Lock();
+  (void)Sim_MotorHallEdge(&Prev);
+  for(i = 0u; i < TESTSTALL_SECTORS; i++)
+  {
+    Sim_Run(SIM_MS(TESTSTALL_SECTOR_MS));
+    TEST_ASSERT(EmoCcu_GetSpeed() != 0u);
+    TEST_ASSERT(EmoCcu_GetStall() == false);
+    Sim_MotorSetAngle(Sim_MotorAngle() + 60.0);
+    Sim_Run(SIM_MS(1));
+    if(i >= TESTSTALL_SETTLE)
+    {
+      TEST_ASSERT_RANGE((float64)EmoCcu_GetSpeed(), TESTSTALL_SECTOR_RPM - TESTSTALL_SECTOR_TOL,
+                        TESTSTALL_SECTOR_RPM + TESTSTALL_SECTOR_TOL);
+    }
+  }
+  (void)Sim_MotorHallEdge(&Edges);
+  TEST_ASSERT_EQ(Edges - Prev, TESTSTALL_SECTORS);
+
+  /* T6 frequency = numerator * 6 * pole pairs / 60 */
+  Ticks = (uint32)(((uint64_t)TESTSTALL_SECTOR_MS * EMOCCU_SPEED_FROM_PERIOD_NUM * 6u * BCHALL_POLE_PAIRS) / 60000u);
+  TEST_LOG("sector %u ms (%u T6 ticks): speed %u rpm, %.1f rpm expected, a 16 bit period would give %u rpm",
+           TESTSTALL_SECTOR_MS, Ticks, EmoCcu_GetSpeed(), TESTSTALL_SECTOR_RPM,
+           EMOCCU_SPEED_FROM_PERIOD_NUM / (Ticks & 0xFFFFu));
+  TEST_ASSERT(Fault_Status.StallCtr == 0u);
+}
+
+/* Locked rotor: speed 0, then the stall fault switches the bridge off */
+static void TestStall_Locked(void)
+{
+  TSim_Time Edge;
+  TSim_Time Zero = SIM_NEVER;
+  TSim_Time Stall = SIM_NEVER;
+
+  TestStall_Lock();
+  while((Stall == SIM_NEVER) && (Sim_Now() < SIM_MS(800 + EMOCCU_STALL_MS + 100u)))
+  {
+    Sim_Run(SIM_MS(1));
+    if((Zero == SIM_NEVER) && (EmoCcu_GetSpeed() == 0u))
+    {
+      Zero = Sim_Now();
+    }
+    if((Fault_Status.Active & FAULT_STALL) != 0u)
+    {
+      Stall = Sim_Now();
+    }
+  }
+  Edge = Sim_MotorHallEdge(NULL);
+  TEST_ASSERT(Zero != SIM_NEVER);
+  TEST_ASSERT(Stall != SIM_NEVER);
+  TEST_LOG("after the last Hall edge: speed 0 at %.1f ms, stall at %.1f ms",
+           (float64)(Zero - Edge) / (float64)SIM_MS(1), (float64)(Stall - Edge) / (float64)SIM_MS(1));
+  TEST_ASSERT_RANGE(Zero - Edge, SIM_MS(EMOCCU_ZERO_SPEED_MS), SIM_MS(EMOCCU_ZERO_SPEED_MS + TESTSTALL_LATE_MS));
+  TEST_ASSERT_RANGE(Stall - Edge, SIM_MS(EMOCCU_STALL_MS), SIM_MS(EMOCCU_STALL_MS + TESTSTALL_LATE_MS));
+  TEST_ASSERT_EQ(Fault_Status.StallCtr, 1u);
+  TEST_ASSERT_EQ(Sim_BdrvGates(), 0u);
+
+  Sim_Run(SIM_MS(2));
+  TEST_ASSERT(Emo_GetMotorState() < EMO_MOTOR_STATE_START);
+}
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+int main(int argc, char **argv)
+{
+  static const TTest_Case Cases[] =
+  {
+    {"TestStall_SlowSectors", TestStall_SlowSectors},
+    {"TestStall_Locked", TestStall_Locked}
+  };
+
+  return Test_Main(Cases, sizeof(Cases) / sizeof(Cases[0]), argc, argv);
+}
@@ -0,0 +1,333 @@
+/**
+ * @cond
+ ***********************************************************************************************************************
+ *
+ * Copyright (c) 2015, Infineon Technologies AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+ * following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this list of conditions and the  following
+ *   disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *   following disclaimer in the documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+ *   products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT  OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************************************************/
+
+/*******************************************************************************
+**                      Revision Control History                              **
+*******************************************************************************/
+/*
+ * V0.1.0: 2026-10-17: Initial version
+ */
+
+/* Efficiency of block commutation over speed with a commutation delay curve.
+ *
+ * Plant: three phases with resistance, inductance and sinusoidal BEMF in star,
+ * block commutation with freewheeling through the diodes of the open phase,
+ * rotor inertia with a quadratic load, a PI speed controller on the duty cycle.
+ * The Hall edges are MODEL_HALL_ADV degrees before the neutral commutation
+ * point; after each edge commutation is delayed as by EmoCcu_HandleHallEvent:
+ * T6 period, speed and delay factor through EmoCcu_SpeedFromPeriod and
+ * EmoCcu_GetDelayFac, T13 ticks. Only copper losses are modelled.
+ *
+ * Usage: delay_model          fixed 30 deg delay against MODEL_CURVE
+ *        delay_model --sweep  efficiency / input power / speed over advance
+ */
+
+/*******************************************************************************
+**                      Includes                                              **
+*******************************************************************************/
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "EmoCcu.h"
+
+/*******************************************************************************
+**                      Private Macro Definitions                             **
+*******************************************************************************/
+/* Motor: DC link [V], pole pairs, phase resistance [ohm] and inductance [H],
+ * BEMF constant [V peak per mechanical rad/s], inertia [kg m^2] */
+#define MODEL_VDC        (24.0)
+#define MODEL_POLE_PAIRS (4u)
+#define MODEL_R          (0.3)
+#define MODEL_L          (0.2e-3)
+#define MODEL_KE         (0.0189)
+#define MODEL_J          (2e-5)
+
+/* Hall edges before the neutral commutation point [degrees] */
+#define MODEL_HALL_ADV (30.0)
+
+/* Integration step, settling time and end of a run [s] */
+#define MODEL_DT     (1e-6)
+#define MODEL_SETTLE (1.0)
+#define MODEL_END    (1.5)
+
+/* Timer clocks as in the firmware [Hz] */
+#define MODEL_T6_HZ  ((float64)EMO_FSYS_HZ / (float64)TIMEBASE_T6_DIV)
+#define MODEL_T13_HZ ((float64)EMO_FSYS_HZ / 256.0)
+#define MODEL_T6_PER_T13 (256u / TIMEBASE_T6_DIV)
+
+#define MODEL_PI (3.14159265358979)
+
+/* Speeds of the comparison [rpm] */
+#define MODEL_SPEED_NUM (7u)
+
+/*******************************************************************************
+**                      Private Type Definitions                              **
+*******************************************************************************/
+typedef struct
+{
+  float64 Eff;   /* mechanical / electrical power */
+  float64 Pin;   /* electrical input power [W] */
+  float64 Irms;  /* phase current [A] */
+  float64 Speed; /* reached speed [rpm] */
+  float64 Adv;   /* mean advance of commutation [degrees] */
+} TModel_Result;
+
+/*******************************************************************************
+**                      Private Constant Definitions                          **
+*******************************************************************************/
+/* Phase states of the six steps: 1 PWM high side, -1 low side, 0 open; step s
+ * starts at the neutral commutation point s * 60 + 30 degrees */
+static const sint8 Model_Drive[6][3] =
+{
+  { 1, -1, 0 }, { 1, 0, -1 }, { 0, 1, -1 }, { -1, 1, 0 }, { -1, 0, 1 }, { 0, -1, 1 }
+};
+
+static const float64 Model_Speeds[MODEL_SPEED_NUM] = { 1000, 2000, 3000, 4000, 5000, 5500, 6000 };
+
+/* No advance: 30 deg delay after the early Hall edge */
+static const TEmoCcu_DelayCurve Model_Fixed =
+  EMOCCU_DELAY_CURVE(0u, 30u, 2000u, 30u, 4000u, 30u, 6000u, 30u);
+
+/* Advance above 3000 rpm, full 30 deg at 6000 rpm */
+static const TEmoCcu_DelayCurve Model_Curve =
+  EMOCCU_DELAY_CURVE(3000u, 30u, 4500u, 22u, 5200u, 22u, 6000u, 0u);
+
+/*******************************************************************************
+**                      Private Function Definitions                          **
+*******************************************************************************/
+/* Load torque [Nm] at angular speed W [rad/s] */
+static float64 Model_Load(float64 W)
+{
+  float64 N = (W * 60.0) / (2.0 * MODEL_PI);
+
+  return 0.02 + (0.25 * (N / 6000.0) * (N / 6000.0));
+}
+
+/* Hall sector 0..5 at electrical angle Angle [degrees] */
+static int Model_Sector(float64 Angle, float64 Adv)
+{
+  return ((int)floor(fmod(Angle - 30.0 + Adv + 720.0, 360.0) / 60.0)) % 6;
+}
+
+/* Runs to the steady state at speed reference Ref [rpm] */
+static void Model_Run(const TEmoCcu_DelayCurve *pCurve, float64 Ref, TModel_Result *pRes)
+{
+  float64 T = 0.0;
+  float64 W = ((Ref * 2.0 * MODEL_PI) / 60.0) * 0.9;
+  float64 Theta = 0.0;
+  float64 I[3] = { 0.0, 0.0, 0.0 };
+  float64 Duty = 0.5;
+  float64 Integ = 0.5;
+  float64 ComTime = 0.0;
+  float64 Ein = 0.0, Emech = 0.0, I2 = 0.0, Tsum = 0.0, AdvSum = 0.0;
+  uint32 AdvNum = 0u;
+  uint32 EdgeTicks = 0u;
+  uint32 Edges = 0u;
+  int Step;
+  int Hall;
+  int Pending = -1;
+  int k;
+
+  Step = Model_Sector(0.0, 0.0);
+  Hall = Model_Sector(0.0, MODEL_HALL_ADV);
+  while(T < MODEL_END)
+  {
+    float64 Angle = fmod(Theta * (float64)MODEL_POLE_PAIRS * 180.0 / MODEL_PI, 360.0);
+    float64 E[3], V[3], Sum = 0.0, Vn, P = 0.0, Pm = 0.0, Err;
+    int Con[3], Num = 0;
+    int Sector = Model_Sector(Angle, MODEL_HALL_ADV);
+
+    /* Hall event: speed and delay as the firmware */
+    if(Sector != Hall)
+    {
+      uint32 Ticks = (uint32)(T * MODEL_T6_HZ);
+      uint32 Diff = Ticks - EdgeTicks;
+      uint32 Speed;
+      uint32 Delay;
+
+      Hall = Sector;
+      EdgeTicks = Ticks;
+      Edges++;
+      if(Edges > 2u)
+      {
+        Speed = (EmoCcu_SpeedFromPeriod(Diff) * BCHALL_POLE_PAIRS) / MODEL_POLE_PAIRS;
+        Delay = Diff / MODEL_T6_PER_T13;
+        Delay = (Delay > 0xFFFFu) ? 0xFFFFu : Delay;
+        Delay = ((Delay * EmoCcu_GetDelayFac(pCurve, Speed)) + 32768u) >> 16u;
+        ComTime = T + ((float64)Delay / MODEL_T13_HZ);
+        Pending = Sector;
+        if(T > MODEL_SETTLE)
+        {
+          AdvSum += MODEL_HALL_ADV - (((float64)Delay / MODEL_T13_HZ) * W * (float64)MODEL_POLE_PAIRS * 180.0 / MODEL_PI);
+          AdvNum++;
+        }
+      }
+      else
+      {
+        Step = Sector;
+      }
+    }
+    if((Pending >= 0) && (T >= ComTime))
+    {
+      Step = Pending;
+      Pending = -1;
+    }
+
+    /* Phase voltages, the open phase conducts through a diode while current flows */
+    for(k = 0; k < 3; k++)
+    {
+      E[k] = MODEL_KE * W * sin((Theta * (float64)MODEL_POLE_PAIRS) - ((float64)k * 2.0 * MODEL_PI / 3.0));
+      Con[k] = 1;
+      if(Model_Drive[Step][k] == 1)
+      {
+        V[k] = Duty * MODEL_VDC;
+      }
+      else if((Model_Drive[Step][k] == -1) || (I[k] > 1e-9))
+      {
+        V[k] = 0.0;
+      }
+      else if(I[k] < -1e-9)
+      {
+        V[k] = MODEL_VDC;
+      }
+      else
+      {
+        V[k] = 0.0;
+        Con[k] = 0;
+      }
+      if(Con[k] != 0)
+      {
+        Num++;
+        Sum += V[k] - (MODEL_R * I[k]) - E[k];
+      }
+    }
+    Vn = (Num != 0) ? (Sum / (float64)Num) : 0.0;
+    for(k = 0; k < 3; k++)
+    {
+      if((Con[k] != 0) && (Num >= 2))
+      {
+        float64 Inew = I[k] + (((V[k] - Vn - (MODEL_R * I[k]) - E[k]) / MODEL_L) * MODEL_DT);
+
+        /* Diode of the open phase blocks at the zero crossing */
+        if((Model_Drive[Step][k] == 0) && (((I[k] > 0.0) && (Inew < 0.0)) || ((I[k] < 0.0) && (Inew > 0.0))))
+        {
+          Inew = 0.0;
+        }
+        I[k] = Inew;
+      }
+      else
+      {
+        I[k] = 0.0;
+      }
+    }
+
+    /* Star point: currents sum to zero */
+    Sum = I[0] + I[1] + I[2];
+    Num = (I[0] != 0.0) + (I[1] != 0.0) + (I[2] != 0.0);
+    for(k = 0; k < 3; k++)
+    {
+      if((Num != 0) && (I[k] != 0.0))
+      {
+        I[k] -= Sum / (float64)Num;
+      }
+      P += V[k] * I[k];
+      Pm += E[k] * I[k];
+    }
+
+    /* Mechanics */
+    W += (((W > 1.0) ? (Pm / W) : 0.0) - Model_Load(W)) / MODEL_J * MODEL_DT;
+    Theta += W * MODEL_DT;
+    T += MODEL_DT;
+
+    /* Speed controller every 1 ms */
+    if(fmod(T, 1e-3) < MODEL_DT)
+    {
+      Err = (Ref - ((W * 60.0) / (2.0 * MODEL_PI))) / 1000.0;
+      Integ += 0.02 * Err;
+      Integ = (Integ > 1.0) ? 1.0 : ((Integ < 0.0) ? 0.0 : Integ);
+      Duty = Integ + (0.2 * Err);
+      Duty = (Duty > 1.0) ? 1.0 : ((Duty < 0.0) ? 0.0 : Duty);
+    }
+    if(T > MODEL_SETTLE)
+    {
+      Ein += P * MODEL_DT;
+      Emech += Pm * MODEL_DT;
+      I2 += ((I[0] * I[0]) + (I[1] * I[1]) + (I[2] * I[2])) / 3.0 * MODEL_DT;
+      Tsum += MODEL_DT;
+    }
+  }
+  pRes->Eff = Emech / Ein;
+  pRes->Pin = Ein / Tsum;
+  pRes->Irms = sqrt(I2 / Tsum);
+  pRes->Speed = (W * 60.0) / (2.0 * MODEL_PI);
+  pRes->Adv = (AdvNum != 0u) ? (AdvSum / (float64)AdvNum) : 0.0;
+}
+
+/*******************************************************************************
+**                      Global Function Definitions                           **
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+  TModel_Result Fixed;
+  TModel_Result Curve;
+  uint32 s;
+  uint32 a;
+
+  if((argc > 1) && (strcmp(argv[1], "--sweep") == 0))
+  {
+    /* Constant advance 0..30 deg: efficiency / input power [W] / speed [rpm] */
+    for(s = 0u; s < MODEL_SPEED_NUM; s++)
+    {
+      printf("%5.0f rpm:", Model_Speeds[s]);
+      for(a = 0u; a <= 30u; a += 5u)
+      {
+        const TEmoCcu_DelayCurve Const = EMOCCU_DELAY_CURVE(0u, 30u - a, 0u, 30u - a, 0u, 30u - a, 0u, 30u - a);
+
+        Model_Run(&Const, Model_Speeds[s], &Fixed);
+        printf("  %2u deg %.3f/%5.1f/%4.0f", a, Fixed.Eff, Fixed.Pin, Fixed.Speed);
+      }
+      printf("\n");
+      fflush(stdout);
+    }
+  }
+  else
+  {
+    for(s = 0u; s < MODEL_SPEED_NUM; s++)
+    {
+      Model_Run(&Model_Fixed, Model_Speeds[s], &Fixed);
+      Model_Run(&Model_Curve, Model_Speeds[s], &Curve);
+      printf("%5.0f rpm: fixed adv %4.1f eff %.3f Pin %5.1f W Irms %5.2f A n %5.0f | "
+             "curve adv %4.1f eff %.3f Pin %5.1f W Irms %5.2f A n %5.0f\n",
+             Model_Speeds[s], Fixed.Adv, Fixed.Eff, Fixed.Pin, Fixed.Irms, Fixed.Speed,
+             Curve.Adv, Curve.Eff, Curve.Pin, Curve.Irms, Curve.Speed);
+      fflush(stdout);
+    }
+  }
+  return 0;
+}
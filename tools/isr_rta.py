@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+"""Worst-case response times of the interrupt handlers.
+
+Fixed priority, preemptive response time analysis for the NVIC levels of
+app/IntPrio.h. Handlers on the same level do not preempt each other, so one
+of them can block; interrupt locks (PRIMASK) block every level.
+
+    R = B + C + sum over higher levels j of ceil(R / T_j) * C_j
+    B = max(longest interrupt lock, longest other handler on the same level)
+
+Input is a CSV file with the columns name, level, wcet_cycles, period_us and
+an optional deadline_us (default: period). wcet_cycles are measured execution
+times of one activation (longest run of the SPI profile frame of a build
+with ISR_PROF_EN = 1, see app/IsrProf.h); period_us is the shortest time
+between two activations.
+
+Usage: isr_rta.py [--fsys HZ] [--lock CYCLES] [--overhead CYCLES] isr_rta.csv
+"""
+
+import argparse
+import csv
+import math
+import sys
+
+
+def load(path):
+    isrs = []
+    with open(path, newline='') as f:
+        for row in csv.DictReader(line for line in f if not line.lstrip().startswith('#')):
+            period = float(row['period_us'])
+            deadline = row.get('deadline_us') or ''
+            isrs.append({
+                'name': row['name'].strip(),
+                'level': int(row['level']),
+                'wcet': int(row['wcet_cycles']),
+                'period': period,
+                'deadline': float(deadline) if deadline.strip() else period,
+            })
+    return isrs
+
+
+def response_time(isr, isrs, lock, overhead, cycles_per_us):
+    cost = lambda other: (other['wcet'] + overhead) / cycles_per_us
+    same = [cost(o) for o in isrs if o is not isr and o['level'] == isr['level']]
+    higher = [o for o in isrs if o['level'] < isr['level']]
+    blocking = max([lock / cycles_per_us] + same)
+    resp = blocking + cost(isr)
+    while True:
+        nxt = blocking + cost(isr) + sum(math.ceil(resp / o['period']) * cost(o) for o in higher)
+        if nxt <= resp + 1e-9:
+            return blocking, resp
+        if nxt > 100.0 * isr['deadline']:
+            return blocking, math.inf
+        resp = nxt
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument('csv')
+    ap.add_argument('--fsys', type=float, default=40e6, help='CPU clock [Hz], default 40 MHz')
+    ap.add_argument('--lock', type=int, default=0, help='longest interrupt lock [cycles]')
+    ap.add_argument('--overhead', type=int, default=24,
+                    help='entry and exit per activation [cycles], default 24 (Cortex-M3)')
+    args = ap.parse_args()
+
+    cycles_per_us = args.fsys / 1e6
+    isrs = sorted(load(args.csv), key=lambda o: o['level'])
+    util = sum((o['wcet'] + args.overhead) / cycles_per_us / o['period'] for o in isrs)
+
+    print('%-10s %5s %9s %9s %9s %9s %9s  %s' %
+          ('isr', 'level', 'C [us]', 'T [us]', 'D [us]', 'B [us]', 'R [us]', 'result'))
+    ok = True
+    for isr in isrs:
+        blocking, resp = response_time(isr, isrs, args.lock, args.overhead, cycles_per_us)
+        met = resp <= isr['deadline']
+        ok = ok and met
+        print('%-10s %5d %9.2f %9.1f %9.1f %9.2f %9s  %s' %
+              (isr['name'], isr['level'], (isr['wcet'] + args.overhead) / cycles_per_us,
+               isr['period'], isr['deadline'], blocking,
+               'inf' if math.isinf(resp) else '%.2f' % resp, 'ok' if met else 'MISSED'))
+    print('utilization %.1f %%' % (100.0 * util))
+    return 0 if ok else 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+"""Decodes the control loop trace of app/Trace.c.
+
+The firmware streams records on UART1 (TXD1, P0.1, 1 MBaud, 8N1):
+
+    0xA5, sequence number, channel mask, values, XOR check
+
+The values of the channels enabled in the mask follow in ascending channel
+order, little endian. The check is the XOR of all bytes from the sequence
+number up to the last value byte. Records with a wrong check are skipped up
+to the next sync byte. A jump in the sequence number counts the records
+dropped by the firmware (ring buffer full) or lost on the line.
+
+Input is a raw capture of the UART bytes, e.g. from a USB serial adapter:
+
+    stty -F /dev/ttyUSB0 1000000 raw && cat /dev/ttyUSB0 > trace.bin
+
+Output is one row per record, CSV by default or aligned columns, with the
+channels of app/Trace.h; channels not in a record are left empty.
+
+Usage: trace_decode.py [--format csv|columns] [--out FILE] trace.bin
+"""
+
+import argparse
+import csv
+import struct
+import sys
+
+SYNC = 0xA5
+HEADER_BYTES = 3
+
+# Channels of app/Trace.h (TRACE_CH_x): name, struct format
+CHANNELS = [
+    ('time_us', '<I'),
+    ('speed_iout', '<i'),
+    ('duty', '<H'),
+    ('hall_speed_rpm', '<H'),
+    ('hall_ptn', '<B'),
+    ('current', '<h'),
+    ('pos', '<i'),
+]
+
+
+def record_len(mask):
+    """Record length [bytes] for a channel mask, None for unknown channels."""
+    if mask >> len(CHANNELS):
+        return None
+    return HEADER_BYTES + sum(struct.calcsize(fmt) for i, (_, fmt) in enumerate(CHANNELS)
+                              if mask & (1 << i)) + 1
+
+
+def decode(data, stats):
+    """Yields (seq, {channel: value}) for each valid record."""
+    pos = 0
+    last_seq = None
+    while pos + HEADER_BYTES < len(data):
+        if data[pos] != SYNC:
+            pos += 1
+            stats['skipped'] += 1
+            continue
+        length = record_len(data[pos + 2])
+        if length is None or data[pos + 2] == 0 or pos + length > len(data):
+            if length is not None and pos + length > len(data):
+                # Capture ends within the record
+                break
+            pos += 1
+            stats['skipped'] += 1
+            continue
+        chk = 0
+        for b in data[pos + 1:pos + length - 1]:
+            chk ^= b
+        if chk != data[pos + length - 1]:
+            stats['check_errors'] += 1
+            pos += 1
+            stats['skipped'] += 1
+            continue
+
+        seq, mask = data[pos + 1], data[pos + 2]
+        values = {}
+        ofs = pos + HEADER_BYTES
+        for i, (name, fmt) in enumerate(CHANNELS):
+            if mask & (1 << i):
+                values[name] = struct.unpack_from(fmt, data, ofs)[0]
+                ofs += struct.calcsize(fmt)
+        if last_seq is not None:
+            stats['lost'] += (seq - last_seq - 1) & 0xFF
+        last_seq = seq
+        stats['records'] += 1
+        yield seq, values
+        pos += length
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument('capture', help='raw UART capture, - for stdin')
+    ap.add_argument('--format', choices=('csv', 'columns'), default='csv')
+    ap.add_argument('--out', help='output file, default stdout')
+    args = ap.parse_args()
+
+    if args.capture == '-':
+        data = sys.stdin.buffer.read()
+    else:
+        with open(args.capture, 'rb') as f:
+            data = f.read()
+
+    stats = {'records': 0, 'lost': 0, 'check_errors': 0, 'skipped': 0}
+    names = ['seq'] + [name for name, _ in CHANNELS]
+    out = open(args.out, 'w', newline='') if args.out else sys.stdout
+    try:
+        if args.format == 'csv':
+            writer = csv.writer(out)
+            writer.writerow(names)
+            for seq, values in decode(data, stats):
+                writer.writerow([seq] + [values.get(name, '') for name in names[1:]])
+        else:
+            width = [max(len(name), 11) for name in names]
+            out.write(' '.join('%*s' % (w, n) for w, n in zip(width, names)) + '\n')
+            for seq, values in decode(data, stats):
+                row = [seq] + [values.get(name, '') for name in names[1:]]
+                out.write(' '.join('%*s' % (w, v) for w, v in zip(width, row)) + '\n')
+    finally:
+        if out is not sys.stdout:
+            out.close()
+
+    sys.stderr.write('%d records, %d lost (sequence gaps), %d check errors, %d bytes skipped\n' %
+                     (stats['records'], stats['lost'], stats['check_errors'], stats['skipped']))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())